@@ -9,11 +9,13 @@ PROJECT_DIR=$(realpath .)
 GENERATED_DIR="${PROJECT_DIR}/generated"
 SRC_DIR="${PROJECT_DIR}/src"
 TESTS_DIR="${PROJECT_DIR}/tests"
+TOOLS_DIR="${PROJECT_DIR}/tools"
 EXAMPLES_DIR="${PROJECT_DIR}/examples"
 
 # Build configuration
 OPTIMIZATION_LEVEL="-O2"
 COMPILER_FLAGS="-Wall -Wextra -Wno-unused-parameter"
+LINK_FLAGS="-lm -pthread"
 TARGET_ARCH=${TARGET_ARCH:-"native"}
 
 echo "=========================================="
@@ -30,23 +32,67 @@ mkdir -p "${GENERATED_DIR}"
 
 # Validate source files exist
 echo "=== Validating source files ==="
-ASN1_SCHEMA="${EXAMPLES_DIR}/satellite.asn"
-if [ ! -f "${ASN1_SCHEMA}" ]; then
-    echo "Error: ASN.1 schema not found: ${ASN1_SCHEMA}"
-    exit 1
-fi
+# Every module is compiled into one runtime and picked per frame by
+# SchemaRegistry; satellite.asn is the primary the tools and tests use,
+# beacon.asn the second module test_registry routes to.
+# Add modules with ASN1_EXTRA_SCHEMAS="a.asn b.asn" ./build.sh
+ASN1_SCHEMAS=("${EXAMPLES_DIR}/satellite.asn" "${EXAMPLES_DIR}/beacon.asn")
+for schema in ${ASN1_EXTRA_SCHEMAS:-}; do
+    ASN1_SCHEMAS+=("${schema}")
+done
+for schema in "${ASN1_SCHEMAS[@]}"; do
+    if [ ! -f "${schema}" ]; then
+        echo "Error: ASN.1 schema not found: ${schema}"
+        exit 1
+    fi
+done
 
 # Check for required source files
-REQUIRED_SRC_FILES=(
-    "${SRC_DIR}/asn1crt_mempool.c"
-    "${SRC_DIR}/asn1crt_mempool.h" 
-    "${SRC_DIR}/asn1crt_stream.c"
-    "${SRC_DIR}/asn1crt_stream.h"
+# Runtime extension modules (src/<name>.c and src/<name>.h)
+RUNTIME_EXTENSIONS=(
+    asn1crt_mempool
+    asn1crt_stream
+    asn1crt_partial
+    asn1crt_lazy
+    asn1crt_corpus
+    asn1crt_latency
+    asn1crt_fieldprof
+    asn1crt_crc
+    asn1crt_integrity
+    asn1crt_ingest
+    asn1crt_reorder
+    asn1crt_parallel
+    asn1crt_export
+    asn1crt_flat
+    asn1crt_outring
+    asn1crt_registry
+    asn1crt_sched
+    asn1crt_cmdtrack
+    asn1crt_validate
+    asn1crt_shmring
+    asn1crt_statetable
+    asn1crt_dedup
+    asn1crt_headerbatch
 )
 
-for file in "${REQUIRED_SRC_FILES[@]}"; do
-    if [ ! -f "$file" ]; then
-        echo "Error: Required source file not found: $file"
+for ext in "${RUNTIME_EXTENSIONS[@]}"; do
+    for file in "${SRC_DIR}/${ext}.c" "${SRC_DIR}/${ext}.h"; do
+        if [ ! -f "$file" ]; then
+            echo "Error: Required source file not found: $file"
+            exit 1
+        fi
+    done
+done
+
+# Header-only runtime pieces (src/<name>.h) the extensions include
+RUNTIME_HEADERS=(
+    asn1crt_layout
+    asn1crt_internal
+)
+
+for hdr in "${RUNTIME_HEADERS[@]}"; do
+    if [ ! -f "${SRC_DIR}/${hdr}.h" ]; then
+        echo "Error: Required header not found: ${SRC_DIR}/${hdr}.h"
         exit 1
     fi
 done
@@ -59,7 +105,7 @@ asn1scc -c -uPER \
         -typePrefix T_ \
         -renamePolicy 1 \
         -o "${GENERATED_DIR}" \
-        "${ASN1_SCHEMA}" || {
+        "${ASN1_SCHEMAS[@]}" || {
     echo "ERROR: ASN1SCC compilation failed"
     echo "Check that ASN1SCC is properly installed and in PATH"
     exit 1
@@ -68,13 +114,18 @@ asn1scc -c -uPER \
 # Verify critical files were generated
 echo "=== Verifying generated files ==="
 REQUIRED_GENERATED_FILES=(
-    "${GENERATED_DIR}/satellite.c"
-    "${GENERATED_DIR}/satellite.h"
     "${GENERATED_DIR}/asn1crt.c"
     "${GENERATED_DIR}/asn1crt.h"
     "${GENERATED_DIR}/asn1crt_encoding.c"
     "${GENERATED_DIR}/asn1crt_encoding_uper.c"
 )
+# asn1scc names each module's files after its schema file
+SCHEMA_MODULES=()
+for schema in "${ASN1_SCHEMAS[@]}"; do
+    module="$(basename "${schema}" .asn)"
+    SCHEMA_MODULES+=("${module}")
+    REQUIRED_GENERATED_FILES+=("${GENERATED_DIR}/${module}.c" "${GENERATED_DIR}/${module}.h")
+done
 
 for file in "${REQUIRED_GENERATED_FILES[@]}"; do
     if [ ! -f "$file" ]; then
@@ -89,28 +140,95 @@ echo "Generated files verified successfully."
 
 # 2. Copy optimization runtime extensions
 echo "=== Copying runtime extensions ==="
-echo "Installing memory pool optimization..."
-cp -v "${SRC_DIR}/asn1crt_mempool.c" "${GENERATED_DIR}/"
-cp -v "${SRC_DIR}/asn1crt_mempool.h" "${GENERATED_DIR}/"
-
-echo "Installing stream optimization..."
-cp -v "${SRC_DIR}/asn1crt_stream.c" "${GENERATED_DIR}/"
-cp -v "${SRC_DIR}/asn1crt_stream.h" "${GENERATED_DIR}/"
-
-# 3. Compile main telemetry program with optimizations
-echo "=== Compiling main program ==="
-echo "Building optimized telemetry program..."
+for ext in "${RUNTIME_EXTENSIONS[@]}"; do
+    echo "Installing ${ext}..."
+    cp -v "${SRC_DIR}/${ext}.c" "${GENERATED_DIR}/"
+    cp -v "${SRC_DIR}/${ext}.h" "${GENERATED_DIR}/"
+done
+for hdr in "${RUNTIME_HEADERS[@]}"; do
+    cp -v "${SRC_DIR}/${hdr}.h" "${GENERATED_DIR}/"
+done
 
-# Define source files for main program
-MAIN_SOURCES=(
+# Generated runtime plus every extension, linked into each program
+RUNTIME_SOURCES=(
     "${GENERATED_DIR}/asn1crt.c"
     "${GENERATED_DIR}/asn1crt_encoding.c"
     "${GENERATED_DIR}/asn1crt_encoding_uper.c"
-    "${GENERATED_DIR}/satellite.c"
-    "${GENERATED_DIR}/asn1crt_mempool.c"
-    "${GENERATED_DIR}/asn1crt_stream.c"
-    "${TESTS_DIR}/test_optimized_decoders.c"
 )
+for module in "${SCHEMA_MODULES[@]}"; do
+    RUNTIME_SOURCES+=("${GENERATED_DIR}/${module}.c")
+done
+for ext in "${RUNTIME_EXTENSIONS[@]}"; do
+    RUNTIME_SOURCES+=("${GENERATED_DIR}/${ext}.c")
+done
+
+# build_program <output> <sources...> - link a driver against the runtime
+build_program() {
+    local output="$1"
+    shift
+    gcc ${COMPILER_FLAGS} ${OPTIMIZATION_LEVEL} \
+        -I"${GENERATED_DIR}" \
+        -I"${SRC_DIR}" \
+        "${RUNTIME_SOURCES[@]}" \
+        "$@" \
+        -o "${PROJECT_DIR}/${output}" \
+        ${LINK_FLAGS}
+}
+
+# build_optional <output> <main source> [support sources...] - build a secondary program, warn on failure
+build_optional() {
+    local output="$1"
+    local source="$2"
+    shift 2
+    if [ ! -f "${source}" ]; then
+        echo "Source not found, skipping ${output}: ${source}"
+        return 0
+    fi
+    echo "Building ${output}..."
+    build_program "${output}" "${source}" "$@" || {
+        echo "Warning: ${output} compilation failed"
+        return 0
+    }
+    echo "${output} compiled successfully: ./${output}"
+}
+
+# build_cxx_optional <output> <main source> - build a C++20 program against the C runtime, warn on failure
+build_cxx_optional() {
+    local output="$1"
+    local source="$2"
+    local objdir="${GENERATED_DIR}/obj"
+    if [ ! -f "${source}" ]; then
+        echo "Source not found, skipping ${output}: ${source}"
+        return 0
+    fi
+    if ! command -v g++ >/dev/null 2>&1; then
+        echo "g++ not found, skipping ${output}"
+        return 0
+    fi
+    echo "Building ${output}..."
+    mkdir -p "${objdir}"
+    for runtime in "${RUNTIME_SOURCES[@]}"; do
+        gcc ${COMPILER_FLAGS} ${OPTIMIZATION_LEVEL} -I"${GENERATED_DIR}" -I"${SRC_DIR}" \
+            -c "${runtime}" -o "${objdir}/$(basename "${runtime%.c}").o" || {
+            echo "Warning: ${output} compilation failed"
+            return 0
+        }
+    done
+    g++ -std=c++20 ${COMPILER_FLAGS} ${OPTIMIZATION_LEVEL} \
+        -I"${GENERATED_DIR}" \
+        -I"${SRC_DIR}" \
+        "${source}" "${objdir}"/*.o \
+        -o "${PROJECT_DIR}/${output}" \
+        ${LINK_FLAGS} || {
+        echo "Warning: ${output} compilation failed"
+        return 0
+    }
+    echo "${output} compiled successfully: ./${output}"
+}
+
+# 3. Compile main telemetry program with optimizations
+echo "=== Compiling main program ==="
+echo "Building optimized telemetry program..."
 
 # Check test file exists
 if [ ! -f "${TESTS_DIR}/test_optimized_decoders.c" ]; then
@@ -120,50 +238,101 @@ if [ ! -f "${TESTS_DIR}/test_optimized_decoders.c" ]; then
     exit 1
 fi
 
-gcc ${COMPILER_FLAGS} ${OPTIMIZATION_LEVEL} \
-    -I"${GENERATED_DIR}" \
-    -I"${SRC_DIR}" \
-    "${MAIN_SOURCES[@]}" \
-    -o "${PROJECT_DIR}/telemetry_program" \
-    -lm || {
+build_program telemetry_program "${TESTS_DIR}/test_optimized_decoders.c" || {
     echo "ERROR: Main program compilation failed"
     exit 1
 }
 
 echo "Main program compiled successfully: ./telemetry_program"
 
-# 4. Compile memory benchmark if available
-echo "=== Compiling memory benchmark ==="
-if [ -f "${TESTS_DIR}/memory_benchmark.c" ]; then
-    echo "Building memory performance benchmark..."
-    
-    BENCHMARK_SOURCES=(
-        "${GENERATED_DIR}/asn1crt.c"
-        "${GENERATED_DIR}/asn1crt_encoding.c"
-        "${GENERATED_DIR}/asn1crt_encoding_uper.c"
-        "${GENERATED_DIR}/satellite.c"
-        "${GENERATED_DIR}/asn1crt_mempool.c"
-        "${GENERATED_DIR}/asn1crt_stream.c"
-        "${TESTS_DIR}/memory_benchmark.c"
-    )
-    
-    gcc ${COMPILER_FLAGS} ${OPTIMIZATION_LEVEL} \
-        -I"${GENERATED_DIR}" \
-        -I"${SRC_DIR}" \
-        "${BENCHMARK_SOURCES[@]}" \
-        -o "${PROJECT_DIR}/memory_benchmark" \
-        -lm || {
-        echo "Warning: Memory benchmark compilation failed"
-    }
-    
-    if [ -f "${PROJECT_DIR}/memory_benchmark" ]; then
-        echo "Memory benchmark compiled successfully: ./memory_benchmark"
-    fi
-else
-    echo "Memory benchmark source not found, skipping..."
-fi
+# 4. Compile benchmark suite if available
+echo "=== Compiling benchmark suite ==="
+build_optional telemetry_benchmark "${TESTS_DIR}/telemetry_benchmark.c" "${TESTS_DIR}/bench_harness.c"
+build_optional corpus_gen "${TOOLS_DIR}/corpus_gen.c"
+build_optional test_corpus "${TESTS_DIR}/test_corpus.c"
+build_optional soak_test "${TESTS_DIR}/soak_test.c"
+
+# 5. Compile network ingest tools and tests
+echo "=== Compiling ingest tools ==="
+build_optional ingest_server "${TOOLS_DIR}/ingest_server.c"
+build_optional udp_frame_generator "${TOOLS_DIR}/udp_frame_generator.c"
+build_optional test_ingest_loopback "${TESTS_DIR}/test_ingest_loopback.c"
+
+# 6. Compile parallel decode tests
+echo "=== Compiling parallel decode tests ==="
+build_optional test_parallel_reorder "${TESTS_DIR}/test_parallel_reorder.c"
+
+# 7. Compile frame integrity tests
+echo "=== Compiling frame integrity tests ==="
+build_optional test_frame_integrity "${TESTS_DIR}/test_frame_integrity.c"
+
+# 8. Compile latency instrumentation tests
+echo "=== Compiling latency instrumentation tests ==="
+build_optional test_latency "${TESTS_DIR}/test_latency.c"
+
+# 9. Compile field profiler
+echo "=== Compiling field profiler ==="
+build_optional field_profile "${TOOLS_DIR}/field_profile.c"
+build_optional test_field_profile "${TESTS_DIR}/test_field_profile.c"
+
+# 10. Compile lazy frame tests
+echo "=== Compiling lazy frame tests ==="
+build_optional test_lazy_frame "${TESTS_DIR}/test_lazy_frame.c"
+
+# 11. Compile C++20 range pipeline tests
+echo "=== Compiling C++ range pipeline tests ==="
+build_cxx_optional test_ranges "${TESTS_DIR}/test_ranges.cpp"
+
+# 12. Compile exporter
+echo "=== Compiling exporter ==="
+build_optional telemetry_export "${TOOLS_DIR}/telemetry_export.c"
+build_optional test_export "${TESTS_DIR}/test_export.c"
+
+# 13. Compile flat encoding tests
+echo "=== Compiling flat encoding tests ==="
+build_optional test_flat "${TESTS_DIR}/test_flat.c"
+
+# 14. Compile output ring tests
+echo "=== Compiling output ring tests ==="
+build_optional test_outring "${TESTS_DIR}/test_outring.c"
+
+# 15. Compile schema registry tests
+echo "=== Compiling schema registry tests ==="
+build_optional test_registry "${TESTS_DIR}/test_registry.c"
+
+# 16. Compile priority scheduler tests
+echo "=== Compiling priority scheduler tests ==="
+build_optional test_sched "${TESTS_DIR}/test_sched.c"
+
+# 17. Compile command tracker tests
+echo "=== Compiling command tracker tests ==="
+build_optional test_cmdtrack "${TESTS_DIR}/test_cmdtrack.c"
+
+# 18. Compile batch validation tests
+echo "=== Compiling batch validation tests ==="
+build_optional test_validate "${TESTS_DIR}/test_validate.c"
+
+# 19. Compile shared-memory ring tests
+echo "=== Compiling shared-memory ring tests ==="
+build_optional test_shmring "${TESTS_DIR}/test_shmring.c"
+
+# 20. Compile state table tests
+echo "=== Compiling state table tests ==="
+build_optional test_statetable "${TESTS_DIR}/test_statetable.c"
+
+# 21. Compile block dedup tests
+echo "=== Compiling block dedup tests ==="
+build_optional test_dedup "${TESTS_DIR}/test_dedup.c"
+
+# 22. Compile batch header unpack tests
+echo "=== Compiling batch header unpack tests ==="
+build_optional test_headerbatch "${TESTS_DIR}/test_headerbatch.c"
+
+# 23. Compile mapped MemPool tests
+echo "=== Compiling mapped MemPool tests ==="
+build_optional test_mempool "${TESTS_DIR}/test_mempool.c"
 
-# 5. Generate build information
+# 24. Generate build information
 echo "=== Generating build information ==="
 BUILD_INFO="${PROJECT_DIR}/build_info.txt"
 cat > "${BUILD_INFO}" << EOF
@@ -185,7 +354,7 @@ EOF
 
 echo "Build information saved to: ${BUILD_INFO}"
 
-# 6. Validation and summary
+# 25. Validation and summary
 echo "=========================================="
 echo "=== BUILD SUCCESSFUL ==="
 echo "=========================================="
@@ -195,15 +364,84 @@ echo "  ✓ Type prefixes active (T_ prefix for types)"
 echo "  ✓ Memory pool optimization integrated"
 echo "  ✓ Enhanced BitStream operations"
 echo "  ✓ uPER encoding optimization"
+echo "  ✓ Batched UDP ingest (recvmmsg/GRO)"
+echo "  ✓ Shard-by-source parallel decoding with reorder buffer"
+echo "  ✓ CRC-32C / CCSDS CRC-16 frame trailers (SSE4.2 when available)"
+echo "  ✓ Per-thread encode/decode latency histograms (ASN1CRT_LATENCY=1)"
+echo "  ✓ Per-field decode profiler (bit budget and cycles per schema field)"
+echo "  ✓ Lazy frame handles decoding fields on first access"
+echo "  ✓ C++20 range pipelines over encoded frame buffers (src/asn1crt_ranges.hpp)"
+echo "  ✓ Bulk CSV/JSON/NDJSON export (SSSE3 hex/base64, vectored writes)"
+echo "  ✓ Flat fixed-offset frame layout with uPER transcoders (src/asn1crt_flat.h)"
+echo "  ✓ Encode-in-place output ring flushed with writev/sendmmsg and backpressure"
+echo "  ✓ Multi-schema registry with table-driven (sourceId, frameType) dispatch"
+echo "  ✓ Priority decode scheduler with a CommandAck fast lane and per-class queueing delay"
+echo "  ✓ O(1) outstanding-command tracker with per-status ack RTT histograms"
+echo "  ✓ Batch constraint validation with an invalid-row bitmap and first failing field"
+echo "  ✓ Shared-memory frame ring for local consumer processes (memfd, futex wakeups)"
+echo "  ✓ Seqlock latest-value housekeeping table per source for lock-free display reads"
+echo "  ✓ Content-addressed ScienceData block dedup for self-contained archives"
+echo "  ✓ Batch FrameHeader unpacking into columns with AVX2 gathers"
+echo "  ✓ Huge-page, prefaulted and NUMA-local MemPool arenas"
 echo ""
 echo "Executables Generated:"
 [ -f "${PROJECT_DIR}/telemetry_program" ] && echo "  ✓ ./telemetry_program (main test program)"
-[ -f "${PROJECT_DIR}/memory_benchmark" ] && echo "  ✓ ./memory_benchmark [iterations] (performance benchmark)"
+[ -f "${PROJECT_DIR}/telemetry_benchmark" ] && echo "  ✓ ./telemetry_benchmark [--json FILE] [--baseline FILE] [--corpus FILE] (benchmark suite)"
+[ -f "${PROJECT_DIR}/corpus_gen" ] && echo "  ✓ ./corpus_gen <output> [frames] [seed] [hk:sci:ack] (mixed frame corpus)"
+[ -f "${PROJECT_DIR}/test_corpus" ] && echo "  ✓ ./test_corpus (corpus generation and replay test)"
+[ -f "${PROJECT_DIR}/soak_test" ] && echo "  ✓ ./soak_test [--duration SEC] [--rate FPS] [--csv FILE] (endurance drift test)"
+[ -f "${PROJECT_DIR}/ingest_server" ] && echo "  ✓ ./ingest_server [port] [shards] [seconds] [crc] (UDP ingest)"
+[ -f "${PROJECT_DIR}/udp_frame_generator" ] && echo "  ✓ ./udp_frame_generator <host> <port> [frames] [rate] [crc] (UDP sender)"
+[ -f "${PROJECT_DIR}/test_ingest_loopback" ] && echo "  ✓ ./test_ingest_loopback (loopback ingest test)"
+[ -f "${PROJECT_DIR}/test_parallel_reorder" ] && echo "  ✓ ./test_parallel_reorder (parallel decode ordering test)"
+[ -f "${PROJECT_DIR}/test_frame_integrity" ] && echo "  ✓ ./test_frame_integrity (checksum trailer test)"
+[ -f "${PROJECT_DIR}/test_latency" ] && echo "  ✓ ./test_latency (latency histogram test)"
+[ -f "${PROJECT_DIR}/field_profile" ] && echo "  ✓ ./field_profile <corpus> [bits|cycles] [passes] (per-field decode profile)"
+[ -f "${PROJECT_DIR}/test_field_profile" ] && echo "  ✓ ./test_field_profile (field profiler test)"
+[ -f "${PROJECT_DIR}/test_lazy_frame" ] && echo "  ✓ ./test_lazy_frame (lazy frame accessor test)"
+[ -f "${PROJECT_DIR}/test_ranges" ] && echo "  ✓ ./test_ranges (C++20 frame range pipeline test)"
+[ -f "${PROJECT_DIR}/telemetry_export" ] && echo "  ✓ ./telemetry_export <corpus> <output|-> [csv|json|ndjson] [hex|base64] (bulk export)"
+[ -f "${PROJECT_DIR}/test_export" ] && echo "  ✓ ./test_export (exporter formatting test)"
+[ -f "${PROJECT_DIR}/test_flat" ] && echo "  ✓ ./test_flat (flat layout and transcoder test)"
+[ -f "${PROJECT_DIR}/test_outring" ] && echo "  ✓ ./test_outring (output ring file, loopback and backpressure test)"
+[ -f "${PROJECT_DIR}/test_registry" ] && echo "  ✓ ./test_registry (schema registry routing and per-schema stats test)"
+[ -f "${PROJECT_DIR}/test_sched" ] && echo "  ✓ ./test_sched (ack fast lane under a science dump)"
+[ -f "${PROJECT_DIR}/test_cmdtrack" ] && echo "  ✓ ./test_cmdtrack (command matching, timeouts and throughput)"
+[ -f "${PROJECT_DIR}/test_validate" ] && echo "  ✓ ./test_validate (batch validation against IsConstraintValid)"
+[ -f "${PROJECT_DIR}/test_shmring" ] && echo "  ✓ ./test_shmring (multi-process producers and consumers)"
+[ -f "${PROJECT_DIR}/test_statetable" ] && echo "  ✓ ./test_statetable (seqlock snapshots under concurrent readers)"
+[ -f "${PROJECT_DIR}/test_dedup" ] && echo "  ✓ ./test_dedup (block store, hash and archive round-trip)"
+[ -f "${PROJECT_DIR}/test_headerbatch" ] && echo "  ✓ ./test_headerbatch (batch header unpack against T_FrameHeader_Decode)"
+[ -f "${PROJECT_DIR}/test_mempool" ] && echo "  ✓ ./test_mempool (arena backings: startup, first frame, decode)"
 echo ""
 echo "Usage Instructions:"
 echo "  Run comprehensive tests:     ./telemetry_program"
-[ -f "${PROJECT_DIR}/memory_benchmark" ] && echo "  Run performance benchmark:   ./memory_benchmark 1000"
-[ -f "${PROJECT_DIR}/memory_benchmark" ] && echo "  Run stability test:          ./memory_benchmark 1000 30"
+[ -f "${PROJECT_DIR}/telemetry_benchmark" ] && echo "  Run benchmark suite:         ./telemetry_benchmark --json bench.json"
+[ -f "${PROJECT_DIR}/telemetry_benchmark" ] && echo "  Compare against baseline:    ./telemetry_benchmark --baseline bench.json"
+[ -f "${PROJECT_DIR}/corpus_gen" ] && echo "  Replay a mixed corpus:       ./corpus_gen corpus.bin 1000000 && ./telemetry_benchmark --corpus corpus.bin"
+[ -f "${PROJECT_DIR}/test_corpus" ] && echo "  Run corpus test:             ./test_corpus"
+[ -f "${PROJECT_DIR}/soak_test" ] && echo "  Run a one-hour soak:         ./soak_test --duration 3600 --interval 60 --csv soak.csv"
+[ -f "${PROJECT_DIR}/test_ingest_loopback" ] && echo "  Run ingest loopback test:    ./test_ingest_loopback"
+[ -f "${PROJECT_DIR}/test_parallel_reorder" ] && echo "  Run parallel decode test:    ./test_parallel_reorder"
+[ -f "${PROJECT_DIR}/test_frame_integrity" ] && echo "  Run frame integrity test:    ./test_frame_integrity"
+[ -f "${PROJECT_DIR}/test_latency" ] && echo "  Run latency histogram test:  ./test_latency"
+[ -f "${PROJECT_DIR}/field_profile" ] && echo "  Profile fields of a corpus:  ./field_profile corpus.bin cycles"
+[ -f "${PROJECT_DIR}/test_field_profile" ] && echo "  Run field profiler test:     ./test_field_profile"
+[ -f "${PROJECT_DIR}/test_lazy_frame" ] && echo "  Run lazy frame test:         ./test_lazy_frame"
+[ -f "${PROJECT_DIR}/test_ranges" ] && echo "  Run C++ range pipeline test: ./test_ranges"
+[ -f "${PROJECT_DIR}/telemetry_export" ] && echo "  Export a corpus to NDJSON:   ./telemetry_export corpus.bin day.ndjson ndjson base64"
+[ -f "${PROJECT_DIR}/test_export" ] && echo "  Run exporter test:           ./test_export"
+[ -f "${PROJECT_DIR}/test_flat" ] && echo "  Run flat encoding test:      ./test_flat"
+[ -f "${PROJECT_DIR}/test_outring" ] && echo "  Run output ring test:        ./test_outring"
+[ -f "${PROJECT_DIR}/test_registry" ] && echo "  Run schema registry test:    ./test_registry"
+[ -f "${PROJECT_DIR}/test_sched" ] && echo "  Run priority scheduler test: ./test_sched"
+[ -f "${PROJECT_DIR}/test_cmdtrack" ] && echo "  Run command tracker test:    ./test_cmdtrack"
+[ -f "${PROJECT_DIR}/test_validate" ] && echo "  Run batch validation test:   ./test_validate"
+[ -f "${PROJECT_DIR}/test_shmring" ] && echo "  Run shared-memory ring test: ./test_shmring"
+[ -f "${PROJECT_DIR}/test_statetable" ] && echo "  Run state table test:        ./test_statetable"
+[ -f "${PROJECT_DIR}/test_dedup" ] && echo "  Run block dedup test:        ./test_dedup"
+[ -f "${PROJECT_DIR}/test_headerbatch" ] && echo "  Run header batch test:       ./test_headerbatch"
+[ -f "${PROJECT_DIR}/test_mempool" ] && echo "  Run mapped MemPool test:     ./test_mempool"
 echo ""
 echo "For thesis validation, run both programs and document results."
-echo "Expected: Error-free encoding/decoding with performance > 70M ops/sec"
+echo "Expected: Error-free encoding/decoding; measure performance with ./telemetry_benchmark"
@@ -25,27 +25,28 @@ gcc -Wall -I"${GENERATED_DIR}" -I"${SRC_DIR}" \
 
 echo "Main program compilation successful!"
 
-# Now compile the memory benchmark if file exists
-if [ -f "${TESTS_DIR}/memory_benchmark.c" ]; then
-    echo "Compiling memory benchmark..."
-    gcc -Wall -I"${GENERATED_DIR}" -I"${SRC_DIR}" \
+# Now compile the benchmark suite if file exists
+if [ -f "${TESTS_DIR}/telemetry_benchmark.c" ]; then
+    echo "Compiling benchmark suite..."
+    gcc -Wall -I"${GENERATED_DIR}" -I"${SRC_DIR}" -I"${TESTS_DIR}" \
        "${GENERATED_DIR}/asn1crt.c" \
        "${GENERATED_DIR}/asn1crt_encoding.c" \
        "${GENERATED_DIR}/asn1crt_encoding_uper.c" \
        "${GENERATED_DIR}/satellite.c" \
        "${GENERATED_DIR}/asn1crt_mempool.c" \
-       "${GENERATED_DIR}/asn1crt_stream.c" \
-       "${TESTS_DIR}/memory_benchmark.c" \
-       -o "${PROJECT_DIR}/memory_benchmark" -lm
+       "${GENERATED_DIR}/asn1crt_partial.c" \
+       "${TESTS_DIR}/bench_harness.c" \
+       "${TESTS_DIR}/telemetry_benchmark.c" \
+       -o "${PROJECT_DIR}/telemetry_benchmark" -lm
     
-    echo "Memory benchmark compilation successful!"
+    echo "Benchmark suite compilation successful!"
 else
-    echo "Skipping memory benchmark - file not found: ${TESTS_DIR}/memory_benchmark.c"
+    echo "Skipping benchmark suite - file not found: ${TESTS_DIR}/telemetry_benchmark.c"
 fi
 
 echo "=== BUILD SUCCESSFUL ==="
 echo "Run main program with: ./telemetry_program"
 
-if [ -f "${PROJECT_DIR}/memory_benchmark" ]; then
-    echo "Run memory benchmark with: ./memory_benchmark [iterations]"
+if [ -f "${PROJECT_DIR}/telemetry_benchmark" ]; then
+    echo "Run benchmark suite with: ./telemetry_benchmark [--json FILE] [--baseline FILE]"
 fi
@@ -0,0 +1,163 @@
+/* asn1crt_cmdtrack.c - O(1) outstanding-command tracker implementation */
+#include "asn1crt_cmdtrack.h"
+#include "asn1crt_internal.h"
+#include <string.h>
+
+size_t CommandTracker_PoolBytes(void) {
+    return Asn1crt_Round8(sizeof(CmdTrackEntry) * CMDTRACK_IDS) +
+           Asn1crt_Round8(sizeof(CmdTrackDeadline) * CMDTRACK_IDS);
+}
+
+flag CommandTracker_Init(CommandTracker* t, MemPool* pool, unsigned long long timeoutNs,
+                         CmdTrackAlertFn alert, void* userData, int* pErrCode) {
+    memset(t, 0, sizeof(CommandTracker));
+    t->entries = (CmdTrackEntry*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(CmdTrackEntry) * CMDTRACK_IDS));
+    t->deadlines = (CmdTrackDeadline*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(CmdTrackDeadline) * CMDTRACK_IDS));
+    if (t->entries == NULL || t->deadlines == NULL) {
+        return Asn1crt_Fail(pErrCode, ERR_CMDTRACK_POOL);
+    }
+    memset(t->entries, 0, sizeof(CmdTrackEntry) * CMDTRACK_IDS);
+    t->timeoutNs = timeoutNs;
+    t->alert = alert;
+    t->userData = userData;
+    pthread_mutex_init(&t->lock, NULL);
+    return TRUE;
+}
+
+void CommandTracker_Destroy(CommandTracker* t) {
+    pthread_mutex_destroy(&t->lock);
+}
+
+/* Pop the oldest deadline; if its send is still the live one it ends with
+ * outcome (CMDTRACK_TIMEOUT, or CMDTRACK_EVICTED when retired early) */
+static int CmdTrack_Expire(CommandTracker* t, unsigned long long nowNs, int outcome) {
+    const CmdTrackDeadline* d = &t->deadlines[t->head];
+    CmdTrackEntry* e = &t->entries[d->commandId];
+    int expired = 0;
+
+    if (e->pending && e->generation == d->generation) {
+        e->pending = FALSE;
+        t->outstanding--;
+        if (outcome == CMDTRACK_EVICTED) {
+            t->stats.evicted++;
+        } else {
+            t->stats.timedOut++;
+        }
+        expired = 1;
+        if (t->alert != NULL) {
+            t->alert(d->commandId, outcome, nowNs > e->sentNs ? nowNs - e->sentNs : 0, t->userData);
+        }
+    }
+    t->head = (t->head + 1) & (CMDTRACK_IDS - 1);
+    t->count--;
+    return expired;
+}
+
+static int CmdTrack_SweepLocked(CommandTracker* t, unsigned long long nowNs) {
+    int expired = 0;
+
+    while (t->count > 0 && t->deadlines[t->head].deadlineNs <= nowNs) {
+        expired += CmdTrack_Expire(t, nowNs, CMDTRACK_TIMEOUT);
+    }
+    return expired;
+}
+
+void CommandTracker_Sent(CommandTracker* t, unsigned int commandId, unsigned long long nowNs) {
+    CmdTrackEntry* e = &t->entries[commandId & (CMDTRACK_IDS - 1)];
+    CmdTrackDeadline* d;
+
+    pthread_mutex_lock(&t->lock);
+    /* Stale records of acked or reissued ids share the ring with live ones;
+     * once it is full the oldest is retired early, live or not */
+    if (t->count == CMDTRACK_IDS) {
+        CmdTrack_SweepLocked(t, nowNs);
+        if (t->count == CMDTRACK_IDS) {
+            CmdTrack_Expire(t, nowNs, CMDTRACK_EVICTED);
+        }
+    }
+
+    if (e->pending) {
+        t->stats.reissued++;
+    } else {
+        t->outstanding++;
+    }
+    e->generation++;
+    e->pending = TRUE;
+    e->sentNs = nowNs;
+    t->stats.sent++;
+
+    d = &t->deadlines[(t->head + t->count) & (CMDTRACK_IDS - 1)];
+    d->deadlineNs = nowNs + t->timeoutNs;
+    d->generation = e->generation;
+    d->commandId = commandId & (CMDTRACK_IDS - 1);
+    t->count++;
+    pthread_mutex_unlock(&t->lock);
+}
+
+flag CommandTracker_Ack(CommandTracker* t, const T_CommandAck* ack, unsigned long long nowNs,
+                        unsigned long long* rttNs, int* pErrCode) {
+    unsigned int commandId = (unsigned int)ack->commandId & (CMDTRACK_IDS - 1);
+    int status = (int)ack->status & LAYOUT_ACK_STATUS_MAX;
+    CmdTrackEntry* e = &t->entries[commandId];
+    unsigned long long rtt;
+
+    pthread_mutex_lock(&t->lock);
+    if (!e->pending) {
+        t->stats.unmatched++;
+        pthread_mutex_unlock(&t->lock);
+        return Asn1crt_Fail(pErrCode, ERR_CMDTRACK_UNMATCHED);
+    }
+
+    /* The deadline record stays in the FIFO; the cleared flag makes it stale */
+    rtt = nowNs > e->sentNs ? nowNs - e->sentNs : 0;
+    e->pending = FALSE;
+    t->outstanding--;
+    t->stats.acked[status]++;
+    LatencyHistogram_Add(&t->stats.rttNs[status], rtt);
+    if (t->alert != NULL && (status == CMDTRACK_EXECUTION_FAILED || status == CMDTRACK_INSUFFICIENT_PRIVILEGES)) {
+        t->alert(commandId, status, rtt, t->userData);
+    }
+    pthread_mutex_unlock(&t->lock);
+
+    if (rttNs != NULL) {
+        *rttNs = rtt;
+    }
+    return TRUE;
+}
+
+int CommandTracker_Sweep(CommandTracker* t, unsigned long long nowNs) {
+    int expired;
+
+    pthread_mutex_lock(&t->lock);
+    expired = CmdTrack_SweepLocked(t, nowNs);
+    pthread_mutex_unlock(&t->lock);
+    return expired;
+}
+
+unsigned int CommandTracker_Outstanding(CommandTracker* t) {
+    unsigned int outstanding;
+
+    pthread_mutex_lock(&t->lock);
+    outstanding = t->outstanding;
+    pthread_mutex_unlock(&t->lock);
+    return outstanding;
+}
+
+void CommandTracker_Snapshot(CommandTracker* t, CmdTrackStats* stats) {
+    pthread_mutex_lock(&t->lock);
+    *stats = t->stats;
+    pthread_mutex_unlock(&t->lock);
+}
+
+unsigned long long CommandTracker_Now(void) {
+    return Asn1crt_NowNs();
+}
+
+void CommandTracker_Emit(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData) {
+    int errCode;
+
+    if (frame->payload.kind == commandAck_PRESENT) {
+        CommandTracker_Ack((CommandTracker*)userData, &frame->payload.u.commandAck, CommandTracker_Now(), NULL,
+                           &errCode);
+    }
+}
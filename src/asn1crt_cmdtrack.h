@@ -0,0 +1,106 @@
+/* asn1crt_cmdtrack.h - O(1) outstanding-command tracker matched by CommandAck.commandId */
+#ifndef ASN1CRT_CMDTRACK_H
+#define ASN1CRT_CMDTRACK_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include "asn1crt.h"
+#include "asn1crt_latency.h"
+#include "asn1crt_layout.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* CommandTracker_Init and CommandTracker_Ack results */
+#define ERR_CMDTRACK_POOL       1090  /* Pool smaller than CommandTracker_PoolBytes */
+#define ERR_CMDTRACK_UNMATCHED  1091  /* Ack for a command not outstanding (late, duplicate or unknown) */
+
+/* One slot per commandId */
+#define CMDTRACK_IDS (1 << LAYOUT_COMMAND_ID_BITS)
+
+/* CommandAck.status values 0..3, plus the tracker's own outcomes: a
+ * deadline that passed, and a live command retired before its deadline
+ * because the deadline ring was full */
+#define CMDTRACK_STATUSES   (LAYOUT_ACK_STATUS_MAX + 1)
+#define CMDTRACK_TIMEOUT    CMDTRACK_STATUSES
+#define CMDTRACK_EVICTED    (CMDTRACK_STATUSES + 1)
+
+/* Statuses raised through CmdTrackAlertFn, in ENUMERATED order */
+#define CMDTRACK_EXECUTION_FAILED          2
+#define CMDTRACK_INSUFFICIENT_PRIVILEGES   3
+
+/* Direct-mapped state of one commandId. generation advances on every send,
+ * so a timeout record left behind by an earlier send never matches. */
+typedef struct {
+    unsigned long long sentNs;
+    unsigned int generation;
+    flag pending;
+} CmdTrackEntry;
+
+/* Timeout FIFO record; deadlines are in send order since the timeout is fixed */
+typedef struct {
+    unsigned long long deadlineNs;
+    unsigned int generation;
+    unsigned int commandId;
+} CmdTrackDeadline;
+
+typedef struct {
+    unsigned long sent;
+    unsigned long reissued;                      /* Sent while the same id was still outstanding */
+    unsigned long acked[CMDTRACK_STATUSES];      /* Matched acks per status */
+    unsigned long unmatched;
+    unsigned long timedOut;
+    unsigned long evicted;                       /* Still live when the full deadline ring retired them */
+    LatencyHistogram rttNs[CMDTRACK_STATUSES];   /* Send to ack, per status */
+} CmdTrackStats;
+
+/* Failed statuses (executionFailed, insufficientPrivileges), timeouts and
+ * evictions; elapsedNs is the time since the send. Called with the
+ * tracker locked: it must not call back into the tracker. */
+typedef void (*CmdTrackAlertFn)(unsigned int commandId, int outcome, unsigned long long elapsedNs, void* userData);
+
+typedef struct {
+    pthread_mutex_t lock;        /* Console sends while decode workers ack */
+    CmdTrackEntry* entries;      /* CMDTRACK_IDS */
+    CmdTrackDeadline* deadlines; /* CMDTRACK_IDS, ring */
+    unsigned int head;           /* Next record to expire */
+    unsigned int count;
+    unsigned int outstanding;
+    unsigned long long timeoutNs;
+    CmdTrackAlertFn alert;
+    void* userData;
+    CmdTrackStats stats;
+} CommandTracker;
+
+/* Pool bytes CommandTracker_Init carves */
+size_t CommandTracker_PoolBytes(void);
+
+/* Empty tracker; commands not acked within timeoutNs are reported by Sweep */
+flag CommandTracker_Init(CommandTracker* t, MemPool* pool, unsigned long long timeoutNs,
+                         CmdTrackAlertFn alert, void* userData, int* pErrCode);
+
+void CommandTracker_Destroy(CommandTracker* t);
+
+/* Record a command sent at nowNs */
+void CommandTracker_Sent(CommandTracker* t, unsigned int commandId, unsigned long long nowNs);
+
+/* Match an ack received at nowNs; rttNs may be NULL */
+flag CommandTracker_Ack(CommandTracker* t, const T_CommandAck* ack, unsigned long long nowNs,
+                        unsigned long long* rttNs, int* pErrCode);
+
+/* Report commands whose deadline has passed; returns how many timed out */
+int CommandTracker_Sweep(CommandTracker* t, unsigned long long nowNs);
+
+/* Commands sent and neither acked nor timed out */
+unsigned int CommandTracker_Outstanding(CommandTracker* t);
+
+/* Copy the counters and histograms */
+void CommandTracker_Snapshot(CommandTracker* t, CmdTrackStats* stats);
+
+/* CLOCK_MONOTONIC in ns, the clock CommandTracker_Emit uses */
+unsigned long long CommandTracker_Now(void);
+
+/* ParallelEmitFn / SchedEmitFn that feeds decoded acks to the tracker in
+ * userData; other payloads are ignored */
+void CommandTracker_Emit(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData);
+
+#endif /* ASN1CRT_CMDTRACK_H */
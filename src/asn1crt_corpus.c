@@ -0,0 +1,358 @@
+/* asn1crt_corpus.c - Seeded telemetry frame corpora */
+#include "asn1crt_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+void CorpusMix_Default(CorpusMix* mix) {
+    memset(mix, 0, sizeof(CorpusMix));
+    mix->seed = 1;
+    mix->housekeepingWeight = 60;
+    mix->scienceWeight = 30;
+    mix->commandAckWeight = 10;
+    mix->minTemperatures = 1;
+    mix->maxTemperatures = 8;
+    mix->minBlocks = 1;
+    mix->maxBlocks = 4;
+    mix->minBlockBytes = 1;
+    mix->maxBlockBytes = 256;
+    mix->sources = 8;
+}
+
+flag CorpusMix_ParseWeights(CorpusMix* mix, const char* text) {
+    int hk, sci, ack;
+
+    if (sscanf(text, "%d:%d:%d", &hk, &sci, &ack) != 3 ||
+        hk < 0 || sci < 0 || ack < 0 || hk + sci + ack == 0) {
+        return FALSE;
+    }
+    mix->housekeepingWeight = hk;
+    mix->scienceWeight = sci;
+    mix->commandAckWeight = ack;
+    return TRUE;
+}
+
+static flag Corpus_RangeValid(int lo, int hi, int min, int max) {
+    return lo >= min && hi <= max && lo <= hi;
+}
+
+static flag CorpusMix_Valid(const CorpusMix* mix) {
+    return mix->housekeepingWeight >= 0 && mix->scienceWeight >= 0 && mix->commandAckWeight >= 0 &&
+           mix->housekeepingWeight + mix->scienceWeight + mix->commandAckWeight > 0 &&
+           Corpus_RangeValid(mix->minTemperatures, mix->maxTemperatures, 1, 8) &&
+           Corpus_RangeValid(mix->minBlocks, mix->maxBlocks, 1, 4) &&
+           Corpus_RangeValid(mix->minBlockBytes, mix->maxBlockBytes, 1, 256) &&
+           mix->sources >= 1 && mix->sources <= 256;
+}
+
+static unsigned long long Corpus_Random(CorpusGenerator* gen) {
+    unsigned long long x = gen->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    gen->state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* Uniform in [lo, hi] */
+static int Corpus_Between(CorpusGenerator* gen, int lo, int hi) {
+    return lo + (int)((Corpus_Random(gen) >> 33) % (unsigned long long)(hi - lo + 1));
+}
+
+static int Corpus_Clamp(int value, int lo, int hi) {
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+flag CorpusGenerator_Init(CorpusGenerator* gen, const CorpusMix* mix, unsigned int* frameCounts) {
+    if (!CorpusMix_Valid(mix)) {
+        return FALSE;
+    }
+    memset(gen, 0, sizeof(CorpusGenerator));
+    /* splitmix64 step so small seeds still give a well-mixed non-zero state */
+    gen->state = mix->seed + 0x9E3779B97F4A7C15ULL;
+    gen->state = (gen->state ^ (gen->state >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    gen->state = (gen->state ^ (gen->state >> 27)) * 0x94D049BB133111EBULL;
+    gen->state ^= gen->state >> 31;
+    if (gen->state == 0) {
+        gen->state = 1;
+    }
+
+    gen->frameCounts = frameCounts;
+    for (int s = 0; s < mix->sources; s++) {
+        frameCounts[s] = (unsigned int)Corpus_Between(gen, 0, 65535);
+    }
+    gen->seconds = 1700000000u + (unsigned int)Corpus_Between(gen, 0, 86400);
+    for (int i = 0; i < 8; i++) {
+        gen->temperatures[i] = Corpus_Between(gen, -40, 60);
+    }
+    return TRUE;
+}
+
+static void Corpus_Housekeeping(CorpusGenerator* gen, const CorpusMix* mix, T_TelemetryFrame* frame) {
+    int count = Corpus_Between(gen, mix->minTemperatures, mix->maxTemperatures);
+
+    frame->payload.kind = housekeeping_PRESENT;
+    frame->payload.u.housekeeping.voltages.mainBus = Corpus_Clamp(3300 + Corpus_Between(gen, -150, 150), 0, 5000);
+    frame->payload.u.housekeeping.voltages.payload = Corpus_Clamp(5000 - Corpus_Between(gen, 0, 300), 0, 5000);
+    frame->payload.u.housekeeping.voltages.comms = Corpus_Clamp(1800 + Corpus_Between(gen, -100, 100), 0, 5000);
+
+    /* Sensors drift a little between frames rather than jumping around */
+    frame->payload.u.housekeeping.temperature.nCount = count;
+    for (int i = 0; i < count; i++) {
+        gen->temperatures[i] = Corpus_Clamp(gen->temperatures[i] + Corpus_Between(gen, -2, 2), -100, 100);
+        frame->payload.u.housekeeping.temperature.arr[i] = gen->temperatures[i];
+    }
+    frame->payload.u.housekeeping.status = Corpus_Between(gen, 0, 15) == 0 ? Corpus_Between(gen, 1, 255) : 0;
+}
+
+static void Corpus_Science(CorpusGenerator* gen, const CorpusMix* mix, T_TelemetryFrame* frame) {
+    int blocks = Corpus_Between(gen, mix->minBlocks, mix->maxBlocks);
+
+    frame->payload.kind = science_PRESENT;
+    frame->payload.u.science.instrumentId = Corpus_Between(gen, 0, 15);
+    frame->payload.u.science.dataBlocks.nCount = blocks;
+    for (int b = 0; b < blocks; b++) {
+        int length = Corpus_Between(gen, mix->minBlockBytes, mix->maxBlockBytes);
+        byte* data = frame->payload.u.science.dataBlocks.arr[b].arr;
+
+        frame->payload.u.science.dataBlocks.arr[b].nCount = length;
+        for (int i = 0; i < length; i += 8) {
+            unsigned long long r = Corpus_Random(gen);
+            for (int k = 0; k < 8 && i + k < length; k++) {
+                data[i + k] = (byte)(r >> (8 * k));
+            }
+        }
+    }
+}
+
+static void Corpus_CommandAck(CorpusGenerator* gen, T_TelemetryFrame* frame) {
+    int roll = Corpus_Between(gen, 0, 99);
+
+    frame->payload.kind = commandAck_PRESENT;
+    frame->payload.u.commandAck.commandId = Corpus_Between(gen, 0, 65535);
+    /* Mostly successes, with a tail of each failure */
+    frame->payload.u.commandAck.status = (T_CommandAck_status)(roll < 85 ? 0 : roll < 92 ? 1 : roll < 97 ? 2 : 3);
+}
+
+void CorpusGenerator_Next(CorpusGenerator* gen, const CorpusMix* mix, T_TelemetryFrame* frame) {
+    int total = mix->housekeepingWeight + mix->scienceWeight + mix->commandAckWeight;
+    int pick = Corpus_Between(gen, 0, total - 1);
+    int source = Corpus_Between(gen, 0, mix->sources - 1);
+
+    T_TelemetryFrame_Initialize(frame);
+
+    gen->subseconds += Corpus_Between(gen, 1, 40);
+    if (gen->subseconds > 999) {
+        gen->subseconds -= 1000;
+        gen->seconds++;
+    }
+    frame->header.timestamp.seconds = gen->seconds;
+    frame->header.timestamp.subseconds = gen->subseconds;
+    frame->header.frameType = source;
+    frame->header.frameCount = gen->frameCounts[source];
+    gen->frameCounts[source] = (gen->frameCounts[source] + 1) & 0xFFFF;
+
+    if (pick < mix->housekeepingWeight) {
+        Corpus_Housekeeping(gen, mix, frame);
+    } else if (pick < mix->housekeepingWeight + mix->scienceWeight) {
+        Corpus_Science(gen, mix, frame);
+    } else {
+        Corpus_CommandAck(gen, frame);
+    }
+}
+
+static void Corpus_Put32(byte* p, unsigned int v) {
+    for (int i = 0; i < 4; i++) p[i] = (byte)(v >> (8 * i));
+}
+
+static void Corpus_Put64(byte* p, unsigned long long v) {
+    for (int i = 0; i < 8; i++) p[i] = (byte)(v >> (8 * i));
+}
+
+static unsigned long long Corpus_Get(const byte* p, int bytes) {
+    unsigned long long v = 0;
+    for (int i = bytes - 1; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static flag Corpus_WriteFail(FILE* out, CorpusEntry* index, int* pErrCode, int errCode) {
+    if (out != NULL) fclose(out);
+    free(index);
+    *pErrCode = errCode;
+    return FALSE;
+}
+
+flag Corpus_Write(const char* path, const CorpusMix* mix, unsigned int count, int* pErrCode) {
+    T_TelemetryFrame frame;
+    byte buffer[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    unsigned int frameCounts[256];
+    byte header[CORPUS_HEADER_SIZE];
+    CorpusGenerator gen;
+    CorpusEntry* index;
+    unsigned long long offset = CORPUS_HEADER_SIZE;
+    FILE* out;
+
+    if (!CorpusGenerator_Init(&gen, mix, frameCounts)) {
+        *pErrCode = ERR_CORPUS_MIX;
+        return FALSE;
+    }
+    index = (CorpusEntry*)malloc(sizeof(CorpusEntry) * (count > 0 ? count : 1));
+    if (index == NULL) {
+        return Corpus_WriteFail(NULL, NULL, pErrCode, ERR_CORPUS_IO);
+    }
+    out = fopen(path, "wb");
+    if (out == NULL) {
+        return Corpus_WriteFail(NULL, index, pErrCode, ERR_CORPUS_IO);
+    }
+
+    /* Header is rewritten with the index offset once the data is out */
+    memset(header, 0, sizeof(header));
+    if (fwrite(header, 1, sizeof(header), out) != sizeof(header)) {
+        return Corpus_WriteFail(out, index, pErrCode, ERR_CORPUS_IO);
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        BitStream bs;
+        int length;
+
+        CorpusGenerator_Next(&gen, mix, &frame);
+        BitStream_Init(&bs, buffer, sizeof(buffer));
+        if (!T_TelemetryFrame_Encode(&frame, &bs, pErrCode, TRUE)) {
+            fclose(out);
+            free(index);
+            return FALSE;
+        }
+        length = (int)BitStream_GetLength(&bs);
+        if (offset + (unsigned long long)length > 0xFFFFFFFFULL ||
+            fwrite(buffer, 1, (size_t)length, out) != (size_t)length) {
+            return Corpus_WriteFail(out, index, pErrCode, ERR_CORPUS_IO);
+        }
+        index[i].offset = (unsigned int)offset;
+        index[i].length = (unsigned short)length;
+        index[i].kind = (byte)frame.payload.kind;
+        index[i].reserved = 0;
+        offset += (unsigned long long)length;
+    }
+
+    /* Align the index so it can be read in place from the mapping */
+    while (offset % CORPUS_ENTRY_SIZE != 0) {
+        fputc(0, out);
+        offset++;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        byte entry[CORPUS_ENTRY_SIZE];
+        Corpus_Put32(entry, index[i].offset);
+        entry[4] = (byte)index[i].length;
+        entry[5] = (byte)(index[i].length >> 8);
+        entry[6] = index[i].kind;
+        entry[7] = 0;
+        if (fwrite(entry, 1, sizeof(entry), out) != sizeof(entry)) {
+            return Corpus_WriteFail(out, index, pErrCode, ERR_CORPUS_IO);
+        }
+    }
+
+    memcpy(header, CORPUS_MAGIC, 8);
+    Corpus_Put32(header + 8, CORPUS_VERSION);
+    Corpus_Put32(header + 12, count);
+    Corpus_Put64(header + 16, mix->seed);
+    Corpus_Put64(header + 24, offset);
+    if (fseek(out, 0, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), out) != sizeof(header)) {
+        return Corpus_WriteFail(out, index, pErrCode, ERR_CORPUS_IO);
+    }
+    free(index);
+    if (fclose(out) != 0) {
+        *pErrCode = ERR_CORPUS_IO;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+flag Corpus_Open(Corpus* corpus, const char* path, int* pErrCode) {
+    struct stat st;
+    unsigned long long indexOffset;
+    CorpusEntry* index;
+    void* base;
+    int fd;
+
+    memset(corpus, 0, sizeof(Corpus));
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        *pErrCode = ERR_CORPUS_IO;
+        return FALSE;
+    }
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        *pErrCode = ERR_CORPUS_IO;
+        return FALSE;
+    }
+    if (st.st_size < CORPUS_HEADER_SIZE) {
+        close(fd);
+        *pErrCode = ERR_CORPUS_FORMAT;
+        return FALSE;
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        *pErrCode = ERR_CORPUS_IO;
+        return FALSE;
+    }
+
+    corpus->base = (const byte*)base;
+    corpus->size = (size_t)st.st_size;
+    corpus->count = (unsigned int)Corpus_Get(corpus->base + 12, 4);
+    corpus->seed = Corpus_Get(corpus->base + 16, 8);
+    indexOffset = Corpus_Get(corpus->base + 24, 8);
+
+    /* Bounds in an order that cannot wrap: a crafted offset near 2^64 would
+     * otherwise pass the sum check and point the index outside the map */
+    if (memcmp(corpus->base, CORPUS_MAGIC, 8) != 0 ||
+        Corpus_Get(corpus->base + 8, 4) != CORPUS_VERSION ||
+        indexOffset % CORPUS_ENTRY_SIZE != 0 ||
+        indexOffset < CORPUS_HEADER_SIZE || indexOffset > corpus->size ||
+        corpus->count > (corpus->size - indexOffset) / CORPUS_ENTRY_SIZE ||
+        indexOffset + (unsigned long long)corpus->count * CORPUS_ENTRY_SIZE != corpus->size) {
+        Corpus_Close(corpus);
+        *pErrCode = ERR_CORPUS_FORMAT;
+        return FALSE;
+    }
+
+    /* Entries are little-endian on disk: decode them once into host order
+     * rather than overlay CorpusEntry on the mapping */
+    index = (CorpusEntry*)malloc(sizeof(CorpusEntry) * (corpus->count > 0 ? corpus->count : 1));
+    if (index == NULL) {
+        Corpus_Close(corpus);
+        *pErrCode = ERR_CORPUS_IO;
+        return FALSE;
+    }
+    corpus->index = index;
+    for (unsigned int i = 0; i < corpus->count; i++) {
+        const byte* entry = corpus->base + indexOffset + (unsigned long long)i * CORPUS_ENTRY_SIZE;
+        index[i].offset = (unsigned int)Corpus_Get(entry, 4);
+        index[i].length = (unsigned short)Corpus_Get(entry + 4, 2);
+        index[i].kind = entry[6];
+        index[i].reserved = 0;
+        if ((unsigned long long)index[i].offset + index[i].length > indexOffset) {
+            Corpus_Close(corpus);
+            *pErrCode = ERR_CORPUS_FORMAT;
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+const byte* Corpus_Frame(const Corpus* corpus, unsigned int i, int* length) {
+    *length = corpus->index[i].length;
+    return corpus->base + corpus->index[i].offset;
+}
+
+void Corpus_Close(Corpus* corpus) {
+    if (corpus->base != NULL) {
+        munmap((void*)corpus->base, corpus->size);
+    }
+    free((void*)corpus->index);
+    memset(corpus, 0, sizeof(Corpus));
+}
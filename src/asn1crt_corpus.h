@@ -0,0 +1,88 @@
+/* asn1crt_corpus.h - Seeded telemetry frame corpora for tests and benchmarks */
+#ifndef ASN1CRT_CORPUS_H
+#define ASN1CRT_CORPUS_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* File layout (little-endian):
+ *   header  CORPUS_HEADER_SIZE bytes: magic, version, count, seed, index offset
+ *   data    encoded frames back to back
+ *   index   count CORPUS_ENTRY_SIZE records: u32 offset, u16 length, u8 kind, u8 0 */
+#define CORPUS_MAGIC "TLMCORP1"
+#define CORPUS_VERSION 1
+#define CORPUS_HEADER_SIZE 32
+#define CORPUS_ENTRY_SIZE 8
+
+/* Corpus file I/O, layout and generator mix failures */
+#define ERR_CORPUS_IO      1020  /* open/read/write/mmap failed */
+#define ERR_CORPUS_FORMAT  1021  /* Bad magic, version or index */
+#define ERR_CORPUS_MIX     1022  /* Mix weights or ranges out of schema bounds */
+
+/* Payload mix and size ranges (inclusive, clamped to the schema) */
+typedef struct {
+    unsigned long long seed;
+    int housekeepingWeight;   /* Relative share of each CHOICE alternative */
+    int scienceWeight;
+    int commandAckWeight;
+    int minTemperatures;      /* 1..8 */
+    int maxTemperatures;
+    int minBlocks;            /* 1..4 */
+    int maxBlocks;
+    int minBlockBytes;        /* 1..256 */
+    int maxBlockBytes;
+    int sources;              /* Distinct frameType values, each with its own frameCount */
+} CorpusMix;
+
+/* Deterministic generator state (xorshift64*) */
+typedef struct {
+    unsigned long long state;
+    unsigned int* frameCounts;  /* Next frameCount per source */
+    unsigned int seconds;       /* Current timestamp */
+    int subseconds;
+    int temperatures[8];        /* Slowly drifting sensor values */
+} CorpusGenerator;
+
+/* One index record */
+typedef struct {
+    unsigned int offset;      /* Byte offset of the frame in the file */
+    unsigned short length;    /* Encoded length in bytes */
+    byte kind;                /* payload.kind of the frame */
+    byte reserved;
+} CorpusEntry;
+
+/* A corpus file mapped read-only */
+typedef struct {
+    const byte* base;         /* Whole file */
+    size_t size;
+    const CorpusEntry* index; /* count entries, decoded to host order */
+    unsigned int count;
+    unsigned long long seed;
+} Corpus;
+
+/* 60% housekeeping, 30% science, 10% command acks over the full schema ranges */
+void CorpusMix_Default(CorpusMix* mix);
+
+/* Parse "hk:sci:ack" weights into mix; FALSE on malformed text */
+flag CorpusMix_ParseWeights(CorpusMix* mix, const char* text);
+
+/* Seed a generator; frameCounts must hold mix->sources entries */
+flag CorpusGenerator_Init(CorpusGenerator* gen, const CorpusMix* mix, unsigned int* frameCounts);
+
+/* Fill frame with the next value of the stream */
+void CorpusGenerator_Next(CorpusGenerator* gen, const CorpusMix* mix, T_TelemetryFrame* frame);
+
+/* Generate count frames into a corpus file */
+flag Corpus_Write(const char* path, const CorpusMix* mix, unsigned int count, int* pErrCode);
+
+/* Map a corpus file and validate its index */
+flag Corpus_Open(Corpus* corpus, const char* path, int* pErrCode);
+
+/* Encoded bytes of frame i */
+const byte* Corpus_Frame(const Corpus* corpus, unsigned int i, int* length);
+
+/* Unmap the file */
+void Corpus_Close(Corpus* corpus);
+
+#endif /* ASN1CRT_CORPUS_H */
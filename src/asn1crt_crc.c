@@ -0,0 +1,166 @@
+/* asn1crt_crc.c - CRC32C and CCSDS CRC-16 implementation */
+#include "asn1crt_crc.h"
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define CRC_HAVE_X86 1
+#endif
+
+#define CRC32C_POLY_REFLECTED 0x82F63B78u
+#define CRC16_CCSDS_POLY 0x1021u
+
+static unsigned int crc32cTable[8][256];
+static unsigned short crc16Table[8][256];
+static pthread_once_t crcTablesOnce = PTHREAD_ONCE_INIT;
+
+typedef unsigned int (*Crc32cUpdateFn)(unsigned int crc, const byte* data, size_t length);
+static Crc32cUpdateFn crc32cUpdate = NULL;
+
+#ifdef CRC_HAVE_X86
+static unsigned int Crc32c_UpdateHardware(unsigned int crc, const byte* data, size_t length);
+#endif
+
+static void Crc_BuildTables(void) {
+    for (unsigned int b = 0; b < 256; b++) {
+        unsigned int c32 = b;
+        unsigned int c16 = b << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            c32 = (c32 & 1) ? (c32 >> 1) ^ CRC32C_POLY_REFLECTED : c32 >> 1;
+            c16 = (c16 & 0x8000) ? (c16 << 1) ^ CRC16_CCSDS_POLY : c16 << 1;
+        }
+        crc32cTable[0][b] = c32;
+        crc16Table[0][b] = (unsigned short)c16;
+    }
+
+    /* Table k: contribution of a byte followed by k zero bytes */
+    for (int k = 1; k < 8; k++) {
+        for (unsigned int b = 0; b < 256; b++) {
+            unsigned int prev32 = crc32cTable[k - 1][b];
+            unsigned int prev16 = crc16Table[k - 1][b];
+            crc32cTable[k][b] = (prev32 >> 8) ^ crc32cTable[0][prev32 & 0xFF];
+            crc16Table[k][b] = (unsigned short)(((prev16 << 8) & 0xFFFF) ^ crc16Table[0][prev16 >> 8]);
+        }
+    }
+
+    crc32cUpdate = Crc32c_UpdateSoftware;
+#ifdef CRC_HAVE_X86
+    if (Crc32c_HardwareAvailable()) {
+        crc32cUpdate = Crc32c_UpdateHardware;
+    }
+#endif
+}
+
+static unsigned int Crc_Load32(const byte* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+           ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+unsigned int Crc32c_UpdateSoftware(unsigned int crc, const byte* data, size_t length) {
+    unsigned int c = ~crc;
+
+    pthread_once(&crcTablesOnce, Crc_BuildTables);
+
+    while (length >= 8) {
+        unsigned int lo = c ^ Crc_Load32(data);
+        unsigned int hi = Crc_Load32(data + 4);
+        c = crc32cTable[7][lo & 0xFF] ^ crc32cTable[6][(lo >> 8) & 0xFF] ^
+            crc32cTable[5][(lo >> 16) & 0xFF] ^ crc32cTable[4][lo >> 24] ^
+            crc32cTable[3][hi & 0xFF] ^ crc32cTable[2][(hi >> 8) & 0xFF] ^
+            crc32cTable[1][(hi >> 16) & 0xFF] ^ crc32cTable[0][hi >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        c = (c >> 8) ^ crc32cTable[0][(c ^ *data++) & 0xFF];
+    }
+    return ~c;
+}
+
+#ifdef CRC_HAVE_X86
+/* Through memcpy rather than an integer pointer: the buffer is bytes
+ * (often a decoded struct), so a punned load would break strict aliasing.
+ * Compiles to a single mov, as Crc_Load32 does. */
+static inline unsigned long long Crc_Load64(const byte* p) {
+    unsigned long long v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* Only selected by the dispatcher when the CPU reports SSE4.2 */
+__attribute__((target("sse4.2")))
+static unsigned int Crc32c_UpdateHardware(unsigned int crc, const byte* data, size_t length) {
+    unsigned long long c = ~crc;
+
+    while (length > 0 && ((size_t)data & 7) != 0) {
+        c = _mm_crc32_u8((unsigned int)c, *data++);
+        length--;
+    }
+#if defined(__x86_64__)
+    while (length >= 32) {
+        c = _mm_crc32_u64(c, Crc_Load64(data));
+        c = _mm_crc32_u64(c, Crc_Load64(data + 8));
+        c = _mm_crc32_u64(c, Crc_Load64(data + 16));
+        c = _mm_crc32_u64(c, Crc_Load64(data + 24));
+        data += 32;
+        length -= 32;
+    }
+    while (length >= 8) {
+        c = _mm_crc32_u64(c, Crc_Load64(data));
+        data += 8;
+        length -= 8;
+    }
+#endif
+    while (length >= 4) {
+        c = _mm_crc32_u32((unsigned int)c, Crc_Load32(data));
+        data += 4;
+        length -= 4;
+    }
+    while (length-- > 0) {
+        c = _mm_crc32_u8((unsigned int)c, *data++);
+    }
+    return ~(unsigned int)c;
+}
+#endif
+
+flag Crc32c_HardwareAvailable(void) {
+#ifdef CRC_HAVE_X86
+    return __builtin_cpu_supports("sse4.2") ? TRUE : FALSE;
+#else
+    return FALSE;
+#endif
+}
+
+unsigned int Crc32c_Update(unsigned int crc, const byte* data, size_t length) {
+    pthread_once(&crcTablesOnce, Crc_BuildTables);
+    return crc32cUpdate(crc, data, length);
+}
+
+unsigned int Crc32c_Compute(const byte* data, size_t length) {
+    return Crc32c_Update(0, data, length);
+}
+
+unsigned short Crc16_CcsdsUpdate(unsigned short crc, const byte* data, size_t length) {
+    unsigned int c = crc;
+
+    pthread_once(&crcTablesOnce, Crc_BuildTables);
+
+    /* The register covers the first two bytes of each 8-byte block */
+    while (length >= 8) {
+        c = crc16Table[7][data[0] ^ (c >> 8)] ^ crc16Table[6][data[1] ^ (c & 0xFF)] ^
+            crc16Table[5][data[2]] ^ crc16Table[4][data[3]] ^
+            crc16Table[3][data[4]] ^ crc16Table[2][data[5]] ^
+            crc16Table[1][data[6]] ^ crc16Table[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        c = ((c << 8) & 0xFFFF) ^ crc16Table[0][((c >> 8) ^ *data++) & 0xFF];
+    }
+    return (unsigned short)c;
+}
+
+unsigned short Crc16_Ccsds(const byte* data, size_t length) {
+    return Crc16_CcsdsUpdate(0xFFFF, data, length);
+}
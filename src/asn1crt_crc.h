@@ -0,0 +1,26 @@
+/* asn1crt_crc.h - CRC32C and CCSDS CRC-16 with runtime CPU dispatch */
+#ifndef ASN1CRT_CRC_H
+#define ASN1CRT_CRC_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+
+/* CRC-32C (Castagnoli, reflected 0x82F63B78), init/xorout 0xFFFFFFFF */
+unsigned int Crc32c_Compute(const byte* data, size_t length);
+
+/* Continue a CRC-32C; pass 0 as crc for the first chunk */
+unsigned int Crc32c_Update(unsigned int crc, const byte* data, size_t length);
+
+/* Portable slicing-by-8 CRC-32C (always available, used as fallback) */
+unsigned int Crc32c_UpdateSoftware(unsigned int crc, const byte* data, size_t length);
+
+/* TRUE when Crc32c_Update runs on the SSE4.2 crc32 instruction */
+flag Crc32c_HardwareAvailable(void);
+
+/* CCSDS CRC-16 (CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF), slicing-by-8 */
+unsigned short Crc16_Ccsds(const byte* data, size_t length);
+
+/* Continue a CCSDS CRC-16; pass 0xFFFF as crc for the first chunk */
+unsigned short Crc16_CcsdsUpdate(unsigned short crc, const byte* data, size_t length);
+
+#endif /* ASN1CRT_CRC_H */
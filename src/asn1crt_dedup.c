@@ -0,0 +1,544 @@
+/* asn1crt_dedup.c - Content-addressed ScienceData block store and dedup archive */
+#include "asn1crt_dedup.h"
+#include "asn1crt_internal.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DEDUP_HAVE_X86 1
+#endif
+
+#define DEDUP_STRIPE  64
+#define DEDUP_LANES   8
+
+typedef unsigned long long DedupVec __attribute__((vector_size(32)));
+
+#define DEDUP_VEC_LANES ((int)(sizeof(DedupVec) / sizeof(unsigned long long)))
+#define DEDUP_VECS      (DEDUP_LANES / DEDUP_VEC_LANES)
+
+/* Largest science record: type, header fields, counts, four full literals */
+#define DEDUP_MAX_RECORD (1 + 12 + LAYOUT_BLOCK_COUNT_MAX * (3 + DEDUP_BLOCK_BYTES))
+
+static const unsigned long long dedupSecret[16] = {
+    0x2CB0F69F4ABEA221ULL, 0x9417034723148989ULL, 0xDD555950609DFE03ULL, 0xDBAFB150DEB12800ULL,
+    0x7E789B2E6C442CB6ULL, 0xF41E5636C7E4F8C4ULL, 0x0959D150F8FBA7E4ULL, 0xA97316F13CDB9EEAULL,
+    0x74CD8258F9520068ULL, 0x55C74A62E116868BULL, 0xD2F4C799A2023CBDULL, 0xDF98CB79A37B51B9ULL,
+    0x396F5885524F3905ULL, 0xAF1D56386CA3B276ULL, 0xA9FFBE6B5104E85AULL, 0x6BD0C51B9FD533B3ULL,
+};
+
+static void Dedup_Put16(byte* p, unsigned int value) {
+    p[0] = (byte)value;
+    p[1] = (byte)(value >> 8);
+}
+
+static void Dedup_Put32(byte* p, unsigned int value) {
+    Dedup_Put16(p, value);
+    Dedup_Put16(p + 2, value >> 16);
+}
+
+static unsigned int Dedup_Get16(const byte* p) {
+    return (unsigned int)p[0] | (unsigned int)p[1] << 8;
+}
+
+static unsigned int Dedup_Get32(const byte* p) {
+    return Dedup_Get16(p) | Dedup_Get16(p + 2) << 16;
+}
+
+/* ---- Hash ---- */
+
+/* Lane i takes the 32x32->64 product of its word and secret, plus the
+ * neighbouring lane's raw word; both are single instructions on vectors */
+static inline __attribute__((always_inline)) void Dedup_Stripe(DedupVec* acc, const byte* p,
+                                                               const unsigned long long* secret) {
+    for (int v = 0; v < DEDUP_VECS; v++) {
+        DedupVec d;
+        DedupVec key;
+        DedupVec k;
+        memcpy(&d, p + v * sizeof(DedupVec), sizeof(d));
+        memcpy(&key, secret + v * DEDUP_VEC_LANES, sizeof(key));
+        k = d ^ key;
+        acc[v] += __builtin_shuffle(d, (DedupVec){ 1, 0, 3, 2 }) + (k & 0xFFFFFFFFULL) * (k >> 32);
+    }
+}
+
+static unsigned long long Dedup_Mix(unsigned long long a, unsigned long long b) {
+    __uint128_t product = (__uint128_t)a * b;
+    return (unsigned long long)product ^ (unsigned long long)(product >> 64);
+}
+
+/* Full stripes, then the last 64 bytes (zero-padded when shorter) unless
+ * the length is a whole number of stripes; the length is mixed in last */
+static inline __attribute__((always_inline)) unsigned long long Dedup_HashBody(const byte* data, size_t length) {
+    DedupVec acc[DEDUP_VECS] = {
+        { 0xC2B2AE3DULL, 0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL },
+        { 0x85EBCA77C2B2AE63ULL, 0x85EBCA77ULL, 0x27D4EB2F165667C5ULL, 0x9E3779B1ULL }
+    };
+    unsigned long long lanes[DEDUP_LANES];
+    size_t stripes = length / DEDUP_STRIPE;
+    unsigned long long h = length * 0x9E3779B185EBCA87ULL;
+
+    for (size_t s = 0; s < stripes; s++) {
+        Dedup_Stripe(acc, data + s * DEDUP_STRIPE, dedupSecret + (s & 7));
+    }
+    if (length % DEDUP_STRIPE != 0 || length == 0) {
+        byte last[DEDUP_STRIPE];
+        if (length >= DEDUP_STRIPE) {
+            memcpy(last, data + length - DEDUP_STRIPE, DEDUP_STRIPE);
+        } else {
+            memset(last, 0, sizeof(last));
+            memcpy(last, data, length);
+        }
+        Dedup_Stripe(acc, last, dedupSecret + DEDUP_LANES);
+    }
+
+    memcpy(lanes, acc, sizeof(lanes));
+    for (int i = 0; i < DEDUP_LANES; i += 2) {
+        h += Dedup_Mix(lanes[i] ^ dedupSecret[i + 1], lanes[i + 1] ^ dedupSecret[i]);
+    }
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+}
+
+unsigned long long Dedup_Hash64Generic(const byte* data, size_t length) {
+    return Dedup_HashBody(data, length);
+}
+
+#ifdef DEDUP_HAVE_X86
+__attribute__((target("avx2")))
+static unsigned long long Dedup_Hash64Avx2(const byte* data, size_t length) {
+    return Dedup_HashBody(data, length);
+}
+#endif
+
+static unsigned long long (*hashKernel)(const byte*, size_t) = Dedup_Hash64Generic;
+static const char* hashKernelName = "generic";
+static pthread_once_t dedupDispatchOnce = PTHREAD_ONCE_INIT;
+
+static void Dedup_SelectKernel(void) {
+#ifdef DEDUP_HAVE_X86
+    if (__builtin_cpu_supports("avx2")) {
+        hashKernel = Dedup_Hash64Avx2;
+        hashKernelName = "avx2";
+    }
+#endif
+}
+
+unsigned long long Dedup_Hash64(const byte* data, size_t length) {
+    pthread_once(&dedupDispatchOnce, Dedup_SelectKernel);
+    return hashKernel(data, length);
+}
+
+const char* Dedup_HashKernel(void) {
+    pthread_once(&dedupDispatchOnce, Dedup_SelectKernel);
+    return hashKernelName;
+}
+
+/* ---- Block store ---- */
+
+static unsigned int BlockStore_SlotCount(unsigned int capacity) {
+    unsigned int slots = 2;
+    while (slots < 2 * capacity) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+size_t BlockStore_PoolBytes(unsigned int capacity) {
+    return Asn1crt_Round8(sizeof(DedupSlot) * BlockStore_SlotCount(capacity)) +
+           Asn1crt_Round8(sizeof(DedupCell) * capacity) + (size_t)capacity * DEDUP_BLOCK_BYTES;
+}
+
+flag BlockStore_Init(BlockStore* store, MemPool* pool, unsigned int capacity, int* pErrCode) {
+    unsigned int slots = BlockStore_SlotCount(capacity);
+
+    memset(store, 0, sizeof(BlockStore));
+    store->slots = (DedupSlot*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(DedupSlot) * slots));
+    store->cells = (DedupCell*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(DedupCell) * capacity));
+    store->bytes = (byte*)MemPool_Alloc(pool, (size_t)capacity * DEDUP_BLOCK_BYTES);
+    if (store->slots == NULL || store->cells == NULL || store->bytes == NULL) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_POOL);
+    }
+    memset(store->slots, 0, sizeof(DedupSlot) * slots);
+    store->slotMask = slots - 1;
+    store->capacity = capacity;
+
+    /* Every cell starts on the free list, lowest first */
+    for (unsigned int i = 0; i < capacity; i++) {
+        memset(&store->cells[i], 0, sizeof(DedupCell));
+        store->cells[i].next = i + 2 <= capacity ? i + 2 : 0;
+    }
+    store->freeHead = capacity > 0 ? 1 : 0;
+    return TRUE;
+}
+
+flag BlockStore_Put(BlockStore* store, const byte* data, int length, unsigned int* blockId, flag* added,
+                    int* pErrCode) {
+    unsigned long long hash;
+    unsigned int i;
+    DedupCell* cell;
+
+    if (length < 0 || length > DEDUP_BLOCK_BYTES) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_LENGTH);
+    }
+    hash = Dedup_Hash64(data, (size_t)length);
+    store->stats.puts++;
+
+    for (i = (unsigned int)hash & store->slotMask; store->slots[i].cell != 0; i = (i + 1) & store->slotMask) {
+        if (store->slots[i].hash == hash) {
+            unsigned int c = store->slots[i].cell - 1;
+            cell = &store->cells[c];
+            if (cell->length == (unsigned int)length &&
+                memcmp(store->bytes + (size_t)c * DEDUP_BLOCK_BYTES, data, (size_t)length) == 0) {
+                cell->refs++;
+                store->stats.hits++;
+                *blockId = c;
+                *added = FALSE;
+                return TRUE;
+            }
+            store->stats.collisions++;
+        }
+    }
+
+    /* i is the empty slot that ended the probe */
+    if (store->freeHead == 0) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_FULL);
+    }
+    *blockId = store->freeHead - 1;
+    cell = &store->cells[*blockId];
+    store->freeHead = cell->next;
+    cell->hash = hash;
+    cell->refs = 1;
+    cell->length = (unsigned short)length;
+    cell->next = 0;
+    memcpy(store->bytes + (size_t)*blockId * DEDUP_BLOCK_BYTES, data, (size_t)length);
+    store->slots[i].hash = hash;
+    store->slots[i].cell = *blockId + 1;
+    store->stats.live++;
+    *added = TRUE;
+    return TRUE;
+}
+
+const byte* BlockStore_Get(const BlockStore* store, unsigned int blockId, int* length) {
+    *length = store->cells[blockId].length;
+    return store->bytes + (size_t)blockId * DEDUP_BLOCK_BYTES;
+}
+
+unsigned int BlockStore_Refs(const BlockStore* store, unsigned int blockId) {
+    return store->cells[blockId].refs;
+}
+
+void BlockStore_Release(BlockStore* store, unsigned int blockId) {
+    DedupCell* cell = &store->cells[blockId];
+    unsigned int mask = store->slotMask;
+    unsigned int i;
+
+    if (cell->refs == 0 || --cell->refs > 0) {
+        return;
+    }
+    i = (unsigned int)cell->hash & mask;
+    while (store->slots[i].cell != blockId + 1) {
+        i = (i + 1) & mask;
+    }
+
+    /* Backward-shift deletion: pull later entries of the probe run into
+     * the hole unless that would put them before their home slot */
+    for (unsigned int j = (i + 1) & mask; store->slots[j].cell != 0; j = (j + 1) & mask) {
+        unsigned int home = (unsigned int)store->slots[j].hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            store->slots[i] = store->slots[j];
+            i = j;
+        }
+    }
+    store->slots[i].cell = 0;
+
+    cell->next = store->freeHead;
+    store->freeHead = blockId + 1;
+    store->stats.live--;
+    store->stats.released++;
+}
+
+/* ---- Archive writer ---- */
+
+size_t DedupWriter_PoolBytes(unsigned int capacity) {
+    return BlockStore_PoolBytes(capacity) + Asn1crt_Round8(sizeof(unsigned int) * capacity);
+}
+
+flag DedupWriter_Open(DedupWriter* w, const char* path, MemPool* pool, unsigned int capacity, int* pErrCode) {
+    byte header[DEDUP_HEADER_SIZE];
+
+    memset(w, 0, sizeof(DedupWriter));
+    if (!BlockStore_Init(&w->store, pool, capacity, pErrCode)) {
+        return FALSE;
+    }
+    w->offsets = (unsigned int*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(unsigned int) * capacity));
+    if (w->offsets == NULL) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_POOL);
+    }
+    w->out = fopen(path, "wb");
+    if (w->out == NULL) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+
+    /* Counts are filled in by DedupWriter_Close */
+    memset(header, 0, sizeof(header));
+    if (fwrite(header, 1, sizeof(header), w->out) != sizeof(header)) {
+        fclose(w->out);
+        w->out = NULL;
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    w->offset = DEDUP_HEADER_SIZE;
+    w->stats.bytes = DEDUP_HEADER_SIZE;
+    return TRUE;
+}
+
+/* A science frame within satellite.asn's constraints. Anything else goes
+ * through the generated encoder, whose constraint check rejects it,
+ * rather than being archived compactly as a frame no decoder accepts. */
+static flag Dedup_ScienceFits(const T_TelemetryFrame* frame) {
+    const T_ScienceData* sci = &frame->payload.u.science;
+
+    if (frame->payload.kind != science_PRESENT ||
+        frame->header.timestamp.seconds > (1ULL << LAYOUT_SECONDS_BITS) - 1 ||
+        frame->header.timestamp.subseconds > LAYOUT_SUBSECONDS_MAX ||
+        frame->header.frameType > (1ULL << LAYOUT_FRAME_TYPE_BITS) - 1 ||
+        frame->header.frameCount > (1ULL << LAYOUT_FRAME_COUNT_BITS) - 1 ||
+        sci->instrumentId > (1ULL << LAYOUT_INSTRUMENT_BITS) - 1 ||
+        sci->dataBlocks.nCount < LAYOUT_BLOCK_COUNT_MIN || sci->dataBlocks.nCount > LAYOUT_BLOCK_COUNT_MAX) {
+        return FALSE;
+    }
+    for (int i = 0; i < sci->dataBlocks.nCount; i++) {
+        if (sci->dataBlocks.arr[i].nCount < LAYOUT_BLOCK_LENGTH_MIN ||
+            sci->dataBlocks.arr[i].nCount > LAYOUT_BLOCK_LENGTH_MAX) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Append one block to the record at rec + *pos, recordOffset being where
+ * the record starts in the file */
+static void DedupWriter_Block(DedupWriter* w, const byte* data, int length, unsigned long long recordOffset,
+                              byte* rec, size_t* pos) {
+    unsigned long long literalOffset = recordOffset + *pos;
+    unsigned int blockId;
+    flag added;
+    int errCode;
+
+    w->stats.blockBytes += (unsigned long long)length;
+    if (BlockStore_Put(&w->store, data, length, &blockId, &added, &errCode)) {
+        if (!added) {
+            rec[(*pos)++] = DEDUP_BLOCK_REF;
+            Dedup_Put32(rec + *pos, w->offsets[blockId]);
+            *pos += 4;
+            w->stats.references++;
+            w->stats.savedBytes += (unsigned long long)length;
+            return;
+        }
+        if (literalOffset > 0xFFFFFFFFULL) {
+            /* Past the reach of a u32 reference: written, never shared */
+            BlockStore_Release(&w->store, blockId);
+        } else {
+            w->offsets[blockId] = (unsigned int)literalOffset;
+        }
+    }
+    /* New block, or the store is full of live blocks: write it in full */
+    rec[(*pos)++] = DEDUP_BLOCK_LITERAL;
+    Dedup_Put16(rec + *pos, (unsigned int)length);
+    memcpy(rec + *pos + 2, data, (size_t)length);
+    *pos += 2 + (size_t)length;
+    w->stats.literals++;
+}
+
+flag DedupWriter_Write(DedupWriter* w, const T_TelemetryFrame* frame, int* pErrCode) {
+    byte rec[DEDUP_MAX_RECORD > T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + 3
+                 ? DEDUP_MAX_RECORD
+                 : T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + 3];
+    size_t pos = 0;
+
+    if (Dedup_ScienceFits(frame)) {
+        const T_ScienceData* sci = &frame->payload.u.science;
+        rec[pos++] = DEDUP_RECORD_SCIENCE;
+        Dedup_Put32(rec + pos, (unsigned int)frame->header.timestamp.seconds);
+        Dedup_Put16(rec + pos + 4, (unsigned int)frame->header.timestamp.subseconds);
+        rec[pos + 6] = (byte)frame->header.frameType;
+        Dedup_Put16(rec + pos + 7, (unsigned int)frame->header.frameCount);
+        rec[pos + 9] = (byte)sci->instrumentId;
+        rec[pos + 10] = (byte)sci->dataBlocks.nCount;
+        pos += 11;
+        for (int i = 0; i < sci->dataBlocks.nCount; i++) {
+            DedupWriter_Block(w, sci->dataBlocks.arr[i].arr, sci->dataBlocks.arr[i].nCount, w->offset, rec, &pos);
+        }
+    } else {
+        BitStream bs;
+        BitStream_Init(&bs, rec + 3, T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING);
+        if (!T_TelemetryFrame_Encode(frame, &bs, pErrCode, TRUE)) {
+            return FALSE;
+        }
+        rec[0] = DEDUP_RECORD_FRAME;
+        Dedup_Put16(rec + 1, (unsigned int)BitStream_GetLength(&bs));
+        pos = 3 + (size_t)BitStream_GetLength(&bs);
+    }
+
+    if (fwrite(rec, 1, pos, w->out) != pos) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    w->offset += pos;
+    w->stats.bytes = w->offset;
+    w->stats.frames++;
+    return TRUE;
+}
+
+flag DedupWriter_Close(DedupWriter* w, int* pErrCode) {
+    byte header[DEDUP_HEADER_SIZE];
+    flag ok = TRUE;
+
+    if (w->out == NULL) {
+        return TRUE;
+    }
+    memset(header, 0, sizeof(header));
+    memcpy(header, DEDUP_MAGIC, 8);
+    Dedup_Put32(header + 8, DEDUP_VERSION);
+    Dedup_Put32(header + 12, (unsigned int)w->stats.frames);
+    Dedup_Put32(header + 16, (unsigned int)w->stats.literals);
+    Dedup_Put32(header + 20, (unsigned int)w->stats.references);
+    if (fseek(w->out, 0, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), w->out) != sizeof(header)) {
+        ok = Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    if (fclose(w->out) != 0 && ok) {
+        ok = Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    w->out = NULL;
+    return ok;
+}
+
+/* ---- Archive reader ---- */
+
+flag DedupArchive_Open(DedupArchive* a, const char* path, int* pErrCode) {
+    struct stat st;
+    void* base;
+    int fd;
+
+    memset(a, 0, sizeof(DedupArchive));
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    if (st.st_size < DEDUP_HEADER_SIZE) {
+        close(fd);
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_IO);
+    }
+    a->base = (const byte*)base;
+    a->size = (size_t)st.st_size;
+    if (memcmp(a->base, DEDUP_MAGIC, 8) != 0 || Dedup_Get32(a->base + 8) != DEDUP_VERSION) {
+        DedupArchive_Close(a);
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+    }
+    a->frames = Dedup_Get32(a->base + 12);
+    a->pos = DEDUP_HEADER_SIZE;
+    return TRUE;
+}
+
+/* Copy one block of the record. References must name a literal that ends
+ * before the reference itself: in an earlier record, or an earlier block
+ * of this one (a frame repeating a fill pattern), never the record header. */
+static flag DedupArchive_Block(DedupArchive* a, size_t recordStart, T_ScienceData_dataBlocks_elem* block) {
+    const byte* p = a->base;
+    size_t literal = a->pos;
+    size_t ref = a->pos;
+
+    if (a->pos + 1 > a->size) {
+        return FALSE;
+    }
+    if (p[a->pos] == DEDUP_BLOCK_REF) {
+        if (a->pos + 5 > a->size) {
+            return FALSE;
+        }
+        literal = Dedup_Get32(p + a->pos + 1);
+        a->pos += 5;
+        if (literal < DEDUP_HEADER_SIZE || (literal >= recordStart && literal < recordStart + 12) ||
+            literal + 3 > ref || p[literal] != DEDUP_BLOCK_LITERAL ||
+            literal + 3 + Dedup_Get16(p + literal + 1) > ref) {
+            return FALSE;
+        }
+    } else if (p[a->pos] == DEDUP_BLOCK_LITERAL) {
+        if (a->pos + 3 > a->size || a->pos + 3 + Dedup_Get16(p + a->pos + 1) > a->size) {
+            return FALSE;
+        }
+        a->pos += 3 + Dedup_Get16(p + a->pos + 1);
+    } else {
+        return FALSE;
+    }
+
+    block->nCount = (int)Dedup_Get16(p + literal + 1);
+    if (block->nCount < LAYOUT_BLOCK_LENGTH_MIN || block->nCount > LAYOUT_BLOCK_LENGTH_MAX) {
+        return FALSE;
+    }
+    memcpy(block->arr, p + literal + 3, (size_t)block->nCount);
+    return TRUE;
+}
+
+flag DedupArchive_Next(DedupArchive* a, T_TelemetryFrame* frame, int* pErrCode) {
+    const byte* p = a->base;
+    size_t start = a->pos;
+
+    if (a->next >= a->frames || start + 3 > a->size) {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+    }
+    if (p[start] == DEDUP_RECORD_FRAME) {
+        BitStream bs;
+        size_t length = Dedup_Get16(p + start + 1);
+        if (start + 3 + length > a->size) {
+            return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+        }
+        BitStream_AttachBuffer(&bs, (byte*)(p + start + 3), length);
+        if (!T_TelemetryFrame_Decode(frame, &bs, pErrCode)) {
+            return FALSE;
+        }
+        a->pos = start + 3 + length;
+    } else if (p[start] == DEDUP_RECORD_SCIENCE && start + 12 <= a->size) {
+        T_ScienceData* sci = &frame->payload.u.science;
+        frame->header.timestamp.seconds = Dedup_Get32(p + start + 1);
+        frame->header.timestamp.subseconds = Dedup_Get16(p + start + 5);
+        frame->header.frameType = p[start + 7];
+        frame->header.frameCount = Dedup_Get16(p + start + 8);
+        frame->payload.kind = science_PRESENT;
+        sci->instrumentId = p[start + 10];
+        sci->dataBlocks.nCount = p[start + 11];
+        if (frame->header.timestamp.subseconds > LAYOUT_SUBSECONDS_MAX ||
+            sci->dataBlocks.nCount < LAYOUT_BLOCK_COUNT_MIN || sci->dataBlocks.nCount > LAYOUT_BLOCK_COUNT_MAX) {
+            return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+        }
+        a->pos = start + 12;
+        for (int i = 0; i < sci->dataBlocks.nCount; i++) {
+            if (!DedupArchive_Block(a, start, &sci->dataBlocks.arr[i])) {
+                a->pos = start;
+                return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+            }
+        }
+    } else {
+        return Asn1crt_Fail(pErrCode, ERR_DEDUP_FORMAT);
+    }
+    a->next++;
+    return TRUE;
+}
+
+void DedupArchive_Close(DedupArchive* a) {
+    if (a->base != NULL) {
+        munmap((void*)a->base, a->size);
+    }
+    memset(a, 0, sizeof(DedupArchive));
+}
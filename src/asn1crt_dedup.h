@@ -0,0 +1,153 @@
+/* asn1crt_dedup.h - Content-addressed ScienceData block store and dedup archive */
+#ifndef ASN1CRT_DEDUP_H
+#define ASN1CRT_DEDUP_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "asn1crt.h"
+#include "asn1crt_layout.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* Block store, writer and archive failures */
+#define ERR_DEDUP_POOL    1120  /* Pool smaller than the PoolBytes for this capacity */
+#define ERR_DEDUP_FULL    1121  /* Every block cell holds a live block */
+#define ERR_DEDUP_LENGTH  1122  /* Block length outside 0..DEDUP_BLOCK_BYTES */
+#define ERR_DEDUP_IO      1123  /* open/write/mmap failed */
+#define ERR_DEDUP_FORMAT  1124  /* Bad magic, record or block reference */
+
+/* Cell size: the largest dataBlocks element */
+#define DEDUP_BLOCK_BYTES LAYOUT_BLOCK_LENGTH_MAX
+
+/* 64-bit non-cryptographic hash built like XXH3: eight 64-bit lanes take
+ * a 64-byte stripe each round with 32x32->64 multiplies, so the lanes map
+ * onto SIMD registers; a final mix folds them together. Not compatible
+ * with XXH3 output. */
+unsigned long long Dedup_Hash64(const byte* data, size_t length);
+
+/* Same hash without the AVX2 build, for checking the dispatched one */
+unsigned long long Dedup_Hash64Generic(const byte* data, size_t length);
+
+/* Hash kernel picked at runtime: "avx2" or "generic" */
+const char* Dedup_HashKernel(void);
+
+/* Index slot: open addressing with linear probing, cell + 1 (0 is empty) */
+typedef struct {
+    unsigned long long hash;
+    unsigned int cell;
+    unsigned int reserved;
+} DedupSlot;
+
+/* One stored block. refs == 0 marks a free cell; next links the free list. */
+typedef struct {
+    unsigned long long hash;
+    unsigned int refs;
+    unsigned short length;
+    unsigned short reserved;
+    unsigned int next;
+} DedupCell;
+
+typedef struct {
+    unsigned long long puts;        /* BlockStore_Put calls */
+    unsigned long long hits;        /* Puts answered by a stored block */
+    unsigned long long collisions;  /* Same hash, different bytes */
+    unsigned long long released;    /* Blocks whose last reference went */
+    unsigned int live;              /* Blocks currently stored */
+} BlockStoreStats;
+
+/* Reference-counted blocks in fixed DEDUP_BLOCK_BYTES cells, indexed by
+ * hash. Equal hashes are confirmed with memcmp before a block is shared. */
+typedef struct {
+    DedupSlot* slots;               /* slotMask + 1, at least twice capacity */
+    unsigned int slotMask;
+    DedupCell* cells;               /* capacity */
+    byte* bytes;                    /* capacity * DEDUP_BLOCK_BYTES */
+    unsigned int capacity;
+    unsigned int freeHead;          /* First free cell + 1, 0 when all are used */
+    BlockStoreStats stats;
+} BlockStore;
+
+size_t BlockStore_PoolBytes(unsigned int capacity);
+
+flag BlockStore_Init(BlockStore* store, MemPool* pool, unsigned int capacity, int* pErrCode);
+
+/* Add a reference to the block holding these bytes, storing it first if
+ * it is new. blockId identifies it until its last BlockStore_Release. */
+flag BlockStore_Put(BlockStore* store, const byte* data, int length, unsigned int* blockId, flag* added,
+                    int* pErrCode);
+
+const byte* BlockStore_Get(const BlockStore* store, unsigned int blockId, int* length);
+
+unsigned int BlockStore_Refs(const BlockStore* store, unsigned int blockId);
+
+/* Drop a reference; the last one removes the block from the index and
+ * frees its cell */
+void BlockStore_Release(BlockStore* store, unsigned int blockId);
+
+/* Archive layout (little-endian):
+ *   header  DEDUP_HEADER_SIZE bytes: magic, version, frames, literals, references
+ *   records, one per frame:
+ *     u8 DEDUP_RECORD_FRAME    u16 length, uPER TelemetryFrame
+ *     u8 DEDUP_RECORD_SCIENCE  u32 seconds, u16 subseconds, u8 frameType, u16 frameCount,
+ *                              u8 instrumentId, u8 block count, then per block:
+ *       u8 DEDUP_BLOCK_LITERAL   u16 length, octets
+ *       u8 DEDUP_BLOCK_REF       u32 file offset of an earlier literal, possibly
+ *                                in the same record
+ * A block seen before in the same archive is written as a 5-byte
+ * reference instead of up to 259 bytes, so the file stays self-contained. */
+#define DEDUP_MAGIC           "TLMDEDP1"
+#define DEDUP_VERSION         1
+#define DEDUP_HEADER_SIZE     32
+#define DEDUP_RECORD_FRAME    0
+#define DEDUP_RECORD_SCIENCE  1
+#define DEDUP_BLOCK_LITERAL   0
+#define DEDUP_BLOCK_REF       1
+
+typedef struct {
+    unsigned long long frames;
+    unsigned long long literals;    /* Blocks written in full */
+    unsigned long long references;  /* Blocks written as references */
+    unsigned long long blockBytes;  /* dataBlocks octets received */
+    unsigned long long savedBytes;  /* Octets replaced by references */
+    unsigned long long bytes;       /* Archive bytes written, header included */
+} DedupStats;
+
+typedef struct {
+    FILE* out;
+    BlockStore store;
+    unsigned int* offsets;          /* Literal's file offset per blockId */
+    unsigned long long offset;      /* Next write position */
+    DedupStats stats;
+} DedupWriter;
+
+/* Pool bytes for a writer that remembers up to capacity distinct blocks;
+ * once they are all in use, new blocks are written as unshared literals */
+size_t DedupWriter_PoolBytes(unsigned int capacity);
+
+flag DedupWriter_Open(DedupWriter* w, const char* path, MemPool* pool, unsigned int capacity, int* pErrCode);
+
+/* Append one frame. Science frames go out with duplicate blocks as
+ * references; other payloads as their uPER encoding. */
+flag DedupWriter_Write(DedupWriter* w, const T_TelemetryFrame* frame, int* pErrCode);
+
+/* Write the header counts and close the file */
+flag DedupWriter_Close(DedupWriter* w, int* pErrCode);
+
+/* An archive mapped read-only, read front to back */
+typedef struct {
+    const byte* base;
+    size_t size;
+    size_t pos;
+    unsigned int frames;
+    unsigned int next;              /* Frames returned so far */
+} DedupArchive;
+
+flag DedupArchive_Open(DedupArchive* a, const char* path, int* pErrCode);
+
+/* Rebuild the next frame, resolving references in place. FALSE with
+ * ERR_DEDUP_FORMAT on a malformed record or after the last frame. */
+flag DedupArchive_Next(DedupArchive* a, T_TelemetryFrame* frame, int* pErrCode);
+
+void DedupArchive_Close(DedupArchive* a);
+
+#endif /* ASN1CRT_DEDUP_H */
@@ -0,0 +1,410 @@
+/* asn1crt_export.c - Bulk TelemetryFrame export to CSV, JSON and NDJSON */
+#include "asn1crt_export.h"
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define EXPORT_HAVE_X86 1
+#endif
+
+/* Append a string literal and advance p */
+#define EXPORT_LIT(p, s) (memcpy((p), (s), sizeof(s) - 1), (p) += sizeof(s) - 1)
+
+static const char digitPairs[201] =
+    "00010203040506070809" "10111213141516171819" "20212223242526272829" "30313233343536373839"
+    "40414243444546474849" "50515253545556575859" "60616263646566676869" "70717273747576777879"
+    "80818283848586878889" "90919293949596979899";
+
+/* powers10[i] = 10^i, except 0 in slot 0 so that 0 counts as one digit */
+static const unsigned long long powers10[20] = {
+    0ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static const char hexDigits[17] = "0123456789abcdef";
+static const char base64Digits[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+typedef size_t (*ExportEncodeFn)(char* out, const byte* in, size_t length);
+static ExportEncodeFn hexEncode = NULL;
+static ExportEncodeFn base64Encode = NULL;
+static pthread_once_t exportDispatchOnce = PTHREAD_ONCE_INIT;
+
+static const char* const kindNames[4] = { "none", "housekeeping", "science", "commandAck" };
+static const char* const ackStatusNames[4] = { "success", "invalidCommand", "executionFailed", "insufficientPrivileges" };
+
+/* Decimal digits of value: log2 estimate scaled by log10(2) ~ 1233/4096,
+ * corrected by one table compare */
+static int Export_DigitCount(unsigned long long value) {
+    int bits = 64 - __builtin_clzll(value | 1);
+    int t = (bits * 1233) >> 12;
+    return t + 1 - (value < powers10[t]);
+}
+
+int Export_Uint(char* out, unsigned long long value) {
+    int n = Export_DigitCount(value);
+    char* p = out + n;
+
+    while (value >= 100) {
+        unsigned int pair = (unsigned int)(value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        memcpy(p, digitPairs + pair, 2);
+    }
+    if (value >= 10) {
+        memcpy(p - 2, digitPairs + value * 2, 2);
+    } else {
+        p[-1] = (char)('0' + value);
+    }
+    return n;
+}
+
+int Export_Sint(char* out, long long value) {
+    if (value < 0) {
+        *out = '-';
+        return 1 + Export_Uint(out + 1, 0ULL - (unsigned long long)value);
+    }
+    return Export_Uint(out, (unsigned long long)value);
+}
+
+size_t Export_HexScalar(char* out, const byte* in, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        out[2 * i] = hexDigits[in[i] >> 4];
+        out[2 * i + 1] = hexDigits[in[i] & 15];
+    }
+    return 2 * length;
+}
+
+size_t Export_Base64Scalar(char* out, const byte* in, size_t length) {
+    char* p = out;
+    size_t i = 0;
+
+    for (; i + 3 <= length; i += 3) {
+        unsigned int v = ((unsigned int)in[i] << 16) | ((unsigned int)in[i + 1] << 8) | in[i + 2];
+        p[0] = base64Digits[v >> 18];
+        p[1] = base64Digits[(v >> 12) & 63];
+        p[2] = base64Digits[(v >> 6) & 63];
+        p[3] = base64Digits[v & 63];
+        p += 4;
+    }
+    if (i < length) {
+        unsigned int v = (unsigned int)in[i] << 16;
+        if (i + 1 < length) v |= (unsigned int)in[i + 1] << 8;
+        p[0] = base64Digits[v >> 18];
+        p[1] = base64Digits[(v >> 12) & 63];
+        p[2] = i + 1 < length ? base64Digits[(v >> 6) & 63] : '=';
+        p[3] = '=';
+        p += 4;
+    }
+    return (size_t)(p - out);
+}
+
+#ifdef EXPORT_HAVE_X86
+/* 16 bytes -> 32 hex digits: split nibbles, map both through one pshufb
+ * table, interleave high and low */
+__attribute__((target("ssse3")))
+static size_t Export_HexSsse3(char* out, const byte* in, size_t length) {
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                         '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + i));
+        __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, nibble));
+        _mm_storeu_si128((__m128i*)(void*)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)(void*)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return 2 * i + Export_HexScalar(out + 2 * i, in + i, length - i);
+}
+
+/* 12 bytes -> 16 characters per step (Mula's pshufb method): gather each
+ * 3-byte group into a 32-bit lane, split into four 6-bit indices with
+ * multiplies, then add a per-range ASCII offset picked by pshufb. Loads
+ * 16 bytes, so the tail shorter than that goes to the scalar encoder. */
+__attribute__((target("ssse3")))
+static size_t Export_Base64Ssse3(char* out, const byte* in, size_t length) {
+    const __m128i gather = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                          '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; i + 16 <= length; i += 12, o += 16) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(in + i)), gather);
+        __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t0, t1);
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i*)(void*)(out + o), _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range)));
+    }
+    return o + Export_Base64Scalar(out + o, in + i, length - i);
+}
+#endif
+
+flag Export_SimdAvailable(void) {
+#ifdef EXPORT_HAVE_X86
+    return __builtin_cpu_supports("ssse3") ? TRUE : FALSE;
+#else
+    return FALSE;
+#endif
+}
+
+static void Export_SelectEncoders(void) {
+    hexEncode = Export_HexScalar;
+    base64Encode = Export_Base64Scalar;
+#ifdef EXPORT_HAVE_X86
+    if (Export_SimdAvailable()) {
+        hexEncode = Export_HexSsse3;
+        base64Encode = Export_Base64Ssse3;
+    }
+#endif
+}
+
+size_t Export_Hex(char* out, const byte* in, size_t length) {
+    pthread_once(&exportDispatchOnce, Export_SelectEncoders);
+    return hexEncode(out, in, length);
+}
+
+size_t Export_Base64(char* out, const byte* in, size_t length) {
+    pthread_once(&exportDispatchOnce, Export_SelectEncoders);
+    return base64Encode(out, in, length);
+}
+
+size_t Exporter_PoolBytes(void) {
+    return (size_t)EXPORT_CHUNKS * EXPORT_CHUNK_BYTES;
+}
+
+flag Exporter_Flush(Exporter* ex, int* pErrCode) {
+    struct iovec iov[EXPORT_CHUNKS];
+    int count = 0;
+
+    for (int c = 0; c <= ex->chunk; c++) {
+        if (ex->chunkUsed[c] == 0) continue;
+        iov[count].iov_base = ex->chunks[c];
+        iov[count].iov_len = ex->chunkUsed[c];
+        count++;
+    }
+
+    /* Resume after short writes until every chunk is out */
+    int first = 0;
+    while (first < count) {
+        ssize_t n = writev(ex->fd, iov + first, count - first);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            *pErrCode = ERR_EXPORT_IO;
+            return FALSE;
+        }
+        ex->bytes += (unsigned long long)n;
+        while (first < count && (size_t)n >= iov[first].iov_len) {
+            n -= (ssize_t)iov[first].iov_len;
+            first++;
+        }
+        if (first < count) {
+            iov[first].iov_base = (char*)iov[first].iov_base + n;
+            iov[first].iov_len -= (size_t)n;
+        }
+    }
+
+    for (int c = 0; c < EXPORT_CHUNKS; c++) ex->chunkUsed[c] = 0;
+    ex->chunk = 0;
+    return TRUE;
+}
+
+/* Room for one full row, moving to the next chunk (and writing all of
+ * them once the last fills) as needed */
+static char* Export_Reserve(Exporter* ex, int* pErrCode) {
+    if (ex->chunkUsed[ex->chunk] + EXPORT_MAX_ROW_BYTES > EXPORT_CHUNK_BYTES) {
+        if (ex->chunk + 1 < EXPORT_CHUNKS) {
+            ex->chunk++;
+        } else if (!Exporter_Flush(ex, pErrCode)) {
+            return NULL;
+        }
+    }
+    return ex->chunks[ex->chunk] + ex->chunkUsed[ex->chunk];
+}
+
+static void Export_Commit(Exporter* ex, const char* end) {
+    ex->chunkUsed[ex->chunk] = (size_t)(end - ex->chunks[ex->chunk]);
+}
+
+flag Exporter_Open(Exporter* ex, int fd, ExportFormat format, ExportBlocks blocks,
+                   MemPool* pool, int* pErrCode) {
+    char* p;
+
+    memset(ex, 0, sizeof(Exporter));
+    ex->fd = fd;
+    ex->format = format;
+    ex->blocks = blocks;
+    for (int c = 0; c < EXPORT_CHUNKS; c++) {
+        ex->chunks[c] = (char*)MemPool_Alloc(pool, EXPORT_CHUNK_BYTES);
+        if (ex->chunks[c] == NULL) {
+            *pErrCode = ERR_EXPORT_POOL;
+            return FALSE;
+        }
+    }
+    pthread_once(&exportDispatchOnce, Export_SelectEncoders);
+
+    p = ex->chunks[0];
+    if (format == EXPORT_CSV) {
+        EXPORT_LIT(p, "seconds,subseconds,frameType,frameCount,kind,mainBus,payload,comms,"
+                      "temperature,status,instrumentId,dataBlocks,commandId,ackStatus\n");
+    } else if (format == EXPORT_JSON) {
+        EXPORT_LIT(p, "[");
+    }
+    Export_Commit(ex, p);
+    return TRUE;
+}
+
+static char* Export_Blocks(const Exporter* ex, char* p, const T_ScienceData* sci, char separator) {
+    for (int b = 0; b < sci->dataBlocks.nCount; b++) {
+        if (b > 0) *p++ = separator;
+        if (separator == ',') *p++ = '"';
+        p += ex->blocks == EXPORT_BLOCKS_HEX
+             ? hexEncode(p, sci->dataBlocks.arr[b].arr, (size_t)sci->dataBlocks.arr[b].nCount)
+             : base64Encode(p, sci->dataBlocks.arr[b].arr, (size_t)sci->dataBlocks.arr[b].nCount);
+        if (separator == ',') *p++ = '"';
+    }
+    return p;
+}
+
+static char* Export_CsvRow(const Exporter* ex, char* p, const T_TelemetryFrame* f) {
+    const char* kind = kindNames[f->payload.kind & 3];
+
+    p += Export_Uint(p, f->header.timestamp.seconds);
+    *p++ = ',';
+    p += Export_Uint(p, f->header.timestamp.subseconds);
+    *p++ = ',';
+    p += Export_Uint(p, f->header.frameType);
+    *p++ = ',';
+    p += Export_Uint(p, f->header.frameCount);
+    *p++ = ',';
+    memcpy(p, kind, strlen(kind));
+    p += strlen(kind);
+    *p++ = ',';
+
+    if (f->payload.kind == housekeeping_PRESENT) {
+        const T_HousekeepingData* hk = &f->payload.u.housekeeping;
+        p += Export_Uint(p, hk->voltages.mainBus);
+        *p++ = ',';
+        p += Export_Uint(p, hk->voltages.payload);
+        *p++ = ',';
+        p += Export_Uint(p, hk->voltages.comms);
+        *p++ = ',';
+        for (int i = 0; i < hk->temperature.nCount; i++) {
+            if (i > 0) *p++ = ';';
+            p += Export_Sint(p, hk->temperature.arr[i]);
+        }
+        *p++ = ',';
+        p += Export_Uint(p, hk->status);
+        EXPORT_LIT(p, ",,,,\n");
+    } else if (f->payload.kind == science_PRESENT) {
+        EXPORT_LIT(p, ",,,,,");
+        p += Export_Uint(p, f->payload.u.science.instrumentId);
+        *p++ = ',';
+        p = Export_Blocks(ex, p, &f->payload.u.science, ';');
+        EXPORT_LIT(p, ",,\n");
+    } else {
+        const char* status = ackStatusNames[f->payload.u.commandAck.status & 3];
+        EXPORT_LIT(p, ",,,,,,,");
+        p += Export_Uint(p, f->payload.u.commandAck.commandId);
+        *p++ = ',';
+        memcpy(p, status, strlen(status));
+        p += strlen(status);
+        *p++ = '\n';
+    }
+    return p;
+}
+
+static char* Export_JsonObject(const Exporter* ex, char* p, const T_TelemetryFrame* f) {
+    const char* kind = kindNames[f->payload.kind & 3];
+
+    EXPORT_LIT(p, "{\"seconds\":");
+    p += Export_Uint(p, f->header.timestamp.seconds);
+    EXPORT_LIT(p, ",\"subseconds\":");
+    p += Export_Uint(p, f->header.timestamp.subseconds);
+    EXPORT_LIT(p, ",\"frameType\":");
+    p += Export_Uint(p, f->header.frameType);
+    EXPORT_LIT(p, ",\"frameCount\":");
+    p += Export_Uint(p, f->header.frameCount);
+    EXPORT_LIT(p, ",\"kind\":\"");
+    memcpy(p, kind, strlen(kind));
+    p += strlen(kind);
+    *p++ = '"';
+
+    if (f->payload.kind == housekeeping_PRESENT) {
+        const T_HousekeepingData* hk = &f->payload.u.housekeeping;
+        EXPORT_LIT(p, ",\"voltages\":{\"mainBus\":");
+        p += Export_Uint(p, hk->voltages.mainBus);
+        EXPORT_LIT(p, ",\"payload\":");
+        p += Export_Uint(p, hk->voltages.payload);
+        EXPORT_LIT(p, ",\"comms\":");
+        p += Export_Uint(p, hk->voltages.comms);
+        EXPORT_LIT(p, "},\"temperature\":[");
+        for (int i = 0; i < hk->temperature.nCount; i++) {
+            if (i > 0) *p++ = ',';
+            p += Export_Sint(p, hk->temperature.arr[i]);
+        }
+        EXPORT_LIT(p, "],\"status\":");
+        p += Export_Uint(p, hk->status);
+    } else if (f->payload.kind == science_PRESENT) {
+        EXPORT_LIT(p, ",\"instrumentId\":");
+        p += Export_Uint(p, f->payload.u.science.instrumentId);
+        EXPORT_LIT(p, ",\"dataBlocks\":[");
+        p = Export_Blocks(ex, p, &f->payload.u.science, ',');
+        *p++ = ']';
+    } else {
+        const char* status = ackStatusNames[f->payload.u.commandAck.status & 3];
+        EXPORT_LIT(p, ",\"commandId\":");
+        p += Export_Uint(p, f->payload.u.commandAck.commandId);
+        EXPORT_LIT(p, ",\"status\":\"");
+        memcpy(p, status, strlen(status));
+        p += strlen(status);
+        *p++ = '"';
+    }
+    *p++ = '}';
+    return p;
+}
+
+flag Exporter_Write(Exporter* ex, const T_TelemetryFrame* frame, int* pErrCode) {
+    char* p = Export_Reserve(ex, pErrCode);
+
+    if (p == NULL) return FALSE;
+    if (ex->format == EXPORT_CSV) {
+        p = Export_CsvRow(ex, p, frame);
+    } else if (ex->format == EXPORT_NDJSON) {
+        p = Export_JsonObject(ex, p, frame);
+        *p++ = '\n';
+    } else {
+        if (ex->frames > 0) *p++ = ',';
+        *p++ = '\n';
+        p = Export_JsonObject(ex, p, frame);
+    }
+    Export_Commit(ex, p);
+    ex->frames++;
+    return TRUE;
+}
+
+int Exporter_WriteBatch(Exporter* ex, const T_TelemetryFrame* frames, int count, int* pErrCode) {
+    for (int i = 0; i < count; i++) {
+        if (!Exporter_Write(ex, &frames[i], pErrCode)) return i;
+    }
+    return count;
+}
+
+flag Exporter_Close(Exporter* ex, int* pErrCode) {
+    if (ex->format == EXPORT_JSON) {
+        char* p = Export_Reserve(ex, pErrCode);
+        if (p == NULL) return FALSE;
+        EXPORT_LIT(p, "\n]\n");
+        Export_Commit(ex, p);
+    }
+    return Exporter_Flush(ex, pErrCode);
+}
@@ -0,0 +1,77 @@
+/* asn1crt_export.h - Bulk TelemetryFrame export to CSV, JSON and NDJSON */
+#ifndef ASN1CRT_EXPORT_H
+#define ASN1CRT_EXPORT_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* Exporter failures; formatting itself cannot fail */
+#define ERR_EXPORT_IO     1050  /* write(2) failed */
+#define ERR_EXPORT_POOL   1051  /* Pool too small for the output chunks */
+
+/* Output is assembled in EXPORT_CHUNKS chunks and written with one
+ * writev(2) once they are all full */
+#define EXPORT_CHUNK_BYTES (256 * 1024)
+#define EXPORT_CHUNKS      4
+
+/* Upper bound of one serialized frame in any format (4 x 256-byte
+ * blocks as hex plus every scalar at full width) */
+#define EXPORT_MAX_ROW_BYTES 4096
+
+typedef enum {
+    EXPORT_CSV,      /* Header line, one row per frame */
+    EXPORT_JSON,     /* One array of objects */
+    EXPORT_NDJSON    /* One object per line */
+} ExportFormat;
+
+/* Text form of dataBlocks octets */
+typedef enum {
+    EXPORT_BLOCKS_HEX,     /* Lower-case hex */
+    EXPORT_BLOCKS_BASE64   /* RFC 4648 with padding */
+} ExportBlocks;
+
+typedef struct {
+    int fd;                           /* Destination, not closed by the exporter */
+    ExportFormat format;
+    ExportBlocks blocks;
+    char* chunks[EXPORT_CHUNKS];      /* Pool-allocated output chunks */
+    size_t chunkUsed[EXPORT_CHUNKS];
+    int chunk;                        /* Chunk being filled */
+    unsigned long long frames;        /* Frames written */
+    unsigned long long bytes;         /* Bytes handed to the kernel */
+} Exporter;
+
+/* Pool bytes Exporter_Open takes */
+size_t Exporter_PoolBytes(void);
+
+/* Start an export to fd; writes the CSV header or opening bracket */
+flag Exporter_Open(Exporter* ex, int fd, ExportFormat format, ExportBlocks blocks,
+                   MemPool* pool, int* pErrCode);
+
+/* Serialize one decoded frame */
+flag Exporter_Write(Exporter* ex, const T_TelemetryFrame* frame, int* pErrCode);
+
+/* Serialize count frames; returns how many were written before an error */
+int Exporter_WriteBatch(Exporter* ex, const T_TelemetryFrame* frames, int count, int* pErrCode);
+
+/* Write out everything buffered */
+flag Exporter_Flush(Exporter* ex, int* pErrCode);
+
+/* Finish the document (closing bracket for JSON) and flush */
+flag Exporter_Close(Exporter* ex, int* pErrCode);
+
+/* Formatting primitives, usable on their own. Each writes without a
+ * terminating NUL and returns the characters written. */
+int Export_Uint(char* out, unsigned long long value);   /* At most 20 chars */
+int Export_Sint(char* out, long long value);            /* At most 20 chars */
+size_t Export_Hex(char* out, const byte* in, size_t length);          /* 2 * length chars */
+size_t Export_HexScalar(char* out, const byte* in, size_t length);
+size_t Export_Base64(char* out, const byte* in, size_t length);       /* 4 * ceil(length / 3) chars */
+size_t Export_Base64Scalar(char* out, const byte* in, size_t length);
+
+/* TRUE when Export_Hex and Export_Base64 run on SSSE3 */
+flag Export_SimdAvailable(void);
+
+#endif /* ASN1CRT_EXPORT_H */
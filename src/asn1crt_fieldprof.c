@@ -0,0 +1,285 @@
+/* asn1crt_fieldprof.c - Per-field bit and cycle profile of TelemetryFrame decoding */
+#include "asn1crt_fieldprof.h"
+#include "asn1crt_internal.h"
+#include "asn1crt_layout.h"
+#include "asn1crt_encoding.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define FIELDPROF_TICKS() __rdtsc()
+#else
+#define FIELDPROF_TICKS() Asn1crt_NowNs()
+#endif
+
+typedef struct {
+    const char* path;
+    int declaredBits;
+} FieldInfo;
+
+static const FieldInfo fieldInfo[FIELD_COUNT] = {
+    { "header.timestamp.seconds", LAYOUT_SECONDS_BITS },
+    { "header.timestamp.subseconds", LAYOUT_SUBSECONDS_BITS },
+    { "header.frameType", LAYOUT_FRAME_TYPE_BITS },
+    { "header.frameCount", LAYOUT_FRAME_COUNT_BITS },
+    { "payload (choice index)", LAYOUT_CHOICE_BITS },
+    { "payload.housekeeping.voltages.mainBus", LAYOUT_VOLTAGE_BITS },
+    { "payload.housekeeping.voltages.payload", LAYOUT_VOLTAGE_BITS },
+    { "payload.housekeeping.voltages.comms", LAYOUT_VOLTAGE_BITS },
+    { "payload.housekeeping.temperature (length)", LAYOUT_TEMP_COUNT_BITS },
+    { "payload.housekeeping.temperature[i]", LAYOUT_TEMP_BITS },
+    { "payload.housekeeping.status", LAYOUT_STATUS_BITS },
+    { "payload.science.instrumentId", LAYOUT_INSTRUMENT_BITS },
+    { "payload.science.dataBlocks (length)", LAYOUT_BLOCK_COUNT_BITS },
+    { "payload.science.dataBlocks[i] (length)", LAYOUT_BLOCK_LENGTH_BITS },
+    { "payload.science.dataBlocks[i]", 0 },
+    { "payload.commandAck.commandId", LAYOUT_COMMAND_ID_BITS },
+    { "payload.commandAck.status", LAYOUT_ACK_STATUS_BITS }
+};
+
+const char* FieldProfile_Path(FieldId id) {
+    return (id >= 0 && id < FIELD_COUNT) ? fieldInfo[id].path : "unknown";
+}
+
+int FieldProfile_DeclaredBits(FieldId id) {
+    return (id >= 0 && id < FIELD_COUNT) ? fieldInfo[id].declaredBits : 0;
+}
+
+void FieldProfile_Init(FieldProfile* prof) {
+    unsigned long long best = ~0ULL;
+
+    memset(prof, 0, sizeof(FieldProfile));
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        prof->fields[i].minValue = 0x7FFFFFFFFFFFFFFFLL;
+        prof->fields[i].maxValue = -0x7FFFFFFFFFFFFFFFLL - 1;
+    }
+
+    /* Cheapest back-to-back read: what every field measurement carries */
+    for (int i = 0; i < 1000; i++) {
+        unsigned long long t0 = FIELDPROF_TICKS();
+        unsigned long long t1 = FIELDPROF_TICKS();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    prof->timerTicks = best;
+}
+
+static long FieldProf_BitPos(const BitStream* bs) {
+    return bs->currentByte * 8 + bs->currentBit;
+}
+
+static void FieldProf_Account(FieldProfile* prof, FieldId id, long bits,
+                              unsigned long long ticks, long long value) {
+    FieldStats* f = &prof->fields[id];
+
+    f->count++;
+    f->bits += (unsigned long long)bits;
+    f->cycles += ticks > prof->timerTicks ? ticks - prof->timerTicks : 0;
+    if (value < f->minValue) f->minValue = value;
+    if (value > f->maxValue) f->maxValue = value;
+}
+
+/* Constrained unsigned whole number in min..max */
+static flag FieldProf_Uint(FieldProfile* prof, FieldId id, BitStream* bs, asn1SccUint* v,
+                           asn1SccUint min, asn1SccUint max, int* pErrCode) {
+    long start = FieldProf_BitPos(bs);
+    unsigned long long t0 = FIELDPROF_TICKS();
+    flag ok = BitStream_DecodeConstraintPosWholeNumber(bs, v, min, max);
+    unsigned long long t1 = FIELDPROF_TICKS();
+
+    if (!ok) return Asn1crt_Fail(pErrCode, ERR_FIELDPROF_INSUFFICIENT_DATA);
+    if (*v > max) return Asn1crt_Fail(pErrCode, ERR_FIELDPROF_RANGE);
+    FieldProf_Account(prof, id, FieldProf_BitPos(bs) - start, t1 - t0, (long long)*v);
+    return TRUE;
+}
+
+/* Constrained signed whole number in min..max */
+static flag FieldProf_Sint(FieldProfile* prof, FieldId id, BitStream* bs, asn1SccSint* v,
+                           asn1SccSint min, asn1SccSint max, int* pErrCode) {
+    long start = FieldProf_BitPos(bs);
+    unsigned long long t0 = FIELDPROF_TICKS();
+    flag ok = BitStream_DecodeConstraintWholeNumber(bs, v, min, max);
+    unsigned long long t1 = FIELDPROF_TICKS();
+
+    if (!ok) return Asn1crt_Fail(pErrCode, ERR_FIELDPROF_INSUFFICIENT_DATA);
+    if (*v > max) return Asn1crt_Fail(pErrCode, ERR_FIELDPROF_RANGE);
+    FieldProf_Account(prof, id, FieldProf_BitPos(bs) - start, t1 - t0, (long long)*v);
+    return TRUE;
+}
+
+static flag FieldProf_Housekeeping(FieldProfile* prof, T_HousekeepingData* hk, BitStream* bs, int* pErrCode) {
+    asn1SccSint count;
+
+    if (!FieldProf_Uint(prof, FIELD_HK_MAIN_BUS, bs, &hk->voltages.mainBus, 0, LAYOUT_VOLTAGE_MAX, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_HK_PAYLOAD, bs, &hk->voltages.payload, 0, LAYOUT_VOLTAGE_MAX, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_HK_COMMS, bs, &hk->voltages.comms, 0, LAYOUT_VOLTAGE_MAX, pErrCode) ||
+        !FieldProf_Sint(prof, FIELD_HK_TEMP_COUNT, bs, &count,
+                        LAYOUT_TEMP_COUNT_MIN, LAYOUT_TEMP_COUNT_MAX, pErrCode)) {
+        return FALSE;
+    }
+    hk->temperature.nCount = (int)count;
+    for (int i = 0; i < hk->temperature.nCount; i++) {
+        if (!FieldProf_Sint(prof, FIELD_HK_TEMP, bs, &hk->temperature.arr[i],
+                            LAYOUT_TEMP_MIN, LAYOUT_TEMP_MAX, pErrCode)) {
+            return FALSE;
+        }
+    }
+    return FieldProf_Uint(prof, FIELD_HK_STATUS, bs, &hk->status, 0, 255, pErrCode);
+}
+
+static flag FieldProf_Science(FieldProfile* prof, T_ScienceData* sci, BitStream* bs, int* pErrCode) {
+    asn1SccSint count;
+
+    if (!FieldProf_Uint(prof, FIELD_SCI_INSTRUMENT, bs, &sci->instrumentId, 0, 255, pErrCode) ||
+        !FieldProf_Sint(prof, FIELD_SCI_BLOCK_COUNT, bs, &count,
+                        LAYOUT_BLOCK_COUNT_MIN, LAYOUT_BLOCK_COUNT_MAX, pErrCode)) {
+        return FALSE;
+    }
+    sci->dataBlocks.nCount = (int)count;
+    for (int b = 0; b < sci->dataBlocks.nCount; b++) {
+        asn1SccSint length;
+        long start;
+        unsigned long long t0, t1;
+        flag ok;
+
+        if (!FieldProf_Sint(prof, FIELD_SCI_BLOCK_LENGTH, bs, &length,
+                            LAYOUT_BLOCK_LENGTH_MIN, LAYOUT_BLOCK_LENGTH_MAX, pErrCode)) {
+            return FALSE;
+        }
+        sci->dataBlocks.arr[b].nCount = (int)length;
+
+        start = FieldProf_BitPos(bs);
+        t0 = FIELDPROF_TICKS();
+        ok = BitStream_ReadBits(bs, sci->dataBlocks.arr[b].arr, (int)length * 8);
+        t1 = FIELDPROF_TICKS();
+        if (!ok) return Asn1crt_Fail(pErrCode, ERR_FIELDPROF_INSUFFICIENT_DATA);
+        FieldProf_Account(prof, FIELD_SCI_BLOCK_DATA, FieldProf_BitPos(bs) - start, t1 - t0, length);
+    }
+    return TRUE;
+}
+
+static flag FieldProf_CommandAck(FieldProfile* prof, T_CommandAck* ack, BitStream* bs, int* pErrCode) {
+    asn1SccUint status;
+
+    if (!FieldProf_Uint(prof, FIELD_ACK_COMMAND_ID, bs, &ack->commandId, 0, 65535, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_ACK_STATUS, bs, &status, 0, LAYOUT_ACK_STATUS_MAX, pErrCode)) {
+        return FALSE;
+    }
+    /* Enumerants are declared 0..3, so the index is the value */
+    ack->status = (T_CommandAck_status)status;
+    return TRUE;
+}
+
+static flag FieldProf_Frame(FieldProfile* prof, T_TelemetryFrame* pVal, BitStream* bs, int* pErrCode) {
+    asn1SccUint choice;
+
+    if (!FieldProf_Uint(prof, FIELD_SECONDS, bs, &pVal->header.timestamp.seconds, 0, 4294967295ULL, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_SUBSECONDS, bs, &pVal->header.timestamp.subseconds,
+                        0, LAYOUT_SUBSECONDS_MAX, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_FRAME_TYPE, bs, &pVal->header.frameType, 0, 255, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_FRAME_COUNT, bs, &pVal->header.frameCount, 0, 65535, pErrCode) ||
+        !FieldProf_Uint(prof, FIELD_PAYLOAD_CHOICE, bs, &choice, 0, 2, pErrCode)) {
+        return FALSE;
+    }
+
+    switch (choice) {
+    case 0:
+        pVal->payload.kind = housekeeping_PRESENT;
+        return FieldProf_Housekeeping(prof, &pVal->payload.u.housekeeping, bs, pErrCode);
+    case 1:
+        pVal->payload.kind = science_PRESENT;
+        return FieldProf_Science(prof, &pVal->payload.u.science, bs, pErrCode);
+    default:
+        pVal->payload.kind = commandAck_PRESENT;
+        return FieldProf_CommandAck(prof, &pVal->payload.u.commandAck, bs, pErrCode);
+    }
+}
+
+flag FieldProfile_Decode(FieldProfile* prof, T_TelemetryFrame* pVal, BitStream* pBitStrm, int* pErrCode) {
+    FieldStats saved[FIELD_COUNT];
+    long start = FieldProf_BitPos(pBitStrm);
+    unsigned long long t0, t1;
+    flag ok;
+
+    /* A rejected frame must not leave half its fields in the totals */
+    memcpy(saved, prof->fields, sizeof(saved));
+    t0 = FIELDPROF_TICKS();
+    ok = FieldProf_Frame(prof, pVal, pBitStrm, pErrCode);
+    t1 = FIELDPROF_TICKS();
+
+    if (!ok) {
+        memcpy(prof->fields, saved, sizeof(saved));
+        prof->failures++;
+        return FALSE;
+    }
+    prof->frames++;
+    /* Frames are padded to whole bytes by the encoder */
+    prof->frameBits += (unsigned long long)((FieldProf_BitPos(pBitStrm) - start + 7) & ~7L);
+    prof->frameCycles += t1 - t0;
+    return TRUE;
+}
+
+/* Bits a constrained integer needs for values lo..hi */
+static int FieldProf_BitsFor(long long lo, long long hi) {
+    unsigned long long span = (unsigned long long)(hi - lo);
+    int bits = 0;
+    while (span > 0) {
+        bits++;
+        span >>= 1;
+    }
+    return bits;
+}
+
+static FieldSortKey reportSort;
+static const FieldProfile* reportProfile;
+
+static int FieldProf_Compare(const void* a, const void* b) {
+    const FieldStats* x = &reportProfile->fields[*(const int*)a];
+    const FieldStats* y = &reportProfile->fields[*(const int*)b];
+    unsigned long long vx = reportSort == FIELD_SORT_CYCLES ? x->cycles : x->bits;
+    unsigned long long vy = reportSort == FIELD_SORT_CYCLES ? y->cycles : y->bits;
+    return (vx < vy) - (vx > vy);
+}
+
+void FieldProfile_Report(FILE* out, const FieldProfile* prof, FieldSortKey sortBy) {
+    int order[FIELD_COUNT];
+    unsigned long long fieldBits = 0;
+    unsigned long long fieldCycles = 0;
+
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        order[i] = i;
+        fieldBits += prof->fields[i].bits;
+        fieldCycles += prof->fields[i].cycles;
+    }
+    reportSort = sortBy;
+    reportProfile = prof;
+    qsort(order, FIELD_COUNT, sizeof(int), FieldProf_Compare);
+
+    fprintf(out, "Frames: %llu (%llu rejected), %.1f bytes/frame, %.0f ticks/frame\n",
+            prof->frames, prof->failures,
+            prof->frames > 0 ? (double)prof->frameBits / 8.0 / prof->frames : 0.0,
+            prof->frames > 0 ? (double)prof->frameCycles / prof->frames : 0.0);
+    fprintf(out, "Padding: %.2f%% of bits; timer overhead %llu ticks removed per field\n\n",
+            prof->frameBits > 0 ? 100.0 * (double)(prof->frameBits - fieldBits) / prof->frameBits : 0.0,
+            prof->timerTicks);
+    fprintf(out, "%-44s %10s %7s %7s %7s %7s %24s %9s\n", "field", "count", "bits%", "cyc%",
+            "bits", "ticks", "observed", "need/has");
+
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        const FieldStats* f = &prof->fields[order[i]];
+        int declared = fieldInfo[order[i]].declaredBits;
+        char range[48] = "-";
+        char need[24] = "-";
+
+        if (f->count == 0) continue;
+        snprintf(range, sizeof(range), "%lld..%lld", f->minValue, f->maxValue);
+        if (declared > 0) {
+            snprintf(need, sizeof(need), "%d/%d", FieldProf_BitsFor(f->minValue, f->maxValue), declared);
+        }
+        fprintf(out, "%-44s %10llu %6.2f%% %6.2f%% %7.1f %7.1f %24s %9s\n",
+                fieldInfo[order[i]].path, f->count,
+                fieldBits > 0 ? 100.0 * f->bits / fieldBits : 0.0,
+                fieldCycles > 0 ? 100.0 * f->cycles / fieldCycles : 0.0,
+                (double)f->bits / f->count, (double)f->cycles / f->count, range, need);
+    }
+}
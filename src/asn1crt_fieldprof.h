@@ -0,0 +1,78 @@
+/* asn1crt_fieldprof.h - Per-field bit and cycle profile of TelemetryFrame decoding */
+#ifndef ASN1CRT_FIELDPROF_H
+#define ASN1CRT_FIELDPROF_H
+
+#include <stdio.h>
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* Profiling decoder failures, mirroring the generated decoder's checks */
+#define ERR_FIELDPROF_INSUFFICIENT_DATA 1030  /* Stream ended inside a field */
+#define ERR_FIELDPROF_RANGE             1031  /* Decoded value outside its constraint */
+
+/* Schema field paths; array elements are aggregated under [i] */
+typedef enum {
+    FIELD_SECONDS,
+    FIELD_SUBSECONDS,
+    FIELD_FRAME_TYPE,
+    FIELD_FRAME_COUNT,
+    FIELD_PAYLOAD_CHOICE,
+    FIELD_HK_MAIN_BUS,
+    FIELD_HK_PAYLOAD,
+    FIELD_HK_COMMS,
+    FIELD_HK_TEMP_COUNT,
+    FIELD_HK_TEMP,
+    FIELD_HK_STATUS,
+    FIELD_SCI_INSTRUMENT,
+    FIELD_SCI_BLOCK_COUNT,
+    FIELD_SCI_BLOCK_LENGTH,
+    FIELD_SCI_BLOCK_DATA,
+    FIELD_ACK_COMMAND_ID,
+    FIELD_ACK_STATUS,
+    FIELD_COUNT
+} FieldId;
+
+/* Ranking order for FieldProfile_Report */
+typedef enum {
+    FIELD_SORT_BITS,
+    FIELD_SORT_CYCLES
+} FieldSortKey;
+
+/* Totals for one field path */
+typedef struct {
+    unsigned long long count;     /* Times the field was decoded */
+    unsigned long long bits;      /* Bits consumed */
+    unsigned long long cycles;    /* Ticks spent, timer overhead removed */
+    long long minValue;           /* Observed range (integers and lengths) */
+    long long maxValue;
+} FieldStats;
+
+/* Accumulated over every frame passed to FieldProfile_Decode */
+typedef struct {
+    FieldStats fields[FIELD_COUNT];
+    unsigned long long frames;      /* Frames decoded */
+    unsigned long long failures;    /* Frames rejected */
+    unsigned long long frameBits;   /* Bits including final byte padding */
+    unsigned long long frameCycles; /* Ticks for whole frames */
+    unsigned long long timerTicks;  /* Cost of one timer read pair, subtracted per field */
+} FieldProfile;
+
+/* Reset counters and measure timer overhead */
+void FieldProfile_Init(FieldProfile* prof);
+
+/* Decode like T_TelemetryFrame_Decode while timing each field. Field
+ * widths come from asn1crt_layout.h, so results must match the
+ * generated decoder bit for bit. */
+flag FieldProfile_Decode(FieldProfile* prof, T_TelemetryFrame* pVal, BitStream* pBitStrm, int* pErrCode);
+
+/* Dotted schema path of a field */
+const char* FieldProfile_Path(FieldId id);
+
+/* Bits the schema gives a field per occurrence (0 for variable-size data) */
+int FieldProfile_DeclaredBits(FieldId id);
+
+/* Ranked table: share of bits and cycles, observed range and the bits
+ * that range would need */
+void FieldProfile_Report(FILE* out, const FieldProfile* prof, FieldSortKey sortBy);
+
+#endif /* ASN1CRT_FIELDPROF_H */
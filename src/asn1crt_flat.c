@@ -0,0 +1,403 @@
+/* asn1crt_flat.c - Fixed-layout random-access TelemetryFrame encoding */
+#include "asn1crt_flat.h"
+#include "asn1crt_internal.h"
+#include "asn1crt_layout.h"
+#include <string.h>
+
+/* uPER bits of a ScienceData frame before the first block length */
+#define FLAT_UPER_SCIENCE_BITS  (LAYOUT_PAYLOAD_OFFSET + LAYOUT_INSTRUMENT_BITS + LAYOUT_BLOCK_COUNT_BITS)
+
+static int Flat_Align(int bytes) {
+    return (bytes + FLAT_ALIGN - 1) & ~(FLAT_ALIGN - 1);
+}
+
+static void Flat_Put16(byte* f, int offset, unsigned int value) {
+    f[offset] = (byte)value;
+    f[offset + 1] = (byte)(value >> 8);
+}
+
+static void Flat_Put32(byte* f, int offset, unsigned int value) {
+    Flat_Put16(f, offset, value & 0xFFFF);
+    Flat_Put16(f, offset + 2, value >> 16);
+}
+
+static void Flat_PutHeader(byte* f, int size, int kind, unsigned int seconds, unsigned int subseconds,
+                           unsigned int frameType, unsigned int frameCount) {
+    Flat_Put16(f, 0, (unsigned int)size);
+    f[2] = FLAT_VERSION;
+    f[3] = (byte)kind;
+    Flat_Put32(f, 4, seconds);
+    Flat_Put16(f, 8, subseconds);
+    f[10] = (byte)frameType;
+    Flat_Put16(f, 12, frameCount);
+}
+
+/* n <= 32 bits, MSB first, starting at bitOffset; the caller has checked
+ * the bits lie inside the buffer */
+static unsigned int Flat_GetBits(const byte* buf, int bitOffset, int n) {
+    int first = bitOffset >> 3;
+    int last = (bitOffset + n - 1) >> 3;
+    unsigned long long window = 0;
+
+    for (int i = first; i <= last; i++) window = window << 8 | buf[i];
+    window >>= (last + 1) * 8 - (bitOffset + n);
+    return (unsigned int)(window & ((1ULL << n) - 1));
+}
+
+static unsigned long long Flat_LoadBe64(const byte* p) {
+    unsigned long long v;
+    memcpy(&v, p, 8);
+    return __builtin_bswap64(v);
+}
+
+static void Flat_StoreBe64(byte* p, unsigned long long v) {
+    v = __builtin_bswap64(v);
+    memcpy(p, &v, 8);
+}
+
+/* count octets starting at an arbitrary bit offset, 8 at a time */
+static void Flat_ReadOctets(byte* dst, const byte* buf, int bitOffset, int count) {
+    const byte* p = buf + (bitOffset >> 3);
+    int shift = bitOffset & 7;
+    int i = 0;
+
+    if (shift == 0) {
+        memcpy(dst, p, (size_t)count);
+        return;
+    }
+    for (; i + 8 < count; i += 8) {
+        Flat_StoreBe64(dst + i, Flat_LoadBe64(p + i) << shift | p[i + 8] >> (8 - shift));
+    }
+    for (; i < count; i++) {
+        dst[i] = (byte)(p[i] << shift | p[i + 1] >> (8 - shift));
+    }
+}
+
+/* MSB-first writer over a zeroed buffer */
+typedef struct {
+    byte* buf;
+    int bit;
+} FlatBitWriter;
+
+static void Flat_PutBits(FlatBitWriter* w, unsigned int value, int n) {
+    byte* p = w->buf + (w->bit >> 3);
+    int shift = w->bit & 7;
+    unsigned long long v = (unsigned long long)value << (64 - n - shift);
+    int touched = (shift + n + 7) >> 3;
+
+    for (int k = 0; k < touched; k++) p[k] |= (byte)(v >> (56 - 8 * k));
+    w->bit += n;
+}
+
+/* Counterpart of Flat_ReadOctets; carry holds the bits bound for the top
+ * of the next output byte, starting with what is already there */
+static void Flat_PutOctets(FlatBitWriter* w, const byte* src, int count) {
+    byte* p = w->buf + (w->bit >> 3);
+    int shift = w->bit & 7;
+    int i = 0;
+
+    w->bit += count * 8;
+    if (shift == 0) {
+        memcpy(p, src, (size_t)count);
+        return;
+    }
+    unsigned long long carry = (unsigned long long)(p[0] >> (8 - shift)) << (64 - shift);
+    for (; i + 8 <= count; i += 8) {
+        unsigned long long v = Flat_LoadBe64(src + i);
+        Flat_StoreBe64(p + i, carry | v >> shift);
+        carry = v << (64 - shift);
+    }
+    for (; i < count; i++) {
+        p[i] = (byte)(carry >> 56 | src[i] >> shift);
+        carry = (unsigned long long)(byte)(src[i] << (8 - shift)) << 56;
+    }
+    p[count] = (byte)(carry >> 56);
+}
+
+flag Flat_Verify(const byte* buf, int length, int* frameBytes, int* pErrCode) {
+    int size;
+
+    if (length < FLAT_HEADER_BYTES) return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+    size = Flat_Size(buf);
+    if (size > length) return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+    if (buf[2] != FLAT_VERSION || size < FLAT_HEADER_BYTES || size % FLAT_ALIGN != 0 ||
+        Flat_Subseconds(buf) > LAYOUT_SUBSECONDS_MAX) {
+        return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+    }
+
+    switch (Flat_Kind(buf)) {
+    case housekeeping_PRESENT: {
+        int count = Flat_TemperatureCount(buf);
+        if (size != FLAT_HOUSEKEEPING_BYTES || Flat_MainBus(buf) > LAYOUT_VOLTAGE_MAX ||
+            Flat_PayloadVoltage(buf) > LAYOUT_VOLTAGE_MAX || Flat_Comms(buf) > LAYOUT_VOLTAGE_MAX ||
+            count < LAYOUT_TEMP_COUNT_MIN || count > LAYOUT_TEMP_COUNT_MAX) {
+            return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+        }
+        for (int i = 0; i < count; i++) {
+            int t = Flat_Temperature(buf, i);
+            if (t < LAYOUT_TEMP_MIN || t > LAYOUT_TEMP_MAX) return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+        }
+        break;
+    }
+    case science_PRESENT: {
+        int count = Flat_BlockCount(buf);
+        if (size < FLAT_BLOCK_DATA_OFFSET || count < LAYOUT_BLOCK_COUNT_MIN || count > LAYOUT_BLOCK_COUNT_MAX) {
+            return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+        }
+        for (int i = 0; i < count; i++) {
+            int offset = (int)Flat_U16(buf, FLAT_BLOCK_TABLE_OFFSET + 4 * i);
+            int n = Flat_BlockLength(buf, i);
+            if (n < LAYOUT_BLOCK_LENGTH_MIN || n > LAYOUT_BLOCK_LENGTH_MAX ||
+                offset < FLAT_BLOCK_DATA_OFFSET || offset + n > size) {
+                return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+            }
+        }
+        break;
+    }
+    case commandAck_PRESENT:
+        if (size != FLAT_COMMAND_ACK_BYTES || buf[18] > LAYOUT_ACK_STATUS_MAX) {
+            return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+        }
+        break;
+    default:
+        return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+    }
+
+    *frameBytes = size;
+    return TRUE;
+}
+
+int Flat_SizeOf(const T_TelemetryFrame* pVal) {
+    if (pVal->payload.kind == housekeeping_PRESENT) return FLAT_HOUSEKEEPING_BYTES;
+    if (pVal->payload.kind == commandAck_PRESENT) return FLAT_COMMAND_ACK_BYTES;
+
+    int bytes = FLAT_BLOCK_DATA_OFFSET;
+    for (int b = 0; b < pVal->payload.u.science.dataBlocks.nCount; b++) {
+        bytes += pVal->payload.u.science.dataBlocks.arr[b].nCount;
+    }
+    return Flat_Align(bytes);
+}
+
+flag Flat_FromFrame(const T_TelemetryFrame* pVal, byte* out, int capacity, int* written, int* pErrCode) {
+    int size;
+
+    if (!T_TelemetryFrame_IsConstraintValid(pVal, pErrCode)) return FALSE;
+    size = Flat_SizeOf(pVal);
+    if (size > capacity) return Asn1crt_Fail(pErrCode, ERR_FLAT_CAPACITY);
+
+    memset(out, 0, (size_t)size);
+    Flat_PutHeader(out, size, pVal->payload.kind, (unsigned int)pVal->header.timestamp.seconds,
+                   (unsigned int)pVal->header.timestamp.subseconds, (unsigned int)pVal->header.frameType,
+                   (unsigned int)pVal->header.frameCount);
+
+    if (pVal->payload.kind == housekeeping_PRESENT) {
+        const T_HousekeepingData* hk = &pVal->payload.u.housekeeping;
+        Flat_Put16(out, 16, (unsigned int)hk->voltages.mainBus);
+        Flat_Put16(out, 18, (unsigned int)hk->voltages.payload);
+        Flat_Put16(out, 20, (unsigned int)hk->voltages.comms);
+        out[22] = (byte)hk->status;
+        out[23] = (byte)hk->temperature.nCount;
+        for (int i = 0; i < hk->temperature.nCount; i++) out[24 + i] = (byte)(signed char)hk->temperature.arr[i];
+    } else if (pVal->payload.kind == science_PRESENT) {
+        const T_ScienceData* sci = &pVal->payload.u.science;
+        int offset = FLAT_BLOCK_DATA_OFFSET;
+        out[16] = (byte)sci->instrumentId;
+        out[17] = (byte)sci->dataBlocks.nCount;
+        for (int b = 0; b < sci->dataBlocks.nCount; b++) {
+            int n = sci->dataBlocks.arr[b].nCount;
+            Flat_Put16(out, FLAT_BLOCK_TABLE_OFFSET + 4 * b, (unsigned int)offset);
+            Flat_Put16(out, FLAT_BLOCK_TABLE_OFFSET + 4 * b + 2, (unsigned int)n);
+            memcpy(out + offset, sci->dataBlocks.arr[b].arr, (size_t)n);
+            offset += n;
+        }
+    } else {
+        Flat_Put16(out, 16, (unsigned int)pVal->payload.u.commandAck.commandId);
+        out[18] = (byte)pVal->payload.u.commandAck.status;
+    }
+
+    *written = size;
+    return TRUE;
+}
+
+flag Flat_ToFrame(const byte* buf, int length, T_TelemetryFrame* pVal, int* pErrCode) {
+    int size;
+
+    if (!Flat_Verify(buf, length, &size, pErrCode)) return FALSE;
+
+    pVal->header.timestamp.seconds = Flat_Seconds(buf);
+    pVal->header.timestamp.subseconds = Flat_Subseconds(buf);
+    pVal->header.frameType = Flat_FrameType(buf);
+    pVal->header.frameCount = Flat_FrameCount(buf);
+    pVal->payload.kind = (T_TelemetryPayload_selection)Flat_Kind(buf);
+
+    if (pVal->payload.kind == housekeeping_PRESENT) {
+        T_HousekeepingData* hk = &pVal->payload.u.housekeeping;
+        hk->voltages.mainBus = Flat_MainBus(buf);
+        hk->voltages.payload = Flat_PayloadVoltage(buf);
+        hk->voltages.comms = Flat_Comms(buf);
+        hk->temperature.nCount = Flat_TemperatureCount(buf);
+        for (int i = 0; i < hk->temperature.nCount; i++) hk->temperature.arr[i] = Flat_Temperature(buf, i);
+        hk->status = Flat_Status(buf);
+    } else if (pVal->payload.kind == science_PRESENT) {
+        T_ScienceData* sci = &pVal->payload.u.science;
+        sci->instrumentId = Flat_InstrumentId(buf);
+        sci->dataBlocks.nCount = Flat_BlockCount(buf);
+        for (int b = 0; b < sci->dataBlocks.nCount; b++) {
+            sci->dataBlocks.arr[b].nCount = Flat_BlockLength(buf, b);
+            memcpy(sci->dataBlocks.arr[b].arr, Flat_Block(buf, b), (size_t)sci->dataBlocks.arr[b].nCount);
+        }
+    } else {
+        pVal->payload.u.commandAck.commandId = Flat_CommandId(buf);
+        pVal->payload.u.commandAck.status = Flat_AckStatus(buf);
+    }
+    return TRUE;
+}
+
+flag Flat_FromUper(const byte* uper, int length, byte* out, int capacity,
+                   int* uperBytes, int* written, int* pErrCode) {
+    int bits = length * 8;
+    int pos = LAYOUT_PAYLOAD_OFFSET;
+    int size;
+    unsigned int choice, subseconds;
+
+    if (bits < LAYOUT_PAYLOAD_OFFSET) return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+    choice = Flat_GetBits(uper, LAYOUT_CHOICE_OFFSET, LAYOUT_CHOICE_BITS);
+    subseconds = Flat_GetBits(uper, LAYOUT_SUBSECONDS_OFFSET, LAYOUT_SUBSECONDS_BITS);
+    if (choice > 2 || subseconds > LAYOUT_SUBSECONDS_MAX) return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+
+    if (choice + 1 == housekeeping_PRESENT) {
+        unsigned int volts[3];
+        int count;
+        if (pos + 3 * LAYOUT_VOLTAGE_BITS + LAYOUT_TEMP_COUNT_BITS > bits) {
+            return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+        }
+        for (int v = 0; v < 3; v++) {
+            volts[v] = Flat_GetBits(uper, pos, LAYOUT_VOLTAGE_BITS);
+            if (volts[v] > LAYOUT_VOLTAGE_MAX) return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+            pos += LAYOUT_VOLTAGE_BITS;
+        }
+        count = (int)Flat_GetBits(uper, pos, LAYOUT_TEMP_COUNT_BITS) + LAYOUT_TEMP_COUNT_MIN;
+        pos += LAYOUT_TEMP_COUNT_BITS;
+        if (pos + count * LAYOUT_TEMP_BITS + LAYOUT_STATUS_BITS > bits) {
+            return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+        }
+        size = FLAT_HOUSEKEEPING_BYTES;
+        if (size > capacity) return Asn1crt_Fail(pErrCode, ERR_FLAT_CAPACITY);
+
+        memset(out, 0, (size_t)size);
+        for (int i = 0; i < count; i++) {
+            int t = (int)Flat_GetBits(uper, pos, LAYOUT_TEMP_BITS) + LAYOUT_TEMP_MIN;
+            if (t > LAYOUT_TEMP_MAX) return Asn1crt_Fail(pErrCode, ERR_FLAT_MALFORMED);
+            out[24 + i] = (byte)(signed char)t;
+            pos += LAYOUT_TEMP_BITS;
+        }
+        Flat_Put16(out, 16, volts[0]);
+        Flat_Put16(out, 18, volts[1]);
+        Flat_Put16(out, 20, volts[2]);
+        out[22] = (byte)Flat_GetBits(uper, pos, LAYOUT_STATUS_BITS);
+        out[23] = (byte)count;
+        pos += LAYOUT_STATUS_BITS;
+    } else if (choice + 1 == science_PRESENT) {
+        int count, offsets[FLAT_MAX_BLOCKS], lengths[FLAT_MAX_BLOCKS];
+        int dataBytes = 0;
+        if (FLAT_UPER_SCIENCE_BITS > bits) return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+        count = (int)Flat_GetBits(uper, pos + LAYOUT_INSTRUMENT_BITS, LAYOUT_BLOCK_COUNT_BITS) + LAYOUT_BLOCK_COUNT_MIN;
+
+        // Walk the length prefixes first so the output size is known before writing
+        pos = FLAT_UPER_SCIENCE_BITS;
+        for (int b = 0; b < count; b++) {
+            if (pos + LAYOUT_BLOCK_LENGTH_BITS > bits) return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+            lengths[b] = (int)Flat_GetBits(uper, pos, LAYOUT_BLOCK_LENGTH_BITS) + LAYOUT_BLOCK_LENGTH_MIN;
+            offsets[b] = pos + LAYOUT_BLOCK_LENGTH_BITS;
+            pos = offsets[b] + lengths[b] * 8;
+            dataBytes += lengths[b];
+        }
+        if (pos > bits) return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+        size = Flat_Align(FLAT_BLOCK_DATA_OFFSET + dataBytes);
+        if (size > capacity) return Asn1crt_Fail(pErrCode, ERR_FLAT_CAPACITY);
+
+        memset(out, 0, FLAT_BLOCK_DATA_OFFSET);
+        out[16] = (byte)Flat_GetBits(uper, LAYOUT_PAYLOAD_OFFSET, LAYOUT_INSTRUMENT_BITS);
+        out[17] = (byte)count;
+        int offset = FLAT_BLOCK_DATA_OFFSET;
+        for (int b = 0; b < count; b++) {
+            Flat_Put16(out, FLAT_BLOCK_TABLE_OFFSET + 4 * b, (unsigned int)offset);
+            Flat_Put16(out, FLAT_BLOCK_TABLE_OFFSET + 4 * b + 2, (unsigned int)lengths[b]);
+            Flat_ReadOctets(out + offset, uper, offsets[b], lengths[b]);
+            offset += lengths[b];
+        }
+        memset(out + offset, 0, (size_t)(size - offset));
+    } else {
+        if (pos + LAYOUT_COMMAND_ID_BITS + LAYOUT_ACK_STATUS_BITS > bits) {
+            return Asn1crt_Fail(pErrCode, ERR_FLAT_INSUFFICIENT_DATA);
+        }
+        size = FLAT_COMMAND_ACK_BYTES;
+        if (size > capacity) return Asn1crt_Fail(pErrCode, ERR_FLAT_CAPACITY);
+
+        memset(out, 0, (size_t)size);
+        Flat_Put16(out, 16, Flat_GetBits(uper, pos, LAYOUT_COMMAND_ID_BITS));
+        out[18] = (byte)Flat_GetBits(uper, pos + LAYOUT_COMMAND_ID_BITS, LAYOUT_ACK_STATUS_BITS);
+        pos += LAYOUT_COMMAND_ID_BITS + LAYOUT_ACK_STATUS_BITS;
+    }
+
+    Flat_PutHeader(out, size, (int)choice + 1, Flat_GetBits(uper, LAYOUT_SECONDS_OFFSET, LAYOUT_SECONDS_BITS),
+                   subseconds, Flat_GetBits(uper, LAYOUT_FRAME_TYPE_OFFSET, LAYOUT_FRAME_TYPE_BITS),
+                   Flat_GetBits(uper, LAYOUT_FRAME_COUNT_OFFSET, LAYOUT_FRAME_COUNT_BITS));
+    *uperBytes = (pos + 7) / 8;
+    *written = size;
+    return TRUE;
+}
+
+flag Flat_ToUper(const byte* flat, int length, byte* out, int capacity, int* written, int* pErrCode) {
+    FlatBitWriter w;
+    int size, bits, kind;
+
+    if (!Flat_Verify(flat, length, &size, pErrCode)) return FALSE;
+    kind = Flat_Kind(flat);
+
+    bits = LAYOUT_PAYLOAD_OFFSET;
+    if (kind == housekeeping_PRESENT) {
+        bits += 3 * LAYOUT_VOLTAGE_BITS + LAYOUT_TEMP_COUNT_BITS +
+                Flat_TemperatureCount(flat) * LAYOUT_TEMP_BITS + LAYOUT_STATUS_BITS;
+    } else if (kind == science_PRESENT) {
+        bits = FLAT_UPER_SCIENCE_BITS;
+        for (int b = 0; b < Flat_BlockCount(flat); b++) bits += LAYOUT_BLOCK_LENGTH_BITS + Flat_BlockLength(flat, b) * 8;
+    } else {
+        bits += LAYOUT_COMMAND_ID_BITS + LAYOUT_ACK_STATUS_BITS;
+    }
+    if ((bits + 7) / 8 > capacity) return Asn1crt_Fail(pErrCode, ERR_FLAT_CAPACITY);
+
+    memset(out, 0, (size_t)((bits + 7) / 8));
+    w.buf = out;
+    w.bit = 0;
+    Flat_PutBits(&w, Flat_Seconds(flat), LAYOUT_SECONDS_BITS);
+    Flat_PutBits(&w, Flat_Subseconds(flat), LAYOUT_SUBSECONDS_BITS);
+    Flat_PutBits(&w, Flat_FrameType(flat), LAYOUT_FRAME_TYPE_BITS);
+    Flat_PutBits(&w, Flat_FrameCount(flat), LAYOUT_FRAME_COUNT_BITS);
+    Flat_PutBits(&w, (unsigned int)(kind - 1), LAYOUT_CHOICE_BITS);
+
+    if (kind == housekeeping_PRESENT) {
+        Flat_PutBits(&w, Flat_MainBus(flat), LAYOUT_VOLTAGE_BITS);
+        Flat_PutBits(&w, Flat_PayloadVoltage(flat), LAYOUT_VOLTAGE_BITS);
+        Flat_PutBits(&w, Flat_Comms(flat), LAYOUT_VOLTAGE_BITS);
+        Flat_PutBits(&w, (unsigned int)(Flat_TemperatureCount(flat) - LAYOUT_TEMP_COUNT_MIN), LAYOUT_TEMP_COUNT_BITS);
+        for (int i = 0; i < Flat_TemperatureCount(flat); i++) {
+            Flat_PutBits(&w, (unsigned int)(Flat_Temperature(flat, i) - LAYOUT_TEMP_MIN), LAYOUT_TEMP_BITS);
+        }
+        Flat_PutBits(&w, Flat_Status(flat), LAYOUT_STATUS_BITS);
+    } else if (kind == science_PRESENT) {
+        Flat_PutBits(&w, Flat_InstrumentId(flat), LAYOUT_INSTRUMENT_BITS);
+        Flat_PutBits(&w, (unsigned int)(Flat_BlockCount(flat) - LAYOUT_BLOCK_COUNT_MIN), LAYOUT_BLOCK_COUNT_BITS);
+        for (int b = 0; b < Flat_BlockCount(flat); b++) {
+            int n = Flat_BlockLength(flat, b);
+            Flat_PutBits(&w, (unsigned int)(n - LAYOUT_BLOCK_LENGTH_MIN), LAYOUT_BLOCK_LENGTH_BITS);
+            Flat_PutOctets(&w, Flat_Block(flat, b), n);
+        }
+    } else {
+        Flat_PutBits(&w, Flat_CommandId(flat), LAYOUT_COMMAND_ID_BITS);
+        Flat_PutBits(&w, (unsigned int)Flat_AckStatus(flat), LAYOUT_ACK_STATUS_BITS);
+    }
+
+    *written = (bits + 7) / 8;
+    return TRUE;
+}
@@ -0,0 +1,109 @@
+/* asn1crt_flat.h - Fixed-layout random-access TelemetryFrame encoding */
+#ifndef ASN1CRT_FLAT_H
+#define ASN1CRT_FLAT_H
+
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* Flat_Verify and conversion failures; Flat_FromFrame passes generated constraint errors through */
+#define ERR_FLAT_INSUFFICIENT_DATA  1060  /* Buffer ends inside the frame */
+#define ERR_FLAT_MALFORMED          1061  /* Bad version, kind, size, count, offset or out-of-range value */
+#define ERR_FLAT_CAPACITY           1062  /* Output buffer too small */
+
+/* Flat frames carry the same values as the uPER TelemetryFrame, with every
+ * field at a fixed, naturally aligned little-endian offset so it can be
+ * read in place. Frame sizes are multiples of FLAT_ALIGN, so frames stored
+ * back to back in an 8-aligned buffer stay aligned.
+ *
+ *   0  u16 size          Whole frame in bytes
+ *   2  u8  version       FLAT_VERSION
+ *   3  u8  kind          payload.kind
+ *   4  u32 seconds
+ *   8  u16 subseconds
+ *  10  u8  frameType
+ *  11  u8  reserved
+ *  12  u16 frameCount
+ *  14  u16 reserved
+ *
+ * housekeeping (32 bytes):
+ *  16  u16 mainBus, 18 u16 payload, 20 u16 comms
+ *  22  u8  status
+ *  23  u8  temperature count
+ *  24  i8  temperature[8]  Unused slots are zero
+ *
+ * science (36 bytes + blocks, padded):
+ *  16  u8  instrumentId
+ *  17  u8  block count
+ *  20  {u16 offset, u16 length}[4]  Offsets from the start of the frame
+ *  36  block octets, back to back
+ *
+ * commandAck (24 bytes):
+ *  16  u16 commandId
+ *  18  u8  status
+ */
+#define FLAT_VERSION              1
+#define FLAT_ALIGN                8
+#define FLAT_HEADER_BYTES         16
+#define FLAT_HOUSEKEEPING_BYTES   32
+#define FLAT_COMMAND_ACK_BYTES    24
+#define FLAT_BLOCK_TABLE_OFFSET   20
+#define FLAT_BLOCK_DATA_OFFSET    36
+#define FLAT_MAX_TEMPERATURES     8
+#define FLAT_MAX_BLOCKS           4
+#define FLAT_MAX_FRAME_BYTES      ((FLAT_BLOCK_DATA_OFFSET + FLAT_MAX_BLOCKS * 256 + FLAT_ALIGN - 1) & ~(FLAT_ALIGN - 1))
+
+/* In-place accessors. They do no checking: call Flat_Verify once on frames
+ * from outside the process, after that every accessor is a plain load. */
+static inline unsigned int Flat_U16(const byte* f, int offset) {
+    return (unsigned int)f[offset] | (unsigned int)f[offset + 1] << 8;
+}
+
+static inline unsigned int Flat_U32(const byte* f, int offset) {
+    return Flat_U16(f, offset) | Flat_U16(f, offset + 2) << 16;
+}
+
+static inline int Flat_Size(const byte* f) { return (int)Flat_U16(f, 0); }
+static inline int Flat_Kind(const byte* f) { return f[3]; }
+static inline unsigned int Flat_Seconds(const byte* f) { return Flat_U32(f, 4); }
+static inline unsigned int Flat_Subseconds(const byte* f) { return Flat_U16(f, 8); }
+static inline unsigned int Flat_FrameType(const byte* f) { return f[10]; }
+static inline unsigned int Flat_FrameCount(const byte* f) { return Flat_U16(f, 12); }
+
+/* housekeeping */
+static inline unsigned int Flat_MainBus(const byte* f) { return Flat_U16(f, 16); }
+static inline unsigned int Flat_PayloadVoltage(const byte* f) { return Flat_U16(f, 18); }
+static inline unsigned int Flat_Comms(const byte* f) { return Flat_U16(f, 20); }
+static inline unsigned int Flat_Status(const byte* f) { return f[22]; }
+static inline int Flat_TemperatureCount(const byte* f) { return f[23]; }
+static inline int Flat_Temperature(const byte* f, int i) { return (int)(signed char)f[24 + i]; }
+
+/* science */
+static inline unsigned int Flat_InstrumentId(const byte* f) { return f[16]; }
+static inline int Flat_BlockCount(const byte* f) { return f[17]; }
+static inline int Flat_BlockLength(const byte* f, int i) { return (int)Flat_U16(f, FLAT_BLOCK_TABLE_OFFSET + 4 * i + 2); }
+static inline const byte* Flat_Block(const byte* f, int i) { return f + Flat_U16(f, FLAT_BLOCK_TABLE_OFFSET + 4 * i); }
+
+/* commandAck */
+static inline unsigned int Flat_CommandId(const byte* f) { return Flat_U16(f, 16); }
+static inline T_CommandAck_status Flat_AckStatus(const byte* f) { return (T_CommandAck_status)f[18]; }
+
+/* Check a flat frame at the start of buf[0..length): size, version, kind,
+ * counts, block table and value ranges. frameBytes gets its size. */
+flag Flat_Verify(const byte* buf, int length, int* frameBytes, int* pErrCode);
+
+/* Flat size a value will take */
+int Flat_SizeOf(const T_TelemetryFrame* pVal);
+
+/* Value <-> flat */
+flag Flat_FromFrame(const T_TelemetryFrame* pVal, byte* out, int capacity, int* written, int* pErrCode);
+flag Flat_ToFrame(const byte* buf, int length, T_TelemetryFrame* pVal, int* pErrCode);
+
+/* uPER <-> flat without a T_TelemetryFrame in between. Flat_FromUper reads
+ * one uPER frame from the start of uper[0..length) and reports the bytes it
+ * took in uperBytes; the output of Flat_ToUper is byte-identical to
+ * T_TelemetryFrame_Encode. */
+flag Flat_FromUper(const byte* uper, int length, byte* out, int capacity,
+                   int* uperBytes, int* written, int* pErrCode);
+flag Flat_ToUper(const byte* flat, int length, byte* out, int capacity, int* written, int* pErrCode);
+
+#endif /* ASN1CRT_FLAT_H */
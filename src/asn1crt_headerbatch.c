@@ -0,0 +1,204 @@
+/* asn1crt_headerbatch.c - Batch FrameHeader unpacking into columns */
+#include "asn1crt_headerbatch.h"
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HEADERBATCH_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+/* The header read as two overlapping big-endian words: bytes 0-7 hold
+ * seconds, subseconds and frameType, bytes 1-8 the whole of frameCount */
+#define HB_SECONDS_SHIFT     (64 - LAYOUT_SUBSECONDS_OFFSET)
+#define HB_SUBSECONDS_SHIFT  (64 - LAYOUT_FRAME_TYPE_OFFSET)
+#define HB_FRAME_TYPE_SHIFT  (64 - LAYOUT_FRAME_COUNT_OFFSET)
+#define HB_FRAME_COUNT_SHIFT (72 - LAYOUT_HEADER_BITS)
+#define HB_MASK(bits)        ((1ULL << (bits)) - 1)
+
+#define HEADERBATCH_STEP 8
+
+typedef int (*HeaderBatchFn)(const byte*, size_t, const unsigned long long*, int, const HeaderColumns*,
+                             unsigned long long*);
+
+static HeaderBatchFn unpackKernel = HeaderBatch_UnpackGeneric;
+static const char* kernelName = "generic";
+static pthread_once_t headerBatchOnce = PTHREAD_ONCE_INIT;
+
+static unsigned long long HeaderBatch_LoadBe64(const byte* p) {
+    unsigned long long v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_bswap64(v);
+}
+
+static flag HeaderBatch_InBounds(size_t size, unsigned long long offset) {
+    return offset <= size && size - offset >= HEADERBATCH_FRAME_BYTES;
+}
+
+static void HeaderBatch_Clear(unsigned long long* invalid, int count) {
+    memset(invalid, 0, (size_t)((count + 63) / 64) * sizeof(unsigned long long));
+}
+
+/* One row; TRUE when it is invalid */
+static flag HeaderBatch_Row(const byte* buf, size_t size, unsigned long long offset, const HeaderColumns* out, int i) {
+    unsigned long long w = 0;
+    unsigned long long w2 = 0;
+    unsigned int subseconds;
+    flag bad = !HeaderBatch_InBounds(size, offset);
+
+    if (!bad) {
+        w = HeaderBatch_LoadBe64(buf + offset);
+        w2 = HeaderBatch_LoadBe64(buf + offset + 1);
+    }
+    subseconds = (unsigned int)(w >> HB_SUBSECONDS_SHIFT & HB_MASK(LAYOUT_SUBSECONDS_BITS));
+    if (subseconds > LAYOUT_SUBSECONDS_MAX) {
+        bad = TRUE;
+        w = w2 = 0;
+        subseconds = 0;
+    }
+    out->seconds[i] = (unsigned int)(w >> HB_SECONDS_SHIFT);
+    out->subseconds[i] = (unsigned short)subseconds;
+    out->frameType[i] = (byte)(w >> HB_FRAME_TYPE_SHIFT);
+    out->frameCount[i] = (unsigned short)(w2 >> HB_FRAME_COUNT_SHIFT);
+    return bad;
+}
+
+int HeaderBatch_UnpackGeneric(const byte* buf, size_t size, const unsigned long long* offsets, int count,
+                              const HeaderColumns* out, unsigned long long* invalid) {
+    int bad = 0;
+
+    HeaderBatch_Clear(invalid, count);
+    for (int i = 0; i < count; i++) {
+        if (HeaderBatch_Row(buf, size, offsets[i], out, i)) {
+            invalid[i / 64] |= 1ULL << (i % 64);
+            bad++;
+        }
+    }
+    return bad;
+}
+
+#ifdef HEADERBATCH_HAVE_X86
+/* u64 lanes holding 32-bit values -> the low 128 bits as four u32 */
+__attribute__((target("avx2")))
+static inline __m128i HeaderBatch_Narrow(__m256i v) {
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i HeaderBatch_Join(__m256i low, __m256i high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(HeaderBatch_Narrow(low)), HeaderBatch_Narrow(high), 1);
+}
+
+/* Four rows: both header words of each frame come in by gather straight
+ * from the offsets, frames past the end are masked out of the gather
+ * rather than loaded, and one byte shuffle makes them big-endian. Lanes
+ * of the returned fields are zero where the bad mask is set. */
+__attribute__((target("avx2")))
+static inline __m256i HeaderBatch_Quad(const byte* buf, const unsigned long long* offsets, __m256i limit,
+                                       __m256i* seconds, __m256i* subseconds, __m256i* frameType,
+                                       __m256i* frameCount) {
+    const __m256i swap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                          7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m256i sign = _mm256_set1_epi64x((long long)(1ULL << 63));
+    const __m256i typeMask = _mm256_set1_epi64x((long long)HB_MASK(LAYOUT_FRAME_TYPE_BITS));
+    const __m256i countMask = _mm256_set1_epi64x((long long)HB_MASK(LAYOUT_FRAME_COUNT_BITS));
+    __m256i offs = _mm256_loadu_si256((const __m256i*)offsets);
+    __m256i outside = _mm256_cmpgt_epi64(_mm256_xor_si256(offs, sign), limit);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i inside = _mm256_xor_si256(outside, _mm256_cmpeq_epi64(zero, zero));
+    const long long* base = (const long long*)buf;
+    __m256i w = _mm256_mask_i64gather_epi64(zero, base, offs, inside, 1);
+    __m256i w2 = _mm256_mask_i64gather_epi64(zero, base, _mm256_add_epi64(offs, _mm256_set1_epi64x(1)), inside, 1);
+    __m256i sub;
+    __m256i bad;
+
+    w = _mm256_shuffle_epi8(w, swap);
+    w2 = _mm256_shuffle_epi8(w2, swap);
+    sub = _mm256_and_si256(_mm256_srli_epi64(w, HB_SUBSECONDS_SHIFT),
+                           _mm256_set1_epi64x((long long)HB_MASK(LAYOUT_SUBSECONDS_BITS)));
+    bad = _mm256_or_si256(outside, _mm256_cmpgt_epi64(sub, _mm256_set1_epi64x(LAYOUT_SUBSECONDS_MAX)));
+    *seconds = _mm256_andnot_si256(bad, _mm256_srli_epi64(w, HB_SECONDS_SHIFT));
+    *subseconds = _mm256_andnot_si256(bad, sub);
+    *frameType = _mm256_andnot_si256(bad, _mm256_and_si256(_mm256_srli_epi64(w, HB_FRAME_TYPE_SHIFT), typeMask));
+    *frameCount = _mm256_andnot_si256(bad, _mm256_and_si256(_mm256_srli_epi64(w2, HB_FRAME_COUNT_SHIFT), countMask));
+    return bad;
+}
+
+/* Eight rows per step, two gathers of four; the fields are narrowed with
+ * packs so each column gets one store */
+__attribute__((target("avx2")))
+static int HeaderBatch_UnpackAvx2(const byte* buf, size_t size, const unsigned long long* offsets, int count,
+                                  const HeaderColumns* out, unsigned long long* invalid) {
+    int full = count - count % HEADERBATCH_STEP;
+    int bad = 0;
+    __m256i limit;
+
+    if (size < HEADERBATCH_FRAME_BYTES) {
+        return HeaderBatch_UnpackGeneric(buf, size, offsets, count, out, invalid);
+    }
+    /* Signed compare of offset against size - 9, both biased by 2^63 */
+    limit = _mm256_set1_epi64x((long long)((size - HEADERBATCH_FRAME_BYTES) ^ (1ULL << 63)));
+    HeaderBatch_Clear(invalid, count);
+    for (int r = 0; r < full; r += HEADERBATCH_STEP) {
+        __m256i sec[2];
+        __m256i sub[2];
+        __m256i type[2];
+        __m256i cnt[2];
+        __m256i badMask[2];
+        __m256i subCount;
+        __m256i types;
+        unsigned int lo;
+        unsigned int hi;
+        unsigned int bits;
+
+        for (int q = 0; q < 2; q++) {
+            badMask[q] = HeaderBatch_Quad(buf, offsets + r + 4 * q, limit, &sec[q], &sub[q], &type[q], &cnt[q]);
+        }
+        /* u32 -> u16 packs within 128-bit halves; the permute puts the
+         * eight subseconds in the low half, the eight frameCounts above */
+        subCount = _mm256_permute4x64_epi64(_mm256_packus_epi32(HeaderBatch_Join(sub[0], sub[1]),
+                                                                HeaderBatch_Join(cnt[0], cnt[1])), 0xD8);
+        types = _mm256_packus_epi16(_mm256_packus_epi32(HeaderBatch_Join(type[0], type[1]), _mm256_setzero_si256()),
+                                    _mm256_setzero_si256());
+        _mm256_storeu_si256((__m256i*)(out->seconds + r), HeaderBatch_Join(sec[0], sec[1]));
+        _mm_storeu_si128((__m128i*)(out->subseconds + r), _mm256_castsi256_si128(subCount));
+        _mm_storeu_si128((__m128i*)(out->frameCount + r), _mm256_extracti128_si256(subCount, 1));
+        lo = (unsigned int)_mm256_extract_epi32(types, 0);
+        hi = (unsigned int)_mm256_extract_epi32(types, 4);
+        memcpy(out->frameType + r, &lo, sizeof(lo));
+        memcpy(out->frameType + r + 4, &hi, sizeof(hi));
+
+        bits = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(badMask[0])) |
+               (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(badMask[1])) << 4;
+        invalid[r / 64] |= (unsigned long long)bits << (r % 64);
+        bad += __builtin_popcount(bits);
+    }
+    for (int i = full; i < count; i++) {
+        if (HeaderBatch_Row(buf, size, offsets[i], out, i)) {
+            invalid[i / 64] |= 1ULL << (i % 64);
+            bad++;
+        }
+    }
+    return bad;
+}
+#endif
+
+static void HeaderBatch_Setup(void) {
+#ifdef HEADERBATCH_HAVE_X86
+    if (__builtin_cpu_supports("avx2")) {
+        unpackKernel = HeaderBatch_UnpackAvx2;
+        kernelName = "avx2";
+    }
+#endif
+}
+
+int HeaderBatch_Unpack(const byte* buf, size_t size, const unsigned long long* offsets, int count,
+                       const HeaderColumns* out, unsigned long long* invalid) {
+    pthread_once(&headerBatchOnce, HeaderBatch_Setup);
+    return unpackKernel(buf, size, offsets, count, out, invalid);
+}
+
+const char* HeaderBatch_Kernel(void) {
+    pthread_once(&headerBatchOnce, HeaderBatch_Setup);
+    return kernelName;
+}
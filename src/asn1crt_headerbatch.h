@@ -0,0 +1,35 @@
+/* asn1crt_headerbatch.h - Batch FrameHeader unpacking into columns */
+#ifndef ASN1CRT_HEADERBATCH_H
+#define ASN1CRT_HEADERBATCH_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "asn1crt_layout.h"
+
+/* Bytes of a frame the header needs: it ends two bits into the ninth */
+#define HEADERBATCH_FRAME_BYTES ((LAYOUT_HEADER_BITS + 7) / 8)
+
+/* Output columns, count entries each */
+typedef struct {
+    unsigned int* seconds;
+    unsigned short* subseconds;
+    byte* frameType;
+    unsigned short* frameCount;
+} HeaderColumns;
+
+/* Unpack the FrameHeader of count uPER frames starting at buf + offsets[i].
+ * Bit i of invalid ((count + 63) / 64 words) is set when the frame runs
+ * past size or its subseconds exceed the constraint, the rows
+ * T_FrameHeader_Decode would reject; their columns read 0. Returns the
+ * number of invalid rows. */
+int HeaderBatch_Unpack(const byte* buf, size_t size, const unsigned long long* offsets, int count,
+                       const HeaderColumns* out, unsigned long long* invalid);
+
+/* Same result one frame at a time, for checking the dispatched kernel */
+int HeaderBatch_UnpackGeneric(const byte* buf, size_t size, const unsigned long long* offsets, int count,
+                              const HeaderColumns* out, unsigned long long* invalid);
+
+/* Unpack kernel picked at runtime: "avx2" or "generic" */
+const char* HeaderBatch_Kernel(void);
+
+#endif /* ASN1CRT_HEADERBATCH_H */
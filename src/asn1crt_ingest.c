@@ -0,0 +1,251 @@
+/* asn1crt_ingest.c - Batched UDP ingest implementation */
+#define _GNU_SOURCE
+#include "asn1crt_ingest.h"
+#include "asn1crt_internal.h"
+#include "asn1crt_latency.h"
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+/* Per-slot control buffer, large enough for one int cmsg */
+#define INGEST_CONTROL_SIZE 64
+
+void IngestConfig_Default(IngestConfig* cfg) {
+    memset(cfg, 0, sizeof(IngestConfig));
+    cfg->bindAddress = NULL;
+    cfg->port = 0;
+    cfg->batchSize = INGEST_MAX_BATCH;
+    cfg->reusePort = FALSE;
+    cfg->enableGro = TRUE;
+    cfg->recvBufferBytes = 0;
+    cfg->integrity = INTEGRITY_NONE;
+}
+
+static int Ingest_BatchSize(const IngestConfig* cfg) {
+    if (cfg->batchSize <= 0 || cfg->batchSize > INGEST_MAX_BATCH) {
+        return INGEST_MAX_BATCH;
+    }
+    return cfg->batchSize;
+}
+
+size_t IngestServer_PoolBytes(const IngestConfig* cfg) {
+    size_t batch = (size_t)Ingest_BatchSize(cfg);
+    size_t slotSize = cfg->enableGro ? INGEST_GRO_SLOT_SIZE : INGEST_FRAME_SLOT_SIZE;
+
+    return Asn1crt_Round8(sizeof(T_TelemetryFrame) * INGEST_MAX_BATCH) +
+           Asn1crt_Round8(sizeof(struct mmsghdr) * batch) +
+           Asn1crt_Round8(sizeof(struct iovec) * batch) +
+           INGEST_CONTROL_SIZE * batch +
+           slotSize * batch;
+}
+
+static flag Ingest_Fail(IngestServer* srv) {
+    if (srv->fd >= 0) {
+        close(srv->fd);
+    }
+    srv->fd = -1;
+    return FALSE;
+}
+
+flag IngestServer_Open(IngestServer* srv, const IngestConfig* cfg, MemPool* pool) {
+    int one = 1;
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof(addr);
+
+    memset(srv, 0, sizeof(IngestServer));
+    srv->batchSize = Ingest_BatchSize(cfg);
+    srv->integrity = cfg->integrity;
+
+    srv->fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (srv->fd < 0) {
+        return FALSE;
+    }
+
+    if (cfg->reusePort &&
+        setsockopt(srv->fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) {
+        return Ingest_Fail(srv);
+    }
+    if (cfg->recvBufferBytes > 0) {
+        setsockopt(srv->fd, SOL_SOCKET, SO_RCVBUF, &cfg->recvBufferBytes, sizeof(int));
+    }
+
+    /* GRO is an optimisation only: older kernels reject it and we carry on */
+    srv->groActive = cfg->enableGro &&
+        setsockopt(srv->fd, SOL_UDP, UDP_GRO, &one, sizeof(one)) == 0;
+    srv->slotSize = srv->groActive ? INGEST_GRO_SLOT_SIZE : INGEST_FRAME_SLOT_SIZE;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(cfg->port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (cfg->bindAddress != NULL && inet_pton(AF_INET, cfg->bindAddress, &addr.sin_addr) != 1) {
+        return Ingest_Fail(srv);
+    }
+    if (bind(srv->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(srv->fd, (struct sockaddr*)&addr, &addrLen) != 0) {
+        return Ingest_Fail(srv);
+    }
+    srv->port = ntohs(addr.sin_port);
+
+    /* Frames first so they keep the pool's base alignment */
+    srv->frames = (T_TelemetryFrame*)MemPool_Alloc(pool,
+        Asn1crt_Round8(sizeof(T_TelemetryFrame) * INGEST_MAX_BATCH));
+    srv->msgs = (struct mmsghdr*)MemPool_Alloc(pool,
+        Asn1crt_Round8(sizeof(struct mmsghdr) * srv->batchSize));
+    srv->iovs = (struct iovec*)MemPool_Alloc(pool,
+        Asn1crt_Round8(sizeof(struct iovec) * srv->batchSize));
+    srv->control = (byte*)MemPool_Alloc(pool, INGEST_CONTROL_SIZE * srv->batchSize);
+    srv->slots = (byte*)MemPool_Alloc(pool, srv->slotSize * srv->batchSize);
+    if (!srv->frames || !srv->msgs || !srv->iovs || !srv->control || !srv->slots) {
+        return Ingest_Fail(srv);
+    }
+
+    memset(srv->msgs, 0, sizeof(struct mmsghdr) * srv->batchSize);
+    for (int i = 0; i < srv->batchSize; i++) {
+        srv->iovs[i].iov_base = srv->slots + (size_t)i * srv->slotSize;
+        srv->iovs[i].iov_len = srv->slotSize;
+        srv->msgs[i].msg_hdr.msg_iov = &srv->iovs[i];
+        srv->msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    return TRUE;
+}
+
+/* GRO segment size from the ancillary data, or the whole read when absent */
+static int Ingest_SegmentSize(struct msghdr* hdr, int length) {
+    struct cmsghdr* cmsg;
+
+    for (cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int segment;
+            memcpy(&segment, CMSG_DATA(cmsg), sizeof(int));
+            if (segment > 0 && segment < length) {
+                return segment;
+            }
+        }
+    }
+    return length;
+}
+
+/* Datagrams collected from one wakeup, checked and decoded together */
+typedef struct {
+    const byte* data[INGEST_MAX_BATCH];
+    int size[INGEST_MAX_BATCH];
+    int count;
+} IngestSegments;
+
+/* Verify the whole batch first so corrupt datagrams never reach the decoder */
+static void Ingest_DecodeSegments(IngestServer* srv, IngestSegments* segs,
+                                  IngestBatchHandler handler, void* userData) {
+    unsigned long long valid[(INGEST_MAX_BATCH + 63) / 64];
+    int trailer = FrameIntegrity_TrailerSize(srv->integrity);
+    int pending = 0;
+
+    if (trailer > 0) {
+        int ok = FrameIntegrity_VerifyBatch(srv->integrity, segs->data, segs->size, segs->count, valid);
+        srv->stats.checksumErrors += (unsigned long)(segs->count - ok);
+    }
+
+    for (int i = 0; i < segs->count; i++) {
+        BitStream bs;
+        int errCode;
+
+        if (trailer > 0 && !(valid[i >> 6] & (1ULL << (i & 63)))) {
+            continue;
+        }
+        BitStream_AttachBuffer(&bs, (byte*)segs->data[i], segs->size[i] - trailer);
+        if (T_TelemetryFrame_DecodeTimed(&srv->frames[pending], &bs, &errCode)) {
+            srv->stats.framesDecoded++;
+            pending++;
+        } else {
+            srv->stats.decodeErrors++;
+            srv->stats.lastErrCode = errCode;
+        }
+    }
+
+    if (pending > 0 && handler != NULL) {
+        handler(srv->frames, pending, userData);
+    }
+    segs->count = 0;
+}
+
+int IngestServer_Poll(IngestServer* srv, int timeoutMs, IngestBatchHandler handler, void* userData) {
+    struct pollfd pfd;
+    IngestSegments segs;
+    int ready;
+    int received;
+    int datagrams = 0;
+
+    pfd.fd = srv->fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    ready = poll(&pfd, 1, timeoutMs);
+    if (ready == 0) {
+        return 0;
+    }
+    if (ready < 0) {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    /* msg_controllen is overwritten by the kernel, so re-arm every slot */
+    for (int i = 0; i < srv->batchSize; i++) {
+        srv->msgs[i].msg_hdr.msg_control = srv->groActive ? srv->control + i * INGEST_CONTROL_SIZE : NULL;
+        srv->msgs[i].msg_hdr.msg_controllen = srv->groActive ? INGEST_CONTROL_SIZE : 0;
+        srv->msgs[i].msg_hdr.msg_flags = 0;
+    }
+
+    received = recvmmsg(srv->fd, srv->msgs, srv->batchSize, MSG_DONTWAIT, NULL);
+    if (received < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    srv->stats.wakeups++;
+
+    segs.count = 0;
+    for (int i = 0; i < received; i++) {
+        struct msghdr* hdr = &srv->msgs[i].msg_hdr;
+        const byte* data = (const byte*)srv->iovs[i].iov_base;
+        int length = (int)srv->msgs[i].msg_len;
+        int segment;
+
+        if (hdr->msg_flags & MSG_TRUNC) {
+            srv->stats.truncated++;
+            continue;
+        }
+
+        segment = srv->groActive ? Ingest_SegmentSize(hdr, length) : length;
+        srv->stats.bytes += (unsigned long)length;
+
+        for (int offset = 0; offset < length; offset += segment) {
+            segs.data[segs.count] = data + offset;
+            segs.size[segs.count] = (length - offset < segment) ? length - offset : segment;
+            datagrams++;
+            if (++segs.count == INGEST_MAX_BATCH) {
+                Ingest_DecodeSegments(srv, &segs, handler, userData);
+            }
+        }
+    }
+
+    if (segs.count > 0) {
+        Ingest_DecodeSegments(srv, &segs, handler, userData);
+    }
+    srv->stats.datagrams += (unsigned long)datagrams;
+    return datagrams;
+}
+
+void IngestServer_Close(IngestServer* srv) {
+    if (srv->fd >= 0) {
+        close(srv->fd);
+    }
+    srv->fd = -1;
+}
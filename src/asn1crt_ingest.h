@@ -0,0 +1,80 @@
+/* asn1crt_ingest.h - Batched UDP ingest of uPER telemetry frames */
+#ifndef ASN1CRT_INGEST_H
+#define ASN1CRT_INGEST_H
+
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_integrity.h"
+#include "satellite.h"
+
+/* Maximum datagrams pulled from the kernel per wakeup */
+#define INGEST_MAX_BATCH 64
+
+/* Receive slot for one datagram (one encoded frame plus trailer, rounded to 8 bytes) */
+#define INGEST_FRAME_SLOT_SIZE ((T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + INTEGRITY_MAX_TRAILER + 7) & ~7)
+
+/* Receive slot when UDP GRO may coalesce many datagrams into one read */
+#define INGEST_GRO_SLOT_SIZE 65536
+
+struct mmsghdr;
+struct iovec;
+
+/* Socket and batching options */
+typedef struct {
+    const char* bindAddress;  /* Dotted IPv4 address, NULL for INADDR_ANY */
+    unsigned short port;      /* 0 binds an ephemeral port */
+    int batchSize;            /* Datagrams per recvmmsg (1..INGEST_MAX_BATCH) */
+    flag reusePort;           /* SO_REUSEPORT so several sockets shard one port */
+    flag enableGro;           /* Ask for UDP_GRO, silently off when unsupported */
+    int recvBufferBytes;      /* SO_RCVBUF, 0 keeps the system default */
+    IntegrityKind integrity;  /* Checksum trailer verified before decode */
+} IngestConfig;
+
+/* Running counters, owned by the polling thread */
+typedef struct {
+    unsigned long wakeups;       /* recvmmsg calls that returned data */
+    unsigned long datagrams;     /* Datagrams seen, after splitting GRO reads */
+    unsigned long bytes;         /* Payload bytes received */
+    unsigned long framesDecoded; /* Datagrams decoded successfully */
+    unsigned long checksumErrors;/* Datagrams rejected by the integrity check */
+    unsigned long decodeErrors;  /* Datagrams rejected by the decoder */
+    unsigned long truncated;     /* Reads larger than the receive slot */
+    int lastErrCode;             /* Most recent decoder error code */
+} IngestStats;
+
+/* Receives every decoded batch; frames are reused on the next call */
+typedef void (*IngestBatchHandler)(const T_TelemetryFrame* frames, int count, void* userData);
+
+/* One receiving socket and its pool-backed buffers */
+typedef struct {
+    int fd;                   /* UDP socket, -1 when closed */
+    unsigned short port;      /* Port actually bound */
+    int batchSize;            /* Datagrams per recvmmsg */
+    size_t slotSize;          /* Bytes per receive slot */
+    flag groActive;           /* Kernel accepted UDP_GRO */
+    IntegrityKind integrity;  /* Trailer checked before decoding */
+    byte* slots;              /* batchSize * slotSize receive buffers */
+    T_TelemetryFrame* frames; /* INGEST_MAX_BATCH decode targets */
+    struct mmsghdr* msgs;     /* recvmmsg headers, one per slot */
+    struct iovec* iovs;       /* One iovec per slot */
+    byte* control;            /* cmsg space for the GRO segment size */
+    IngestStats stats;
+} IngestServer;
+
+/* Fill a config with defaults (any address, full batches, GRO on) */
+void IngestConfig_Default(IngestConfig* cfg);
+
+/* Pool bytes IngestServer_Open will carve for this config */
+size_t IngestServer_PoolBytes(const IngestConfig* cfg);
+
+/* Create and bind the socket; all buffers come from pool */
+flag IngestServer_Open(IngestServer* srv, const IngestConfig* cfg, MemPool* pool);
+
+/* Wait up to timeoutMs, drain one recvmmsg batch and decode it.
+ * Returns datagrams received (0 on timeout) or -1 on socket error. */
+int IngestServer_Poll(IngestServer* srv, int timeoutMs, IngestBatchHandler handler, void* userData);
+
+/* Close the socket (pool memory is left to the caller) */
+void IngestServer_Close(IngestServer* srv);
+
+#endif /* ASN1CRT_INGEST_H */
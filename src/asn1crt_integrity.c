@@ -0,0 +1,112 @@
+/* asn1crt_integrity.c - Checksum trailers on encoded frames */
+#include "asn1crt_integrity.h"
+#include "asn1crt_crc.h"
+#include <string.h>
+
+int FrameIntegrity_TrailerSize(IntegrityKind kind) {
+    switch (kind) {
+    case INTEGRITY_CRC16_CCSDS:
+        return 2;
+    case INTEGRITY_CRC32C:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+static unsigned int Integrity_Checksum(IntegrityKind kind, const byte* data, int length) {
+    if (kind == INTEGRITY_CRC32C) {
+        return Crc32c_Compute(data, (size_t)length);
+    }
+    return Crc16_Ccsds(data, (size_t)length);
+}
+
+int FrameIntegrity_Append(IntegrityKind kind, byte* buf, int length, int capacity) {
+    int trailer = FrameIntegrity_TrailerSize(kind);
+    unsigned int crc;
+
+    if (length < 0 || length + trailer > capacity) {
+        return 0;
+    }
+    if (trailer == 0) {
+        return length;
+    }
+
+    crc = Integrity_Checksum(kind, buf, length);
+    for (int i = 0; i < trailer; i++) {
+        buf[length + i] = (byte)(crc >> (8 * (trailer - 1 - i)));
+    }
+    return length + trailer;
+}
+
+flag FrameIntegrity_Verify(IntegrityKind kind, const byte* frame, int length, int* payloadLength) {
+    int trailer = FrameIntegrity_TrailerSize(kind);
+    int payload = length - trailer;
+    unsigned int expected = 0;
+
+    if (payload <= 0) {
+        return FALSE;
+    }
+    if (payloadLength != NULL) {
+        *payloadLength = payload;
+    }
+    if (trailer == 0) {
+        return TRUE;
+    }
+
+    for (int i = 0; i < trailer; i++) {
+        expected = (expected << 8) | frame[payload + i];
+    }
+    return Integrity_Checksum(kind, frame, payload) == expected;
+}
+
+int FrameIntegrity_VerifyBatch(IntegrityKind kind, const byte* const* frames, const int* lengths,
+                               int count, unsigned long long* validBitmap) {
+    int valid = 0;
+
+    memset(validBitmap, 0, sizeof(unsigned long long) * (size_t)((count + 63) / 64));
+    for (int i = 0; i < count; i++) {
+        if (FrameIntegrity_Verify(kind, frames[i], lengths[i], NULL)) {
+            validBitmap[i >> 6] |= 1ULL << (i & 63);
+            valid++;
+        }
+    }
+    return valid;
+}
+
+flag FrameIntegrity_EncodeFrame(const T_TelemetryFrame* frame, IntegrityKind kind,
+                                byte* buf, int capacity, int* length, int* pErrCode) {
+    BitStream bs;
+    int encoded;
+
+    BitStream_Init(&bs, buf, capacity);
+    if (!T_TelemetryFrame_Encode(frame, &bs, pErrCode, TRUE)) {
+        return FALSE;
+    }
+
+    encoded = FrameIntegrity_Append(kind, buf, (int)BitStream_GetLength(&bs), capacity);
+    if (encoded == 0) {
+        *pErrCode = ERR_FRAME_INTEGRITY_LENGTH;
+        return FALSE;
+    }
+    *length = encoded;
+    return TRUE;
+}
+
+flag FrameIntegrity_DecodeFrame(T_TelemetryFrame* frame, IntegrityKind kind,
+                                const byte* buf, int length, int* pErrCode) {
+    BitStream bs;
+    int payload;
+
+    if (length <= FrameIntegrity_TrailerSize(kind)) {
+        *pErrCode = ERR_FRAME_INTEGRITY_LENGTH;
+        return FALSE;
+    }
+    if (!FrameIntegrity_Verify(kind, buf, length, &payload)) {
+        *pErrCode = ERR_FRAME_INTEGRITY_CHECKSUM;
+        return FALSE;
+    }
+
+    BitStream_AttachBuffer(&bs, (byte*)buf, payload);
+    return T_TelemetryFrame_Decode(frame, &bs, pErrCode);
+}
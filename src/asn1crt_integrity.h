@@ -0,0 +1,47 @@
+/* asn1crt_integrity.h - Checksum trailers on encoded frames */
+#ifndef ASN1CRT_INTEGRITY_H
+#define ASN1CRT_INTEGRITY_H
+
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* Trailer failures; the wrapped encode and decode pass generated codes through */
+#define ERR_FRAME_INTEGRITY_CHECKSUM 1001  /* Trailer does not match the frame */
+#define ERR_FRAME_INTEGRITY_LENGTH   1002  /* Buffer too short or too small */
+
+/* Largest trailer appended by any kind */
+#define INTEGRITY_MAX_TRAILER 4
+
+/* Checksum carried after the uPER bytes (big-endian) */
+typedef enum {
+    INTEGRITY_NONE,          /* No trailer */
+    INTEGRITY_CRC16_CCSDS,   /* 2-byte CCSDS CRC-16 */
+    INTEGRITY_CRC32C         /* 4-byte CRC-32C */
+} IntegrityKind;
+
+/* Trailer bytes for a kind (0, 2 or 4) */
+int FrameIntegrity_TrailerSize(IntegrityKind kind);
+
+/* Append the checksum of buf[0..length) at buf + length.
+ * Returns the new length, or 0 when capacity is too small. */
+int FrameIntegrity_Append(IntegrityKind kind, byte* buf, int length, int capacity);
+
+/* Check a frame carrying a trailer; payloadLength gets the uPER byte count */
+flag FrameIntegrity_Verify(IntegrityKind kind, const byte* frame, int length, int* payloadLength);
+
+/* Check count frames in one pass before any decoding. Bit i of validBitmap
+ * (64 frames per word, (count + 63) / 64 words) is set when frame i passes.
+ * Returns the number of valid frames. */
+int FrameIntegrity_VerifyBatch(IntegrityKind kind, const byte* const* frames, const int* lengths,
+                               int count, unsigned long long* validBitmap);
+
+/* Encode a frame and append its trailer */
+flag FrameIntegrity_EncodeFrame(const T_TelemetryFrame* frame, IntegrityKind kind,
+                                byte* buf, int capacity, int* length, int* pErrCode);
+
+/* Verify the trailer, then decode; fails with ERR_FRAME_INTEGRITY_CHECKSUM
+ * without touching the decoder when the checksum is wrong */
+flag FrameIntegrity_DecodeFrame(T_TelemetryFrame* frame, IntegrityKind kind,
+                                const byte* buf, int length, int* pErrCode);
+
+#endif /* ASN1CRT_INTEGRITY_H */
@@ -0,0 +1,27 @@
+/* asn1crt_internal.h - Helpers shared by the runtime extension modules */
+#ifndef ASN1CRT_INTERNAL_H
+#define ASN1CRT_INTERNAL_H
+
+#include <stddef.h>
+#include <time.h>
+#include "asn1crt.h"
+
+/* Store errCode and return FALSE, for `return Asn1crt_Fail(pErrCode, ERR_X);` */
+static inline flag Asn1crt_Fail(int* pErrCode, int errCode) {
+    *pErrCode = errCode;
+    return FALSE;
+}
+
+/* Round a pool carve-out up so the next MemPool_Alloc stays 8-byte aligned */
+static inline size_t Asn1crt_Round8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+/* CLOCK_MONOTONIC in ns, for timeouts, deadlines and wall-time stats */
+static inline unsigned long long Asn1crt_NowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+#endif /* ASN1CRT_INTERNAL_H */
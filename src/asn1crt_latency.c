@@ -0,0 +1,361 @@
+/* asn1crt_latency.c - Per-thread log-linear latency histograms */
+#include "asn1crt_latency.h"
+#include "asn1crt_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LATENCY_HAVE_TSC 1
+#endif
+
+/* Written only by its owning thread; read concurrently by snapshots */
+typedef struct LatencyRecorder {
+    struct LatencyRecorder* next;
+    LatencyHistogram ok[LATENCY_OP_COUNT][LATENCY_KINDS];
+    LatencyErrorHistogram errors[LATENCY_OP_COUNT][LATENCY_ERROR_SLOTS + 1];
+} LatencyRecorder;
+
+static LatencyRecorder* recorderList = NULL;
+static __thread LatencyRecorder* threadRecorder = NULL;
+static int latencyEnabled = 0;
+static double nsPerTick = 0.0;
+static pthread_once_t calibrateOnce = PTHREAD_ONCE_INIT;
+
+static const char* opNames[LATENCY_OP_COUNT] = { "encode", "decode", "partial" };
+static const char* kindNames[LATENCY_KINDS] = { "unknown", "housekeeping", "science", "commandAck" };
+
+const char* Latency_OpName(LatencyOp op) {
+    return (op >= 0 && op < LATENCY_OP_COUNT) ? opNames[op] : "unknown";
+}
+
+const char* Latency_KindName(int kind) {
+    return (kind >= 0 && kind < LATENCY_KINDS) ? kindNames[kind] : kindNames[0];
+}
+
+unsigned long long Latency_Now(void) {
+#ifdef LATENCY_HAVE_TSC
+    return __rdtsc();
+#else
+    return Asn1crt_NowNs();
+#endif
+}
+
+/* Ticks per ns over a 10 ms window, done once when recording is first
+ * enabled; pthread_once also publishes nsPerTick to every thread that
+ * goes through it */
+static void Latency_Calibrate(void) {
+#ifdef LATENCY_HAVE_TSC
+    unsigned long long startNs = Asn1crt_NowNs();
+    unsigned long long startTicks = __rdtsc();
+    unsigned long long elapsedNs;
+    do {
+        elapsedNs = Asn1crt_NowNs() - startNs;
+    } while (elapsedNs < 10000000ULL);
+    nsPerTick = (double)elapsedNs / (double)(__rdtsc() - startTicks);
+#else
+    nsPerTick = 1.0;
+#endif
+}
+
+void Latency_SetEnabled(flag enabled) {
+    if (enabled) {
+        pthread_once(&calibrateOnce, Latency_Calibrate);
+    }
+    __atomic_store_n(&latencyEnabled, enabled ? 1 : 0, __ATOMIC_RELEASE);
+}
+
+flag Latency_Enabled(void) {
+    return __atomic_load_n(&latencyEnabled, __ATOMIC_RELAXED) != 0;
+}
+
+void Latency_InitFromEnv(void) {
+    const char* value = getenv("ASN1CRT_LATENCY");
+    if (value != NULL && strcmp(value, "1") == 0) {
+        Latency_SetEnabled(TRUE);
+    }
+}
+
+static int Latency_BucketIndex(unsigned long long ticks) {
+    int msb;
+
+    if (ticks < 32) {
+        return (int)ticks;
+    }
+    msb = 63 - __builtin_clzll(ticks);
+    if (msb > LATENCY_MAX_MSB) {
+        return LATENCY_BUCKETS - 1;
+    }
+    return 32 + (msb - 5) * LATENCY_SUB_BUCKETS +
+           (int)((ticks >> (msb - 4)) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+/* Midpoint of a bucket's range */
+static unsigned long long Latency_BucketValue(int index) {
+    int msb;
+    unsigned long long width;
+
+    if (index < 32) {
+        return (unsigned long long)index;
+    }
+    msb = 5 + (index - 32) / LATENCY_SUB_BUCKETS;
+    width = 1ULL << (msb - 4);
+    return ((unsigned long long)(LATENCY_SUB_BUCKETS + (index - 32) % LATENCY_SUB_BUCKETS) << (msb - 4)) +
+           width / 2;
+}
+
+/* Single writer: plain read-modify-write published with relaxed stores */
+void LatencyHistogram_Add(LatencyHistogram* h, unsigned long long ticks) {
+    int index = Latency_BucketIndex(ticks);
+
+    __atomic_store_n(&h->counts[index], h->counts[index] + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->sumTicks, h->sumTicks + ticks, __ATOMIC_RELAXED);
+    if (ticks > h->maxTicks) {
+        __atomic_store_n(&h->maxTicks, ticks, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&h->total, h->total + 1, __ATOMIC_RELAXED);
+}
+
+static LatencyRecorder* Latency_ThreadRecorder(void) {
+    LatencyRecorder* rec = threadRecorder;
+
+    if (rec == NULL) {
+        rec = (LatencyRecorder*)calloc(1, sizeof(LatencyRecorder));
+        if (rec == NULL) {
+            return NULL;
+        }
+        /* Recorders are never unlinked, so samples outlive their thread */
+        rec->next = __atomic_load_n(&recorderList, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&recorderList, &rec->next, rec, TRUE,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+        threadRecorder = rec;
+    }
+    return rec;
+}
+
+void Latency_Record(LatencyOp op, int kind, int errCode, unsigned long long ticks) {
+    LatencyRecorder* rec = Latency_ThreadRecorder();
+    LatencyErrorHistogram* slots;
+    int i;
+
+    if (rec == NULL || op < 0 || op >= LATENCY_OP_COUNT) {
+        return;
+    }
+    if (errCode == 0) {
+        LatencyHistogram_Add(&rec->ok[op][(kind >= 0 && kind < LATENCY_KINDS) ? kind : 0], ticks);
+        return;
+    }
+
+    slots = rec->errors[op];
+    for (i = 0; i < LATENCY_ERROR_SLOTS; i++) {
+        if (slots[i].code == errCode) {
+            break;
+        }
+        if (slots[i].code == 0) {
+            __atomic_store_n(&slots[i].code, errCode, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    if (i == LATENCY_ERROR_SLOTS) {
+        __atomic_store_n(&slots[i].code, -1, __ATOMIC_RELAXED);
+    }
+    LatencyHistogram_Add(&slots[i].hist, ticks);
+}
+
+static void LatencyHistogram_Merge(LatencyHistogram* dst, const LatencyHistogram* src) {
+    unsigned long long maxTicks = __atomic_load_n(&src->maxTicks, __ATOMIC_RELAXED);
+
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        dst->counts[b] += __atomic_load_n(&src->counts[b], __ATOMIC_RELAXED);
+    }
+    dst->total += __atomic_load_n(&src->total, __ATOMIC_RELAXED);
+    dst->sumTicks += __atomic_load_n(&src->sumTicks, __ATOMIC_RELAXED);
+    if (maxTicks > dst->maxTicks) {
+        dst->maxTicks = maxTicks;
+    }
+}
+
+/* Slot for code in a merged error table, claiming a free one if needed */
+static LatencyErrorHistogram* Latency_ErrorSlot(LatencyErrorHistogram* slots, int code) {
+    if (code > 0 || code < -1) {
+        for (int i = 0; i < LATENCY_ERROR_SLOTS; i++) {
+            if (slots[i].code == code) return &slots[i];
+            if (slots[i].code == 0) {
+                slots[i].code = code;
+                return &slots[i];
+            }
+        }
+    }
+    slots[LATENCY_ERROR_SLOTS].code = -1;
+    return &slots[LATENCY_ERROR_SLOTS];
+}
+
+flag Latency_Snapshot(LatencySnapshot* snap) {
+    LatencyRecorder* rec = __atomic_load_n(&recorderList, __ATOMIC_ACQUIRE);
+
+    memset(snap, 0, sizeof(LatencySnapshot));
+    if (rec != NULL) {
+        /* Recorders exist only once recording was enabled, so this only
+         * waits for a calibration another thread is still running */
+        pthread_once(&calibrateOnce, Latency_Calibrate);
+    }
+    snap->nsPerTick = rec != NULL && nsPerTick > 0.0 ? nsPerTick : 1.0;
+    for (; rec != NULL; rec = rec->next) {
+        snap->threads++;
+        for (int op = 0; op < LATENCY_OP_COUNT; op++) {
+            for (int k = 0; k < LATENCY_KINDS; k++) {
+                LatencyHistogram_Merge(&snap->ok[op][k], &rec->ok[op][k]);
+            }
+            for (int i = 0; i <= LATENCY_ERROR_SLOTS; i++) {
+                int code = __atomic_load_n(&rec->errors[op][i].code, __ATOMIC_ACQUIRE);
+                if (code == 0) continue;
+                LatencyHistogram_Merge(&Latency_ErrorSlot(snap->errors[op], code)->hist,
+                                       &rec->errors[op][i].hist);
+            }
+        }
+    }
+    return snap->threads > 0;
+}
+
+unsigned long long LatencyHistogram_ValueAt(const LatencyHistogram* h, double pct) {
+    unsigned long long total = 0;
+    unsigned long long rank;
+    unsigned long long seen = 0;
+
+    /* Sum the buckets rather than trust total, which a writer may be ahead on */
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        total += h->counts[b];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    rank = (unsigned long long)(pct / 100.0 * (double)total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += h->counts[b];
+        if (seen >= rank) {
+            unsigned long long value = Latency_BucketValue(b);
+            return (h->maxTicks > 0 && value > h->maxTicks) ? h->maxTicks : value;
+        }
+    }
+    return h->maxTicks;
+}
+
+static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+static void Latency_PrometheusSeries(FILE* out, const LatencySnapshot* snap, const char* op,
+                                     const char* labels, const LatencyHistogram* h) {
+    double secondsPerTick = snap->nsPerTick * 1e-9;
+
+    for (size_t q = 0; q < sizeof(quantiles) / sizeof(quantiles[0]); q++) {
+        fprintf(out, "asn1_frame_latency_seconds{op=\"%s\",%s,quantile=\"%g\"} %.9f\n", op, labels,
+                quantiles[q], LatencyHistogram_ValueAt(h, quantiles[q] * 100.0) * secondsPerTick);
+    }
+    fprintf(out, "asn1_frame_latency_seconds_sum{op=\"%s\",%s} %.9f\n", op, labels,
+            h->sumTicks * secondsPerTick);
+    fprintf(out, "asn1_frame_latency_seconds_count{op=\"%s\",%s} %llu\n", op, labels, h->total);
+}
+
+void Latency_WritePrometheus(FILE* out, const LatencySnapshot* snap) {
+    char labels[64];
+
+    fprintf(out, "# HELP asn1_frame_latency_seconds Encode/decode call latency by payload kind or error code\n");
+    fprintf(out, "# TYPE asn1_frame_latency_seconds summary\n");
+    for (int op = 0; op < LATENCY_OP_COUNT; op++) {
+        for (int k = 0; k < LATENCY_KINDS; k++) {
+            if (snap->ok[op][k].total == 0) continue;
+            snprintf(labels, sizeof(labels), "kind=\"%s\",error=\"0\"", kindNames[k]);
+            Latency_PrometheusSeries(out, snap, opNames[op], labels, &snap->ok[op][k]);
+        }
+        for (int i = 0; i <= LATENCY_ERROR_SLOTS; i++) {
+            const LatencyErrorHistogram* e = &snap->errors[op][i];
+            if (e->code == 0 || e->hist.total == 0) continue;
+            if (e->code == -1) {
+                snprintf(labels, sizeof(labels), "kind=\"error\",error=\"other\"");
+            } else {
+                snprintf(labels, sizeof(labels), "kind=\"error\",error=\"%d\"", e->code);
+            }
+            Latency_PrometheusSeries(out, snap, opNames[op], labels, &e->hist);
+        }
+    }
+}
+
+static void Latency_JsonSeries(FILE* out, const LatencySnapshot* snap, flag* first, const char* op,
+                               const char* kind, int code, const LatencyHistogram* h) {
+    double ns = snap->nsPerTick;
+
+    fprintf(out, "%s\n    {\"op\":\"%s\",\"kind\":\"%s\",\"error\":%d,\"count\":%llu,"
+                 "\"mean_ns\":%.1f,\"p50_ns\":%.1f,\"p99_ns\":%.1f,\"p999_ns\":%.1f,\"max_ns\":%.1f}",
+            *first ? "" : ",", op, kind, code, h->total,
+            h->total > 0 ? (double)h->sumTicks / h->total * ns : 0.0,
+            LatencyHistogram_ValueAt(h, 50.0) * ns, LatencyHistogram_ValueAt(h, 99.0) * ns,
+            LatencyHistogram_ValueAt(h, 99.9) * ns, h->maxTicks * ns);
+    *first = FALSE;
+}
+
+void Latency_WriteJson(FILE* out, const LatencySnapshot* snap) {
+    flag first = TRUE;
+
+    fprintf(out, "{\"threads\":%d,\"ns_per_tick\":%.6f,\"series\":[", snap->threads, snap->nsPerTick);
+    for (int op = 0; op < LATENCY_OP_COUNT; op++) {
+        for (int k = 0; k < LATENCY_KINDS; k++) {
+            if (snap->ok[op][k].total == 0) continue;
+            Latency_JsonSeries(out, snap, &first, opNames[op], kindNames[k], 0, &snap->ok[op][k]);
+        }
+        for (int i = 0; i <= LATENCY_ERROR_SLOTS; i++) {
+            const LatencyErrorHistogram* e = &snap->errors[op][i];
+            if (e->code == 0 || e->hist.total == 0) continue;
+            Latency_JsonSeries(out, snap, &first, opNames[op], "error", e->code, &e->hist);
+        }
+    }
+    fprintf(out, "\n]}\n");
+}
+
+#if ASN1CRT_LATENCY
+flag T_TelemetryFrame_EncodeTimed(const T_TelemetryFrame* pVal, BitStream* pBitStrm,
+                                  int* pErrCode, flag bCheckConstraints) {
+    unsigned long long start;
+    flag ok;
+
+    if (!Latency_Enabled()) {
+        return T_TelemetryFrame_Encode(pVal, pBitStrm, pErrCode, bCheckConstraints);
+    }
+    start = Latency_Now();
+    ok = T_TelemetryFrame_Encode(pVal, pBitStrm, pErrCode, bCheckConstraints);
+    Latency_Record(LATENCY_OP_ENCODE, (int)pVal->payload.kind, ok ? 0 : *pErrCode, Latency_Now() - start);
+    return ok;
+}
+
+flag T_TelemetryFrame_DecodeTimed(T_TelemetryFrame* pVal, BitStream* pBitStrm, int* pErrCode) {
+    unsigned long long start;
+    flag ok;
+
+    if (!Latency_Enabled()) {
+        return T_TelemetryFrame_Decode(pVal, pBitStrm, pErrCode);
+    }
+    start = Latency_Now();
+    ok = T_TelemetryFrame_Decode(pVal, pBitStrm, pErrCode);
+    Latency_Record(LATENCY_OP_DECODE, ok ? (int)pVal->payload.kind : 0, ok ? 0 : *pErrCode,
+                   Latency_Now() - start);
+    return ok;
+}
+
+flag T_TelemetryFrame_PartialDecodeTimed(T_TelemetryFrame* pVal, BitStream* pBitStrm,
+                                         PartialContext* ctx, int* pErrCode) {
+    unsigned long long start;
+    flag ok;
+
+    if (!Latency_Enabled()) {
+        return T_TelemetryFrame_PartialDecode(pVal, pBitStrm, ctx, pErrCode);
+    }
+    start = Latency_Now();
+    ok = T_TelemetryFrame_PartialDecode(pVal, pBitStrm, ctx, pErrCode);
+    Latency_Record(LATENCY_OP_PARTIAL, ok ? (int)pVal->payload.kind : 0, ok ? 0 : *pErrCode,
+                   Latency_Now() - start);
+    return ok;
+}
+#endif
@@ -0,0 +1,103 @@
+/* asn1crt_latency.h - Per-thread log-linear latency histograms for encode/decode */
+#ifndef ASN1CRT_LATENCY_H
+#define ASN1CRT_LATENCY_H
+
+#include <stdio.h>
+#include "asn1crt.h"
+#include "asn1crt_partial.h"
+#include "satellite.h"
+
+/* Build with -DASN1CRT_LATENCY=0 to turn the *_Timed wrappers into plain calls */
+#ifndef ASN1CRT_LATENCY
+#define ASN1CRT_LATENCY 1
+#endif
+
+/* Log-linear buckets: exact below 32 ticks, then 16 sub-buckets per power
+ * of two (at most 1/16 relative error) up to 2^41 ticks */
+#define LATENCY_SUB_BUCKETS 16
+#define LATENCY_MAX_MSB 40
+#define LATENCY_BUCKETS (32 + (LATENCY_MAX_MSB - 4) * LATENCY_SUB_BUCKETS)
+
+/* payload.kind values 0..3; 0 collects frames whose kind is unknown */
+#define LATENCY_KINDS 4
+
+/* Distinct error codes tracked per op; later codes share the last slot */
+#define LATENCY_ERROR_SLOTS 8
+
+/* Instrumented entry points */
+typedef enum {
+    LATENCY_OP_ENCODE,
+    LATENCY_OP_DECODE,
+    LATENCY_OP_PARTIAL,
+    LATENCY_OP_COUNT
+} LatencyOp;
+
+/* One distribution, in clock ticks */
+typedef struct {
+    unsigned long long counts[LATENCY_BUCKETS];
+    unsigned long long total;     /* Samples recorded */
+    unsigned long long sumTicks;
+    unsigned long long maxTicks;
+} LatencyHistogram;
+
+/* Failed calls of one op that returned the same error code */
+typedef struct {
+    int code;                     /* 0 = unused slot, -1 = overflow slot */
+    LatencyHistogram hist;
+} LatencyErrorHistogram;
+
+/* Merged view over every thread's recorder */
+typedef struct {
+    LatencyHistogram ok[LATENCY_OP_COUNT][LATENCY_KINDS];
+    LatencyErrorHistogram errors[LATENCY_OP_COUNT][LATENCY_ERROR_SLOTS + 1];
+    double nsPerTick;             /* Tick to ns conversion for export */
+    int threads;                  /* Recorders merged */
+} LatencySnapshot;
+
+/* Switch recording on or off at runtime (off by default) */
+void Latency_SetEnabled(flag enabled);
+flag Latency_Enabled(void);
+
+/* Enable when the ASN1CRT_LATENCY environment variable is "1" */
+void Latency_InitFromEnv(void);
+
+/* Current tick count (rdtsc on x86, CLOCK_MONOTONIC ns elsewhere) */
+unsigned long long Latency_Now(void);
+
+/* Record one call in the calling thread's recorder. errCode 0 means
+ * success and files the sample under kind; otherwise under errCode. */
+void Latency_Record(LatencyOp op, int kind, int errCode, unsigned long long ticks);
+
+/* Merge all recorders without stopping writers; counts may trail by the
+ * calls in flight. Returns FALSE when nothing has been recorded. */
+flag Latency_Snapshot(LatencySnapshot* snap);
+
+/* Add one sample to a histogram; a single thread may write each histogram */
+void LatencyHistogram_Add(LatencyHistogram* h, unsigned long long ticks);
+
+/* Tick value at a percentile (0..100) of a histogram */
+unsigned long long LatencyHistogram_ValueAt(const LatencyHistogram* h, double pct);
+
+/* Prometheus text exposition (summary metrics in seconds) */
+void Latency_WritePrometheus(FILE* out, const LatencySnapshot* snap);
+
+/* One JSON object with p50/p99/p999/max in ns per op, kind and error code */
+void Latency_WriteJson(FILE* out, const LatencySnapshot* snap);
+
+const char* Latency_OpName(LatencyOp op);
+const char* Latency_KindName(int kind);
+
+#if ASN1CRT_LATENCY
+/* Same contract as the generated functions, timed when recording is enabled */
+flag T_TelemetryFrame_EncodeTimed(const T_TelemetryFrame* pVal, BitStream* pBitStrm,
+                                  int* pErrCode, flag bCheckConstraints);
+flag T_TelemetryFrame_DecodeTimed(T_TelemetryFrame* pVal, BitStream* pBitStrm, int* pErrCode);
+flag T_TelemetryFrame_PartialDecodeTimed(T_TelemetryFrame* pVal, BitStream* pBitStrm,
+                                         PartialContext* ctx, int* pErrCode);
+#else
+#define T_TelemetryFrame_EncodeTimed T_TelemetryFrame_Encode
+#define T_TelemetryFrame_DecodeTimed T_TelemetryFrame_Decode
+#define T_TelemetryFrame_PartialDecodeTimed T_TelemetryFrame_PartialDecode
+#endif
+
+#endif /* ASN1CRT_LATENCY_H */
@@ -0,0 +1,57 @@
+/* asn1crt_layout.h - uPER bit layout of satellite.asn (TelemetryFrame) */
+#ifndef ASN1CRT_LAYOUT_H
+#define ASN1CRT_LAYOUT_H
+
+/* Widths follow from the constraints in examples/satellite.asn: a constrained
+ * whole number in lo..hi takes ceil(log2(hi - lo + 1)) bits, SIZE(lo..hi)
+ * lengths are encoded the same way, CHOICE indices use ceil(log2(n)) bits.
+ * Keep in step with the schema; hand-written fast paths depend on these. */
+
+/* FrameHeader: timestamp, frameType, frameCount */
+#define LAYOUT_SECONDS_BITS         32   /* INTEGER (0..4294967295) */
+#define LAYOUT_SUBSECONDS_BITS      10   /* INTEGER (0..1000) */
+#define LAYOUT_SUBSECONDS_MAX       1000
+#define LAYOUT_FRAME_TYPE_BITS      8    /* INTEGER (0..255) */
+#define LAYOUT_FRAME_COUNT_BITS     16   /* INTEGER (0..65535) */
+#define LAYOUT_HEADER_BITS          66
+
+/* Bit offsets inside the header */
+#define LAYOUT_SECONDS_OFFSET       0
+#define LAYOUT_SUBSECONDS_OFFSET    32
+#define LAYOUT_FRAME_TYPE_OFFSET    42
+#define LAYOUT_FRAME_COUNT_OFFSET   50
+
+/* TelemetryPayload CHOICE index, straight after the header */
+#define LAYOUT_CHOICE_BITS          2
+#define LAYOUT_CHOICE_OFFSET        LAYOUT_HEADER_BITS
+#define LAYOUT_PAYLOAD_OFFSET       (LAYOUT_HEADER_BITS + LAYOUT_CHOICE_BITS)
+
+/* HousekeepingData */
+#define LAYOUT_VOLTAGE_BITS         13   /* INTEGER (0..5000) */
+#define LAYOUT_VOLTAGE_MAX          5000
+#define LAYOUT_TEMP_COUNT_BITS      3    /* SIZE (1..8) */
+#define LAYOUT_TEMP_COUNT_MIN       1
+#define LAYOUT_TEMP_COUNT_MAX       8
+#define LAYOUT_TEMP_BITS            8    /* INTEGER (-100..100) */
+#define LAYOUT_TEMP_MIN             (-100)
+#define LAYOUT_TEMP_MAX             100
+#define LAYOUT_STATUS_BITS          8    /* INTEGER (0..255) */
+
+/* ScienceData */
+#define LAYOUT_INSTRUMENT_BITS      8    /* INTEGER (0..255) */
+#define LAYOUT_BLOCK_COUNT_BITS     2    /* SIZE (1..4) */
+#define LAYOUT_BLOCK_COUNT_MIN      1
+#define LAYOUT_BLOCK_COUNT_MAX      4
+#define LAYOUT_BLOCK_LENGTH_BITS    8    /* OCTET STRING SIZE (1..256) */
+#define LAYOUT_BLOCK_LENGTH_MIN     1
+#define LAYOUT_BLOCK_LENGTH_MAX     256
+
+/* CommandAck */
+#define LAYOUT_COMMAND_ID_BITS      16   /* INTEGER (0..65535) */
+#define LAYOUT_ACK_STATUS_BITS      2    /* ENUMERATED, 4 values */
+#define LAYOUT_ACK_STATUS_MAX       3
+
+/* Smallest complete frame: header, index and a CommandAck, padded to bytes */
+#define LAYOUT_MIN_FRAME_BYTES      ((LAYOUT_PAYLOAD_OFFSET + LAYOUT_COMMAND_ID_BITS + LAYOUT_ACK_STATUS_BITS + 7) / 8)
+
+#endif /* ASN1CRT_LAYOUT_H */
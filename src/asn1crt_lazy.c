@@ -0,0 +1,309 @@
+/* asn1crt_lazy.c - Lazily decoded TelemetryFrame over an encoded buffer */
+#include "asn1crt_lazy.h"
+#include "asn1crt_internal.h"
+#include "asn1crt_layout.h"
+#include "asn1crt_encoding.h"
+#include <string.h>
+
+/* Offsets that follow from the layout without any skipping */
+#define LAZY_VOLTAGES_OFFSET     LAYOUT_PAYLOAD_OFFSET
+#define LAZY_TEMP_COUNT_OFFSET   (LAYOUT_PAYLOAD_OFFSET + 3 * LAYOUT_VOLTAGE_BITS)
+#define LAZY_TEMPS_OFFSET        (LAZY_TEMP_COUNT_OFFSET + LAYOUT_TEMP_COUNT_BITS)
+#define LAZY_INSTRUMENT_OFFSET   LAYOUT_PAYLOAD_OFFSET
+#define LAZY_BLOCK_COUNT_OFFSET  (LAYOUT_PAYLOAD_OFFSET + LAYOUT_INSTRUMENT_BITS)
+#define LAZY_FIRST_BLOCK_OFFSET  (LAZY_BLOCK_COUNT_OFFSET + LAYOUT_BLOCK_COUNT_BITS)
+#define LAZY_COMMAND_ID_OFFSET   LAYOUT_PAYLOAD_OFFSET
+#define LAZY_ACK_STATUS_OFFSET   (LAYOUT_PAYLOAD_OFFSET + LAYOUT_COMMAND_ID_BITS)
+
+void LazyFrame_Init(LazyFrame* lf, const byte* buf, int length) {
+    lf->buf = buf;
+    lf->length = length;
+    lf->cached = 0;
+    lf->statusOffset = 0;
+    lf->blocksLocated = 0;
+}
+
+/* Position a stream at a bit offset of the frame */
+static void Lazy_Seek(const LazyFrame* lf, BitStream* bs, int bitOffset) {
+    BitStream_AttachBuffer(bs, (unsigned char*)lf->buf, lf->length);
+    bs->currentByte = bitOffset >> 3;
+    bs->currentBit = bitOffset & 7;
+}
+
+static flag Lazy_Uint(BitStream* bs, asn1SccUint* v, asn1SccUint min, asn1SccUint max, int* pErrCode) {
+    if (!BitStream_DecodeConstraintPosWholeNumber(bs, v, min, max)) {
+        return Asn1crt_Fail(pErrCode, ERR_LAZY_INSUFFICIENT_DATA);
+    }
+    if (*v > max) return Asn1crt_Fail(pErrCode, ERR_LAZY_RANGE);
+    return TRUE;
+}
+
+static flag Lazy_Sint(BitStream* bs, asn1SccSint* v, asn1SccSint min, asn1SccSint max, int* pErrCode) {
+    if (!BitStream_DecodeConstraintWholeNumber(bs, v, min, max)) {
+        return Asn1crt_Fail(pErrCode, ERR_LAZY_INSUFFICIENT_DATA);
+    }
+    if (*v > max) return Asn1crt_Fail(pErrCode, ERR_LAZY_RANGE);
+    return TRUE;
+}
+
+/* One header field at its fixed offset */
+static flag Lazy_HeaderField(LazyFrame* lf, unsigned int bit, int offset, asn1SccUint max,
+                             asn1SccUint* field, asn1SccUint* value, int* pErrCode) {
+    if (!(lf->cached & bit)) {
+        BitStream bs;
+        Lazy_Seek(lf, &bs, offset);
+        if (!Lazy_Uint(&bs, field, 0, max, pErrCode)) return FALSE;
+        lf->cached |= bit;
+    }
+    *value = *field;
+    return TRUE;
+}
+
+flag LazyFrame_Seconds(LazyFrame* lf, asn1SccUint* value, int* pErrCode) {
+    return Lazy_HeaderField(lf, LAZY_CACHED_SECONDS, LAYOUT_SECONDS_OFFSET, 4294967295ULL,
+                            &lf->header.timestamp.seconds, value, pErrCode);
+}
+
+flag LazyFrame_Subseconds(LazyFrame* lf, asn1SccUint* value, int* pErrCode) {
+    return Lazy_HeaderField(lf, LAZY_CACHED_SUBSECONDS, LAYOUT_SUBSECONDS_OFFSET, LAYOUT_SUBSECONDS_MAX,
+                            &lf->header.timestamp.subseconds, value, pErrCode);
+}
+
+flag LazyFrame_FrameType(LazyFrame* lf, asn1SccUint* value, int* pErrCode) {
+    return Lazy_HeaderField(lf, LAZY_CACHED_FRAME_TYPE, LAYOUT_FRAME_TYPE_OFFSET, 255,
+                            &lf->header.frameType, value, pErrCode);
+}
+
+flag LazyFrame_FrameCount(LazyFrame* lf, asn1SccUint* value, int* pErrCode) {
+    return Lazy_HeaderField(lf, LAZY_CACHED_FRAME_COUNT, LAYOUT_FRAME_COUNT_OFFSET, 65535,
+                            &lf->header.frameCount, value, pErrCode);
+}
+
+flag LazyFrame_Header(LazyFrame* lf, T_FrameHeader* header, int* pErrCode) {
+    asn1SccUint v;
+    if (!LazyFrame_Seconds(lf, &v, pErrCode) || !LazyFrame_Subseconds(lf, &v, pErrCode) ||
+        !LazyFrame_FrameType(lf, &v, pErrCode) || !LazyFrame_FrameCount(lf, &v, pErrCode)) {
+        return FALSE;
+    }
+    *header = lf->header;
+    return TRUE;
+}
+
+flag LazyFrame_Kind(LazyFrame* lf, int* kind, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_KIND)) {
+        BitStream bs;
+        asn1SccUint choice;
+
+        Lazy_Seek(lf, &bs, LAYOUT_CHOICE_OFFSET);
+        if (!Lazy_Uint(&bs, &choice, 0, 2, pErrCode)) return FALSE;
+        lf->kind = choice == 0 ? housekeeping_PRESENT : choice == 1 ? science_PRESENT : commandAck_PRESENT;
+        lf->cached |= LAZY_CACHED_KIND;
+    }
+    *kind = lf->kind;
+    return TRUE;
+}
+
+static flag Lazy_RequireKind(LazyFrame* lf, int kind, int* pErrCode) {
+    int actual;
+    if (!LazyFrame_Kind(lf, &actual, pErrCode)) return FALSE;
+    if (actual != kind) return Asn1crt_Fail(pErrCode, ERR_LAZY_WRONG_KIND);
+    return TRUE;
+}
+
+flag LazyFrame_Voltages(LazyFrame* lf, T_VoltageReadings* voltages, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_VOLTAGES)) {
+        BitStream bs;
+
+        if (!Lazy_RequireKind(lf, housekeeping_PRESENT, pErrCode)) return FALSE;
+        Lazy_Seek(lf, &bs, LAZY_VOLTAGES_OFFSET);
+        if (!Lazy_Uint(&bs, &lf->voltages.mainBus, 0, LAYOUT_VOLTAGE_MAX, pErrCode) ||
+            !Lazy_Uint(&bs, &lf->voltages.payload, 0, LAYOUT_VOLTAGE_MAX, pErrCode) ||
+            !Lazy_Uint(&bs, &lf->voltages.comms, 0, LAYOUT_VOLTAGE_MAX, pErrCode)) {
+            return FALSE;
+        }
+        lf->cached |= LAZY_CACHED_VOLTAGES;
+    }
+    *voltages = lf->voltages;
+    return TRUE;
+}
+
+flag LazyFrame_Temperatures(LazyFrame* lf, const T_HousekeepingData_temperature** temperature, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_TEMPERATURES)) {
+        BitStream bs;
+        asn1SccSint count;
+
+        if (!Lazy_RequireKind(lf, housekeeping_PRESENT, pErrCode)) return FALSE;
+        Lazy_Seek(lf, &bs, LAZY_TEMP_COUNT_OFFSET);
+        if (!Lazy_Sint(&bs, &count, LAYOUT_TEMP_COUNT_MIN, LAYOUT_TEMP_COUNT_MAX, pErrCode)) return FALSE;
+        lf->temperature.nCount = (int)count;
+        for (int i = 0; i < lf->temperature.nCount; i++) {
+            if (!Lazy_Sint(&bs, &lf->temperature.arr[i], LAYOUT_TEMP_MIN, LAYOUT_TEMP_MAX, pErrCode)) {
+                return FALSE;
+            }
+        }
+        lf->statusOffset = (unsigned short)(LAZY_TEMPS_OFFSET + lf->temperature.nCount * LAYOUT_TEMP_BITS);
+        lf->cached |= LAZY_CACHED_TEMPERATURES;
+    }
+    *temperature = &lf->temperature;
+    return TRUE;
+}
+
+flag LazyFrame_Status(LazyFrame* lf, asn1SccUint* status, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_STATUS)) {
+        BitStream bs;
+
+        if (!Lazy_RequireKind(lf, housekeeping_PRESENT, pErrCode)) return FALSE;
+        if (lf->statusOffset == 0) {
+            /* Only the count is needed to skip the temperatures */
+            asn1SccSint count;
+            Lazy_Seek(lf, &bs, LAZY_TEMP_COUNT_OFFSET);
+            if (!Lazy_Sint(&bs, &count, LAYOUT_TEMP_COUNT_MIN, LAYOUT_TEMP_COUNT_MAX, pErrCode)) return FALSE;
+            lf->statusOffset = (unsigned short)(LAZY_TEMPS_OFFSET + (int)count * LAYOUT_TEMP_BITS);
+        }
+        Lazy_Seek(lf, &bs, lf->statusOffset);
+        if (!Lazy_Uint(&bs, &lf->status, 0, 255, pErrCode)) return FALSE;
+        lf->cached |= LAZY_CACHED_STATUS;
+    }
+    *status = lf->status;
+    return TRUE;
+}
+
+flag LazyFrame_InstrumentId(LazyFrame* lf, asn1SccUint* instrumentId, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_INSTRUMENT)) {
+        BitStream bs;
+
+        if (!Lazy_RequireKind(lf, science_PRESENT, pErrCode)) return FALSE;
+        Lazy_Seek(lf, &bs, LAZY_INSTRUMENT_OFFSET);
+        if (!Lazy_Uint(&bs, &lf->instrumentId, 0, 255, pErrCode)) return FALSE;
+        lf->cached |= LAZY_CACHED_INSTRUMENT;
+    }
+    *instrumentId = lf->instrumentId;
+    return TRUE;
+}
+
+flag LazyFrame_BlockCount(LazyFrame* lf, int* count, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_BLOCK_COUNT)) {
+        BitStream bs;
+        asn1SccSint n;
+
+        if (!Lazy_RequireKind(lf, science_PRESENT, pErrCode)) return FALSE;
+        Lazy_Seek(lf, &bs, LAZY_BLOCK_COUNT_OFFSET);
+        if (!Lazy_Sint(&bs, &n, LAYOUT_BLOCK_COUNT_MIN, LAYOUT_BLOCK_COUNT_MAX, pErrCode)) return FALSE;
+        lf->blockCount = (int)n;
+        lf->cached |= LAZY_CACHED_BLOCK_COUNT;
+    }
+    *count = lf->blockCount;
+    return TRUE;
+}
+
+/* Extend the offset map until dataBlocks[index] is located, reading only
+ * the length prefixes of the blocks in between */
+static flag Lazy_LocateBlock(LazyFrame* lf, int index, int* pErrCode) {
+    int count;
+    int offset;
+
+    if (index < lf->blocksLocated) return TRUE;
+    if (!LazyFrame_BlockCount(lf, &count, pErrCode)) return FALSE;
+    if (index < 0 || index >= count) return Asn1crt_Fail(pErrCode, ERR_LAZY_INDEX);
+
+    offset = lf->blocksLocated == 0
+             ? LAZY_FIRST_BLOCK_OFFSET
+             : lf->blockOffsets[lf->blocksLocated - 1] + lf->blockLengths[lf->blocksLocated - 1] * 8;
+    while (lf->blocksLocated <= index) {
+        BitStream bs;
+        asn1SccSint length;
+
+        Lazy_Seek(lf, &bs, offset);
+        if (!Lazy_Sint(&bs, &length, LAYOUT_BLOCK_LENGTH_MIN, LAYOUT_BLOCK_LENGTH_MAX, pErrCode)) return FALSE;
+        offset += LAYOUT_BLOCK_LENGTH_BITS;
+        if (offset + length * 8 > lf->length * 8) return Asn1crt_Fail(pErrCode, ERR_LAZY_INSUFFICIENT_DATA);
+        lf->blockOffsets[lf->blocksLocated] = (unsigned short)offset;
+        lf->blockLengths[lf->blocksLocated] = (short)length;
+        lf->blocksLocated++;
+        offset += (int)length * 8;
+    }
+    return TRUE;
+}
+
+flag LazyFrame_BlockLength(LazyFrame* lf, int index, int* length, int* pErrCode) {
+    if (!Lazy_LocateBlock(lf, index, pErrCode)) return FALSE;
+    *length = lf->blockLengths[index];
+    return TRUE;
+}
+
+flag LazyFrame_ReadBlock(LazyFrame* lf, int index, byte* out, int capacity, int* length, int* pErrCode) {
+    BitStream bs;
+    int n;
+
+    if (!Lazy_LocateBlock(lf, index, pErrCode)) return FALSE;
+    n = lf->blockLengths[index];
+    if (n > capacity) return Asn1crt_Fail(pErrCode, ERR_LAZY_CAPACITY);
+    if ((lf->blockOffsets[index] & 7) == 0) {
+        memcpy(out, lf->buf + (lf->blockOffsets[index] >> 3), (size_t)n);
+    } else {
+        Lazy_Seek(lf, &bs, lf->blockOffsets[index]);
+        if (!BitStream_ReadBits(&bs, out, n * 8)) return Asn1crt_Fail(pErrCode, ERR_LAZY_INSUFFICIENT_DATA);
+    }
+    *length = n;
+    return TRUE;
+}
+
+flag LazyFrame_CommandId(LazyFrame* lf, asn1SccUint* commandId, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_COMMAND_ID)) {
+        BitStream bs;
+
+        if (!Lazy_RequireKind(lf, commandAck_PRESENT, pErrCode)) return FALSE;
+        Lazy_Seek(lf, &bs, LAZY_COMMAND_ID_OFFSET);
+        if (!Lazy_Uint(&bs, &lf->commandId, 0, 65535, pErrCode)) return FALSE;
+        lf->cached |= LAZY_CACHED_COMMAND_ID;
+    }
+    *commandId = lf->commandId;
+    return TRUE;
+}
+
+flag LazyFrame_AckStatus(LazyFrame* lf, T_CommandAck_status* status, int* pErrCode) {
+    if (!(lf->cached & LAZY_CACHED_ACK_STATUS)) {
+        BitStream bs;
+        asn1SccUint value;
+
+        if (!Lazy_RequireKind(lf, commandAck_PRESENT, pErrCode)) return FALSE;
+        Lazy_Seek(lf, &bs, LAZY_ACK_STATUS_OFFSET);
+        if (!Lazy_Uint(&bs, &value, 0, LAYOUT_ACK_STATUS_MAX, pErrCode)) return FALSE;
+        /* Enumerants are declared 0..3, so the index is the value */
+        lf->ackStatus = (T_CommandAck_status)value;
+        lf->cached |= LAZY_CACHED_ACK_STATUS;
+    }
+    *status = lf->ackStatus;
+    return TRUE;
+}
+
+flag LazyFrame_Measure(const byte* buf, int length, int* frameBytes, int* kind, int* pErrCode) {
+    LazyFrame lf;
+    int bits;
+
+    LazyFrame_Init(&lf, buf, length);
+    if (!LazyFrame_Kind(&lf, kind, pErrCode)) return FALSE;
+
+    if (*kind == housekeeping_PRESENT) {
+        asn1SccUint status;
+        if (!LazyFrame_Status(&lf, &status, pErrCode)) return FALSE;
+        bits = lf.statusOffset + LAYOUT_STATUS_BITS;
+    } else if (*kind == science_PRESENT) {
+        int count;
+        if (!LazyFrame_BlockCount(&lf, &count, pErrCode) || !Lazy_LocateBlock(&lf, count - 1, pErrCode)) {
+            return FALSE;
+        }
+        bits = lf.blockOffsets[count - 1] + lf.blockLengths[count - 1] * 8;
+    } else {
+        bits = LAZY_ACK_STATUS_OFFSET + LAYOUT_ACK_STATUS_BITS;
+    }
+    *frameBytes = (bits + 7) / 8;
+    if (*frameBytes > length) return Asn1crt_Fail(pErrCode, ERR_LAZY_INSUFFICIENT_DATA);
+    return TRUE;
+}
+
+flag LazyFrame_Materialize(LazyFrame* lf, T_TelemetryFrame* pVal, int* pErrCode) {
+    BitStream bs;
+    Lazy_Seek(lf, &bs, 0);
+    return T_TelemetryFrame_Decode(pVal, &bs, pErrCode);
+}
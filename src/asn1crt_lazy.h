@@ -0,0 +1,98 @@
+/* asn1crt_lazy.h - Lazily decoded TelemetryFrame over an encoded buffer */
+#ifndef ASN1CRT_LAZY_H
+#define ASN1CRT_LAZY_H
+
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* Field accessor failures; LazyFrame_Materialize returns the generated decoder's codes */
+#define ERR_LAZY_INSUFFICIENT_DATA 1040  /* Buffer ends inside the requested field */
+#define ERR_LAZY_RANGE             1041  /* Encoded value outside its constraint */
+#define ERR_LAZY_WRONG_KIND        1042  /* Field belongs to another CHOICE alternative */
+#define ERR_LAZY_INDEX             1043  /* Array index past the encoded count */
+#define ERR_LAZY_CAPACITY          1044  /* Output buffer smaller than the block */
+
+/* Bits of LazyFrame.cached: values already decoded */
+#define LAZY_CACHED_SECONDS      (1u << 0)
+#define LAZY_CACHED_SUBSECONDS   (1u << 1)
+#define LAZY_CACHED_FRAME_TYPE   (1u << 2)
+#define LAZY_CACHED_FRAME_COUNT  (1u << 3)
+#define LAZY_CACHED_KIND         (1u << 4)
+#define LAZY_CACHED_VOLTAGES     (1u << 5)
+#define LAZY_CACHED_TEMPERATURES (1u << 6)
+#define LAZY_CACHED_STATUS       (1u << 7)
+#define LAZY_CACHED_INSTRUMENT   (1u << 8)
+#define LAZY_CACHED_BLOCK_COUNT  (1u << 9)
+#define LAZY_CACHED_COMMAND_ID   (1u << 10)
+#define LAZY_CACHED_ACK_STATUS   (1u << 11)
+
+/* Handle over one encoded frame. Nothing is decoded by LazyFrame_Init;
+ * each accessor decodes its field on first call and caches the value.
+ * Fields after a variable-length part (housekeeping status, science
+ * blocks) are found by skipping forward and their bit offsets kept, so a
+ * later access resumes from the furthest point already located. The
+ * buffer must stay valid and unchanged while the handle is in use. */
+typedef struct {
+    const byte* buf;              /* Encoded frame (uPER, no trailer) */
+    int length;                   /* Bytes in buf */
+    unsigned int cached;          /* LAZY_CACHED_* bits */
+
+    /* Offset map: bit positions located so far */
+    unsigned short statusOffset;  /* HousekeepingData.status, 0 = not located */
+    int blocksLocated;            /* dataBlocks[0..blocksLocated) have offsets */
+    unsigned short blockOffsets[4];  /* Bit position of each block's content */
+    short blockLengths[4];        /* Octets in each located block */
+
+    /* Cached values */
+    T_FrameHeader header;
+    int kind;                     /* payload.kind */
+    T_VoltageReadings voltages;
+    T_HousekeepingData_temperature temperature;
+    asn1SccUint status;
+    asn1SccUint instrumentId;
+    int blockCount;
+    asn1SccUint commandId;
+    T_CommandAck_status ackStatus;
+} LazyFrame;
+
+/* Attach to an encoded frame; decodes nothing */
+void LazyFrame_Init(LazyFrame* lf, const byte* buf, int length);
+
+/* Header */
+flag LazyFrame_Seconds(LazyFrame* lf, asn1SccUint* value, int* pErrCode);
+flag LazyFrame_Subseconds(LazyFrame* lf, asn1SccUint* value, int* pErrCode);
+flag LazyFrame_FrameType(LazyFrame* lf, asn1SccUint* value, int* pErrCode);
+flag LazyFrame_FrameCount(LazyFrame* lf, asn1SccUint* value, int* pErrCode);
+flag LazyFrame_Header(LazyFrame* lf, T_FrameHeader* header, int* pErrCode);
+
+/* payload.kind (housekeeping_PRESENT, science_PRESENT, commandAck_PRESENT) */
+flag LazyFrame_Kind(LazyFrame* lf, int* kind, int* pErrCode);
+
+/* HousekeepingData; ERR_LAZY_WRONG_KIND on other payloads */
+flag LazyFrame_Voltages(LazyFrame* lf, T_VoltageReadings* voltages, int* pErrCode);
+flag LazyFrame_Temperatures(LazyFrame* lf, const T_HousekeepingData_temperature** temperature, int* pErrCode);
+flag LazyFrame_Status(LazyFrame* lf, asn1SccUint* status, int* pErrCode);
+
+/* ScienceData. Block contents are never cached: LazyFrame_ReadBlock
+ * copies from the located offset each call, and blocks nobody asks for
+ * are skipped by length without reading their octets. A 256-byte out
+ * buffer always suffices. */
+flag LazyFrame_InstrumentId(LazyFrame* lf, asn1SccUint* instrumentId, int* pErrCode);
+flag LazyFrame_BlockCount(LazyFrame* lf, int* count, int* pErrCode);
+flag LazyFrame_BlockLength(LazyFrame* lf, int index, int* length, int* pErrCode);
+flag LazyFrame_ReadBlock(LazyFrame* lf, int index, byte* out, int capacity, int* length, int* pErrCode);
+
+/* CommandAck */
+flag LazyFrame_CommandId(LazyFrame* lf, asn1SccUint* commandId, int* pErrCode);
+flag LazyFrame_AckStatus(LazyFrame* lf, T_CommandAck_status* status, int* pErrCode);
+
+/* Size of the frame starting at buf, found by skipping through the
+ * layout (lengths and counts only) without decoding any values. Lets a
+ * reader walk back-to-back frames in one buffer. kind gets payload.kind. */
+flag LazyFrame_Measure(const byte* buf, int length, int* frameBytes, int* kind, int* pErrCode);
+
+/* Full decode with the generated decoder, for consumers that end up
+ * needing everything */
+flag LazyFrame_Materialize(LazyFrame* lf, T_TelemetryFrame* pVal, int* pErrCode);
+
+#endif /* ASN1CRT_LAZY_H */
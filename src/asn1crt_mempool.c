@@ -1,9 +1,191 @@
+#define _GNU_SOURCE
 #include "asn1crt_mempool.h"
+#include "asn1crt_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define MEMPOOL_HUGE_PAGE       ((size_t)2 << 20)  /* When the kernel does not say */
+#define MEMPOOL_MPOL_PREFERRED  1     /* linux/mempolicy.h, without needing libnuma */
+#define MEMPOOL_NODE_BITS       1024
 
 void MemPool_Init(MemPool* pool, byte* buffer, size_t size) {
     pool->buffer = buffer;
     pool->size = size;
     pool->used = 0;
+    pool->peak = 0;
+    pool->mapped = 0;
+    pool->mapFlags = 0;
+    pool->pageSize = 0;
+}
+
+static size_t MemPool_RoundUp(size_t size, size_t unit) {
+    return (size + unit - 1) / unit * unit;
+}
+
+/* First "<key> <number>" line of path, times scale; fallback when absent */
+static size_t MemPool_ReadSize(const char* path, const char* key, size_t scale, size_t fallback) {
+    char line[128];
+    unsigned long long value = 0;
+    size_t keyLength = strlen(key);
+    FILE* f = fopen(path, "r");
+
+    if (f == NULL) {
+        return fallback;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, key, keyLength) == 0 && sscanf(line + keyLength, " %llu", &value) == 1) {
+            break;
+        }
+        value = 0;
+    }
+    fclose(f);
+    return value > 0 ? (size_t)value * scale : fallback;
+}
+
+/* Default hugetlbfs page, which MAP_HUGETLB without a size flag uses: 2 MB
+ * on x86-64, 512 MB on 64K-page arm64, 1 GB when booted that way */
+static size_t MemPool_HugetlbPage(void) {
+    return MemPool_ReadSize("/proc/meminfo", "Hugepagesize:", 1024, MEMPOOL_HUGE_PAGE);
+}
+
+/* PMD size, the only extent THP backs with a huge page */
+static size_t MemPool_ThpPage(void) {
+    return MemPool_ReadSize("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "", 1, MEMPOOL_HUGE_PAGE);
+}
+
+/* madvise(MADV_HUGEPAGE) succeeds whatever the system mode is; huge
+ * pages only follow when the bracketed mode is [always] or [madvise] */
+static flag MemPool_ThpEnabled(void) {
+    char line[128];
+    FILE* f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    flag enabled = FALSE;
+
+    if (f == NULL) {
+        return FALSE;
+    }
+    if (fgets(line, sizeof(line), f) != NULL) {
+        enabled = strstr(line, "[always]") != NULL || strstr(line, "[madvise]") != NULL;
+    }
+    fclose(f);
+    return enabled;
+}
+
+static byte* MemPool_Map(size_t length, int extraFlags) {
+    void* p = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+    return p == MAP_FAILED ? NULL : (byte*)p;
+}
+
+/* THP only backs whole aligned huge page extents: map a huge page extra
+ * and trim both ends so the arena starts on one */
+static byte* MemPool_MapAligned(size_t length, size_t huge) {
+    byte* raw = MemPool_Map(length + huge, 0);
+    size_t head;
+
+    if (raw == NULL) {
+        return NULL;
+    }
+    head = (huge - (size_t)raw % huge) % huge;
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    munmap(raw + head + length, huge - head);
+    return raw + head;
+}
+
+/* MPOL_PREFERRED rather than MPOL_BIND: allocations spill to another node
+ * under memory pressure instead of failing */
+static flag MemPool_BindLocal(byte* base, size_t length) {
+#if defined(SYS_mbind) && defined(SYS_getcpu)
+    unsigned long mask[MEMPOOL_NODE_BITS / (8 * sizeof(unsigned long))] = { 0 };
+    const unsigned int wordBits = 8 * sizeof(unsigned long);
+    unsigned int cpu;
+    unsigned int node;
+
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= MEMPOOL_NODE_BITS) {
+        return FALSE;
+    }
+    mask[node / wordBits] = 1UL << (node % wordBits);
+    /* The kernel drops the top bit of maxnode, hence the + 1 */
+    return syscall(SYS_mbind, base, length, MEMPOOL_MPOL_PREFERRED, mask, MEMPOOL_NODE_BITS + 1, 0) == 0;
+#else
+    (void)base;
+    (void)length;
+    return FALSE;
+#endif
+}
+
+/* One write per page; MADV_POPULATE_WRITE (Linux 5.14) does the same in
+ * a single call */
+static void MemPool_Prefault(byte* base, size_t length, size_t page) {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(base, length, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    for (size_t off = 0; off < length; off += page) {
+        ((volatile byte*)base)[off] = 0;
+    }
+}
+
+flag MemPool_InitMapped(MemPool* pool, size_t size, int flags, int* pErrCode) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = 0;
+    byte* base = NULL;
+    size_t extent = page;  /* Alignment and rounding the backing took */
+    int took = 0;
+
+    MemPool_Init(pool, NULL, 0);
+    if (size == 0) {
+        return Asn1crt_Fail(pErrCode, ERR_MEMPOOL_MAP);
+    }
+#ifdef MAP_HUGETLB
+    if ((flags & MEMPOOL_MAP_HUGETLB) != 0) {
+        /* munmap needs the length rounded to the same page the kernel used */
+        size_t huge = MemPool_HugetlbPage();
+        length = MemPool_RoundUp(size, huge);
+        base = MemPool_Map(length, MAP_HUGETLB);
+        if (base != NULL) {
+            took |= MEMPOOL_MAP_HUGETLB;
+            page = huge;
+            extent = huge;
+        }
+    }
+#endif
+    if (base == NULL && (flags & MEMPOOL_MAP_THP) != 0) {
+        size_t huge = MemPool_ThpPage();
+        length = MemPool_RoundUp(size, huge);
+        base = MemPool_MapAligned(length, huge);
+#ifdef MADV_HUGEPAGE
+        if (base != NULL && madvise(base, length, MADV_HUGEPAGE) == 0 && MemPool_ThpEnabled()) {
+            took |= MEMPOOL_MAP_THP;
+            extent = huge;
+        }
+#endif
+    }
+    if (base == NULL) {
+        length = MemPool_RoundUp(size, page);
+        base = MemPool_Map(length, 0);
+    }
+    if (base == NULL) {
+        return Asn1crt_Fail(pErrCode, ERR_MEMPOOL_MAP);
+    }
+
+    /* Policy before the first touch, so prefaulted pages land on the node */
+    if ((flags & MEMPOOL_MAP_NUMA) != 0 && MemPool_BindLocal(base, length)) {
+        took |= MEMPOOL_MAP_NUMA;
+    }
+    if ((flags & MEMPOOL_MAP_PREFAULT) != 0) {
+        MemPool_Prefault(base, length, page);
+        took |= MEMPOOL_MAP_PREFAULT;
+    }
+    MemPool_Init(pool, base, length);
+    pool->mapped = length;
+    pool->mapFlags = took;
+    pool->pageSize = extent;
+    return TRUE;
 }
 
 void* MemPool_Alloc(MemPool* pool, size_t size) {
@@ -11,9 +193,17 @@ void* MemPool_Alloc(MemPool* pool, size_t size) {
     if (pool->used + size > pool->size) return NULL;
     void* ptr = pool->buffer + pool->used;
     pool->used += size;
+    if (pool->used > pool->peak) pool->peak = pool->used;
     return ptr;
 }
 
 void MemPool_Reset(MemPool* pool) {
     pool->used = 0;
 }
+
+void MemPool_Destroy(MemPool* pool) {
+    if (pool->mapped > 0) {
+        munmap(pool->buffer, pool->mapped);
+    }
+    MemPool_Init(pool, NULL, 0);
+}
@@ -4,20 +4,45 @@
 
 #include "asn1crt.h"  // Must include base runtime first
 
+/* MemPool_InitMapped failure (zero size or mmap refused); Alloc just returns NULL */
+#define ERR_MEMPOOL_MAP  1130  /* mmap of the backing failed */
+
+/* Backing options for MemPool_InitMapped; each falls back when the
+ * system cannot provide it, and MemPool.mapFlags keeps the ones that took */
+#define MEMPOOL_MAP_HUGETLB   0x1  /* Explicit huge pages (MAP_HUGETLB) of the default Hugepagesize,
+                                    * needs nr_hugepages reserved */
+#define MEMPOOL_MAP_THP       0x2  /* Transparent huge pages via madvise(MADV_HUGEPAGE); kept
+                                    * only when the THP mode is always or madvise */
+#define MEMPOOL_MAP_PREFAULT  0x4  /* Fault every page in now instead of on first use */
+#define MEMPOOL_MAP_NUMA      0x8  /* Prefer the calling thread's NUMA node (mbind) */
+
 /* Simple memory pool structure */
 typedef struct {
     byte* buffer;     /* Pool buffer */
     size_t size;      /* Total size */
     size_t used;      /* Bytes allocated */
+    size_t peak;      /* High-water mark of used, survives MemPool_Reset */
+    size_t mapped;    /* Length MemPool_InitMapped mapped, 0 for a caller's buffer */
+    int mapFlags;     /* MEMPOOL_MAP_* in effect */
+    size_t pageSize;  /* Page (huge page when one took) the mapping is aligned and sized to */
 } MemPool;
 
 /* Initialization */
 void MemPool_Init(MemPool* pool, byte* buffer, size_t size);
 
+/* Initialization with backing the pool maps itself: at least size bytes,
+ * rounded up to whole pages (huge pages when those took). Fails only
+ * when no mapping at all can be made. */
+flag MemPool_InitMapped(MemPool* pool, size_t size, int flags, int* pErrCode);
+
 /* Allocation (returns NULL if out of memory) */
 void* MemPool_Alloc(MemPool* pool, size_t size);
 
 /* Reset pool (does NOT free memory) */
 void MemPool_Reset(MemPool* pool);
 
+/* Unmap backing from MemPool_InitMapped and empty the pool; a buffer
+ * passed to MemPool_Init stays with its owner */
+void MemPool_Destroy(MemPool* pool);
+
 #endif /* ASN1CRT_MEMPOOL_H */
@@ -0,0 +1,200 @@
+/* asn1crt_outring.c - Encode-in-place output ring flushed with writev/sendmmsg */
+#define _GNU_SOURCE
+#include "asn1crt_outring.h"
+#include "asn1crt_internal.h"
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/* Result of one writev/sendmmsg attempt */
+#define OUTRING_MOVED    1
+#define OUTRING_BLOCKED  0
+#define OUTRING_FAILED  (-1)
+
+void OutRingConfig_Default(OutRingConfig* cfg) {
+    memset(cfg, 0, sizeof(OutRingConfig));
+    cfg->mode = OUTRING_STREAM;
+    cfg->slotCount = 256;
+    cfg->batchSize = OUTRING_MAX_BATCH;
+    cfg->integrity = INTEGRITY_NONE;
+}
+
+static int OutRing_BatchSize(const OutRingConfig* cfg) {
+    if (cfg->batchSize <= 0 || cfg->batchSize > OUTRING_MAX_BATCH) {
+        return OUTRING_MAX_BATCH;
+    }
+    return cfg->batchSize;
+}
+
+/* slotCount rounded up to a power of two no smaller than the batch */
+static int OutRing_SlotCount(const OutRingConfig* cfg) {
+    int count = 1;
+    int wanted = cfg->slotCount > OutRing_BatchSize(cfg) ? cfg->slotCount : OutRing_BatchSize(cfg);
+
+    while (count < wanted) count <<= 1;
+    return count;
+}
+
+size_t OutRing_PoolBytes(const OutRingConfig* cfg) {
+    size_t slots = (size_t)OutRing_SlotCount(cfg);
+
+    return Asn1crt_Round8(sizeof(struct iovec) * OUTRING_MAX_BATCH) +
+           Asn1crt_Round8(sizeof(struct mmsghdr) * OUTRING_MAX_BATCH) +
+           OUTRING_SLOT_SIZE * slots +
+           Asn1crt_Round8(sizeof(int) * slots);
+}
+
+flag OutRing_Open(OutRing* ring, int fd, const OutRingConfig* cfg, MemPool* pool, int* pErrCode) {
+    memset(ring, 0, sizeof(OutRing));
+    ring->fd = fd;
+    ring->mode = cfg->mode;
+    ring->integrity = cfg->integrity;
+    ring->slotCount = OutRing_SlotCount(cfg);
+    ring->batchSize = OutRing_BatchSize(cfg);
+
+    /* Headers first so they keep the pool's base alignment; slots are 8-byte multiples */
+    ring->iovs = (struct iovec*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(struct iovec) * OUTRING_MAX_BATCH));
+    ring->msgs = (struct mmsghdr*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(struct mmsghdr) * OUTRING_MAX_BATCH));
+    ring->slots = (byte*)MemPool_Alloc(pool, OUTRING_SLOT_SIZE * (size_t)ring->slotCount);
+    ring->lengths = (int*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(int) * (size_t)ring->slotCount));
+    if (!ring->iovs || !ring->msgs || !ring->slots || !ring->lengths) {
+        return Asn1crt_Fail(pErrCode, ERR_OUTRING_POOL);
+    }
+
+    memset(ring->msgs, 0, sizeof(struct mmsghdr) * OUTRING_MAX_BATCH);
+    for (int i = 0; i < OUTRING_MAX_BATCH; i++) {
+        ring->msgs[i].msg_hdr.msg_iov = &ring->iovs[i];
+        ring->msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    return TRUE;
+}
+
+int OutRing_Pending(const OutRing* ring) {
+    return (int)(ring->head - ring->tail);
+}
+
+static byte* OutRing_Slot(const OutRing* ring, unsigned long seq) {
+    return ring->slots + (seq & (unsigned long)(ring->slotCount - 1)) * OUTRING_SLOT_SIZE;
+}
+
+static int OutRing_Length(const OutRing* ring, unsigned long seq) {
+    return ring->lengths[seq & (unsigned long)(ring->slotCount - 1)];
+}
+
+/* Point iovs at up to OUTRING_MAX_BATCH committed slots from the tail */
+static int OutRing_Gather(OutRing* ring) {
+    int count = OutRing_Pending(ring) < OUTRING_MAX_BATCH ? OutRing_Pending(ring) : OUTRING_MAX_BATCH;
+
+    for (int i = 0; i < count; i++) {
+        unsigned long seq = ring->tail + (unsigned long)i;
+        size_t skip = i == 0 ? ring->tailOffset : 0;
+        ring->iovs[i].iov_base = OutRing_Slot(ring, seq) + skip;
+        ring->iovs[i].iov_len = (size_t)OutRing_Length(ring, seq) - skip;
+    }
+    return count;
+}
+
+static int OutRing_Error(int* pErrCode) {
+    /* A connected datagram socket reports an earlier ICMP port-unreachable
+     * once, instead of sending; retrying sends the batch */
+    if (errno == EINTR || errno == ECONNREFUSED) return OUTRING_MOVED;
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) return OUTRING_BLOCKED;
+    *pErrCode = ERR_OUTRING_IO;
+    return OUTRING_FAILED;
+}
+
+static int OutRing_WriteStream(OutRing* ring, int* pErrCode) {
+    int count = OutRing_Gather(ring);
+    ssize_t n = writev(ring->fd, ring->iovs, count);
+
+    if (n < 0) return OutRing_Error(pErrCode);
+    ring->stats.syscalls++;
+    ring->stats.bytes += (unsigned long)n;
+
+    /* Retire whole slots; a short write leaves the rest of one for next time */
+    while (n > 0) {
+        size_t remaining = (size_t)OutRing_Length(ring, ring->tail) - ring->tailOffset;
+        if ((size_t)n < remaining) {
+            ring->tailOffset += (size_t)n;
+            ring->stats.shortWrites++;
+            break;
+        }
+        n -= (ssize_t)remaining;
+        ring->tail++;
+        ring->tailOffset = 0;
+        ring->stats.flushed++;
+    }
+    return OUTRING_MOVED;
+}
+
+static int OutRing_SendDatagrams(OutRing* ring, int* pErrCode) {
+    int count = OutRing_Gather(ring);
+    int n = sendmmsg(ring->fd, ring->msgs, (unsigned int)count, 0);
+
+    if (n < 0) return OutRing_Error(pErrCode);
+    ring->stats.syscalls++;
+    for (int i = 0; i < n; i++) ring->stats.bytes += ring->iovs[i].iov_len;
+    ring->tail += (unsigned long)n;
+    ring->stats.flushed += (unsigned long)n;
+    return OUTRING_MOVED;
+}
+
+flag OutRing_Flush(OutRing* ring, int* pErrCode) {
+    while (ring->tail != ring->head) {
+        int result = ring->mode == OUTRING_STREAM ? OutRing_WriteStream(ring, pErrCode)
+                                                  : OutRing_SendDatagrams(ring, pErrCode);
+        if (result == OUTRING_FAILED) return FALSE;
+        if (result == OUTRING_BLOCKED) break;
+    }
+    return TRUE;
+}
+
+flag OutRing_Wait(OutRing* ring, int timeoutMs, int* pErrCode) {
+    struct pollfd pfd;
+
+    pfd.fd = ring->fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeoutMs) < 0 && errno != EINTR) return Asn1crt_Fail(pErrCode, ERR_OUTRING_IO);
+    return OutRing_Flush(ring, pErrCode);
+}
+
+byte* OutRing_Reserve(OutRing* ring, int* pErrCode) {
+    if (OutRing_Pending(ring) == ring->slotCount) {
+        if (!OutRing_Flush(ring, pErrCode)) return NULL;
+        if (OutRing_Pending(ring) == ring->slotCount) {
+            ring->stats.fullEvents++;
+            Asn1crt_Fail(pErrCode, ERR_OUTRING_FULL);
+            return NULL;
+        }
+    }
+    return OutRing_Slot(ring, ring->head);
+}
+
+flag OutRing_Commit(OutRing* ring, int length, int* pErrCode) {
+    if (length <= 0 || length > OUTRING_SLOT_SIZE) return Asn1crt_Fail(pErrCode, ERR_OUTRING_LENGTH);
+    if (OutRing_Pending(ring) == ring->slotCount) return Asn1crt_Fail(pErrCode, ERR_OUTRING_FULL);
+
+    ring->lengths[ring->head & (unsigned long)(ring->slotCount - 1)] = length;
+    ring->head++;
+    ring->stats.frames++;
+
+    /* Flush on whole batches so a backed-up fd costs one failed attempt per batch */
+    if (OutRing_Pending(ring) >= ring->batchSize && ring->stats.frames % (unsigned long)ring->batchSize == 0) {
+        return OutRing_Flush(ring, pErrCode);
+    }
+    return TRUE;
+}
+
+flag OutRing_Encode(OutRing* ring, const T_TelemetryFrame* frame, int* pErrCode) {
+    byte* slot = OutRing_Reserve(ring, pErrCode);
+    int length;
+
+    if (slot == NULL) return FALSE;
+    if (!FrameIntegrity_EncodeFrame(frame, ring->integrity, slot, OUTRING_SLOT_SIZE, &length, pErrCode)) {
+        return FALSE;
+    }
+    return OutRing_Commit(ring, length, pErrCode);
+}
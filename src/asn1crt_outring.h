@@ -0,0 +1,97 @@
+/* asn1crt_outring.h - Encode-in-place output ring flushed with writev/sendmmsg */
+#ifndef ASN1CRT_OUTRING_H
+#define ASN1CRT_OUTRING_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "asn1crt_integrity.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* Ring setup and flush failures; Encode passes generated encoder errors through */
+#define ERR_OUTRING_IO      1070  /* writev/sendmmsg failed */
+#define ERR_OUTRING_FULL    1071  /* Every slot holds unflushed data and the fd would block */
+#define ERR_OUTRING_POOL    1072  /* Pool too small for the ring */
+#define ERR_OUTRING_LENGTH  1073  /* Committed more than a slot holds */
+
+/* One encoded frame plus trailer, rounded to 8 bytes */
+#define OUTRING_SLOT_SIZE ((T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + INTEGRITY_MAX_TRAILER + 7) & ~7)
+
+/* Slots handed to the kernel per writev/sendmmsg */
+#define OUTRING_MAX_BATCH 64
+
+struct iovec;
+struct mmsghdr;
+
+typedef enum {
+    OUTRING_STREAM,    /* File, pipe or stream socket: slots concatenated by writev */
+    OUTRING_DATAGRAM   /* Connected datagram socket: one datagram per slot via sendmmsg */
+} OutRingMode;
+
+typedef struct {
+    OutRingMode mode;
+    int slotCount;            /* Power of two, at least batchSize */
+    int batchSize;            /* Committed slots that trigger a flush (1..OUTRING_MAX_BATCH) */
+    IntegrityKind integrity;  /* Trailer appended by OutRing_Encode */
+} OutRingConfig;
+
+typedef struct {
+    unsigned long frames;       /* Slots committed */
+    unsigned long flushed;      /* Slots fully handed to the kernel */
+    unsigned long bytes;        /* Bytes handed to the kernel */
+    unsigned long syscalls;     /* writev/sendmmsg calls that moved data */
+    unsigned long shortWrites;  /* writev calls that stopped inside a slot */
+    unsigned long fullEvents;   /* Times the ring was full and the fd would block */
+} OutRingStats;
+
+/* Frames are encoded straight into slots[seq % slotCount]; tail..head is
+ * the committed, unflushed window. Stream mode may have written the first
+ * tailOffset bytes of the tail slot already. */
+typedef struct {
+    int fd;                    /* Not owned; O_NONBLOCK makes a full ring report ERR_OUTRING_FULL */
+    OutRingMode mode;
+    IntegrityKind integrity;
+    int slotCount;
+    int batchSize;
+    byte* slots;               /* slotCount * OUTRING_SLOT_SIZE */
+    int* lengths;              /* Committed bytes per slot */
+    struct iovec* iovs;        /* OUTRING_MAX_BATCH */
+    struct mmsghdr* msgs;      /* OUTRING_MAX_BATCH, datagram mode */
+    unsigned long head;        /* Next slot to fill */
+    unsigned long tail;        /* Oldest unflushed slot */
+    size_t tailOffset;
+    OutRingStats stats;
+} OutRing;
+
+/* Fill a config with defaults (stream, 256 slots, flush every 64) */
+void OutRingConfig_Default(OutRingConfig* cfg);
+
+/* Pool bytes OutRing_Open will carve for this config */
+size_t OutRing_PoolBytes(const OutRingConfig* cfg);
+
+/* Attach a ring to fd; all buffers come from pool */
+flag OutRing_Open(OutRing* ring, int fd, const OutRingConfig* cfg, MemPool* pool, int* pErrCode);
+
+/* Encode a frame (plus trailer) directly into the next slot; flushes a
+ * batch once batchSize slots are waiting */
+flag OutRing_Encode(OutRing* ring, const T_TelemetryFrame* frame, int* pErrCode);
+
+/* Next free slot (OUTRING_SLOT_SIZE bytes) for bytes produced elsewhere,
+ * e.g. frames being re-broadcast. Flushes first when the ring is full. */
+byte* OutRing_Reserve(OutRing* ring, int* pErrCode);
+
+/* Queue the first length bytes of the reserved slot */
+flag OutRing_Commit(OutRing* ring, int length, int* pErrCode);
+
+/* Hand every committed slot to the kernel. On a non-blocking fd this stops
+ * early, without error, once the kernel would block; OutRing_Pending says
+ * what is left. */
+flag OutRing_Flush(OutRing* ring, int* pErrCode);
+
+/* Wait up to timeoutMs for the fd to accept data, then flush */
+flag OutRing_Wait(OutRing* ring, int timeoutMs, int* pErrCode);
+
+/* Committed slots not yet fully written */
+int OutRing_Pending(const OutRing* ring);
+
+#endif /* ASN1CRT_OUTRING_H */
@@ -0,0 +1,311 @@
+/* asn1crt_parallel.c - Shard-by-source parallel decoding implementation */
+#include "asn1crt_parallel.h"
+#include "asn1crt_internal.h"
+#include "asn1crt_latency.h"
+#include <string.h>
+#include <time.h>
+
+/* maxSources rounded up to a power of two so probes wrap with a mask */
+static unsigned int Parallel_SourceCapacity(const ParallelConfig* cfg) {
+    unsigned int capacity = 1;
+    while ((int)capacity < cfg->maxSources) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/* Worker-private arena: queue, slot bytes, source table and reorder windows */
+static size_t Parallel_WorkerBytes(const ParallelConfig* cfg) {
+    unsigned int capacity = Parallel_SourceCapacity(cfg);
+    return Asn1crt_Round8(sizeof(ParallelSlot) * cfg->queueDepth) +
+           (size_t)PARALLEL_SLOT_BYTES * cfg->queueDepth +
+           Asn1crt_Round8(sizeof(ParallelSource) * capacity) +
+           ReorderBuffer_PoolBytes(cfg->reorderWindow) * capacity;
+}
+
+void ParallelConfig_Default(ParallelConfig* cfg) {
+    cfg->workers = 4;
+    cfg->queueDepth = 256;
+    cfg->reorderWindow = 64;
+    cfg->maxSources = 32;
+    cfg->maxHoldUs = 50000;
+}
+
+size_t ParallelDecoder_PoolBytes(const ParallelConfig* cfg) {
+    return Parallel_WorkerBytes(cfg) * (size_t)cfg->workers;
+}
+
+/* Source IDs are often small and sequential, so mix before picking a worker */
+static unsigned int Parallel_Hash(unsigned int sourceId) {
+    sourceId ^= sourceId >> 16;
+    sourceId *= 0x45d9f3bU;
+    sourceId ^= sourceId >> 16;
+    return sourceId;
+}
+
+static ParallelSource* Parallel_FindSource(ParallelWorker* w, unsigned int sourceId) {
+    const ParallelConfig* cfg = &w->owner->config;
+    unsigned int capacity = Parallel_SourceCapacity(cfg);
+    unsigned int idx = Parallel_Hash(sourceId) & (capacity - 1);
+
+    for (unsigned int probe = 0; probe < capacity; probe++) {
+        ParallelSource* src = &w->sources[(idx + probe) & (capacity - 1)];
+        if (src->used && src->sourceId == sourceId) {
+            return src;
+        }
+        if (!src->used) {
+            if (!ReorderBuffer_Init(&src->reorder, &w->pool, cfg->reorderWindow)) {
+                return NULL;
+            }
+            src->used = TRUE;
+            src->sourceId = sourceId;
+            return src;
+        }
+    }
+    return NULL;
+}
+
+static void Parallel_Emit(const T_TelemetryFrame* frame, void* userData) {
+    ParallelWorker* w = (ParallelWorker*)userData;
+    w->owner->emit(w->currentSource, frame, w->owner->userData);
+}
+
+static void Parallel_ExpireAll(ParallelWorker* w, unsigned long long nowNs, flag flush) {
+    unsigned int capacity = Parallel_SourceCapacity(&w->owner->config);
+    unsigned long long maxHoldNs = (unsigned long long)w->owner->config.maxHoldUs * 1000ULL;
+
+    for (unsigned int i = 0; i < capacity; i++) {
+        ParallelSource* src = &w->sources[i];
+        if (!src->used || src->reorder.held == 0) {
+            continue;
+        }
+        w->currentSource = src->sourceId;
+        if (flush) {
+            ReorderBuffer_Flush(&src->reorder, Parallel_Emit, w);
+        } else {
+            ReorderBuffer_Expire(&src->reorder, nowNs, maxHoldNs, Parallel_Emit, w);
+        }
+    }
+}
+
+static void Parallel_DecodeSlot(ParallelWorker* w, const ParallelSlot* slot, unsigned long long nowNs) {
+    BitStream bs;
+    int errCode;
+    ParallelSource* src;
+
+    BitStream_AttachBuffer(&bs, slot->data, slot->size);
+    if (!T_TelemetryFrame_DecodeTimed(&w->scratch, &bs, &errCode)) {
+        w->stats.decodeErrors++;
+        return;
+    }
+    w->stats.decoded++;
+
+    src = Parallel_FindSource(w, slot->sourceId);
+    if (src == NULL) {
+        w->stats.sourceOverflow++;
+        return;
+    }
+    w->currentSource = slot->sourceId;
+    ReorderBuffer_Push(&src->reorder, &w->scratch, nowNs, Parallel_Emit, w);
+}
+
+static void* Parallel_WorkerMain(void* arg) {
+    ParallelWorker* w = (ParallelWorker*)arg;
+    const ParallelConfig* cfg = &w->owner->config;
+    unsigned long long tickNs = (unsigned long long)cfg->maxHoldUs * 500ULL;
+    unsigned long long lastExpire = Asn1crt_NowNs();
+
+    if (tickNs < 1000000ULL) {
+        tickNs = 1000000ULL;
+    }
+
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+        int start, n;
+        unsigned long long now;
+
+        while (w->count == 0 && !w->stopping) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_nsec += (long)(tickNs % 1000000000ULL);
+            deadline.tv_sec += (time_t)(tickNs / 1000000000ULL) + deadline.tv_nsec / 1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+
+            if (pthread_cond_timedwait(&w->notEmpty, &w->lock, &deadline) != 0) {
+                /* Idle: still release gaps that have waited long enough */
+                pthread_mutex_unlock(&w->lock);
+                lastExpire = Asn1crt_NowNs();
+                Parallel_ExpireAll(w, lastExpire, FALSE);
+                pthread_mutex_lock(&w->lock);
+            }
+        }
+        if (w->count == 0 && w->stopping) {
+            break;
+        }
+
+        /* Take the whole backlog; the producer only writes free slots */
+        start = w->tail;
+        n = w->count;
+        pthread_mutex_unlock(&w->lock);
+
+        now = Asn1crt_NowNs();
+        for (int i = 0; i < n; i++) {
+            Parallel_DecodeSlot(w, &w->queue[(start + i) % cfg->queueDepth], now);
+        }
+        if (now - lastExpire >= tickNs) {
+            Parallel_ExpireAll(w, now, FALSE);
+            lastExpire = now;
+        }
+
+        pthread_mutex_lock(&w->lock);
+        w->tail = (start + n) % cfg->queueDepth;
+        w->count -= n;
+        pthread_cond_signal(&w->notFull);
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    Parallel_ExpireAll(w, Asn1crt_NowNs(), TRUE);
+    return NULL;
+}
+
+flag ParallelDecoder_Start(ParallelDecoder* pd, const ParallelConfig* cfg, MemPool* pool,
+                           ParallelEmitFn emit, void* userData) {
+    size_t workerBytes = Parallel_WorkerBytes(cfg);
+    unsigned int capacity = Parallel_SourceCapacity(cfg);
+    pthread_condattr_t attr;
+
+    if (cfg->workers <= 0 || cfg->workers > PARALLEL_MAX_WORKERS || cfg->queueDepth <= 0 ||
+        cfg->reorderWindow <= 0 || cfg->maxSources <= 0 || emit == NULL) {
+        return FALSE;
+    }
+
+    memset(pd, 0, sizeof(ParallelDecoder));
+    pd->config = *cfg;
+    pd->emit = emit;
+    pd->userData = userData;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    for (int i = 0; i < cfg->workers; i++) {
+        ParallelWorker* w = &pd->workers[i];
+        byte* arena = (byte*)MemPool_Alloc(pool, workerBytes);
+        byte* slotBytes;
+
+        if (arena == NULL) {
+            ParallelDecoder_Stop(pd, NULL);
+            pthread_condattr_destroy(&attr);
+            return FALSE;
+        }
+
+        /* Each worker allocates lazily from its own arena, so no pool locking */
+        w->owner = pd;
+        MemPool_Init(&w->pool, arena, workerBytes);
+        w->queue = (ParallelSlot*)MemPool_Alloc(&w->pool, Asn1crt_Round8(sizeof(ParallelSlot) * cfg->queueDepth));
+        slotBytes = (byte*)MemPool_Alloc(&w->pool, (size_t)PARALLEL_SLOT_BYTES * cfg->queueDepth);
+        w->sources = (ParallelSource*)MemPool_Alloc(&w->pool, Asn1crt_Round8(sizeof(ParallelSource) * capacity));
+        memset(w->sources, 0, sizeof(ParallelSource) * capacity);
+        for (int s = 0; s < cfg->queueDepth; s++) {
+            w->queue[s].data = slotBytes + (size_t)s * PARALLEL_SLOT_BYTES;
+        }
+
+        pthread_mutex_init(&w->lock, NULL);
+        pthread_cond_init(&w->notEmpty, &attr);
+        pthread_cond_init(&w->notFull, NULL);
+        if (pthread_create(&w->thread, NULL, Parallel_WorkerMain, w) != 0) {
+            pthread_mutex_destroy(&w->lock);
+            pthread_cond_destroy(&w->notEmpty);
+            pthread_cond_destroy(&w->notFull);
+            ParallelDecoder_Stop(pd, NULL);
+            pthread_condattr_destroy(&attr);
+            return FALSE;
+        }
+        pd->workerCount++;
+    }
+
+    pthread_condattr_destroy(&attr);
+    return TRUE;
+}
+
+flag ParallelDecoder_Submit(ParallelDecoder* pd, unsigned int sourceId, const byte* data, int size) {
+    ParallelWorker* w;
+    ParallelSlot* slot;
+
+    if (size <= 0 || size > PARALLEL_SLOT_BYTES || pd->workerCount == 0) {
+        return FALSE;
+    }
+    w = &pd->workers[Parallel_Hash(sourceId) % (unsigned int)pd->workerCount];
+
+    pthread_mutex_lock(&w->lock);
+    while (w->count == pd->config.queueDepth && !w->stopping) {
+        pthread_cond_wait(&w->notFull, &w->lock);
+    }
+    if (w->stopping) {
+        pthread_mutex_unlock(&w->lock);
+        return FALSE;
+    }
+
+    slot = &w->queue[w->head];
+    slot->sourceId = sourceId;
+    slot->size = size;
+    memcpy(slot->data, data, (size_t)size);
+    w->head = (w->head + 1) % pd->config.queueDepth;
+    w->count++;
+    w->stats.submitted++;
+    pthread_cond_signal(&w->notEmpty);
+    pthread_mutex_unlock(&w->lock);
+    return TRUE;
+}
+
+static void Parallel_AddStats(ParallelStats* total, const ParallelStats* part) {
+    total->submitted += part->submitted;
+    total->decoded += part->decoded;
+    total->decodeErrors += part->decodeErrors;
+    total->sourceOverflow += part->sourceOverflow;
+    total->reorder.emitted += part->reorder.emitted;
+    total->reorder.gaps += part->reorder.gaps;
+    total->reorder.duplicates += part->reorder.duplicates;
+    total->reorder.late += part->reorder.late;
+    total->reorder.resyncs += part->reorder.resyncs;
+}
+
+void ParallelDecoder_Stop(ParallelDecoder* pd, ParallelStats* totals) {
+    unsigned int capacity = Parallel_SourceCapacity(&pd->config);
+
+    if (totals != NULL) {
+        memset(totals, 0, sizeof(ParallelStats));
+    }
+
+    for (int i = 0; i < pd->workerCount; i++) {
+        ParallelWorker* w = &pd->workers[i];
+        pthread_mutex_lock(&w->lock);
+        w->stopping = TRUE;
+        pthread_cond_broadcast(&w->notEmpty);
+        pthread_cond_broadcast(&w->notFull);
+        pthread_mutex_unlock(&w->lock);
+    }
+
+    for (int i = 0; i < pd->workerCount; i++) {
+        ParallelWorker* w = &pd->workers[i];
+        pthread_join(w->thread, NULL);
+
+        for (unsigned int s = 0; s < capacity; s++) {
+            if (w->sources[s].used) {
+                const ReorderStats* rs = &w->sources[s].reorder.stats;
+                w->stats.reorder.emitted += rs->emitted;
+                w->stats.reorder.gaps += rs->gaps;
+                w->stats.reorder.duplicates += rs->duplicates;
+                w->stats.reorder.late += rs->late;
+                w->stats.reorder.resyncs += rs->resyncs;
+            }
+        }
+        if (totals != NULL) {
+            Parallel_AddStats(totals, &w->stats);
+        }
+
+        pthread_mutex_destroy(&w->lock);
+        pthread_cond_destroy(&w->notEmpty);
+        pthread_cond_destroy(&w->notFull);
+    }
+    pd->workerCount = 0;
+}
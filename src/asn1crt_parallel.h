@@ -0,0 +1,100 @@
+/* asn1crt_parallel.h - Shard-by-source parallel decoding with in-order delivery */
+#ifndef ASN1CRT_PARALLEL_H
+#define ASN1CRT_PARALLEL_H
+
+#include <pthread.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_reorder.h"
+#include "satellite.h"
+
+/* Upper bound on decode threads */
+#define PARALLEL_MAX_WORKERS 64
+
+/* Bytes reserved per queued encoded frame */
+#define PARALLEL_SLOT_BYTES ((T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + 7) & ~7)
+
+/* Tuning knobs */
+typedef struct {
+    int workers;                 /* Decode threads (sources are hashed onto them) */
+    int queueDepth;              /* Encoded frames buffered per worker */
+    int reorderWindow;           /* Frames held per source (memory limit) */
+    int maxSources;              /* Distinct sources tracked per worker; rounded up to a power of
+                                  * two for the hash table, and that rounded count is both the
+                                  * real limit and what PoolBytes sizes (e.g. 40 tracks 64) */
+    unsigned long maxHoldUs;     /* Latency limit before a gap is skipped */
+} ParallelConfig;
+
+/* Totals across workers */
+typedef struct {
+    unsigned long submitted;     /* Frames accepted by Submit */
+    unsigned long decoded;       /* Frames decoded successfully */
+    unsigned long decodeErrors;  /* Frames rejected by the decoder */
+    unsigned long sourceOverflow;/* Frames dropped because maxSources was reached */
+    ReorderStats reorder;        /* Summed per-source reorder counters */
+} ParallelStats;
+
+/* Delivers frames of one source in frameCount order. Different sources may
+ * be delivered concurrently from different workers. */
+typedef void (*ParallelEmitFn)(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData);
+
+/* Encoded frame waiting in a worker queue */
+typedef struct {
+    unsigned int sourceId;
+    int size;
+    byte* data;                  /* PARALLEL_SLOT_BYTES from the pool */
+} ParallelSlot;
+
+/* Reorder state of one source */
+typedef struct {
+    unsigned int sourceId;
+    flag used;
+    ReorderBuffer reorder;
+} ParallelSource;
+
+struct ParallelDecoder;
+
+/* One decode thread and the sources hashed onto it */
+typedef struct {
+    struct ParallelDecoder* owner;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+    ParallelSlot* queue;         /* queueDepth slots */
+    int head;                    /* Next slot the producer fills */
+    int tail;                    /* Next slot the worker decodes */
+    int count;                   /* Slots filled */
+    flag stopping;
+    MemPool pool;                /* Worker-private arena for lazy allocations */
+    ParallelSource* sources;     /* maxSources rounded to a power of two, open addressing */
+    unsigned int currentSource;  /* Source being emitted (for the callback) */
+    T_TelemetryFrame scratch;    /* Decode target */
+    ParallelStats stats;
+} ParallelWorker;
+
+typedef struct ParallelDecoder {
+    ParallelConfig config;
+    ParallelEmitFn emit;
+    void* userData;
+    int workerCount;
+    ParallelWorker workers[PARALLEL_MAX_WORKERS];
+} ParallelDecoder;
+
+/* Defaults: 4 workers, 256-deep queues, 64-frame windows, 32 sources, 50 ms */
+void ParallelConfig_Default(ParallelConfig* cfg);
+
+/* Pool bytes ParallelDecoder_Start will carve for this config */
+size_t ParallelDecoder_PoolBytes(const ParallelConfig* cfg);
+
+/* Allocate queues and reorder windows from pool and start the workers */
+flag ParallelDecoder_Start(ParallelDecoder* pd, const ParallelConfig* cfg, MemPool* pool,
+                           ParallelEmitFn emit, void* userData);
+
+/* Queue one encoded frame; blocks while the source's worker queue is full */
+flag ParallelDecoder_Submit(ParallelDecoder* pd, unsigned int sourceId, const byte* data, int size);
+
+/* Drain queues, flush every reorder window, join workers and sum their stats */
+void ParallelDecoder_Stop(ParallelDecoder* pd, ParallelStats* totals);
+
+#endif /* ASN1CRT_PARALLEL_H */
@@ -1,5 +1,6 @@
 /* asn1crt_partial.c - Partial decoding implementation */
 #include "asn1crt_partial.h"
+#include "asn1crt_encoding.h"
 #include <string.h>
 
 void PartialContext_Init(PartialContext* ctx, FieldSelector* fields, int fieldCount) {
@@ -43,3 +44,35 @@ void ExitLevel(PartialContext* ctx) {
         ctx->currentLevel--;
     }
 }
+
+flag T_TelemetryFrame_PartialDecode(T_TelemetryFrame* pVal, BitStream* pBitStrm,
+                                    PartialContext* ctx, int* pErrCode) {
+    asn1SccSint choice;
+
+    if (!T_FrameHeader_Decode(&pVal->header, pBitStrm, pErrCode)) {
+        return FALSE;
+    }
+    if (ShouldDecodeField(ctx, PARTIAL_FIELD_PAYLOAD)) {
+        return T_TelemetryPayload_Decode(&pVal->payload, pBitStrm, pErrCode);
+    }
+
+    /* uPER CHOICE index for three alternatives: 2 bits, 0-based */
+    if (!BitStream_DecodeConstraintWholeNumber(pBitStrm, &choice, 0, 2)) {
+        *pErrCode = ERR_PARTIAL_PAYLOAD_CHOICE;
+        return FALSE;
+    }
+    switch (choice) {
+    case 0:
+        pVal->payload.kind = housekeeping_PRESENT;
+        return TRUE;
+    case 1:
+        pVal->payload.kind = science_PRESENT;
+        return TRUE;
+    case 2:
+        pVal->payload.kind = commandAck_PRESENT;
+        return TRUE;
+    default:
+        *pErrCode = ERR_PARTIAL_PAYLOAD_CHOICE;
+        return FALSE;
+    }
+}
@@ -3,6 +3,14 @@
 #define ASN1CRT_PARTIAL_H
 
 #include "asn1crt.h"
+#include "satellite.h"
+
+/* Field indices of T_TelemetryFrame for FieldSelector */
+#define PARTIAL_FIELD_HEADER  0
+#define PARTIAL_FIELD_PAYLOAD 1
+
+/* Encoded CHOICE index outside TelemetryPayload's alternatives */
+#define ERR_PARTIAL_PAYLOAD_CHOICE 1010
 
 /* Field selection structure to indicate which fields to decode */
 typedef struct {
@@ -34,4 +42,10 @@ void EnterLevel(PartialContext* ctx);
 /* Decrement nesting level */
 void ExitLevel(PartialContext* ctx);
 
+/* Decode the header, then the payload only when PARTIAL_FIELD_PAYLOAD is
+ * selected (a NULL ctx decodes everything). When skipped, only the CHOICE
+ * index is read so payload.kind still identifies the frame. */
+flag T_TelemetryFrame_PartialDecode(T_TelemetryFrame* pVal, BitStream* pBitStrm,
+                                    PartialContext* ctx, int* pErrCode);
+
 #endif /* ASN1CRT_PARTIAL_H */
@@ -0,0 +1,329 @@
+/* asn1crt_ranges.hpp - C++20 range pipeline over buffers of encoded TelemetryFrames */
+#ifndef ASN1CRT_RANGES_HPP
+#define ASN1CRT_RANGES_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+extern "C" {
+#include "asn1crt.h"
+#include "asn1crt_encoding.h"
+#include "asn1crt_lazy.h"
+#include "asn1crt_stream.h"
+#include "satellite.h"
+}
+
+/* Single-pass pipelines over back-to-back uPER frames:
+ *
+ *   for (const auto& f : asn1crt::frames(buf, len)
+ *                        | asn1crt::filter_type(commandAck_PRESENT)
+ *                        | asn1crt::decode_header()
+ *                        | std::views::take_while([&](const auto& f) {
+ *                              return f.header.timestamp.seconds < t1; }))
+ *
+ * frames() yields FrameView, a zero-copy pointer and length found by
+ * skipping through the layout; payload.kind comes for free from that walk,
+ * so filter_type() never decodes. decode_header() and decode() run the
+ * generated decoders once per element that reaches them and cache the
+ * result in the iterator, so later stages and the loop body share it. */
+namespace asn1crt {
+
+/* One encoded frame inside a caller-owned buffer */
+class FrameView {
+public:
+    FrameView() = default;
+    FrameView(const byte* data, int size, int kind) : data_(data), size_(size), kind_(kind) {}
+
+    const byte* data() const { return data_; }
+    int size() const { return size_; }
+    int kind() const { return kind_; }  /* payload.kind */
+
+    bool header(T_FrameHeader& out, int* pErrCode) const {
+        BitStream bs;
+        BitStream_AttachBuffer(&bs, const_cast<byte*>(data_), size_);
+        return T_FrameHeader_Decode(&out, &bs, pErrCode);
+    }
+
+    bool decode(T_TelemetryFrame& out, int* pErrCode) const {
+        BitStream bs;
+        BitStream_AttachBuffer(&bs, const_cast<byte*>(data_), size_);
+        return T_TelemetryFrame_Decode(&out, &bs, pErrCode);
+    }
+
+    /* Field-by-field access for consumers that need a few payload fields */
+    LazyFrame lazy() const {
+        LazyFrame lf;
+        LazyFrame_Init(&lf, data_, size_);
+        return lf;
+    }
+
+private:
+    const byte* data_ = nullptr;
+    int size_ = 0;
+    int kind_ = 0;
+};
+
+/* Element of decode_header() */
+struct HeaderFrame {
+    FrameView frame;
+    T_FrameHeader header;
+    bool ok;        /* FALSE when the header did not decode; errCode says why */
+    int errCode;
+};
+
+/* Element of decode() */
+struct DecodedFrame {
+    FrameView frame;
+    T_TelemetryFrame value;
+    bool ok;
+    int errCode;
+};
+
+/* The encoded frame behind any pipeline element */
+inline const FrameView& frame_of(const FrameView& f) { return f; }
+inline const FrameView& frame_of(const HeaderFrame& h) { return h.frame; }
+
+/* Contiguous chunk of frames: a buffer or one StreamContext fragment */
+struct FrameSpan {
+    const byte* data;
+    std::size_t size;
+};
+
+class FrameRange : public std::ranges::view_interface<FrameRange> {
+public:
+    static constexpr int MaxSpans = MAX_STREAM_FRAGMENTS;
+
+    FrameRange() = default;
+
+    FrameRange(const FrameSpan* spans, int count, int* pErrCode) : count_(count), errCode_(pErrCode) {
+        for (int i = 0; i < count && i < MaxSpans; i++) spans_[i] = spans[i];
+        if (errCode_ != nullptr) *errCode_ = 0;
+    }
+
+    struct sentinel {};
+
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FrameView;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(const FrameRange* parent, int span, std::size_t offset)
+            : parent_(parent), span_(span), offset_(offset) {
+            settle();
+        }
+
+        const FrameView& operator*() const { return current_; }
+        const FrameView* operator->() const { return &current_; }
+
+        iterator& operator++() {
+            offset_ += static_cast<std::size_t>(current_.size());
+            settle();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) {
+            return a.span_ == b.span_ && a.offset_ == b.offset_;
+        }
+        friend bool operator==(const iterator& it, sentinel) { return it.done(); }
+
+    private:
+        bool done() const { return span_ >= parent_->count_; }
+
+        /* Measure the frame at the current position, moving to the next span
+         * when this one is used up. Malformed data ends the range. */
+        void settle() {
+            while (span_ < parent_->count_) {
+                const FrameSpan& s = parent_->spans_[span_];
+                if (offset_ < s.size) {
+                    int bytes, kind, errCode;
+                    int remaining = static_cast<int>(s.size - offset_);
+                    if (LazyFrame_Measure(s.data + offset_, remaining, &bytes, &kind, &errCode)) {
+                        current_ = FrameView(s.data + offset_, bytes, kind);
+                        return;
+                    }
+                    if (parent_->errCode_ != nullptr) *parent_->errCode_ = errCode;
+                    span_ = parent_->count_;
+                    break;
+                }
+                span_++;
+                offset_ = 0;
+            }
+            offset_ = 0;
+            current_ = FrameView();
+        }
+
+        const FrameRange* parent_ = nullptr;
+        int span_ = 0;
+        std::size_t offset_ = 0;
+        FrameView current_;
+    };
+
+    iterator begin() const { return iterator(this, 0, 0); }
+    sentinel end() const { return sentinel{}; }
+
+private:
+    FrameSpan spans_[MaxSpans] = {};
+    int count_ = 0;
+    int* errCode_ = nullptr;
+};
+
+/* Frames packed back to back in buf[0..size). pErrCode, when given, is
+ * set if the walk stopped at malformed data rather than the end. */
+inline FrameRange frames(const byte* buf, std::size_t size, int* pErrCode = nullptr) {
+    FrameSpan span = { buf, size };
+    return FrameRange(&span, 1, pErrCode);
+}
+
+/* Unconsumed bytes of every fragment in a StreamContext, in order. The
+ * context is only read; each fragment must hold whole frames. */
+inline FrameRange frames(const StreamContext& ctx, int* pErrCode = nullptr) {
+    FrameSpan spans[MAX_STREAM_FRAGMENTS];
+    int count = 0;
+    for (int i = ctx.currentFragment; i < ctx.fragmentCount; i++) {
+        const StreamFragment& f = ctx.fragments[i];
+        spans[count++] = { f.data + f.processed, f.size - f.processed };
+    }
+    return FrameRange(spans, count, pErrCode);
+}
+
+/* Makes a stage's function assignable even when it captures by
+ * reference, which a view must be */
+template <class F>
+class fn_box {
+public:
+    fn_box() = default;
+    explicit fn_box(F fn) : fn_(std::move(fn)) {}
+    fn_box(const fn_box&) = default;
+    fn_box(fn_box&&) = default;
+
+    fn_box& operator=(const fn_box& other) {
+        if (this != &other) {
+            if (other.fn_) fn_.emplace(*other.fn_);
+            else fn_.reset();
+        }
+        return *this;
+    }
+
+    fn_box& operator=(fn_box&& other) {
+        if (this != &other) {
+            if (other.fn_) fn_.emplace(std::move(*other.fn_));
+            else fn_.reset();
+        }
+        return *this;
+    }
+
+    const F& operator*() const { return *fn_; }
+
+private:
+    std::optional<F> fn_;
+};
+
+/* transform that calls fn once per position and keeps the result in the
+ * iterator, so every later dereference reuses the decoded value */
+template <std::ranges::input_range V, class F>
+    requires std::ranges::view<V>
+class decode_view : public std::ranges::view_interface<decode_view<V, F>> {
+public:
+    using element = std::invoke_result_t<const F&, std::ranges::range_reference_t<V>>;
+
+    decode_view() = default;
+    decode_view(V base, F fn) : base_(std::move(base)), fn_(std::move(fn)) {}
+
+    class iterator {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = element;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(const decode_view* parent, std::ranges::iterator_t<V> it) : parent_(parent), it_(std::move(it)) {}
+
+        const element& operator*() const {
+            if (!cache_) cache_.emplace(std::invoke(*parent_->fn_, *it_));
+            return *cache_;
+        }
+
+        iterator& operator++() {
+            ++it_;
+            cache_.reset();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, const std::ranges::sentinel_t<V>& end) { return it.it_ == end; }
+
+    private:
+        const decode_view* parent_ = nullptr;
+        std::ranges::iterator_t<V> it_;
+        mutable std::optional<element> cache_;
+    };
+
+    iterator begin() { return iterator(this, std::ranges::begin(base_)); }
+    auto end() { return std::ranges::end(base_); }
+
+private:
+    V base_;
+    fn_box<F> fn_;
+};
+
+/* Pipe target for decode_header() and decode() */
+template <class F>
+struct decode_closure {
+    F fn;
+
+    template <std::ranges::viewable_range R>
+    friend auto operator|(R&& r, const decode_closure& c) {
+        using V = std::views::all_t<R>;
+        return decode_view<V, F>(std::views::all(std::forward<R>(r)), c.fn);
+    }
+};
+
+/* Keep frames whose payload.kind is kind (no decoding) */
+inline auto filter_type(int kind) {
+    return std::views::filter([kind](const FrameView& f) { return f.kind() == kind; });
+}
+
+/* Decode the FrameHeader of each frame; payload stays encoded */
+inline auto decode_header() {
+    auto fn = [](const auto& in) {
+        const FrameView& f = frame_of(in);
+        HeaderFrame h;
+        h.frame = f;
+        h.errCode = 0;
+        h.ok = f.header(h.header, &h.errCode);
+        return h;
+    };
+    return decode_closure<decltype(fn)>{ fn };
+}
+
+/* Full T_TelemetryFrame_Decode of each frame; also accepts the output
+ * of decode_header() */
+inline auto decode() {
+    auto fn = [](const auto& in) {
+        const FrameView& f = frame_of(in);
+        DecodedFrame d;
+        d.frame = f;
+        d.errCode = 0;
+        d.ok = f.decode(d.value, &d.errCode);
+        return d;
+    };
+    return decode_closure<decltype(fn)>{ fn };
+}
+
+}  // namespace asn1crt
+
+#endif /* ASN1CRT_RANGES_HPP */
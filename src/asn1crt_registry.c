@@ -0,0 +1,114 @@
+/* asn1crt_registry.c - Multi-schema registry with table-driven frame dispatch */
+#include "asn1crt_registry.h"
+#include "asn1crt_internal.h"
+#include "asn1crt_encoding.h"
+#include "asn1crt_layout.h"
+#include <string.h>
+
+void SchemaRegistry_Init(SchemaRegistry* reg) {
+    memset(reg, 0, sizeof(SchemaRegistry));
+    reg->frameTypeOffset = LAYOUT_FRAME_TYPE_OFFSET;
+}
+
+size_t SchemaRegistry_PoolBytes(const SchemaDesc* desc, size_t poolBytes) {
+    return Asn1crt_Round8(desc->valueSize) + Asn1crt_Round8(poolBytes);
+}
+
+flag SchemaRegistry_Add(SchemaRegistry* reg, const SchemaDesc* desc, MemPool* parent, size_t poolBytes,
+                        int* schemaId, int* pErrCode) {
+    Schema* s;
+    byte* own;
+
+    if (reg->count == REGISTRY_MAX_SCHEMAS) return Asn1crt_Fail(pErrCode, ERR_REGISTRY_FULL);
+
+    s = &reg->schemas[reg->count];
+    memset(s, 0, sizeof(Schema));
+    s->desc = *desc;
+    s->value = MemPool_Alloc(parent, Asn1crt_Round8(desc->valueSize));
+    own = (byte*)MemPool_Alloc(parent, Asn1crt_Round8(poolBytes));
+    if (s->value == NULL || (poolBytes > 0 && own == NULL)) return Asn1crt_Fail(pErrCode, ERR_REGISTRY_POOL);
+    MemPool_Init(&s->pool, own, poolBytes);
+
+    *schemaId = reg->count++;
+    return TRUE;
+}
+
+flag SchemaRegistry_Route(SchemaRegistry* reg, int schemaId, unsigned int sourceId, unsigned int frameType,
+                          int* pErrCode) {
+    if (schemaId < 0 || schemaId >= reg->count) return Asn1crt_Fail(pErrCode, ERR_REGISTRY_SCHEMA);
+    if (sourceId > REGISTRY_MAX_SOURCE) return Asn1crt_Fail(pErrCode, ERR_REGISTRY_SOURCE);
+    reg->route[REGISTRY_KEY(sourceId, frameType)] = (byte)(schemaId + 1);
+    return TRUE;
+}
+
+flag SchemaRegistry_RouteSource(SchemaRegistry* reg, int schemaId, unsigned int sourceId, int* pErrCode) {
+    if (schemaId < 0 || schemaId >= reg->count) return Asn1crt_Fail(pErrCode, ERR_REGISTRY_SCHEMA);
+    if (sourceId > REGISTRY_MAX_SOURCE) return Asn1crt_Fail(pErrCode, ERR_REGISTRY_SOURCE);
+    memset(reg->route + REGISTRY_KEY(sourceId, 0), schemaId + 1, 256);
+    return TRUE;
+}
+
+int SchemaRegistry_Lookup(const SchemaRegistry* reg, unsigned int sourceId, unsigned int frameType) {
+    if (sourceId > REGISTRY_MAX_SOURCE) return -1;
+    return (int)reg->route[REGISTRY_KEY(sourceId, frameType)] - 1;
+}
+
+flag SchemaRegistry_Dispatch(SchemaRegistry* reg, unsigned int sourceId, const byte* buf, int length,
+                             int* pErrCode) {
+    int offset = reg->frameTypeOffset;
+    int index = offset >> 3;
+    unsigned int window, frameType;
+    Schema* s;
+    BitStream bs;
+
+    if (sourceId > REGISTRY_MAX_SOURCE) {
+        reg->unrouted++;
+        return Asn1crt_Fail(pErrCode, ERR_REGISTRY_SOURCE);
+    }
+    /* frameType straddles at most two bytes */
+    if ((offset + LAYOUT_FRAME_TYPE_BITS + 7) / 8 > length) {
+        reg->shortFrames++;
+        return Asn1crt_Fail(pErrCode, ERR_REGISTRY_SHORT);
+    }
+    window = (unsigned int)buf[index] << 8 | (index + 1 < length ? buf[index + 1] : 0);
+    frameType = (window >> (16 - (offset & 7) - LAYOUT_FRAME_TYPE_BITS)) & ((1u << LAYOUT_FRAME_TYPE_BITS) - 1);
+
+    index = reg->route[REGISTRY_KEY(sourceId, frameType)];
+    if (index == 0) {
+        reg->unrouted++;
+        return Asn1crt_Fail(pErrCode, ERR_REGISTRY_UNROUTED);
+    }
+    s = &reg->schemas[index - 1];
+
+    BitStream_AttachBuffer(&bs, (unsigned char*)buf, length);
+    if (!s->desc.decode(s->value, &bs, pErrCode)) {
+        s->stats.errors++;
+        s->stats.lastErrCode = *pErrCode;
+        return FALSE;
+    }
+    s->stats.frames++;
+    s->stats.bytes += (unsigned long)length;
+    if (s->desc.handler != NULL) s->desc.handler(index - 1, sourceId, s->value, s->desc.userData);
+    return TRUE;
+}
+
+int SchemaRegistry_DispatchBatch(SchemaRegistry* reg, unsigned int sourceId, const byte* const* frames,
+                                 const int* lengths, int count) {
+    int decoded = 0;
+    int errCode;
+
+    for (int i = 0; i < count; i++) {
+        decoded += SchemaRegistry_Dispatch(reg, sourceId, frames[i], lengths[i], &errCode) ? 1 : 0;
+    }
+    return decoded;
+}
+
+MemPool* SchemaRegistry_Pool(SchemaRegistry* reg, int schemaId) {
+    if (schemaId < 0 || schemaId >= reg->count) return NULL;
+    return &reg->schemas[schemaId].pool;
+}
+
+const SchemaStats* SchemaRegistry_Stats(const SchemaRegistry* reg, int schemaId) {
+    if (schemaId < 0 || schemaId >= reg->count) return NULL;
+    return &reg->schemas[schemaId].stats;
+}
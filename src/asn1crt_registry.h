@@ -0,0 +1,107 @@
+/* asn1crt_registry.h - Multi-schema registry with table-driven frame dispatch */
+#ifndef ASN1CRT_REGISTRY_H
+#define ASN1CRT_REGISTRY_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+
+/* Registration and routing failures; a routed frame's decoder reports its own ERR_* */
+#define ERR_REGISTRY_FULL      1080  /* REGISTRY_MAX_SCHEMAS already registered */
+#define ERR_REGISTRY_POOL      1081  /* Pool too small for the schema's decode target */
+#define ERR_REGISTRY_SCHEMA    1082  /* Unknown schema id */
+#define ERR_REGISTRY_UNROUTED  1083  /* No schema for this (sourceId, frameType) */
+#define ERR_REGISTRY_SHORT     1084  /* Frame ends before the frameType discriminator */
+#define ERR_REGISTRY_SOURCE    1085  /* sourceId above REGISTRY_MAX_SOURCE */
+
+#define REGISTRY_MAX_SCHEMAS 15
+#define REGISTRY_MAX_SOURCE  255
+
+/* Dispatch key: 8-bit source id (from the transport: port, shard, link)
+ * and the 8-bit frameType every schema carries at the same place. Callers
+ * reject sourceId > REGISTRY_MAX_SOURCE first rather than let it alias a
+ * lower source. */
+#define REGISTRY_KEY(sourceId, frameType) (((unsigned int)(sourceId) << 8) | ((unsigned int)(frameType) & 0xFF))
+#define REGISTRY_KEYS 65536
+
+/* Decoder for one generated top-level type, through a void* target */
+typedef flag (*SchemaDecodeFn)(void* pVal, BitStream* bs, int* pErrCode);
+
+/* Called with each decoded value; value is reused by the next frame */
+typedef void (*SchemaHandler)(int schemaId, unsigned int sourceId, const void* value, void* userData);
+
+/* Defines T##_RegistryDecode, the SchemaDecodeFn of generated type T */
+#define SCHEMA_DECODER(T) \
+    static flag T##_RegistryDecode(void* pVal, BitStream* bs, int* pErrCode) { \
+        return T##_Decode((T*)pVal, bs, pErrCode); \
+    }
+
+/* Descriptor initializer for generated type T (after SCHEMA_DECODER(T)) */
+#define SCHEMA_DESC(T, name, handler, userData) { (name), sizeof(T), T##_RegistryDecode, (handler), (userData) }
+
+typedef struct {
+    const char* name;          /* For reports only */
+    size_t valueSize;          /* sizeof the decoded type */
+    SchemaDecodeFn decode;
+    SchemaHandler handler;     /* NULL to only count */
+    void* userData;
+} SchemaDesc;
+
+typedef struct {
+    unsigned long frames;      /* Decoded and handed to the handler */
+    unsigned long bytes;
+    unsigned long errors;      /* Rejected by the decoder */
+    int lastErrCode;
+} SchemaStats;
+
+typedef struct {
+    SchemaDesc desc;
+    MemPool pool;              /* Schema-private, carved from the caller's pool */
+    void* value;               /* Decode target in pool */
+    SchemaStats stats;
+} Schema;
+
+typedef struct {
+    byte route[REGISTRY_KEYS];       /* Schema index + 1, 0 = unrouted */
+    Schema schemas[REGISTRY_MAX_SCHEMAS];
+    int count;
+    int frameTypeOffset;             /* Bit offset of frameType in every schema */
+    unsigned long unrouted;          /* Frames with no route */
+    unsigned long shortFrames;       /* Frames too short to route */
+} SchemaRegistry;
+
+/* Empty registry reading frameType where satellite.asn puts it */
+void SchemaRegistry_Init(SchemaRegistry* reg);
+
+/* Pool bytes SchemaRegistry_Add takes for a schema with poolBytes of its own */
+size_t SchemaRegistry_PoolBytes(const SchemaDesc* desc, size_t poolBytes);
+
+/* Register a schema. Its decode target plus poolBytes of private pool
+ * (for the handler's use via SchemaRegistry_Pool) come from parent. */
+flag SchemaRegistry_Add(SchemaRegistry* reg, const SchemaDesc* desc, MemPool* parent, size_t poolBytes,
+                        int* schemaId, int* pErrCode);
+
+/* Send (sourceId, frameType) to a schema */
+flag SchemaRegistry_Route(SchemaRegistry* reg, int schemaId, unsigned int sourceId, unsigned int frameType,
+                          int* pErrCode);
+
+/* Send every frameType of sourceId to a schema */
+flag SchemaRegistry_RouteSource(SchemaRegistry* reg, int schemaId, unsigned int sourceId, int* pErrCode);
+
+/* Look up, decode and hand one frame to its schema's handler */
+flag SchemaRegistry_Dispatch(SchemaRegistry* reg, unsigned int sourceId, const byte* buf, int length,
+                             int* pErrCode);
+
+/* Dispatch count frames from one source; returns how many decoded */
+int SchemaRegistry_DispatchBatch(SchemaRegistry* reg, unsigned int sourceId, const byte* const* frames,
+                                 const int* lengths, int count);
+
+/* Schema index for (sourceId, frameType), -1 when unrouted or sourceId is
+ * out of range */
+int SchemaRegistry_Lookup(const SchemaRegistry* reg, unsigned int sourceId, unsigned int frameType);
+
+/* A schema's private pool and counters */
+MemPool* SchemaRegistry_Pool(SchemaRegistry* reg, int schemaId);
+const SchemaStats* SchemaRegistry_Stats(const SchemaRegistry* reg, int schemaId);
+
+#endif /* ASN1CRT_REGISTRY_H */
@@ -0,0 +1,184 @@
+/* asn1crt_reorder.c - Per-source frameCount reorder buffer */
+#include "asn1crt_reorder.h"
+#include "asn1crt_internal.h"
+#include <string.h>
+
+static unsigned int Reorder_WindowSize(int window) {
+    unsigned int size = 2;
+    while ((int)size < window && size < REORDER_MAX_WINDOW) {
+        size <<= 1;
+    }
+    return size;
+}
+
+int Reorder_SeqDiff(unsigned int a, unsigned int b) {
+    return (int)(short)(unsigned short)((a - b) & REORDER_SEQ_MASK);
+}
+
+size_t ReorderBuffer_PoolBytes(int window) {
+    size_t size = Reorder_WindowSize(window);
+    return sizeof(T_TelemetryFrame) * size +
+           sizeof(unsigned long long) * size +
+           Asn1crt_Round8(sizeof(unsigned short) * size) +
+           Asn1crt_Round8(size);
+}
+
+flag ReorderBuffer_Init(ReorderBuffer* rb, MemPool* pool, int window) {
+    unsigned int size = Reorder_WindowSize(window);
+
+    memset(rb, 0, sizeof(ReorderBuffer));
+    rb->frames = (T_TelemetryFrame*)MemPool_Alloc(pool, sizeof(T_TelemetryFrame) * size);
+    rb->arrivalNs = (unsigned long long*)MemPool_Alloc(pool, sizeof(unsigned long long) * size);
+    rb->slotSeq = (unsigned short*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(unsigned short) * size));
+    rb->state = (byte*)MemPool_Alloc(pool, Asn1crt_Round8(size));
+    if (!rb->frames || !rb->arrivalNs || !rb->slotSeq || !rb->state) {
+        return FALSE;
+    }
+    memset(rb->state, REORDER_SLOT_EMPTY, size);
+    rb->mask = size - 1;
+    return TRUE;
+}
+
+static flag Reorder_IsHeld(const ReorderBuffer* rb, unsigned int seq) {
+    unsigned int idx = seq & rb->mask;
+    return rb->state[idx] == REORDER_SLOT_HELD && rb->slotSeq[idx] == seq;
+}
+
+static void Reorder_Emit(ReorderBuffer* rb, ReorderEmitFn emit, void* userData) {
+    unsigned int idx = rb->nextSeq & rb->mask;
+
+    emit(&rb->frames[idx], userData);
+    rb->state[idx] = REORDER_SLOT_EMITTED;
+    rb->held--;
+    rb->stats.emitted++;
+    rb->nextSeq = (rb->nextSeq + 1) & REORDER_SEQ_MASK;
+}
+
+static void Reorder_Skip(ReorderBuffer* rb) {
+    unsigned int idx = rb->nextSeq & rb->mask;
+
+    rb->state[idx] = REORDER_SLOT_SKIPPED;
+    rb->slotSeq[idx] = (unsigned short)rb->nextSeq;
+    rb->stats.gaps++;
+    rb->nextSeq = (rb->nextSeq + 1) & REORDER_SEQ_MASK;
+}
+
+/* Deliver the contiguous run starting at nextSeq */
+static void Reorder_Drain(ReorderBuffer* rb, ReorderEmitFn emit, void* userData) {
+    while (!rb->priming && rb->held > 0 && Reorder_IsHeld(rb, rb->nextSeq)) {
+        Reorder_Emit(rb, emit, userData);
+    }
+}
+
+/* Pass over missing frameCounts up to the next held frame */
+static void Reorder_SkipToHeld(ReorderBuffer* rb) {
+    while (rb->held > 0 && !Reorder_IsHeld(rb, rb->nextSeq)) {
+        Reorder_Skip(rb);
+    }
+}
+
+/* Move nextSeq forward to target, delivering or skipping everything before it */
+static void Reorder_Advance(ReorderBuffer* rb, unsigned int target, ReorderEmitFn emit, void* userData) {
+    int steps = Reorder_SeqDiff(target, rb->nextSeq);
+    int window = (int)rb->mask + 1;
+
+    rb->priming = FALSE;
+    for (int i = 0; i < steps && i < window; i++) {
+        if (Reorder_IsHeld(rb, rb->nextSeq)) {
+            Reorder_Emit(rb, emit, userData);
+        } else {
+            Reorder_Skip(rb);
+        }
+    }
+    /* Beyond one window nothing can be held, so count the rest as gaps in bulk */
+    if (steps > window) {
+        rb->stats.gaps += (unsigned long)(steps - window);
+    }
+    rb->nextSeq = target & REORDER_SEQ_MASK;
+}
+
+void ReorderBuffer_Push(ReorderBuffer* rb, const T_TelemetryFrame* frame,
+                        unsigned long long nowNs, ReorderEmitFn emit, void* userData) {
+    unsigned int seq = (unsigned int)frame->header.frameCount & REORDER_SEQ_MASK;
+    int window = (int)rb->mask + 1;
+    unsigned int idx = seq & rb->mask;
+    int distance;
+
+    if (!rb->started) {
+        rb->started = TRUE;
+        rb->priming = TRUE;
+        rb->nextSeq = seq;
+        rb->highSeq = seq;
+    }
+
+    distance = Reorder_SeqDiff(seq, rb->nextSeq);
+    if (distance < 0 && rb->priming && Reorder_SeqDiff(rb->highSeq, seq) < window) {
+        /* Nothing delivered yet: an overtaken frame simply becomes the new start */
+        rb->nextSeq = seq;
+        distance = 0;
+    }
+    if (distance < 0) {
+        if (-distance <= window) {
+            /* Behind the window start: either a repeat or a frame we gave up on */
+            if (rb->slotSeq[idx] == seq && rb->state[idx] == REORDER_SLOT_EMITTED) {
+                rb->stats.duplicates++;
+            } else {
+                rb->stats.late++;
+            }
+            return;
+        }
+        /* Far behind anything recent: the source restarted its counter */
+        rb->stats.resyncs++;
+        ReorderBuffer_Flush(rb, emit, userData);
+        rb->nextSeq = seq;
+        rb->highSeq = seq;
+    } else if (distance >= window) {
+        /* Memory limit: make room by releasing the oldest part of the window */
+        Reorder_Advance(rb, (seq - (unsigned int)window + 1) & REORDER_SEQ_MASK, emit, userData);
+    }
+
+    if (Reorder_IsHeld(rb, seq)) {
+        rb->stats.duplicates++;
+        return;
+    }
+
+    memcpy(&rb->frames[idx], frame, sizeof(T_TelemetryFrame));
+    rb->arrivalNs[idx] = nowNs;
+    rb->slotSeq[idx] = (unsigned short)seq;
+    rb->state[idx] = REORDER_SLOT_HELD;
+    rb->held++;
+    if (Reorder_SeqDiff(seq, rb->highSeq) > 0) {
+        rb->highSeq = seq;
+    }
+
+    Reorder_Drain(rb, emit, userData);
+}
+
+void ReorderBuffer_Expire(ReorderBuffer* rb, unsigned long long nowNs,
+                          unsigned long long maxHoldNs, ReorderEmitFn emit, void* userData) {
+    int window = (int)rb->mask + 1;
+
+    while (rb->held > 0) {
+        unsigned long long oldest = nowNs;
+
+        for (int i = 0; i < window; i++) {
+            if (rb->state[i] == REORDER_SLOT_HELD && rb->arrivalNs[i] < oldest) {
+                oldest = rb->arrivalNs[i];
+            }
+        }
+        if (nowNs - oldest < maxHoldNs) {
+            break;
+        }
+        rb->priming = FALSE;
+        Reorder_SkipToHeld(rb);
+        Reorder_Drain(rb, emit, userData);
+    }
+}
+
+void ReorderBuffer_Flush(ReorderBuffer* rb, ReorderEmitFn emit, void* userData) {
+    rb->priming = FALSE;
+    while (rb->held > 0) {
+        Reorder_SkipToHeld(rb);
+        Reorder_Drain(rb, emit, userData);
+    }
+}
@@ -0,0 +1,72 @@
+/* asn1crt_reorder.h - Per-source frameCount reorder buffer */
+#ifndef ASN1CRT_REORDER_H
+#define ASN1CRT_REORDER_H
+
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* Largest reorder window (frames held per source) */
+#define REORDER_MAX_WINDOW 4096
+
+/* frameCount is INTEGER (0..65535) and wraps */
+#define REORDER_SEQ_MASK 0xFFFFu
+
+/* Slot states */
+typedef enum {
+    REORDER_SLOT_EMPTY,
+    REORDER_SLOT_HELD,     /* Frame waiting for earlier frameCounts */
+    REORDER_SLOT_EMITTED,  /* Frame already delivered */
+    REORDER_SLOT_SKIPPED   /* Declared missing and passed over */
+} ReorderSlotState;
+
+/* Delivery and loss counters */
+typedef struct {
+    unsigned long emitted;    /* Frames delivered in order */
+    unsigned long gaps;       /* frameCounts skipped as missing */
+    unsigned long duplicates; /* Frames already held or delivered */
+    unsigned long late;       /* Frames arriving after their gap was skipped */
+    unsigned long resyncs;    /* Source restarted far behind the window */
+} ReorderStats;
+
+/* Called once per frame, in frameCount order */
+typedef void (*ReorderEmitFn)(const T_TelemetryFrame* frame, void* userData);
+
+/* Sliding window over one source's frameCount sequence */
+typedef struct {
+    T_TelemetryFrame* frames;          /* window frames, indexed by seq & mask */
+    unsigned long long* arrivalNs;     /* Arrival time of each held frame */
+    unsigned short* slotSeq;           /* frameCount owning each slot */
+    byte* state;                       /* ReorderSlotState per slot */
+    unsigned int mask;                 /* window - 1 */
+    unsigned int nextSeq;              /* Next frameCount to deliver */
+    unsigned int highSeq;              /* Highest frameCount held so far */
+    int held;                          /* Frames currently waiting */
+    flag started;                      /* First frame seen */
+    flag priming;                      /* Start of stream: earlier frames may still arrive */
+    ReorderStats stats;
+} ReorderBuffer;
+
+/* Pool bytes needed for a window (rounded up to a power of two) */
+size_t ReorderBuffer_PoolBytes(int window);
+
+/* Initialize with window slots from pool; window bounds memory per source */
+flag ReorderBuffer_Init(ReorderBuffer* rb, MemPool* pool, int window);
+
+/* Add a decoded frame and deliver everything that is now in order. The first
+ * frame of a stream is held until Expire/Flush (or a full window) so that
+ * frames overtaken by it can still be delivered ahead of it. */
+void ReorderBuffer_Push(ReorderBuffer* rb, const T_TelemetryFrame* frame,
+                        unsigned long long nowNs, ReorderEmitFn emit, void* userData);
+
+/* Skip gaps whose oldest waiting frame has been held longer than maxHoldNs */
+void ReorderBuffer_Expire(ReorderBuffer* rb, unsigned long long nowNs,
+                          unsigned long long maxHoldNs, ReorderEmitFn emit, void* userData);
+
+/* Deliver every held frame, skipping all gaps (end of stream) */
+void ReorderBuffer_Flush(ReorderBuffer* rb, ReorderEmitFn emit, void* userData);
+
+/* Signed distance a - b in frameCount serial arithmetic (-32768..32767) */
+int Reorder_SeqDiff(unsigned int a, unsigned int b);
+
+#endif /* ASN1CRT_REORDER_H */
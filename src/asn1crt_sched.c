@@ -0,0 +1,217 @@
+/* asn1crt_sched.c - Priority decode scheduler implementation */
+#include "asn1crt_sched.h"
+#include "asn1crt_internal.h"
+#include <string.h>
+
+static size_t Sched_LaneBytes(int depth, size_t slotBytes) {
+    return Asn1crt_Round8(sizeof(SchedSlot) * (size_t)depth) + slotBytes * (size_t)depth;
+}
+
+void SchedConfig_Default(SchedConfig* cfg) {
+    cfg->workers = 4;
+    cfg->ackWorkers = 1;
+    cfg->ackDepth = 64;
+    cfg->bulkDepth = 1024;
+}
+
+size_t Scheduler_PoolBytes(const SchedConfig* cfg) {
+    return Sched_LaneBytes(cfg->ackDepth, SCHED_ACK_SLOT_BYTES) +
+           Sched_LaneBytes(cfg->bulkDepth, SCHED_BULK_SLOT_BYTES);
+}
+
+int Scheduler_Classify(const byte* data, int size) {
+    int index = LAYOUT_CHOICE_OFFSET >> 3;
+    int shift = 8 - (LAYOUT_CHOICE_OFFSET & 7) - LAYOUT_CHOICE_BITS;
+
+    if (size <= index) {
+        return 0;
+    }
+    /* CHOICE indices 0..2 are payload.kind 1..3; index 3 is not in the schema */
+    return (((data[index] >> shift) & ((1 << LAYOUT_CHOICE_BITS) - 1)) + 1) & (LATENCY_KINDS - 1);
+}
+
+static flag Sched_InitLane(SchedQueue* q, MemPool* pool, int depth, size_t slotBytes) {
+    byte* data;
+
+    q->slots = (SchedSlot*)MemPool_Alloc(pool, Asn1crt_Round8(sizeof(SchedSlot) * (size_t)depth));
+    data = (byte*)MemPool_Alloc(pool, slotBytes * (size_t)depth);
+    if (q->slots == NULL || data == NULL) {
+        return FALSE;
+    }
+    for (int i = 0; i < depth; i++) {
+        q->slots[i].data = data + (size_t)i * slotBytes;
+    }
+    q->depth = depth;
+    pthread_cond_init(&q->notFull, NULL);
+    return TRUE;
+}
+
+/* Called with the lock held and a non-empty lane */
+static void Sched_Take(Scheduler* sched, SchedWorker* w, SchedLane lane, SchedSlot* out) {
+    SchedQueue* q = &sched->lanes[lane];
+    SchedSlot* slot = &q->slots[q->tail];
+    unsigned long long now = Asn1crt_NowNs();
+
+    out->sourceId = slot->sourceId;
+    out->size = slot->size;
+    out->kind = slot->kind;
+    memcpy(w->frame, slot->data, (size_t)slot->size);
+    LatencyHistogram_Add(&sched->stats.delayNs[slot->kind], now > slot->enqueuedNs ? now - slot->enqueuedNs : 0);
+
+    q->tail = (q->tail + 1) % q->depth;
+    q->count--;
+    pthread_cond_signal(&q->notFull);
+}
+
+static void* Sched_WorkerMain(void* arg) {
+    SchedWorker* w = (SchedWorker*)arg;
+    Scheduler* sched = w->owner;
+    SchedQueue* acks = &sched->lanes[SCHED_LANE_ACK];
+    SchedQueue* bulk = &sched->lanes[SCHED_LANE_BULK];
+
+    pthread_mutex_lock(&sched->lock);
+    for (;;) {
+        SchedSlot taken;
+        BitStream bs;
+        int errCode;
+        flag ok;
+
+        /* Shared workers re-check the ack lane before every bulk frame, so
+         * an ack waits at most for the bulk decodes already in progress */
+        if (acks->count > 0) {
+            if (!w->ackOnly && bulk->count > 0) {
+                sched->stats.preemptions++;
+            }
+            Sched_Take(sched, w, SCHED_LANE_ACK, &taken);
+        } else if (!w->ackOnly && bulk->count > 0) {
+            Sched_Take(sched, w, SCHED_LANE_BULK, &taken);
+        } else if (sched->stopping) {
+            break;
+        } else {
+            pthread_cond_wait(w->ackOnly ? &sched->ackReady : &sched->anyReady, &sched->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&sched->lock);
+
+        BitStream_AttachBuffer(&bs, w->frame, taken.size);
+        ok = T_TelemetryFrame_DecodeTimed(&w->scratch, &bs, &errCode);
+        if (ok) {
+            sched->emit(taken.sourceId, &w->scratch, sched->userData);
+        }
+
+        pthread_mutex_lock(&sched->lock);
+        if (ok) {
+            sched->stats.decoded++;
+        } else {
+            sched->stats.decodeErrors++;
+        }
+    }
+    pthread_mutex_unlock(&sched->lock);
+    return NULL;
+}
+
+flag Scheduler_Start(Scheduler* sched, const SchedConfig* cfg, MemPool* pool, SchedEmitFn emit, void* userData) {
+    int total = cfg->workers + cfg->ackWorkers;
+
+    if (cfg->workers <= 0 || cfg->ackWorkers < 0 || total > SCHED_MAX_WORKERS || cfg->ackDepth <= 0 ||
+        cfg->bulkDepth <= 0 || emit == NULL) {
+        return FALSE;
+    }
+
+    memset(sched, 0, sizeof(Scheduler));
+    sched->config = *cfg;
+    sched->emit = emit;
+    sched->userData = userData;
+
+    if (!Sched_InitLane(&sched->lanes[SCHED_LANE_ACK], pool, cfg->ackDepth, SCHED_ACK_SLOT_BYTES)) {
+        return FALSE;
+    }
+    if (!Sched_InitLane(&sched->lanes[SCHED_LANE_BULK], pool, cfg->bulkDepth, SCHED_BULK_SLOT_BYTES)) {
+        pthread_cond_destroy(&sched->lanes[SCHED_LANE_ACK].notFull);
+        return FALSE;
+    }
+    pthread_mutex_init(&sched->lock, NULL);
+    pthread_cond_init(&sched->ackReady, NULL);
+    pthread_cond_init(&sched->anyReady, NULL);
+
+    for (int i = 0; i < total; i++) {
+        SchedWorker* w = &sched->workers[i];
+        w->owner = sched;
+        w->ackOnly = i >= cfg->workers;
+        if (pthread_create(&w->thread, NULL, Sched_WorkerMain, w) != 0) {
+            Scheduler_Stop(sched, NULL);
+            return FALSE;
+        }
+        sched->workerCount++;
+    }
+    return TRUE;
+}
+
+flag Scheduler_Submit(Scheduler* sched, unsigned int sourceId, const byte* data, int size) {
+    int kind = Scheduler_Classify(data, size);
+    SchedLane lane = kind == commandAck_PRESENT && size <= SCHED_ACK_SLOT_BYTES ? SCHED_LANE_ACK : SCHED_LANE_BULK;
+    SchedQueue* q = &sched->lanes[lane];
+    SchedSlot* slot;
+
+    if (size <= 0 || size > SCHED_BULK_SLOT_BYTES || sched->workerCount == 0) {
+        return FALSE;
+    }
+
+    pthread_mutex_lock(&sched->lock);
+    while (q->count == q->depth && !sched->stopping) {
+        pthread_cond_wait(&q->notFull, &sched->lock);
+    }
+    if (sched->stopping) {
+        pthread_mutex_unlock(&sched->lock);
+        return FALSE;
+    }
+
+    slot = &q->slots[q->head];
+    slot->sourceId = sourceId;
+    slot->size = size;
+    slot->kind = kind;
+    slot->enqueuedNs = Asn1crt_NowNs();
+    memcpy(slot->data, data, (size_t)size);
+    q->head = (q->head + 1) % q->depth;
+    q->count++;
+    sched->stats.submitted[kind]++;
+
+    if (lane == SCHED_LANE_ACK) {
+        pthread_cond_signal(&sched->ackReady);
+    }
+    pthread_cond_signal(&sched->anyReady);
+    pthread_mutex_unlock(&sched->lock);
+    return TRUE;
+}
+
+void Scheduler_Snapshot(Scheduler* sched, SchedStats* stats) {
+    pthread_mutex_lock(&sched->lock);
+    *stats = sched->stats;
+    pthread_mutex_unlock(&sched->lock);
+}
+
+void Scheduler_Stop(Scheduler* sched, SchedStats* stats) {
+    pthread_mutex_lock(&sched->lock);
+    sched->stopping = TRUE;
+    pthread_cond_broadcast(&sched->ackReady);
+    pthread_cond_broadcast(&sched->anyReady);
+    for (int l = 0; l < SCHED_LANE_COUNT; l++) {
+        pthread_cond_broadcast(&sched->lanes[l].notFull);
+    }
+    pthread_mutex_unlock(&sched->lock);
+
+    for (int i = 0; i < sched->workerCount; i++) {
+        pthread_join(sched->workers[i].thread, NULL);
+    }
+    sched->workerCount = 0;
+
+    if (stats != NULL) {
+        *stats = sched->stats;
+    }
+    pthread_mutex_destroy(&sched->lock);
+    pthread_cond_destroy(&sched->ackReady);
+    pthread_cond_destroy(&sched->anyReady);
+    for (int l = 0; l < SCHED_LANE_COUNT; l++) {
+        pthread_cond_destroy(&sched->lanes[l].notFull);
+    }
+}
@@ -0,0 +1,111 @@
+/* asn1crt_sched.h - Priority decode scheduler with a CommandAck fast lane */
+#ifndef ASN1CRT_SCHED_H
+#define ASN1CRT_SCHED_H
+
+#include <pthread.h>
+#include "asn1crt.h"
+#include "asn1crt_latency.h"
+#include "asn1crt_layout.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* Upper bound on decode threads */
+#define SCHED_MAX_WORKERS 64
+
+/* Queues, highest priority first */
+typedef enum {
+    SCHED_LANE_ACK,    /* CommandAck frames */
+    SCHED_LANE_BULK,   /* Everything else, in arrival order */
+    SCHED_LANE_COUNT
+} SchedLane;
+
+/* A whole CommandAck frame, padded to 8 bytes; bulk slots hold any frame */
+#define SCHED_ACK_SLOT_BYTES  ((LAYOUT_MIN_FRAME_BYTES + 7) & ~7)
+#define SCHED_BULK_SLOT_BYTES ((T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + 7) & ~7)
+
+typedef struct {
+    int workers;          /* Threads serving both lanes, acks first */
+    int ackWorkers;       /* Extra threads that only serve the ack lane */
+    int ackDepth;         /* Ack frames buffered */
+    int bulkDepth;        /* Other frames buffered */
+} SchedConfig;
+
+/* Counters and queueing delay, indexed by payload.kind (0 = unclassified) */
+typedef struct {
+    unsigned long submitted[LATENCY_KINDS];
+    unsigned long decoded;
+    unsigned long decodeErrors;
+    unsigned long preemptions;               /* Times a shared worker took an ack while bulk waited */
+    LatencyHistogram delayNs[LATENCY_KINDS]; /* Submit to start of decode */
+} SchedStats;
+
+/* Called from a worker for each decoded frame; acks may overtake bulk frames */
+typedef void (*SchedEmitFn)(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData);
+
+typedef struct {
+    unsigned int sourceId;
+    int size;
+    int kind;
+    unsigned long long enqueuedNs;
+    byte* data;
+} SchedSlot;
+
+/* Ring of slots for one lane */
+typedef struct {
+    SchedSlot* slots;
+    int depth;
+    int head;
+    int tail;
+    int count;
+    pthread_cond_t notFull;
+} SchedQueue;
+
+struct Scheduler;
+
+typedef struct {
+    struct Scheduler* owner;
+    pthread_t thread;
+    flag ackOnly;
+    T_TelemetryFrame scratch;    /* Decode target */
+    byte frame[SCHED_BULK_SLOT_BYTES];
+} SchedWorker;
+
+/* Both lanes share one lock so a worker picks the highest priority frame
+ * atomically; decoding happens outside it on a private copy */
+typedef struct Scheduler {
+    SchedConfig config;
+    SchedEmitFn emit;
+    void* userData;
+    pthread_mutex_t lock;
+    pthread_cond_t ackReady;     /* Wakes ack-only workers */
+    pthread_cond_t anyReady;     /* Wakes shared workers */
+    SchedQueue lanes[SCHED_LANE_COUNT];
+    flag stopping;
+    int workerCount;
+    SchedWorker workers[SCHED_MAX_WORKERS];
+    SchedStats stats;            /* Written under lock */
+} Scheduler;
+
+/* Defaults: 4 shared workers, 1 ack worker, 64 ack and 1024 bulk slots */
+void SchedConfig_Default(SchedConfig* cfg);
+
+/* Pool bytes Scheduler_Start will carve for this config */
+size_t Scheduler_PoolBytes(const SchedConfig* cfg);
+
+/* payload.kind of an encoded frame from the CHOICE index after the
+ * header, without decoding it; 0 when the frame is too short */
+int Scheduler_Classify(const byte* data, int size);
+
+/* Allocate both lanes from pool and start the workers */
+flag Scheduler_Start(Scheduler* sched, const SchedConfig* cfg, MemPool* pool, SchedEmitFn emit, void* userData);
+
+/* Queue one encoded frame on its lane; blocks while that lane is full */
+flag Scheduler_Submit(Scheduler* sched, unsigned int sourceId, const byte* data, int size);
+
+/* Copy the counters and histograms while running */
+void Scheduler_Snapshot(Scheduler* sched, SchedStats* stats);
+
+/* Drain both lanes, join the workers and return the final stats */
+void Scheduler_Stop(Scheduler* sched, SchedStats* stats);
+
+#endif /* ASN1CRT_SCHED_H */
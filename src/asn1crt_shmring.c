@@ -0,0 +1,383 @@
+/* asn1crt_shmring.c - Shared-memory frame ring for local consumer processes */
+#define _GNU_SOURCE
+#include "asn1crt_shmring.h"
+#include "asn1crt_internal.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#define SHMRING_MAGIC    0x53524E47U  /* "SRNG" */
+#define SHMRING_LINE     64
+#define SHMRING_PENDING  (~0ULL)       /* Cursor of a consumer still joining */
+
+static size_t ShmRing_RoundLine(size_t size) {
+    return (size + SHMRING_LINE - 1) & ~(size_t)(SHMRING_LINE - 1);
+}
+
+/* Shared (not FUTEX_PRIVATE) so waiters in other processes are found */
+static void ShmRing_FutexWait(unsigned int* word, unsigned int expected, unsigned long long deadlineNs) {
+    struct timespec ts;
+    struct timespec* timeout = NULL;
+
+    if (deadlineNs != 0) {
+        unsigned long long now = Asn1crt_NowNs();
+        unsigned long long left = deadlineNs > now ? deadlineNs - now : 0;
+        if (left == 0) {
+            return;
+        }
+        ts.tv_sec = (time_t)(left / 1000000000ULL);
+        ts.tv_nsec = (long)(left % 1000000000ULL);
+        timeout = &ts;
+    }
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+/* Sleepers set *sleeping before their last check; the first side to see
+ * it clears it and pays for the one FUTEX_WAKE, so a stream of publishes
+ * (or releases) into a parked peer costs a single syscall */
+static void ShmRing_FutexWake(unsigned int* word, unsigned int* sleeping) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(sleeping, __ATOMIC_RELAXED) != 0 && __atomic_exchange_n(sleeping, 0, __ATOMIC_SEQ_CST) != 0) {
+        __atomic_fetch_add(word, 1, __ATOMIC_SEQ_CST);
+        syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/* 0 waits forever; otherwise the absolute time a wait gives up */
+static unsigned long long ShmRing_Deadline(int timeoutMs) {
+    return timeoutMs < 0 ? 0 : Asn1crt_NowNs() + (unsigned long long)timeoutMs * 1000000ULL;
+}
+
+static ShmRingSlot* ShmRing_SlotAt(const ShmRing* ring, unsigned long long seq) {
+    return (ShmRingSlot*)(ring->slots + (size_t)(seq & ring->mask) * ring->stride);
+}
+
+static size_t ShmRing_Stride(unsigned int slotBytes) {
+    return ShmRing_RoundLine(sizeof(ShmRingSlot) + slotBytes);
+}
+
+void ShmRingConfig_Default(ShmRingConfig* cfg) {
+    memset(cfg, 0, sizeof(ShmRingConfig));
+    cfg->slotCount = 1024;
+    cfg->slotBytes = (unsigned int)sizeof(T_TelemetryFrame);
+}
+
+size_t ShmRing_MapBytes(const ShmRingConfig* cfg) {
+    return ShmRing_RoundLine(sizeof(ShmRingHeader)) + (size_t)cfg->slotCount * ShmRing_Stride(cfg->slotBytes);
+}
+
+static flag ShmRing_Map(ShmRing* ring, size_t mapBytes, int* pErrCode) {
+    void* base = mmap(NULL, mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+
+    if (base == MAP_FAILED) {
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_MAP);
+    }
+    ring->header = (ShmRingHeader*)base;
+    ring->slots = (byte*)base + ShmRing_RoundLine(sizeof(ShmRingHeader));
+    ring->mapBytes = mapBytes;
+    ring->gate = 0;
+    return TRUE;
+}
+
+/* memfd where the kernel has it, else a /dev/shm file unlinked at once */
+static int ShmRing_OpenFd(const char* name) {
+    int fd = -1;
+#ifdef SYS_memfd_create
+    fd = (int)syscall(SYS_memfd_create, name, 0);
+#endif
+    if (fd < 0) {
+        char path[] = "/dev/shm/asn1crt-ring-XXXXXX";
+        fd = mkstemp(path);
+        if (fd >= 0) {
+            unlink(path);
+        }
+    }
+    return fd;
+}
+
+flag ShmRing_Create(ShmRing* ring, const char* name, const ShmRingConfig* cfg, int* pErrCode) {
+    size_t mapBytes = ShmRing_MapBytes(cfg);
+
+    memset(ring, 0, sizeof(ShmRing));
+    if (cfg->slotCount < 2 || (cfg->slotCount & (cfg->slotCount - 1)) != 0 || cfg->slotBytes == 0) {
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_LAYOUT);
+    }
+    ring->fd = ShmRing_OpenFd(name);
+    if (ring->fd < 0) {
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_MAP);
+    }
+    ring->ownsFd = TRUE;
+    if (ftruncate(ring->fd, (off_t)mapBytes) != 0 || !ShmRing_Map(ring, mapBytes, pErrCode)) {
+        close(ring->fd);
+        ring->fd = -1;
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_MAP);
+    }
+
+    /* The file starts zeroed: no claims, no consumers, no slot published */
+    ring->header->slotCount = cfg->slotCount;
+    ring->header->slotBytes = cfg->slotBytes;
+    ring->header->slotStride = (unsigned int)ShmRing_Stride(cfg->slotBytes);
+    ring->mask = cfg->slotCount - 1;
+    ring->stride = ShmRing_Stride(cfg->slotBytes);
+    __atomic_store_n(&ring->header->magic, SHMRING_MAGIC, __ATOMIC_RELEASE);
+    return TRUE;
+}
+
+flag ShmRing_Attach(ShmRing* ring, int fd, int* pErrCode) {
+    struct stat st;
+    ShmRingConfig cfg;
+
+    memset(ring, 0, sizeof(ShmRing));
+    ring->fd = fd;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < ShmRing_RoundLine(sizeof(ShmRingHeader))) {
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_LAYOUT);
+    }
+    if (!ShmRing_Map(ring, (size_t)st.st_size, pErrCode)) {
+        return FALSE;
+    }
+
+    /* The layout is whatever another process wrote there: the stride is
+     * recomputed rather than trusted, and the map must hold exactly it */
+    cfg.slotCount = ring->header->slotCount;
+    cfg.slotBytes = ring->header->slotBytes;
+    if (__atomic_load_n(&ring->header->magic, __ATOMIC_ACQUIRE) != SHMRING_MAGIC || cfg.slotCount < 2 ||
+        (cfg.slotCount & (cfg.slotCount - 1)) != 0 || cfg.slotBytes == 0 ||
+        ring->header->slotStride != ShmRing_Stride(cfg.slotBytes) || ShmRing_MapBytes(&cfg) != ring->mapBytes) {
+        munmap(ring->header, ring->mapBytes);
+        ring->header = NULL;
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_LAYOUT);
+    }
+    ring->mask = cfg.slotCount - 1;
+    ring->stride = ShmRing_Stride(cfg.slotBytes);
+    return TRUE;
+}
+
+void ShmRing_Close(ShmRing* ring) {
+    if (ring->header != NULL) {
+        munmap(ring->header, ring->mapBytes);
+        ring->header = NULL;
+    }
+    if (ring->ownsFd && ring->fd >= 0) {
+        close(ring->fd);
+    }
+    ring->fd = -1;
+}
+
+/* First sequence below claim whose slot is not yet published. Anything a
+ * lap or more behind claim already is, so at most slotCount slots are read. */
+static unsigned long long ShmRing_PublishedFloor(const ShmRing* ring, unsigned long long claim) {
+    unsigned long long seq = ring->gate;
+
+    if (claim > ring->mask && claim - ring->mask - 1 > seq) {
+        seq = claim - ring->mask - 1;
+    }
+    /* A later lap's seq also means this one was published before it */
+    while (seq < claim && __atomic_load_n(&ShmRing_SlotAt(ring, seq)->seq, __ATOMIC_ACQUIRE) > seq) {
+        seq++;
+    }
+    return seq;
+}
+
+/* Lowest joined cursor, bounded by the oldest unpublished claim so that
+ * producers never lap one still filling its slot (with nobody reading,
+ * that bound is the whole gate). A consumer still joining may end up
+ * below a gate computed now, so the old gate is kept. */
+static unsigned long long ShmRing_Gate(ShmRing* ring, unsigned long long claim) {
+    unsigned long long gate = ShmRing_PublishedFloor(ring, claim);
+
+    for (int i = 0; i < SHMRING_MAX_CONSUMERS; i++) {
+        const ShmRingCursor* c = &ring->header->consumers[i];
+        if (__atomic_load_n(&c->active, __ATOMIC_SEQ_CST)) {
+            unsigned long long cursor = __atomic_load_n(&c->cursor, __ATOMIC_ACQUIRE);
+            if (cursor == SHMRING_PENDING) {
+                return ring->gate;
+            }
+            gate = cursor < gate ? cursor : gate;
+        }
+    }
+    return gate > ring->gate ? gate : ring->gate;
+}
+
+byte* ShmRing_Claim(ShmRing* ring, int timeoutMs, unsigned long long* seq, int* pErrCode) {
+    ShmRingHeader* h = ring->header;
+    unsigned long long deadline = 0;
+    flag waited = FALSE;
+    unsigned long long s = __atomic_load_n(&h->claim, __ATOMIC_ACQUIRE);
+
+    for (;;) {
+        if (s >= ring->gate + h->slotCount) {
+            ring->gate = ShmRing_Gate(ring, s);
+        }
+        if (s < ring->gate + h->slotCount) {
+            /* A failed CAS reloads s with the winner's claim */
+            if (__atomic_compare_exchange_n(&h->claim, &s, s + 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                break;
+            }
+            continue;
+        }
+
+        /* The slowest consumer still holds the slot s would reuse */
+        if (timeoutMs == 0) {
+            Asn1crt_Fail(pErrCode, ERR_SHMRING_FULL);
+            return NULL;
+        }
+        if (!waited) {
+            deadline = ShmRing_Deadline(timeoutMs);
+            waited = TRUE;
+        } else if (deadline != 0 && Asn1crt_NowNs() >= deadline) {
+            Asn1crt_Fail(pErrCode, ERR_SHMRING_FULL);
+            return NULL;
+        }
+        unsigned int word = __atomic_load_n(&h->released, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&h->producerSleeping, 1, __ATOMIC_SEQ_CST);
+        ring->gate = ShmRing_Gate(ring, s);
+        if (s >= ring->gate + h->slotCount) {
+            __atomic_fetch_add(&h->producerWaits, 1, __ATOMIC_RELAXED);
+            ShmRing_FutexWait(&h->released, word, deadline);
+        }
+        s = __atomic_load_n(&h->claim, __ATOMIC_ACQUIRE);
+    }
+
+    *seq = s;
+    return (byte*)(ShmRing_SlotAt(ring, s) + 1);
+}
+
+flag ShmRing_Publish(ShmRing* ring, unsigned long long seq, int length, int* pErrCode) {
+    ShmRingHeader* h = ring->header;
+    ShmRingSlot* slot = ShmRing_SlotAt(ring, seq);
+    flag ok = TRUE;
+
+    if (length < 0 || (unsigned int)length > h->slotBytes) {
+        /* Still published, empty, so consumers do not stall on it */
+        length = 0;
+        ok = Asn1crt_Fail(pErrCode, ERR_SHMRING_LENGTH);
+    }
+    slot->length = (unsigned int)length;
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELEASE);
+    ShmRing_FutexWake(&h->published, &h->consumerSleeping);
+    return ok;
+}
+
+flag ShmRing_Decode(ShmRing* ring, BitStream* bs, int timeoutMs, int* pErrCode) {
+    unsigned long long seq;
+    byte* data;
+    int errCode = 0;
+
+    if (ring->header->slotBytes < sizeof(T_TelemetryFrame)) {
+        return Asn1crt_Fail(pErrCode, ERR_SHMRING_LAYOUT);
+    }
+    data = ShmRing_Claim(ring, timeoutMs, &seq, pErrCode);
+    if (data == NULL) {
+        return FALSE;
+    }
+    if (!T_TelemetryFrame_Decode((T_TelemetryFrame*)data, bs, &errCode)) {
+        ShmRing_Publish(ring, seq, 0, pErrCode);
+        return Asn1crt_Fail(pErrCode, errCode);
+    }
+    return ShmRing_Publish(ring, seq, (int)sizeof(T_TelemetryFrame), pErrCode);
+}
+
+flag ShmRing_Join(ShmRing* ring, int* consumerId, int* pErrCode) {
+    ShmRingHeader* h = ring->header;
+
+    for (int i = 0; i < SHMRING_MAX_CONSUMERS; i++) {
+        ShmRingCursor* c = &h->consumers[i];
+        unsigned int expected = 0;
+        if (__atomic_load_n(&c->active, __ATOMIC_RELAXED) != 0) {
+            continue;
+        }
+        __atomic_store_n(&c->cursor, SHMRING_PENDING, __ATOMIC_RELAXED);
+        if (!__atomic_compare_exchange_n(&c->active, &expected, 1, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            continue;
+        }
+        /* Read after active is visible: any producer that missed this
+         * consumer read claim earlier, so its gate is not past the cursor */
+        __atomic_store_n(&c->cursor, __atomic_load_n(&h->claim, __ATOMIC_SEQ_CST), __ATOMIC_RELEASE);
+        *consumerId = i;
+        return TRUE;
+    }
+    return Asn1crt_Fail(pErrCode, ERR_SHMRING_CONSUMERS);
+}
+
+void ShmRing_Leave(ShmRing* ring, int consumerId) {
+    ShmRingHeader* h = ring->header;
+
+    __atomic_store_n(&h->consumers[consumerId].active, 0, __ATOMIC_SEQ_CST);
+    ShmRing_FutexWake(&h->released, &h->producerSleeping);
+}
+
+static int ShmRing_Ready(const ShmRing* ring, unsigned long long cursor) {
+    int ready = 0;
+
+    while (ready < SHMRING_POLL_MAX && ready < (int)ring->header->slotCount &&
+           __atomic_load_n(&ShmRing_SlotAt(ring, cursor + (unsigned long long)ready)->seq, __ATOMIC_ACQUIRE) ==
+               cursor + (unsigned long long)ready + 1) {
+        ready++;
+    }
+    return ready;
+}
+
+int ShmRing_Poll(ShmRing* ring, int consumerId, int timeoutMs) {
+    ShmRingHeader* h = ring->header;
+    unsigned long long cursor = __atomic_load_n(&h->consumers[consumerId].cursor, __ATOMIC_RELAXED);
+    unsigned long long deadline;
+    int ready = ShmRing_Ready(ring, cursor);
+
+    if (ready > 0 || timeoutMs == 0) {
+        return ready;
+    }
+    deadline = ShmRing_Deadline(timeoutMs);
+    for (;;) {
+        unsigned int word = __atomic_load_n(&h->published, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&h->consumerSleeping, 1, __ATOMIC_SEQ_CST);
+        ready = ShmRing_Ready(ring, cursor);
+        if (ready == 0) {
+            __atomic_fetch_add(&h->consumerWaits, 1, __ATOMIC_RELAXED);
+            ShmRing_FutexWait(&h->published, word, deadline);
+            ready = ShmRing_Ready(ring, cursor);
+        }
+        if (ready > 0 || (deadline != 0 && Asn1crt_NowNs() >= deadline)) {
+            return ready;
+        }
+    }
+}
+
+const byte* ShmRing_Peek(const ShmRing* ring, int consumerId, int index, int* length) {
+    unsigned long long cursor = __atomic_load_n(&ring->header->consumers[consumerId].cursor, __ATOMIC_RELAXED);
+    const ShmRingSlot* slot = ShmRing_SlotAt(ring, cursor + (unsigned long long)index);
+
+    *length = (int)slot->length;
+    return (const byte*)(slot + 1);
+}
+
+void ShmRing_Release(ShmRing* ring, int consumerId, int count) {
+    ShmRingHeader* h = ring->header;
+    ShmRingCursor* c = &h->consumers[consumerId];
+
+    __atomic_store_n(&c->cursor, c->cursor + (unsigned long long)count, __ATOMIC_RELEASE);
+    ShmRing_FutexWake(&h->released, &h->producerSleeping);
+}
+
+void ShmRing_Snapshot(const ShmRing* ring, ShmRingStats* stats) {
+    const ShmRingHeader* h = ring->header;
+
+    memset(stats, 0, sizeof(ShmRingStats));
+    stats->claimed = __atomic_load_n(&h->claim, __ATOMIC_ACQUIRE);
+    stats->producerWaits = __atomic_load_n(&h->producerWaits, __ATOMIC_RELAXED);
+    stats->consumerWaits = __atomic_load_n(&h->consumerWaits, __ATOMIC_RELAXED);
+    for (int i = 0; i < SHMRING_MAX_CONSUMERS; i++) {
+        unsigned long long cursor = __atomic_load_n(&h->consumers[i].cursor, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&h->consumers[i].active, __ATOMIC_ACQUIRE) && cursor != SHMRING_PENDING) {
+            stats->consumers++;
+            if (stats->claimed > cursor && stats->claimed - cursor > stats->maxLag) {
+                stats->maxLag = stats->claimed - cursor;
+            }
+        }
+    }
+}
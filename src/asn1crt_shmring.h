@@ -0,0 +1,139 @@
+/* asn1crt_shmring.h - Shared-memory frame ring for local consumer processes */
+#ifndef ASN1CRT_SHMRING_H
+#define ASN1CRT_SHMRING_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* Ring mapping, attach and producer/consumer failures */
+#define ERR_SHMRING_MAP        1100  /* memfd/mmap failed */
+#define ERR_SHMRING_LAYOUT     1101  /* Attached fd is not a ring, or the config is unusable */
+#define ERR_SHMRING_FULL       1102  /* A consumer still holds the slot and the wait timed out */
+#define ERR_SHMRING_CONSUMERS  1103  /* All SHMRING_MAX_CONSUMERS cursors are taken */
+#define ERR_SHMRING_LENGTH     1104  /* Published more than a slot holds */
+
+#define SHMRING_MAX_CONSUMERS  8
+#define SHMRING_POLL_MAX       64   /* Slots ShmRing_Poll reports at once */
+#define SHMRING_WAIT_FOREVER   (-1)
+
+/* Producers and consumers may live in different processes; everything
+ * shared sits in one MAP_SHARED region:
+ *
+ *   ShmRingHeader                   cursors, futex words, layout
+ *   slotCount * slotStride          ShmRingSlot header + slotBytes of data
+ *
+ * Every consumer sees every slot (archiver, dashboard and alarm engine all
+ * get the full stream). Producers claim sequence numbers with a CAS on
+ * claim, fill the slot in place and publish it by storing seq + 1 into the
+ * slot. A slot is reused only once every joined consumer's cursor has
+ * passed it and its previous claim has been published, so consumers read
+ * frames where the producer decoded them and producers never lap each
+ * other, with or without consumers attached. */
+typedef struct {
+    unsigned long long cursor;  /* Next sequence this consumer reads */
+    unsigned int active;
+    byte pad[52];
+} ShmRingCursor;
+
+typedef struct {
+    unsigned int magic;
+    unsigned int slotCount;     /* Power of two */
+    unsigned int slotBytes;     /* Data bytes per slot */
+    unsigned int slotStride;    /* ShmRingSlot + data, rounded to a cache line */
+    byte pad0[48];
+    unsigned long long claim;   /* Next sequence a producer takes */
+    byte pad1[56];
+    unsigned int published;     /* Futex word bumped to wake sleeping consumers */
+    unsigned int consumerSleeping;
+    unsigned int released;      /* Futex word bumped to wake sleeping producers */
+    unsigned int producerSleeping;
+    unsigned long long producerWaits;
+    unsigned long long consumerWaits;
+    byte pad2[32];
+    ShmRingCursor consumers[SHMRING_MAX_CONSUMERS];
+} ShmRingHeader;
+
+typedef struct {
+    unsigned long long seq;     /* Sequence + 1 once published, 0 before the first lap */
+    unsigned int length;        /* Data bytes; 0 marks a slot the producer gave up on */
+    unsigned int reserved;
+} ShmRingSlot;
+
+typedef struct {
+    unsigned int slotCount;     /* Power of two */
+    unsigned int slotBytes;     /* sizeof(T_TelemetryFrame), or e.g. FLAT_MAX_FRAME_BYTES * n for batches */
+} ShmRingConfig;
+
+typedef struct {
+    unsigned long long claimed;        /* Sequences handed to producers */
+    unsigned long long producerWaits;  /* Claims that had to sleep on a lagging consumer */
+    unsigned long long consumerWaits;  /* Polls that had to sleep on an empty ring */
+    int consumers;                     /* Joined consumers */
+    unsigned long long maxLag;         /* Slots the slowest consumer is behind */
+} ShmRingStats;
+
+/* Process-local view of a ring */
+typedef struct {
+    int fd;
+    flag ownsFd;
+    ShmRingHeader* header;
+    byte* slots;
+    size_t mapBytes;
+    unsigned int mask;
+    size_t stride;              /* Slot stride, recomputed locally rather than read from the header */
+    unsigned long long gate;    /* Cached lowest consumer cursor; only ever rises */
+} ShmRing;
+
+/* Fill a config with defaults (1024 slots of one decoded T_TelemetryFrame) */
+void ShmRingConfig_Default(ShmRingConfig* cfg);
+
+/* Size of the shared region for this config */
+size_t ShmRing_MapBytes(const ShmRingConfig* cfg);
+
+/* Create a ring in a fresh memfd (an unlinked /dev/shm file where memfd is
+ * missing). Children forked afterwards share the mapping; other processes
+ * receive ring->fd (SCM_RIGHTS, or inherited across exec) and attach. */
+flag ShmRing_Create(ShmRing* ring, const char* name, const ShmRingConfig* cfg, int* pErrCode);
+
+/* Map a ring created elsewhere; fd stays owned by the caller. A header
+ * whose stride or size disagrees with its slot config is rejected. */
+flag ShmRing_Attach(ShmRing* ring, int fd, int* pErrCode);
+
+/* Unmap; closes the fd when ShmRing_Create opened it */
+void ShmRing_Close(ShmRing* ring);
+
+/* Producer: claim the next slot, waiting up to timeoutMs (SHMRING_WAIT_FOREVER,
+ * or 0 to fail at once) while the slowest consumer still holds it. Returns
+ * slotBytes of slot data to fill, then ShmRing_Publish it. */
+byte* ShmRing_Claim(ShmRing* ring, int timeoutMs, unsigned long long* seq, int* pErrCode);
+
+/* Make a claimed slot visible; length 0 publishes an empty slot that
+ * consumers skip. Every claim must be published. */
+flag ShmRing_Publish(ShmRing* ring, unsigned long long seq, int length, int* pErrCode);
+
+/* Producer: decode one uPER TelemetryFrame straight into the next slot.
+ * A frame that fails to decode is published empty and the error returned. */
+flag ShmRing_Decode(ShmRing* ring, BitStream* bs, int timeoutMs, int* pErrCode);
+
+/* Consumer: take a cursor starting at the next sequence to be claimed */
+flag ShmRing_Join(ShmRing* ring, int* consumerId, int* pErrCode);
+
+/* Give the cursor up so producers stop waiting on it; a supervisor may
+ * call this for a consumer process that died */
+void ShmRing_Leave(ShmRing* ring, int consumerId);
+
+/* Consumer: number of published slots ready at the cursor (up to
+ * SHMRING_POLL_MAX), sleeping up to timeoutMs while there are none */
+int ShmRing_Poll(ShmRing* ring, int consumerId, int timeoutMs);
+
+/* Consumer: slot index (< ShmRing_Poll) past the cursor, in place. length
+ * receives its data bytes, 0 for a slot to skip. */
+const byte* ShmRing_Peek(const ShmRing* ring, int consumerId, int index, int* length);
+
+/* Consumer: hand count slots back to the producers */
+void ShmRing_Release(ShmRing* ring, int consumerId, int count);
+
+void ShmRing_Snapshot(const ShmRing* ring, ShmRingStats* stats);
+
+#endif /* ASN1CRT_SHMRING_H */
@@ -0,0 +1,161 @@
+/* asn1crt_statetable.c - Seqlock latest-value housekeeping table per source */
+#define _GNU_SOURCE
+#include "asn1crt_statetable.h"
+#include "asn1crt_internal.h"
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+#define STATETABLE_LINE   64
+#define STATETABLE_SPINS  64   /* Busy retries before yielding to a preempted writer */
+#define STATETABLE_WORDS  (sizeof(StateSnapshot) / sizeof(StateWord))
+
+/* Snapshot words; may_alias because StateSnapshot holds ints and structs */
+typedef unsigned long long __attribute__((may_alias)) StateWord;
+
+_Static_assert(sizeof(StateSnapshot) % sizeof(StateWord) == 0, "StateSnapshot must be whole 64-bit words");
+
+static size_t StateTable_RoundLine(size_t size) {
+    return (size + STATETABLE_LINE - 1) & ~(size_t)(STATETABLE_LINE - 1);
+}
+
+/* The coarse clock is a few ns against ~40 for CLOCK_MONOTONIC, and a
+ * display needs no more than its tick (normally 1-4 ms) */
+static unsigned long long StateTable_NowNs(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+static void StateTable_Relax(int spins) {
+    if (spins % STATETABLE_SPINS == STATETABLE_SPINS - 1) {
+        sched_yield();
+    } else {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+static StateEntry* StateTable_Entry(const StateTable* table, unsigned int sourceId) {
+    return (StateEntry*)(table->entries + (size_t)sourceId * table->entryStride);
+}
+
+size_t StateTable_PoolBytes(unsigned int sources) {
+    /* Slack to align the first entry to a cache line */
+    return StateTable_RoundLine(sizeof(StateEntry)) * sources + STATETABLE_LINE;
+}
+
+flag StateTable_Init(StateTable* table, MemPool* pool, unsigned int sources, int* pErrCode) {
+    byte* raw = (byte*)MemPool_Alloc(pool, StateTable_PoolBytes(sources));
+
+    memset(table, 0, sizeof(StateTable));
+    if (raw == NULL) {
+        return Asn1crt_Fail(pErrCode, ERR_STATETABLE_POOL);
+    }
+    table->entries = raw + (STATETABLE_LINE - (size_t)raw % STATETABLE_LINE) % STATETABLE_LINE;
+    table->entryStride = StateTable_RoundLine(sizeof(StateEntry));
+    table->sources = sources;
+    memset(table->entries, 0, table->entryStride * sources);
+    return TRUE;
+}
+
+/* Snapshots move a word at a time with relaxed atomics: a reader racing a
+ * writer sees mixed words, never a torn one, and the seq check rejects it */
+static void StateTable_Store(StateSnapshot* dst, const StateSnapshot* src) {
+    StateWord* d = (StateWord*)dst;
+    const StateWord* s = (const StateWord*)src;
+
+    for (size_t i = 0; i < STATETABLE_WORDS; i++) {
+        __atomic_store_n(&d[i], s[i], __ATOMIC_RELAXED);
+    }
+}
+
+static void StateTable_Load(StateSnapshot* dst, const StateSnapshot* src) {
+    StateWord* d = (StateWord*)dst;
+    const StateWord* s = (const StateWord*)src;
+
+    for (size_t i = 0; i < STATETABLE_WORDS; i++) {
+        d[i] = __atomic_load_n(&s[i], __ATOMIC_RELAXED);
+    }
+}
+
+static flag StateTable_Older(const T_FrameHeader* a, const T_FrameHeader* b) {
+    return a->timestamp.seconds < b->timestamp.seconds ||
+           (a->timestamp.seconds == b->timestamp.seconds && a->timestamp.subseconds < b->timestamp.subseconds);
+}
+
+flag StateTable_Update(StateTable* table, unsigned int sourceId, const T_TelemetryFrame* frame, int* pErrCode) {
+    StateEntry* e;
+    StateSnapshot next;
+    unsigned int seq;
+    int spins = 0;
+
+    if (frame->payload.kind != housekeeping_PRESENT) {
+        return TRUE;
+    }
+    if (sourceId >= table->sources) {
+        return Asn1crt_Fail(pErrCode, ERR_STATETABLE_SOURCE);
+    }
+    e = StateTable_Entry(table, sourceId);
+    /* Built before taking the entry so writers hold it only for the copy */
+    next.header = frame->header;
+    next.housekeeping = frame->payload.u.housekeeping;
+    next.updatedNs = StateTable_NowNs();
+
+    /* Odd seq marks the entry busy. The acquire only orders later loads;
+     * the release fence after it keeps the data stores below from being
+     * seen before the odd seq (smp_wmb in write_seqcount_begin) */
+    seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+    while ((seq & 1) != 0 ||
+           !__atomic_compare_exchange_n(&e->seq, &seq, seq + 1, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        StateTable_Relax(spins++);
+        seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    /* Only writers get here, one at a time: plain reads of the entry are safe */
+    if (e->valid && StateTable_Older(&frame->header, &e->value.header)) {
+        __atomic_store_n(&e->value.stale, e->value.stale + 1, __ATOMIC_RELAXED);
+    } else {
+        next.updates = e->value.updates + 1;
+        next.stale = e->value.stale;
+        StateTable_Store(&e->value, &next);
+    }
+    __atomic_store_n(&e->valid, TRUE, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->seq, seq + 2, __ATOMIC_RELEASE);
+    return TRUE;
+}
+
+flag StateTable_Read(const StateTable* table, unsigned int sourceId, StateSnapshot* out) {
+    const StateEntry* e;
+    int spins = 0;
+
+    if (sourceId >= table->sources) {
+        return FALSE;
+    }
+    e = StateTable_Entry(table, sourceId);
+    for (;;) {
+        unsigned int before = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        if ((before & 1) == 0) {
+            flag valid = __atomic_load_n(&e->valid, __ATOMIC_RELAXED);
+            StateTable_Load(out, &e->value);
+            /* Order the copy before the second seq load */
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) == before) {
+                return valid;
+            }
+        }
+        StateTable_Relax(spins++);
+    }
+}
+
+void StateTable_Emit(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData) {
+    int errCode;
+
+    StateTable_Update((StateTable*)userData, sourceId, frame, &errCode);
+}
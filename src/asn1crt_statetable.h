@@ -0,0 +1,56 @@
+/* asn1crt_statetable.h - Seqlock latest-value housekeeping table per source */
+#ifndef ASN1CRT_STATETABLE_H
+#define ASN1CRT_STATETABLE_H
+
+#include <stddef.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+/* StateTable_Init and StateTable_Update rejections */
+#define ERR_STATETABLE_POOL    1110  /* Pool smaller than StateTable_PoolBytes */
+#define ERR_STATETABLE_SOURCE  1111  /* sourceId outside the table */
+
+/* Latest housekeeping of one source, as a reader gets it */
+typedef struct {
+    T_FrameHeader header;              /* Header of the frame the values came from */
+    T_HousekeepingData housekeeping;
+    unsigned long long updatedNs;      /* CLOCK_MONOTONIC when stored, to the coarse clock's tick */
+    unsigned long long updates;        /* Housekeeping frames stored for this source */
+    unsigned long long stale;          /* Frames dropped for being older than the stored one */
+} StateSnapshot;
+
+/* One cache-line aligned entry per source. seq is odd while a writer is
+ * inside; writers take it with a CAS from even to odd, so decode workers
+ * sharing a source serialize on it and readers never write at all. */
+typedef struct {
+    unsigned int seq;
+    flag valid;
+    StateSnapshot value;
+} StateEntry;
+
+typedef struct {
+    byte* entries;             /* sources * entryStride, 64-aligned */
+    size_t entryStride;
+    unsigned int sources;
+} StateTable;
+
+/* Pool bytes for sourceIds 0..sources-1 */
+size_t StateTable_PoolBytes(unsigned int sources);
+
+flag StateTable_Init(StateTable* table, MemPool* pool, unsigned int sources, int* pErrCode);
+
+/* Store the frame's housekeeping as the source's latest values. Other
+ * payloads are ignored (TRUE); a frame with an older timestamp than the
+ * stored one is counted as stale and dropped (TRUE). */
+flag StateTable_Update(StateTable* table, unsigned int sourceId, const T_TelemetryFrame* frame, int* pErrCode);
+
+/* Consistent copy of the source's latest values without taking a lock;
+ * retries while a writer is inside. FALSE until the source's first
+ * housekeeping frame, or for a sourceId outside the table. */
+flag StateTable_Read(const StateTable* table, unsigned int sourceId, StateSnapshot* out);
+
+/* ParallelEmitFn / SchedEmitFn that updates the table (userData) from the decoders */
+void StateTable_Emit(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData);
+
+#endif /* ASN1CRT_STATETABLE_H */
@@ -3,8 +3,7 @@
 #define ASN1CRT_STREAM_H
 
 #include "asn1crt.h"
-
-void BitStream_AttachBuffer(BitStream* bs, byte* buf, int size);
+#include "asn1crt_encoding.h"  /* BitStream_AttachBuffer */
 
 /* Maximum number of fragments in a stream */
 #define MAX_STREAM_FRAGMENTS 16
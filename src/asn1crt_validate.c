@@ -0,0 +1,205 @@
+/* asn1crt_validate.c - Batch constraint validation with SIMD range compares */
+#include "asn1crt_validate.h"
+#include "asn1crt_layout.h"
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VALIDATE_HAVE_X86 1
+#endif
+
+/* Each check becomes "column value <= max" on 32-bit lanes. Gathering
+ * folds lower bounds and 64-bit overflow into the value; a field that does
+ * not apply to a row (other CHOICE alternative, past nCount) reads 0. */
+enum {
+    COL_SECONDS_HIGH,
+    COL_SUBSECONDS,
+    COL_FRAME_TYPE,
+    COL_FRAME_COUNT,
+    COL_KIND,
+    COL_MAIN_BUS,
+    COL_PAYLOAD_BUS,
+    COL_COMMS_BUS,
+    COL_TEMP_COUNT,
+    COL_TEMPERATURE,
+    COL_HK_STATUS = COL_TEMPERATURE + LAYOUT_TEMP_COUNT_MAX,
+    COL_INSTRUMENT,
+    COL_BLOCK_COUNT,
+    COL_BLOCK_LENGTH,
+    COL_COMMAND_ID = COL_BLOCK_LENGTH + LAYOUT_BLOCK_COUNT_MAX,
+    COL_ACK_STATUS,
+    VALIDATE_COLUMNS
+};
+
+typedef unsigned int ValidateVec __attribute__((vector_size(32)));
+
+#define VALIDATE_LANES ((int)(sizeof(ValidateVec) / sizeof(unsigned int)))
+
+typedef struct {
+    unsigned int max[VALIDATE_COLUMNS];
+    unsigned int field[VALIDATE_COLUMNS];
+} ValidateRules;
+
+static ValidateRules rules;
+
+typedef void (*ValidateCompareFn)(unsigned int (*cols)[VALIDATE_BLOCK], unsigned int* first);
+static ValidateCompareFn compareBlock = NULL;
+static const char* kernelName = "generic";
+static pthread_once_t validateOnce = PTHREAD_ONCE_INIT;
+
+static const char* const fieldNames[VALIDATE_FIELD_COUNT] = {
+    "ok", "header.timestamp.seconds", "header.timestamp.subseconds", "header.frameType", "header.frameCount",
+    "payload", "housekeeping.voltages.mainBus", "housekeeping.voltages.payload", "housekeeping.voltages.comms",
+    "housekeeping.temperature", "housekeeping.temperature[i]", "housekeeping.status", "science.instrumentId",
+    "science.dataBlocks", "science.dataBlocks[i]", "commandAck.commandId", "commandAck.status"
+};
+
+const char* Validate_FieldName(ValidateField field) {
+    return (unsigned int)field < VALIDATE_FIELD_COUNT ? fieldNames[field] : "unknown";
+}
+
+static void Validate_Rule(int col, int count, ValidateField field, unsigned int max) {
+    for (int i = 0; i < count; i++) {
+        rules.max[col + i] = max;
+        rules.field[col + i] = (unsigned int)field;
+    }
+}
+
+/* Unsigned value clamped to 32 bits; the clamp is above every max checked */
+static unsigned int Validate_Clamp(asn1SccUint value) {
+    return value > 0xFFFFFFFFULL ? 0xFFFFFFFFU : (unsigned int)value;
+}
+
+/* Columns start zeroed (valid); a row writes only the fields its payload
+ * carries, so it touches the same cache lines the scalar check does */
+static void Validate_Gather(unsigned int (*cols)[VALIDATE_BLOCK], int row, const T_TelemetryFrame* f) {
+    cols[COL_SECONDS_HIGH][row] = Validate_Clamp((asn1SccUint)f->header.timestamp.seconds >> 32);
+    cols[COL_SUBSECONDS][row] = Validate_Clamp(f->header.timestamp.subseconds);
+    cols[COL_FRAME_TYPE][row] = Validate_Clamp(f->header.frameType);
+    cols[COL_FRAME_COUNT][row] = Validate_Clamp(f->header.frameCount);
+    cols[COL_KIND][row] = (unsigned int)f->payload.kind - 1U;
+
+    switch (f->payload.kind) {
+    case housekeeping_PRESENT: {
+        const T_HousekeepingData* hk = &f->payload.u.housekeeping;
+        int temps = hk->temperature.nCount < LAYOUT_TEMP_COUNT_MAX ? hk->temperature.nCount : LAYOUT_TEMP_COUNT_MAX;
+        cols[COL_MAIN_BUS][row] = Validate_Clamp(hk->voltages.mainBus);
+        cols[COL_PAYLOAD_BUS][row] = Validate_Clamp(hk->voltages.payload);
+        cols[COL_COMMS_BUS][row] = Validate_Clamp(hk->voltages.comms);
+        cols[COL_TEMP_COUNT][row] = (unsigned int)hk->temperature.nCount - LAYOUT_TEMP_COUNT_MIN;
+        for (int i = 0; i < temps; i++) {
+            cols[COL_TEMPERATURE + i][row] =
+                Validate_Clamp((asn1SccUint)hk->temperature.arr[i] - (asn1SccUint)LAYOUT_TEMP_MIN);
+        }
+        cols[COL_HK_STATUS][row] = Validate_Clamp(hk->status);
+        break;
+    }
+    case science_PRESENT: {
+        const T_ScienceData* sci = &f->payload.u.science;
+        int blocks = sci->dataBlocks.nCount < LAYOUT_BLOCK_COUNT_MAX ? sci->dataBlocks.nCount : LAYOUT_BLOCK_COUNT_MAX;
+        cols[COL_INSTRUMENT][row] = Validate_Clamp(sci->instrumentId);
+        cols[COL_BLOCK_COUNT][row] = (unsigned int)sci->dataBlocks.nCount - LAYOUT_BLOCK_COUNT_MIN;
+        for (int i = 0; i < blocks; i++) {
+            cols[COL_BLOCK_LENGTH + i][row] = (unsigned int)sci->dataBlocks.arr[i].nCount - LAYOUT_BLOCK_LENGTH_MIN;
+        }
+        break;
+    }
+    case commandAck_PRESENT:
+        cols[COL_COMMAND_ID][row] = Validate_Clamp(f->payload.u.commandAck.commandId);
+        cols[COL_ACK_STATUS][row] = (unsigned int)f->payload.u.commandAck.status;
+        break;
+    default:
+        break;
+    }
+}
+
+/* Walk the columns last to first so the earliest failing field wins */
+static inline __attribute__((always_inline)) void Validate_CompareBody(unsigned int (*cols)[VALIDATE_BLOCK],
+                                                                      unsigned int* first) {
+    for (int r = 0; r < VALIDATE_BLOCK; r += VALIDATE_LANES) {
+        ValidateVec found = { 0 };
+        for (int c = VALIDATE_COLUMNS - 1; c >= 0; c--) {
+            ValidateVec value;
+            ValidateVec bad;
+            memcpy(&value, &cols[c][r], sizeof(value));
+            bad = (ValidateVec)(value > rules.max[c]);
+            found = (bad & rules.field[c]) | (~bad & found);
+        }
+        memcpy(first + r, &found, sizeof(found));
+    }
+}
+
+static void Validate_CompareGeneric(unsigned int (*cols)[VALIDATE_BLOCK], unsigned int* first) {
+    Validate_CompareBody(cols, first);
+}
+
+#ifdef VALIDATE_HAVE_X86
+__attribute__((target("avx2")))
+static void Validate_CompareAvx2(unsigned int (*cols)[VALIDATE_BLOCK], unsigned int* first) {
+    Validate_CompareBody(cols, first);
+}
+#endif
+
+static void Validate_Setup(void) {
+    Validate_Rule(COL_SECONDS_HIGH, 1, VALIDATE_SECONDS, 0);
+    Validate_Rule(COL_SUBSECONDS, 1, VALIDATE_SUBSECONDS, LAYOUT_SUBSECONDS_MAX);
+    Validate_Rule(COL_FRAME_TYPE, 1, VALIDATE_FRAME_TYPE, (1U << LAYOUT_FRAME_TYPE_BITS) - 1);
+    Validate_Rule(COL_FRAME_COUNT, 1, VALIDATE_FRAME_COUNT, (1U << LAYOUT_FRAME_COUNT_BITS) - 1);
+    Validate_Rule(COL_KIND, 1, VALIDATE_KIND, commandAck_PRESENT - housekeeping_PRESENT);
+    Validate_Rule(COL_MAIN_BUS, 1, VALIDATE_MAIN_BUS, LAYOUT_VOLTAGE_MAX);
+    Validate_Rule(COL_PAYLOAD_BUS, 1, VALIDATE_PAYLOAD_BUS, LAYOUT_VOLTAGE_MAX);
+    Validate_Rule(COL_COMMS_BUS, 1, VALIDATE_COMMS_BUS, LAYOUT_VOLTAGE_MAX);
+    Validate_Rule(COL_TEMP_COUNT, 1, VALIDATE_TEMP_COUNT, LAYOUT_TEMP_COUNT_MAX - LAYOUT_TEMP_COUNT_MIN);
+    Validate_Rule(COL_TEMPERATURE, LAYOUT_TEMP_COUNT_MAX, VALIDATE_TEMPERATURE, LAYOUT_TEMP_MAX - LAYOUT_TEMP_MIN);
+    Validate_Rule(COL_HK_STATUS, 1, VALIDATE_HK_STATUS, (1U << LAYOUT_STATUS_BITS) - 1);
+    Validate_Rule(COL_INSTRUMENT, 1, VALIDATE_INSTRUMENT, (1U << LAYOUT_INSTRUMENT_BITS) - 1);
+    Validate_Rule(COL_BLOCK_COUNT, 1, VALIDATE_BLOCK_COUNT, LAYOUT_BLOCK_COUNT_MAX - LAYOUT_BLOCK_COUNT_MIN);
+    Validate_Rule(COL_BLOCK_LENGTH, LAYOUT_BLOCK_COUNT_MAX, VALIDATE_BLOCK_LENGTH,
+                  LAYOUT_BLOCK_LENGTH_MAX - LAYOUT_BLOCK_LENGTH_MIN);
+    Validate_Rule(COL_COMMAND_ID, 1, VALIDATE_COMMAND_ID, (1U << LAYOUT_COMMAND_ID_BITS) - 1);
+    Validate_Rule(COL_ACK_STATUS, 1, VALIDATE_ACK_STATUS, LAYOUT_ACK_STATUS_MAX);
+
+    compareBlock = Validate_CompareGeneric;
+#ifdef VALIDATE_HAVE_X86
+    kernelName = "sse2";
+    if (__builtin_cpu_supports("avx2")) {
+        compareBlock = Validate_CompareAvx2;
+        kernelName = "avx2";
+    }
+#endif
+}
+
+const char* Validate_Kernel(void) {
+    pthread_once(&validateOnce, Validate_Setup);
+    return kernelName;
+}
+
+int Validate_Frames(const T_TelemetryFrame* frames, int count, unsigned long long* invalid, byte* firstField) {
+    unsigned int cols[VALIDATE_COLUMNS][VALIDATE_BLOCK] __attribute__((aligned(32)));
+    unsigned int first[VALIDATE_BLOCK] __attribute__((aligned(32)));
+    int total = 0;
+
+    pthread_once(&validateOnce, Validate_Setup);
+
+    for (int base = 0; base < count; base += VALIDATE_BLOCK) {
+        int rows = count - base < VALIDATE_BLOCK ? count - base : VALIDATE_BLOCK;
+        unsigned long long bits = 0;
+
+        /* Rows past the batch, like absent fields, compare as valid */
+        memset(cols, 0, sizeof(cols));
+        for (int r = 0; r < rows; r++) {
+            Validate_Gather(cols, r, &frames[base + r]);
+        }
+        compareBlock(cols, first);
+
+        for (int r = 0; r < rows; r++) {
+            bits |= (unsigned long long)(first[r] != 0) << r;
+            if (firstField != NULL) {
+                firstField[base + r] = (byte)first[r];
+            }
+        }
+        invalid[base / VALIDATE_BLOCK] = bits;
+        total += __builtin_popcountll(bits);
+    }
+    return total;
+}
@@ -0,0 +1,45 @@
+/* asn1crt_validate.h - Batch constraint validation with SIMD range compares */
+#ifndef ASN1CRT_VALIDATE_H
+#define ASN1CRT_VALIDATE_H
+
+#include "asn1crt.h"
+#include "satellite.h"
+
+/* Rows validated per SoA block; one bitmap word per block */
+#define VALIDATE_BLOCK 64
+
+/* Constrained fields in schema order; the first failing one is reported */
+typedef enum {
+    VALIDATE_OK,
+    VALIDATE_SECONDS,
+    VALIDATE_SUBSECONDS,
+    VALIDATE_FRAME_TYPE,
+    VALIDATE_FRAME_COUNT,
+    VALIDATE_KIND,
+    VALIDATE_MAIN_BUS,
+    VALIDATE_PAYLOAD_BUS,
+    VALIDATE_COMMS_BUS,
+    VALIDATE_TEMP_COUNT,
+    VALIDATE_TEMPERATURE,
+    VALIDATE_HK_STATUS,
+    VALIDATE_INSTRUMENT,
+    VALIDATE_BLOCK_COUNT,
+    VALIDATE_BLOCK_LENGTH,
+    VALIDATE_COMMAND_ID,
+    VALIDATE_ACK_STATUS,
+    VALIDATE_FIELD_COUNT
+} ValidateField;
+
+/* Check count frames. Bit i of invalid ((count + 63) / 64 words) is set
+ * when frames[i] breaks a constraint; firstField[i] (may be NULL) names
+ * the first one in schema order. Returns the number of invalid frames.
+ * Agrees with T_TelemetryFrame_IsConstraintValid frame by frame, so valid
+ * frames can then be encoded with bCheckConstraints FALSE. */
+int Validate_Frames(const T_TelemetryFrame* frames, int count, unsigned long long* invalid, byte* firstField);
+
+const char* Validate_FieldName(ValidateField field);
+
+/* Compare kernel picked at runtime: "avx2", "sse2" or "generic" */
+const char* Validate_Kernel(void);
+
+#endif /* ASN1CRT_VALIDATE_H */
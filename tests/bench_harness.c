@@ -0,0 +1,197 @@
+/* bench_harness.c - Timing harness shared by the benchmark programs */
+#include "bench_harness.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#endif
+
+static double tscNsPerTick = 0.0;
+
+void BenchConfig_Default(BenchConfig* cfg) {
+    cfg->warmupOps = 2000;
+    cfg->samples = 20000;
+    cfg->opsPerSample = 8;
+    cfg->useTsc = FALSE;
+}
+
+static double Bench_MonotonicNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+#ifdef BENCH_HAVE_TSC
+/* Ticks per ns over a 20 ms busy window; assumes an invariant TSC */
+static void Bench_CalibrateTsc(void) {
+    double startNs = Bench_MonotonicNs();
+    unsigned long long startTicks = __rdtsc();
+    while (Bench_MonotonicNs() - startNs < 20e6) {
+    }
+    tscNsPerTick = (Bench_MonotonicNs() - startNs) / (double)(__rdtsc() - startTicks);
+}
+#endif
+
+double Bench_NowNs(flag useTsc) {
+#ifdef BENCH_HAVE_TSC
+    if (useTsc) {
+        if (tscNsPerTick == 0.0) {
+            Bench_CalibrateTsc();
+        }
+        return (double)__rdtsc() * tscNsPerTick;
+    }
+#endif
+    return Bench_MonotonicNs();
+}
+
+static int Bench_CompareDouble(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array */
+static double Bench_Percentile(const double* sorted, int count, double pct) {
+    int rank = (int)(pct / 100.0 * count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+flag Bench_Run(const BenchConfig* cfg, const char* name, BenchOp op, void* userData, BenchResult* result) {
+    int samples = cfg->samples > 0 ? cfg->samples : 1;
+    int perSample = cfg->opsPerSample > 0 ? cfg->opsPerSample : 1;
+    double* latencies = (double*)malloc(sizeof(double) * (size_t)samples);
+    double total = 0.0;
+    long long bytes = 0;
+    long long good = 0;
+
+    if (latencies == NULL) {
+        return FALSE;
+    }
+    memset(result, 0, sizeof(BenchResult));
+    snprintf(result->name, sizeof(result->name), "%s", name);
+
+    for (int i = 0; i < cfg->warmupOps; i++) {
+        op(userData);
+    }
+
+    for (int s = 0; s < samples; s++) {
+        double start = Bench_NowNs(cfg->useTsc);
+        for (int i = 0; i < perSample; i++) {
+            int n = op(userData);
+            if (n < 0) {
+                result->errors++;
+            } else {
+                bytes += n;
+                good++;
+            }
+        }
+        latencies[s] = (Bench_NowNs(cfg->useTsc) - start) / perSample;
+        total += latencies[s];
+    }
+
+    qsort(latencies, (size_t)samples, sizeof(double), Bench_CompareDouble);
+    result->ops = (long long)samples * perSample;
+    result->bytesPerOp = good > 0 ? (int)(bytes / good) : 0;
+    result->minNs = latencies[0];
+    result->meanNs = total / samples;
+    result->p50Ns = Bench_Percentile(latencies, samples, 50.0);
+    result->p99Ns = Bench_Percentile(latencies, samples, 99.0);
+    result->p999Ns = Bench_Percentile(latencies, samples, 99.9);
+    result->opsPerSec = result->meanNs > 0 ? 1e9 / result->meanNs : 0;
+    result->bytesPerSec = total > 0 ? (double)bytes / (total * perSample) * 1e9 : 0;
+
+    free(latencies);
+    return TRUE;
+}
+
+void Bench_PrintHeader(void) {
+    printf("%-32s %6s %9s %9s %9s %9s %12s %10s\n",
+           "case", "bytes", "p50 ns", "p99 ns", "p999 ns", "mean ns", "ops/s", "MB/s");
+}
+
+void Bench_Print(const BenchResult* r) {
+    printf("%-32s %6d %9.1f %9.1f %9.1f %9.1f %12.0f %10.1f%s\n",
+           r->name, r->bytesPerOp, r->p50Ns, r->p99Ns, r->p999Ns, r->meanNs,
+           r->opsPerSec, r->bytesPerSec / 1e6, r->errors > 0 ? "  ERRORS" : "");
+}
+
+void Bench_WriteJson(FILE* out, const BenchResult* r, flag useTsc) {
+    fprintf(out, "{\"name\":\"%s\",\"clock\":\"%s\",\"ops\":%lld,\"bytes\":%d,\"errors\":%lld,"
+                 "\"ns_min\":%.2f,\"ns_mean\":%.2f,\"ns_p50\":%.2f,\"ns_p99\":%.2f,\"ns_p999\":%.2f,"
+                 "\"ops_per_sec\":%.0f,\"bytes_per_sec\":%.0f}\n",
+            r->name, useTsc ? "tsc" : "monotonic", r->ops, r->bytesPerOp, r->errors,
+            r->minNs, r->meanNs, r->p50Ns, r->p99Ns, r->p999Ns, r->opsPerSec, r->bytesPerSec);
+}
+
+/* Value following "key": in a line written by Bench_WriteJson */
+static flag Bench_JsonNumber(const char* line, const char* key, double* value) {
+    char pattern[32];
+    const char* at;
+
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    at = strstr(line, pattern);
+    return at != NULL && sscanf(at + strlen(pattern), "%lf", value) == 1;
+}
+
+int Bench_LoadBaseline(const char* path, BenchResult* results, int maxResults) {
+    FILE* in = fopen(path, "r");
+    char line[512];
+    int count = 0;
+
+    if (in == NULL) {
+        return -1;
+    }
+    while (count < maxResults && fgets(line, sizeof(line), in) != NULL) {
+        BenchResult* r = &results[count];
+        const char* name = strstr(line, "\"name\":\"");
+        const char* end;
+        double value;
+
+        if (name == NULL) continue;
+        name += 8;
+        end = strchr(name, '"');
+        if (end == NULL || end - name >= BENCH_NAME_SIZE) continue;
+
+        memset(r, 0, sizeof(BenchResult));
+        memcpy(r->name, name, (size_t)(end - name));
+        if (Bench_JsonNumber(line, "ns_p50", &value)) r->p50Ns = value;
+        if (Bench_JsonNumber(line, "ns_p99", &value)) r->p99Ns = value;
+        if (Bench_JsonNumber(line, "ns_p999", &value)) r->p999Ns = value;
+        if (Bench_JsonNumber(line, "ns_mean", &value)) r->meanNs = value;
+        count++;
+    }
+    fclose(in);
+    return count;
+}
+
+int Bench_Compare(const BenchResult* current, int count,
+                  const BenchResult* baseline, int baselineCount, double thresholdPct) {
+    int regressions = 0;
+
+    printf("%-32s %10s %10s %8s\n", "case", "base p50", "now p50", "delta");
+    for (int i = 0; i < count; i++) {
+        const BenchResult* base = NULL;
+        for (int j = 0; j < baselineCount; j++) {
+            if (strcmp(baseline[j].name, current[i].name) == 0) {
+                base = &baseline[j];
+                break;
+            }
+        }
+        if (base == NULL || base->p50Ns <= 0) {
+            printf("%-32s %10s %10.1f %8s\n", current[i].name, "-", current[i].p50Ns, "new");
+            continue;
+        }
+
+        double delta = (current[i].p50Ns - base->p50Ns) / base->p50Ns * 100.0;
+        flag regressed = delta > thresholdPct;
+        printf("%-32s %10.1f %10.1f %+7.1f%%%s\n", current[i].name, base->p50Ns,
+               current[i].p50Ns, delta, regressed ? "  REGRESSION" : "");
+        if (regressed) regressions++;
+    }
+    return regressions;
+}
@@ -0,0 +1,62 @@
+/* bench_harness.h - Timing harness shared by the benchmark programs */
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "asn1crt.h"
+
+#define BENCH_NAME_SIZE 64
+
+/* How each case is run */
+typedef struct {
+    int warmupOps;      /* Untimed ops before the first sample */
+    int samples;        /* Timed samples per case */
+    int opsPerSample;   /* Ops between clock reads; percentiles are of their means
+                         * (1 = true per-op timing) */
+    flag useTsc;        /* rdtsc calibrated against CLOCK_MONOTONIC */
+} BenchConfig;
+
+/* One benchmark operation; returns bytes processed, or -1 on failure */
+typedef int (*BenchOp)(void* userData);
+
+/* Summary of one case; latencies are ns per op */
+typedef struct {
+    char name[BENCH_NAME_SIZE];
+    long long ops;        /* Timed ops */
+    int bytesPerOp;       /* Mean bytes reported per successful op */
+    long long errors;     /* Ops that returned -1 */
+    double minNs;
+    double meanNs;
+    double p50Ns;
+    double p99Ns;
+    double p999Ns;
+    double opsPerSec;     /* From mean latency */
+    double bytesPerSec;
+} BenchResult;
+
+/* 2000 warmup ops, 20000 samples of 8 ops, CLOCK_MONOTONIC */
+void BenchConfig_Default(BenchConfig* cfg);
+
+/* Current time in ns from the configured clock */
+double Bench_NowNs(flag useTsc);
+
+/* Run op under cfg and fill result; FALSE when sample memory runs out */
+flag Bench_Run(const BenchConfig* cfg, const char* name, BenchOp op, void* userData, BenchResult* result);
+
+/* Human-readable table */
+void Bench_PrintHeader(void);
+void Bench_Print(const BenchResult* result);
+
+/* One JSON object per line, so files can be appended and diffed */
+void Bench_WriteJson(FILE* out, const BenchResult* result, flag useTsc);
+
+/* Read results written by Bench_WriteJson; returns the count loaded or -1 */
+int Bench_LoadBaseline(const char* path, BenchResult* results, int maxResults);
+
+/* Print p50 deltas against a baseline by name.
+ * Returns the number of cases slower than thresholdPct. */
+int Bench_Compare(const BenchResult* current, int count,
+                  const BenchResult* baseline, int baselineCount, double thresholdPct);
+
+#endif /* BENCH_HARNESS_H */
@@ -0,0 +1,372 @@
+/* soak_test.c - Long-running encode/frame/decode/consume loop sampling drift over time */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_integrity.h"
+#include "asn1crt_latency.h"
+#include "satellite.h"
+
+#define MAX_BATCH 4096
+#define MAX_SOURCES 256
+#define FRAME_CAPACITY (T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + INTEGRITY_MAX_TRAILER)
+
+typedef struct {
+    double duration;          /* Seconds to run, 0 = until SIGINT */
+    double interval;          /* Seconds between samples */
+    double rate;              /* Frames per second, 0 = as fast as possible */
+    int batch;                /* Frames per pool cycle */
+    IntegrityKind integrity;
+    const char* csvPath;
+    double maxRssGrowth;      /* Fail when RSS grows more than this many KB, 0 = report only */
+    double maxSlowdown;       /* Fail when throughput drops more than this %, 0 = report only */
+} SoakConfig;
+
+/* One row of the time series */
+typedef struct {
+    double elapsed;
+    unsigned long long frames;
+    double framesPerSecond;
+    double megabytesPerSecond;
+    double encodeP99Ns;
+    double decodeP99Ns;
+    long rssKb;
+    size_t poolPeak;
+    unsigned long long errors;
+    unsigned long long gaps;
+} SoakSample;
+
+/* Per-batch state, all carved from the pool on every cycle */
+typedef struct {
+    T_TelemetryFrame* sources;   /* Values fed to the encoder */
+    T_TelemetryFrame* decoded;   /* Values out of the decoder */
+    byte** wire;                 /* Framed bytes, sized to each frame */
+    int* lengths;
+} SoakBatch;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stopRequested = 1;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void sleep_until(double deadline) {
+    double delay = deadline - now_seconds();
+    if (delay <= 0) return;
+    struct timespec ts;
+    ts.tv_sec = (time_t)delay;
+    ts.tv_nsec = (long)((delay - (double)ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+}
+
+// Resident set size from /proc/self/statm (pages -> KB)
+static long resident_kb(void) {
+    long pages = 0, resident = 0;
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f == NULL) return -1;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    fclose(f);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// All ok kinds of one op merged, minus what the previous snapshot already held
+static void interval_histogram(const LatencySnapshot* now, const LatencySnapshot* before,
+                               LatencyOp op, LatencyHistogram* out) {
+    memset(out, 0, sizeof(LatencyHistogram));
+    for (int k = 0; k < LATENCY_KINDS; k++) {
+        const LatencyHistogram* a = &now->ok[op][k];
+        const LatencyHistogram* b = &before->ok[op][k];
+        for (int i = 0; i < LATENCY_BUCKETS; i++) {
+            out->counts[i] += a->counts[i] - b->counts[i];
+        }
+        out->total += a->total - b->total;
+        out->sumTicks += a->sumTicks - b->sumTicks;
+        if (a->maxTicks > out->maxTicks) out->maxTicks = a->maxTicks;
+    }
+}
+
+static flag batch_alloc(MemPool* pool, SoakBatch* b, int count) {
+    // Large fixed arrays first, then one exact-size buffer per frame
+    b->sources = (T_TelemetryFrame*)MemPool_Alloc(pool, sizeof(T_TelemetryFrame) * count);
+    b->decoded = (T_TelemetryFrame*)MemPool_Alloc(pool, sizeof(T_TelemetryFrame) * count);
+    b->wire = (byte**)MemPool_Alloc(pool, sizeof(byte*) * count);
+    b->lengths = (int*)MemPool_Alloc(pool, sizeof(int) * count);
+    return b->sources != NULL && b->decoded != NULL && b->wire != NULL && b->lengths != NULL;
+}
+
+static size_t pool_bytes(int batch) {
+    return (sizeof(T_TelemetryFrame) * 2 + sizeof(byte*) + sizeof(int) + 16) * (size_t)batch +
+           (size_t)FRAME_CAPACITY * batch;
+}
+
+static void write_row(FILE* csv, const SoakSample* s) {
+    fprintf(csv, "%.1f,%llu,%.0f,%.3f,%.0f,%.0f,%ld,%zu,%llu,%llu\n", s->elapsed, s->frames,
+            s->framesPerSecond, s->megabytesPerSecond, s->encodeP99Ns, s->decodeP99Ns, s->rssKb,
+            s->poolPeak, s->errors, s->gaps);
+    fflush(csv);
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --duration SEC        total run time, 0 = until Ctrl-C (default 60)\n");
+    printf("  --interval SEC        sampling interval (default 5)\n");
+    printf("  --rate FPS            target frames per second, 0 = unthrottled (default 0)\n");
+    printf("  --batch N             frames per pool cycle, 1-%d (default 256)\n", MAX_BATCH);
+    printf("  --crc none|crc16|crc32c   frame trailer (default crc32c)\n");
+    printf("  --seed N              corpus generator seed\n");
+    printf("  --mix HK:SCI:ACK      payload weights (default 60:30:10)\n");
+    printf("  --csv FILE            time series output (default soak.csv)\n");
+    printf("  --max-rss-growth KB   fail when RSS grows more than KB after the first sample\n");
+    printf("  --max-slowdown PCT    fail when throughput drops more than PCT%% from the first sample\n");
+}
+
+int main(int argc, char** argv) {
+    SoakConfig cfg = { 60.0, 5.0, 0.0, 256, INTEGRITY_CRC32C, "soak.csv", 0.0, 0.0 };
+    CorpusMix mix;
+
+    CorpusMix_Default(&mix);
+    mix.seed = 1;
+    for (int i = 1; i < argc; i++) {
+        int ok = i + 1 < argc;
+        if (ok && strcmp(argv[i], "--duration") == 0) {
+            cfg.duration = atof(argv[++i]);
+        } else if (ok && strcmp(argv[i], "--interval") == 0) {
+            cfg.interval = atof(argv[++i]);
+        } else if (ok && strcmp(argv[i], "--rate") == 0) {
+            cfg.rate = atof(argv[++i]);
+        } else if (ok && strcmp(argv[i], "--batch") == 0) {
+            cfg.batch = atoi(argv[++i]);
+        } else if (ok && strcmp(argv[i], "--crc") == 0) {
+            i++;
+            if (strcmp(argv[i], "none") == 0) cfg.integrity = INTEGRITY_NONE;
+            else if (strcmp(argv[i], "crc16") == 0) cfg.integrity = INTEGRITY_CRC16_CCSDS;
+            else if (strcmp(argv[i], "crc32c") == 0) cfg.integrity = INTEGRITY_CRC32C;
+            else ok = 0;
+        } else if (ok && strcmp(argv[i], "--seed") == 0) {
+            mix.seed = strtoull(argv[++i], NULL, 10);
+        } else if (ok && strcmp(argv[i], "--mix") == 0) {
+            ok = CorpusMix_ParseWeights(&mix, argv[++i]);
+        } else if (ok && strcmp(argv[i], "--csv") == 0) {
+            cfg.csvPath = argv[++i];
+        } else if (ok && strcmp(argv[i], "--max-rss-growth") == 0) {
+            cfg.maxRssGrowth = atof(argv[++i]);
+        } else if (ok && strcmp(argv[i], "--max-slowdown") == 0) {
+            cfg.maxSlowdown = atof(argv[++i]);
+        } else {
+            ok = 0;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.batch < 1 || cfg.batch > MAX_BATCH || cfg.interval <= 0 || cfg.duration < 0 || cfg.rate < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE* csv = fopen(cfg.csvPath, "w");
+    if (csv == NULL) {
+        printf("ERROR: Cannot write %s\n", cfg.csvPath);
+        return 1;
+    }
+    fprintf(csv, "elapsed_s,frames,frames_per_s,mb_per_s,encode_p99_ns,decode_p99_ns,"
+                 "rss_kb,pool_peak_bytes,errors,gaps\n");
+
+    size_t poolSize = pool_bytes(cfg.batch);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    CorpusGenerator gen;
+    unsigned int frameCounts[MAX_SOURCES];
+    int expectedCount[MAX_SOURCES];
+
+    if (poolBuffer == NULL || !CorpusGenerator_Init(&gen, &mix, frameCounts)) {
+        printf("ERROR: Setup failed\n");
+        fclose(csv);
+        free(poolBuffer);
+        return 1;
+    }
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    for (int s = 0; s < MAX_SOURCES; s++) expectedCount[s] = -1;
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    Latency_SetEnabled(TRUE);
+
+    printf("===== Telemetry Soak Test =====\n");
+    printf("Duration: %.0fs, interval: %.0fs, rate: %.0f frames/s (0 = unthrottled), batch: %d, trailer: %d bytes\n",
+           cfg.duration, cfg.interval, cfg.rate, cfg.batch, FrameIntegrity_TrailerSize(cfg.integrity));
+    printf("Time series: %s\n\n", cfg.csvPath);
+    printf("%8s %12s %10s %8s %10s %10s %10s %10s %7s\n", "elapsed", "frames", "frames/s", "MB/s",
+           "enc p99", "dec p99", "RSS KB", "pool peak", "errors");
+
+    static LatencySnapshot before, after;
+    static LatencyHistogram hist;
+    Latency_Snapshot(&before);
+
+    SoakSample first, last;
+    int samples = 0;
+    unsigned long long totalFrames = 0, intervalFrames = 0, intervalBytes = 0;
+    unsigned long long errors = 0, gaps = 0;
+    unsigned long long consumed = 0;   /* Folded over every decoded value so nothing is skipped */
+    int poolExhausted = 0;
+    double start = now_seconds();
+    double nextSample = start + cfg.interval;
+    double intervalStart = start;
+    memset(&first, 0, sizeof(first));
+    memset(&last, 0, sizeof(last));
+
+    while (!stopRequested) {
+        SoakBatch b;
+        int errCode;
+
+        // Frame: encode every value and append its trailer into an exact-size pool buffer
+        MemPool_Reset(&pool);
+        if (!batch_alloc(&pool, &b, cfg.batch)) {
+            printf("ERROR: Pool of %zu bytes too small for batch\n", poolSize);
+            poolExhausted = 1;
+            break;
+        }
+        for (int i = 0; i < cfg.batch; i++) {
+            byte scratch[FRAME_CAPACITY];
+            BitStream bs;
+
+            CorpusGenerator_Next(&gen, &mix, &b.sources[i]);
+            BitStream_Init(&bs, scratch, T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING);
+            if (!T_TelemetryFrame_EncodeTimed(&b.sources[i], &bs, &errCode, TRUE)) {
+                errors++;
+                b.lengths[i] = 0;
+                continue;
+            }
+            b.lengths[i] = FrameIntegrity_Append(cfg.integrity, scratch, (int)BitStream_GetLength(&bs),
+                                                 FRAME_CAPACITY);
+            b.wire[i] = (byte*)MemPool_Alloc(&pool, (size_t)b.lengths[i]);
+            if (b.wire[i] == NULL) {
+                printf("ERROR: Pool of %zu bytes exhausted at frame %d of the batch\n", poolSize, i);
+                poolExhausted = 1;
+                break;
+            }
+            memcpy(b.wire[i], scratch, (size_t)b.lengths[i]);
+        }
+        if (poolExhausted) break;
+
+        // Decode and consume: verify, decode, compare with the source and track sequence gaps
+        for (int i = 0; i < cfg.batch; i++) {
+            int payloadLength;
+            BitStream bs;
+
+            if (b.lengths[i] == 0) continue;
+            if (!FrameIntegrity_Verify(cfg.integrity, b.wire[i], b.lengths[i], &payloadLength)) {
+                errors++;
+                continue;
+            }
+            BitStream_AttachBuffer(&bs, b.wire[i], payloadLength);
+            if (!T_TelemetryFrame_DecodeTimed(&b.decoded[i], &bs, &errCode)) {
+                errors++;
+                continue;
+            }
+
+            const T_FrameHeader* h = &b.decoded[i].header;
+            int source = (int)h->frameType;
+            if (h->frameCount != b.sources[i].header.frameCount ||
+                h->timestamp.seconds != b.sources[i].header.timestamp.seconds ||
+                b.decoded[i].payload.kind != b.sources[i].payload.kind) {
+                errors++;
+            }
+            if (expectedCount[source] >= 0 && (int)h->frameCount != expectedCount[source]) gaps++;
+            expectedCount[source] = (int)((h->frameCount + 1) & 0xFFFF);
+            consumed += h->frameCount + h->timestamp.subseconds + (unsigned long long)b.decoded[i].payload.kind;
+            intervalBytes += (unsigned long long)b.lengths[i];
+        }
+        totalFrames += (unsigned long long)cfg.batch;
+        intervalFrames += (unsigned long long)cfg.batch;
+
+        if (cfg.rate > 0) {
+            sleep_until(start + (double)totalFrames / cfg.rate);
+        }
+
+        double now = now_seconds();
+        if (now < nextSample) continue;
+
+        SoakSample s;
+        double span = now - intervalStart;
+        Latency_Snapshot(&after);
+        s.elapsed = now - start;
+        s.frames = totalFrames;
+        s.framesPerSecond = intervalFrames / span;
+        s.megabytesPerSecond = intervalBytes / span / 1e6;
+        interval_histogram(&after, &before, LATENCY_OP_ENCODE, &hist);
+        s.encodeP99Ns = LatencyHistogram_ValueAt(&hist, 99.0) * after.nsPerTick;
+        interval_histogram(&after, &before, LATENCY_OP_DECODE, &hist);
+        s.decodeP99Ns = LatencyHistogram_ValueAt(&hist, 99.0) * after.nsPerTick;
+        s.rssKb = resident_kb();
+        s.poolPeak = pool.peak;
+        s.errors = errors;
+        s.gaps = gaps;
+        before = after;
+
+        write_row(csv, &s);
+        printf("%7.0fs %12llu %10.0f %8.2f %8.0fns %8.0fns %10ld %10zu %7llu\n", s.elapsed, s.frames,
+               s.framesPerSecond, s.megabytesPerSecond, s.encodeP99Ns, s.decodeP99Ns, s.rssKb,
+               s.poolPeak, s.errors);
+        fflush(stdout);
+
+        if (samples == 0) first = s;
+        last = s;
+        samples++;
+        intervalFrames = 0;
+        intervalBytes = 0;
+        intervalStart = now;
+        nextSample += cfg.interval;
+        if (cfg.duration > 0 && s.elapsed >= cfg.duration) break;
+    }
+    fclose(csv);
+    free(poolBuffer);
+    if (poolExhausted) {
+        printf("\nSoak test: FAILED\n");
+        return 1;
+    }
+
+    printf("\nFrames: %llu, decode errors: %llu, sequence gaps: %llu (consumed %llx)\n",
+           totalFrames, errors, gaps, consumed);
+    if (samples < 2) {
+        printf("Too few samples for drift; run longer than two intervals\n");
+        return errors == 0 ? 0 : 1;
+    }
+
+    // Drift: last sample against the first, scaled to an hour
+    double hours = (last.elapsed - first.elapsed) / 3600.0;
+    double rssGrowth = (double)(last.rssKb - first.rssKb);
+    double slowdown = first.framesPerSecond > 0
+                      ? (first.framesPerSecond - last.framesPerSecond) / first.framesPerSecond * 100.0 : 0.0;
+    printf("Drift over %.2f h:\n", hours);
+    printf("  RSS:        %+.0f KB (%+.0f KB/h)\n", rssGrowth, hours > 0 ? rssGrowth / hours : 0.0);
+    printf("  Throughput: %.0f -> %.0f frames/s (%+.1f%%)\n", first.framesPerSecond,
+           last.framesPerSecond, -slowdown);
+    printf("  Decode p99: %.0f -> %.0f ns\n", first.decodeP99Ns, last.decodeP99Ns);
+    printf("  Pool peak:  %zu -> %zu of %zu bytes\n", first.poolPeak, last.poolPeak, poolSize);
+
+    int failed = errors > 0;
+    if (cfg.maxRssGrowth > 0 && rssGrowth > cfg.maxRssGrowth) {
+        printf("FAILED: RSS grew %.0f KB (limit %.0f)\n", rssGrowth, cfg.maxRssGrowth);
+        failed = 1;
+    }
+    if (cfg.maxSlowdown > 0 && slowdown > cfg.maxSlowdown) {
+        printf("FAILED: Throughput dropped %.1f%% (limit %.1f%%)\n", slowdown, cfg.maxSlowdown);
+        failed = 1;
+    }
+    printf("\nSoak test: %s\n", failed ? "FAILED" : "PASSED");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,400 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_encoding.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_partial.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_lazy.h"
+#include "asn1crt_flat.h"
+#include "satellite.h"
+#include "bench_harness.h"
+
+#define MAX_CASES 64
+#define MAX_BASELINE 256
+
+typedef enum { OP_ENCODE, OP_DECODE, OP_PARTIAL, OP_LAZY, OP_FLAT, OP_TO_FLAT, OP_FROM_FLAT } BenchOpKind;
+
+static const char* opNames[] = { "encode", "decode", "partial", "lazy", "flat", "toflat", "fromflat" };
+
+/* One row of the matrix: a frame value and its encoding */
+typedef struct {
+    char label[32];
+    T_TelemetryFrame frame;          /* Value the encode op writes */
+    T_TelemetryFrame* decoded;       /* Pool-allocated decode target */
+    byte encoded[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    int encodedLength;
+    byte scratch[FLAT_MAX_FRAME_BYTES];  /* Output of encode and transcodes; fits either layout */
+    PartialContext* partial;         /* Header-only selection */
+    byte flat[FLAT_MAX_FRAME_BYTES]; /* Same value in the flat layout */
+    int flatLength;
+} BenchCase;
+
+static void frame_header(T_TelemetryFrame* frame, int frameType) {
+    T_TelemetryFrame_Initialize(frame);
+    frame->header.timestamp.seconds = 1700000000;
+    frame->header.timestamp.subseconds = 250;
+    frame->header.frameType = frameType;
+    frame->header.frameCount = 4242;
+}
+
+static void make_housekeeping(BenchCase* c, int temperatures) {
+    frame_header(&c->frame, 1);
+    c->frame.payload.kind = housekeeping_PRESENT;
+    c->frame.payload.u.housekeeping.voltages.mainBus = 3300;
+    c->frame.payload.u.housekeeping.voltages.payload = 5000;
+    c->frame.payload.u.housekeeping.voltages.comms = 1800;
+    c->frame.payload.u.housekeeping.temperature.nCount = temperatures;
+    for (int i = 0; i < temperatures; i++) {
+        c->frame.payload.u.housekeeping.temperature.arr[i] = -40 + 11 * i;
+    }
+    c->frame.payload.u.housekeeping.status = 0x5A;
+    snprintf(c->label, sizeof(c->label), "housekeeping/t%d", temperatures);
+}
+
+static void make_science(BenchCase* c, int blocks, int blockBytes) {
+    frame_header(&c->frame, 2);
+    c->frame.payload.kind = science_PRESENT;
+    c->frame.payload.u.science.instrumentId = 9;
+    c->frame.payload.u.science.dataBlocks.nCount = blocks;
+    for (int b = 0; b < blocks; b++) {
+        c->frame.payload.u.science.dataBlocks.arr[b].nCount = blockBytes;
+        for (int i = 0; i < blockBytes; i++) {
+            c->frame.payload.u.science.dataBlocks.arr[b].arr[i] = (byte)(i * 7 + b);
+        }
+    }
+    snprintf(c->label, sizeof(c->label), "science/%dx%d", blocks, blockBytes);
+}
+
+static void make_command_ack(BenchCase* c) {
+    frame_header(&c->frame, 3);
+    c->frame.payload.kind = commandAck_PRESENT;
+    c->frame.payload.u.commandAck.commandId = 1234;
+    c->frame.payload.u.commandAck.status = (T_CommandAck_status)2;
+    snprintf(c->label, sizeof(c->label), "commandAck");
+}
+
+/* Sequential replay of a corpus file: every op takes the next frame */
+typedef struct {
+    const Corpus* corpus;
+    unsigned int next;
+    T_TelemetryFrame* decoded;
+    PartialContext* partial;
+} ReplayCase;
+
+static int op_replay_decode(void* userData) {
+    ReplayCase* r = (ReplayCase*)userData;
+    BitStream bs;
+    int errCode;
+    int length;
+    const byte* data = Corpus_Frame(r->corpus, r->next, &length);
+
+    if (++r->next == r->corpus->count) r->next = 0;
+    BitStream_AttachBuffer(&bs, (byte*)data, length);
+    if (!T_TelemetryFrame_Decode(r->decoded, &bs, &errCode)) {
+        return -1;
+    }
+    return length;
+}
+
+static int op_replay_partial(void* userData) {
+    ReplayCase* r = (ReplayCase*)userData;
+    BitStream bs;
+    int errCode;
+    int length;
+    const byte* data = Corpus_Frame(r->corpus, r->next, &length);
+
+    if (++r->next == r->corpus->count) r->next = 0;
+    BitStream_AttachBuffer(&bs, (byte*)data, length);
+    if (!T_TelemetryFrame_PartialDecode(r->decoded, &bs, r->partial, &errCode)) {
+        return -1;
+    }
+    return length;
+}
+
+static int op_encode(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    BitStream bs;
+    int errCode;
+
+    BitStream_Init(&bs, c->scratch, sizeof(c->scratch));
+    if (!T_TelemetryFrame_Encode(&c->frame, &bs, &errCode, TRUE)) {
+        return -1;
+    }
+    return (int)BitStream_GetLength(&bs);
+}
+
+static int op_decode(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    BitStream bs;
+    int errCode;
+
+    BitStream_AttachBuffer(&bs, c->encoded, c->encodedLength);
+    if (!T_TelemetryFrame_Decode(c->decoded, &bs, &errCode)) {
+        return -1;
+    }
+    return c->encodedLength;
+}
+
+static int op_partial(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    BitStream bs;
+    int errCode;
+
+    BitStream_AttachBuffer(&bs, c->encoded, c->encodedLength);
+    if (!T_TelemetryFrame_PartialDecode(c->decoded, &bs, c->partial, &errCode)) {
+        return -1;
+    }
+    return c->encodedLength;
+}
+
+/* Sparse consumer: frameCount, kind and one scalar of the payload */
+static int op_lazy(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    LazyFrame lf;
+    asn1SccUint value;
+    int kind;
+    int errCode;
+    flag ok;
+
+    LazyFrame_Init(&lf, c->encoded, c->encodedLength);
+    if (!LazyFrame_FrameCount(&lf, &value, &errCode) || !LazyFrame_Kind(&lf, &kind, &errCode)) {
+        return -1;
+    }
+    if (kind == housekeeping_PRESENT) {
+        ok = LazyFrame_Status(&lf, &value, &errCode);
+    } else if (kind == science_PRESENT) {
+        ok = LazyFrame_InstrumentId(&lf, &value, &errCode);
+    } else {
+        ok = LazyFrame_CommandId(&lf, &value, &errCode);
+    }
+    return ok ? c->encodedLength : -1;
+}
+
+/* Keeps op_flat's loads from being optimized away */
+static volatile unsigned int flatSink;
+
+/* op_lazy's fields read in place from the flat layout */
+static int op_flat(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    unsigned int value = Flat_FrameCount(c->flat);
+    int kind = Flat_Kind(c->flat);
+
+    if (kind == housekeeping_PRESENT) {
+        value += Flat_Status(c->flat);
+    } else if (kind == science_PRESENT) {
+        value += Flat_InstrumentId(c->flat);
+    } else {
+        value += Flat_CommandId(c->flat);
+    }
+    flatSink = value;
+    return c->flatLength;
+}
+
+static int op_to_flat(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    int consumed, written, errCode;
+
+    if (!Flat_FromUper(c->encoded, c->encodedLength, c->scratch, sizeof(c->scratch), &consumed, &written, &errCode)) {
+        return -1;
+    }
+    return c->encodedLength;
+}
+
+static int op_from_flat(void* userData) {
+    BenchCase* c = (BenchCase*)userData;
+    int written, errCode;
+
+    if (!Flat_ToUper(c->flat, c->flatLength, c->scratch, sizeof(c->scratch), &written, &errCode)) {
+        return -1;
+    }
+    return written;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --samples N       timed samples per case (default 20000)\n");
+    printf("  --per-sample N    ops per clock read (default 8: percentiles are of 8-op means;\n");
+    printf("                    1 = per-op timing for the true tail)\n");
+    printf("  --warmup N        untimed ops per case (default 2000)\n");
+    printf("  --tsc             time with rdtsc instead of CLOCK_MONOTONIC\n");
+    printf("  --filter TEXT     only run cases whose name contains TEXT\n");
+    printf("  --corpus FILE     also replay a corpus_gen file through decode and partial\n");
+    printf("  --json FILE       write one JSON result per line\n");
+    printf("  --baseline FILE   compare p50 against a previous --json run\n");
+    printf("  --threshold PCT   p50 slowdown counted as a regression (default 10)\n");
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    const char* jsonPath = NULL;
+    const char* baselinePath = NULL;
+    const char* filter = NULL;
+    const char* corpusPath = NULL;
+    double threshold = 10.0;
+
+    BenchConfig_Default(&config);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            config.samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--per-sample") == 0 && i + 1 < argc) {
+            config.opsPerSample = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.warmupOps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tsc") == 0) {
+            config.useTsc = TRUE;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) {
+            corpusPath = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    printf("===== ASN.1 Telemetry Benchmark =====\n");
+    printf("Samples: %d x %d ops, warmup %d ops, clock %s\n", config.samples,
+           config.opsPerSample, config.warmupOps, config.useTsc ? "rdtsc" : "CLOCK_MONOTONIC");
+    if (config.opsPerSample > 1) {
+        printf("Percentiles are of %d-op means; --per-sample 1 for the per-op tail\n", config.opsPerSample);
+    }
+
+    // Payload matrix: every CHOICE alternative across its size range
+    static BenchCase cases[10];
+    int caseCount = 0;
+    make_housekeeping(&cases[caseCount++], 1);
+    make_housekeeping(&cases[caseCount++], 4);
+    make_housekeeping(&cases[caseCount++], 8);
+    make_science(&cases[caseCount++], 1, 16);
+    make_science(&cases[caseCount++], 1, 256);
+    make_science(&cases[caseCount++], 2, 128);
+    make_science(&cases[caseCount++], 4, 256);
+    make_command_ack(&cases[caseCount++]);
+
+    // Decode targets live in a pool, as they do in the ingest path
+    size_t poolSize = ((sizeof(T_TelemetryFrame) + 7) & ~(size_t)7) * (caseCount + 1);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    FieldSelector headerOnly[] = {
+        { PARTIAL_FIELD_HEADER, "header", TRUE },
+        { PARTIAL_FIELD_PAYLOAD, "payload", FALSE }
+    };
+    PartialContext partial;
+    if (!poolBuffer) {
+        printf("ERROR: Failed to allocate pool buffer\n");
+        return 1;
+    }
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    PartialContext_Init(&partial, headerOnly, 2);
+
+    for (int i = 0; i < caseCount; i++) {
+        BenchCase* c = &cases[i];
+        BitStream bs;
+        int errCode;
+
+        c->decoded = (T_TelemetryFrame*)MemPool_Alloc(&pool, sizeof(T_TelemetryFrame));
+        c->partial = &partial;
+        BitStream_Init(&bs, c->encoded, sizeof(c->encoded));
+        if (c->decoded == NULL || !T_TelemetryFrame_Encode(&c->frame, &bs, &errCode, TRUE) ||
+            !Flat_FromFrame(&c->frame, c->flat, sizeof(c->flat), &c->flatLength, &errCode)) {
+            printf("ERROR: Cannot prepare case %s\n", c->label);
+            return 1;
+        }
+        c->encodedLength = (int)BitStream_GetLength(&bs);
+    }
+
+    static BenchResult results[MAX_CASES];
+    int resultCount = 0;
+    long long errors = 0;
+    BenchOp ops[] = { op_encode, op_decode, op_partial, op_lazy, op_flat, op_to_flat, op_from_flat };
+
+    printf("\n");
+    Bench_PrintHeader();
+    for (int op = OP_ENCODE; op <= OP_FROM_FLAT; op++) {
+        for (int i = 0; i < caseCount && resultCount < MAX_CASES; i++) {
+            char name[BENCH_NAME_SIZE];
+            snprintf(name, sizeof(name), "%s/%.31s", opNames[op], cases[i].label);
+            if (filter != NULL && strstr(name, filter) == NULL) continue;
+
+            if (!Bench_Run(&config, name, ops[op], &cases[i], &results[resultCount])) {
+                printf("ERROR: Out of memory running %s\n", name);
+                return 1;
+            }
+            Bench_Print(&results[resultCount]);
+            errors += results[resultCount].errors;
+            resultCount++;
+        }
+    }
+
+    // Mixed corpus replay: realistic branch and cache behaviour across payload kinds
+    Corpus corpus;
+    int corpusOpen = 0;
+    if (corpusPath != NULL) {
+        int errCode;
+        if (!Corpus_Open(&corpus, corpusPath, &errCode) || corpus.count == 0) {
+            printf("ERROR: Cannot open corpus %s: error %d\n", corpusPath, errCode);
+            return 1;
+        }
+        corpusOpen = 1;
+
+        ReplayCase replay = { &corpus, 0, NULL, &partial };
+        replay.decoded = (T_TelemetryFrame*)MemPool_Alloc(&pool, sizeof(T_TelemetryFrame));
+        BenchOp replayOps[] = { op_replay_decode, op_replay_partial };
+        const char* replayNames[] = { "decode/corpus", "partial/corpus" };
+
+        printf("\nCorpus %s: %u frames, seed %llu\n", corpusPath, corpus.count, corpus.seed);
+        for (int op = 0; op < 2 && resultCount < MAX_CASES; op++) {
+            if (filter != NULL && strstr(replayNames[op], filter) == NULL) continue;
+            replay.next = 0;
+            if (!Bench_Run(&config, replayNames[op], replayOps[op], &replay, &results[resultCount])) {
+                printf("ERROR: Out of memory running %s\n", replayNames[op]);
+                return 1;
+            }
+            Bench_Print(&results[resultCount]);
+            errors += results[resultCount].errors;
+            resultCount++;
+        }
+    }
+
+    if (jsonPath != NULL) {
+        FILE* out = fopen(jsonPath, "w");
+        if (out == NULL) {
+            perror(jsonPath);
+            return 1;
+        }
+        for (int i = 0; i < resultCount; i++) {
+            Bench_WriteJson(out, &results[i], config.useTsc);
+        }
+        fclose(out);
+        printf("\nResults written to %s\n", jsonPath);
+    }
+
+    int regressions = 0;
+    if (baselinePath != NULL) {
+        static BenchResult baseline[MAX_BASELINE];
+        int baselineCount = Bench_LoadBaseline(baselinePath, baseline, MAX_BASELINE);
+        if (baselineCount < 0) {
+            perror(baselinePath);
+            return 1;
+        }
+        printf("\nAgainst baseline %s (threshold %.1f%%):\n", baselinePath, threshold);
+        regressions = Bench_Compare(results, resultCount, baseline, baselineCount, threshold);
+        printf("Regressions: %d\n", regressions);
+    }
+
+    if (corpusOpen) Corpus_Close(&corpus);
+    free(poolBuffer);
+    if (errors > 0) {
+        printf("\nERROR: %lld operations failed\n", errors);
+        return 1;
+    }
+    return regressions > 0 ? 2 : 0;
+}
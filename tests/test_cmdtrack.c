@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_cmdtrack.h"
+#include "asn1crt_corpus.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define TIMEOUT_NS 1000000ULL
+#define COMMANDS   1000
+#define BENCH_OPS  2000000
+
+typedef struct {
+    unsigned long count[CMDTRACK_EVICTED + 1];
+    unsigned int lastId;
+    unsigned long long lastElapsedNs;
+} Alerts;
+
+static void on_alert(unsigned int commandId, int outcome, unsigned long long elapsedNs, void* userData) {
+    Alerts* alerts = (Alerts*)userData;
+
+    alerts->count[outcome]++;
+    alerts->lastId = commandId;
+    alerts->lastElapsedNs = elapsedNs;
+}
+
+static T_CommandAck make_ack(unsigned int commandId, int status) {
+    T_CommandAck ack;
+
+    memset(&ack, 0, sizeof(ack));
+    ack.commandId = commandId;
+    ack.status = (T_CommandAck_status)status;
+    return ack;
+}
+
+int main() {
+    CommandTracker tracker;
+    CmdTrackStats stats;
+    Alerts alerts;
+    MemPool pool;
+    size_t poolSize = CommandTracker_PoolBytes();
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    unsigned long long rtt = 0;
+    int errCode = 0;
+
+    printf("===== Command Tracker Test =====\n");
+    memset(&alerts, 0, sizeof(alerts));
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    check(CommandTracker_Init(&tracker, &pool, TIMEOUT_NS, on_alert, &alerts, &errCode),
+          "Tracker fits in CommandTracker_PoolBytes");
+
+    printf("\nMatching:\n");
+    for (unsigned int i = 0; i < COMMANDS; i++) {
+        CommandTracker_Sent(&tracker, i * 61, i * 100);
+    }
+    check(CommandTracker_Outstanding(&tracker) == COMMANDS, "Every sent command outstanding");
+    int matched = 1;
+    for (unsigned int i = 0; i < COMMANDS; i++) {
+        T_CommandAck ack = make_ack(i * 61, (int)(i & 3));
+        matched = matched && CommandTracker_Ack(&tracker, &ack, i * 100 + 5000 + (i & 3) * 1000, &rtt, &errCode) &&
+                  rtt == 5000 + (i & 3) * 1000;
+    }
+    CommandTracker_Snapshot(&tracker, &stats);
+    check(matched && CommandTracker_Outstanding(&tracker) == 0, "Acks matched with send-to-ack RTT");
+    check(stats.acked[0] == COMMANDS / 4 && stats.acked[3] == COMMANDS / 4 &&
+          stats.rttNs[2].total == COMMANDS / 4 && stats.rttNs[1].maxTicks == 6000 &&
+          LatencyHistogram_ValueAt(&stats.rttNs[3], 50) >= 7000 * 15 / 16,
+          "RTT histogram per status");
+    check(alerts.count[CMDTRACK_EXECUTION_FAILED] == COMMANDS / 4 &&
+          alerts.count[CMDTRACK_INSUFFICIENT_PRIVILEGES] == COMMANDS / 4 && alerts.count[0] == 0 &&
+          alerts.count[1] == 0, "executionFailed and insufficientPrivileges raised");
+
+    T_CommandAck again = make_ack(61, 0);
+    check(!CommandTracker_Ack(&tracker, &again, 1, NULL, &errCode) && errCode == ERR_CMDTRACK_UNMATCHED,
+          "Duplicate ack reports ERR_CMDTRACK_UNMATCHED");
+
+    printf("\nTimeouts:\n");
+    memset(&alerts, 0, sizeof(alerts));
+    unsigned long long t0 = 10000000ULL;
+    for (unsigned int i = 0; i < 100; i++) {
+        CommandTracker_Sent(&tracker, 40000 + i, t0 + i);
+    }
+    for (unsigned int i = 0; i < 100; i += 2) {
+        T_CommandAck ack = make_ack(40000 + i, 0);
+        CommandTracker_Ack(&tracker, &ack, t0 + 500, NULL, &errCode);
+    }
+    check(CommandTracker_Sweep(&tracker, t0 + TIMEOUT_NS - 1) == 0, "Nothing expires before its deadline");
+    check(CommandTracker_Sweep(&tracker, t0 + TIMEOUT_NS + 99) == 50 && alerts.count[CMDTRACK_TIMEOUT] == 50 &&
+          CommandTracker_Outstanding(&tracker) == 0, "Unacked commands time out, acked ones do not");
+    check(alerts.lastId == 40099 && alerts.lastElapsedNs == TIMEOUT_NS, "Timeout alert reports time since the send");
+    T_CommandAck late = make_ack(40001, 0);
+    check(!CommandTracker_Ack(&tracker, &late, t0 + 2 * TIMEOUT_NS, NULL, &errCode), "Ack after timeout unmatched");
+
+    // Reissuing an id leaves the first deadline behind; its generation no longer matches
+    CommandTracker_Sent(&tracker, 7, t0);
+    CommandTracker_Sent(&tracker, 7, t0 + TIMEOUT_NS / 2);
+    check(CommandTracker_Sweep(&tracker, t0 + TIMEOUT_NS) == 0 && CommandTracker_Outstanding(&tracker) == 1,
+          "Reissued command keeps its new deadline");
+    check(CommandTracker_Sweep(&tracker, t0 + 2 * TIMEOUT_NS) == 1, "Reissued command times out once");
+
+    // More sends than slots inside one timeout: the oldest are retired early
+    unsigned long long t1 = t0 + 10 * TIMEOUT_NS;
+    for (unsigned int i = 0; i < CMDTRACK_IDS + 100; i++) {
+        CommandTracker_Sent(&tracker, i, t1);
+    }
+    CommandTracker_Snapshot(&tracker, &stats);
+    check(tracker.count == CMDTRACK_IDS && CommandTracker_Outstanding(&tracker) == CMDTRACK_IDS &&
+          stats.reissued == 1 && stats.timedOut == 50 + 1 && stats.evicted == 100,
+          "Full deadline ring retires the oldest early");
+    check(alerts.count[CMDTRACK_EVICTED] == 100 && alerts.count[CMDTRACK_TIMEOUT] == 50 + 1 &&
+          alerts.lastElapsedNs == 0, "Evictions counted apart from timeouts");
+    CommandTracker_Sweep(&tracker, t1 + TIMEOUT_NS);
+
+    printf("\nFed from the decoder:\n");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    static unsigned int frameCounts[256];
+    T_TelemetryFrame frame, decoded;
+    unsigned long acks = 0;
+    CorpusMix_Default(&mix);
+    mix.seed = 41;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    CommandTracker_Snapshot(&tracker, &stats);
+    unsigned long before = stats.acked[0] + stats.acked[1] + stats.acked[2] + stats.acked[3];
+    for (int i = 0; i < 2000; i++) {
+        byte buf[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+        BitStream bs;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        if (frame.payload.kind == commandAck_PRESENT) {
+            CommandTracker_Sent(&tracker, (unsigned int)frame.payload.u.commandAck.commandId, CommandTracker_Now());
+            acks++;
+        }
+        BitStream_Init(&bs, buf, sizeof(buf));
+        T_TelemetryFrame_Encode(&frame, &bs, &errCode, TRUE);
+        BitStream_AttachBuffer(&bs, buf, BitStream_GetLength(&bs));
+        if (T_TelemetryFrame_Decode(&decoded, &bs, &errCode)) {
+            CommandTracker_Emit(1, &decoded, &tracker);
+        }
+    }
+    CommandTracker_Snapshot(&tracker, &stats);
+    check(acks > 0 && stats.acked[0] + stats.acked[1] + stats.acked[2] + stats.acked[3] - before == acks &&
+          CommandTracker_Outstanding(&tracker) == 0, "CommandTracker_Emit matches decoded acks");
+
+    printf("\nThroughput:\n");
+    unsigned long long start = CommandTracker_Now();
+    for (unsigned int i = 0; i < BENCH_OPS; i++) {
+        T_CommandAck ack = make_ack(i & (CMDTRACK_IDS - 1), 0);
+        CommandTracker_Sent(&tracker, i & (CMDTRACK_IDS - 1), start + i);
+        CommandTracker_Ack(&tracker, &ack, start + i + 10, NULL, &errCode);
+    }
+    double ns = (double)(CommandTracker_Now() - start) / BENCH_OPS;
+    printf("  send + ack: %.1f ns per command\n", ns);
+    check(CommandTracker_Outstanding(&tracker) == 0, "Send/ack cycle leaves nothing outstanding");
+
+    MemPool small;
+    byte tiny[256];
+    MemPool_Init(&small, tiny, sizeof(tiny));
+    CommandTracker_Destroy(&tracker);
+    check(!CommandTracker_Init(&tracker, &small, TIMEOUT_NS, NULL, NULL, &errCode) && errCode == ERR_CMDTRACK_POOL,
+          "Pool smaller than CommandTracker_PoolBytes rejected");
+    free(poolBuffer);
+
+    return test_report("Command tracker");
+}
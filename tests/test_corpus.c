@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define CORPUS_FRAMES 3000
+
+static int files_equal(const char* a, const char* b) {
+    FILE* fa = fopen(a, "rb");
+    FILE* fb = fopen(b, "rb");
+    int equal = fa != NULL && fb != NULL;
+    while (equal) {
+        int ca = fgetc(fa);
+        int cb = fgetc(fb);
+        if (ca != cb) equal = 0;
+        if (ca == EOF || cb == EOF) break;
+    }
+    if (fa) fclose(fa);
+    if (fb) fclose(fb);
+    return equal;
+}
+
+int main() {
+    printf("===== Frame Corpus Test =====\n");
+
+    char pathA[] = "/tmp/test_corpus_a_XXXXXX";
+    char pathB[] = "/tmp/test_corpus_b_XXXXXX";
+    char pathC[] = "/tmp/test_corpus_c_XXXXXX";
+    close(mkstemp(pathA));
+    close(mkstemp(pathB));
+    close(mkstemp(pathC));
+
+    CorpusMix mix;
+    int errCode = 0;
+    CorpusMix_Default(&mix);
+    mix.seed = 42;
+
+    printf("\nGeneration:\n");
+    check(Corpus_Write(pathA, &mix, CORPUS_FRAMES, &errCode), "Write 3000-frame corpus");
+    check(Corpus_Write(pathB, &mix, CORPUS_FRAMES, &errCode), "Write again with the same seed");
+    check(files_equal(pathA, pathB), "Same seed gives identical bytes");
+    mix.seed = 43;
+    check(Corpus_Write(pathC, &mix, CORPUS_FRAMES, &errCode) && !files_equal(pathA, pathC),
+          "Different seed gives a different corpus");
+
+    CorpusMix bad = mix;
+    bad.maxTemperatures = 9;
+    check(!Corpus_Write(pathC, &bad, 10, &errCode) && errCode == ERR_CORPUS_MIX,
+          "Out-of-schema range rejected");
+
+    printf("\nReplay:\n");
+    Corpus corpus;
+    if (!Corpus_Open(&corpus, pathA, &errCode)) {
+        check(0, "Open corpus");
+        return 1;
+    }
+    check(corpus.count == CORPUS_FRAMES && corpus.seed == 42, "Header count and seed");
+
+    // Every frame decodes and matches its index entry
+    int decoded = 0;
+    int kindsMatch = 1;
+    int kinds[4] = { 0, 0, 0, 0 };
+    int temperatureCounts[9] = { 0 };
+    int blockCounts[5] = { 0 };
+    for (unsigned int i = 0; i < corpus.count; i++) {
+        T_TelemetryFrame frame;
+        BitStream bs;
+        int length;
+        const byte* data = Corpus_Frame(&corpus, i, &length);
+
+        BitStream_AttachBuffer(&bs, (byte*)data, length);
+        if (!T_TelemetryFrame_Decode(&frame, &bs, &errCode)) continue;
+        decoded++;
+        if ((int)frame.payload.kind != corpus.index[i].kind) kindsMatch = 0;
+        kinds[frame.payload.kind & 3]++;
+        if (frame.payload.kind == housekeeping_PRESENT) {
+            temperatureCounts[frame.payload.u.housekeeping.temperature.nCount]++;
+        } else if (frame.payload.kind == science_PRESENT) {
+            blockCounts[frame.payload.u.science.dataBlocks.nCount]++;
+        }
+    }
+    check(decoded == CORPUS_FRAMES, "Every frame decodes");
+    check(kindsMatch, "Index kind matches decoded payload");
+
+    printf("    housekeeping %d, science %d, commandAck %d\n",
+           kinds[housekeeping_PRESENT], kinds[science_PRESENT], kinds[commandAck_PRESENT]);
+    check(kinds[housekeeping_PRESENT] > 1600 && kinds[housekeeping_PRESENT] < 2000 &&
+          kinds[science_PRESENT] > 700 && kinds[science_PRESENT] < 1100 &&
+          kinds[commandAck_PRESENT] > 200 && kinds[commandAck_PRESENT] < 400,
+          "60:30:10 mix within tolerance");
+
+    int allTemperatures = 1;
+    for (int t = 1; t <= 8; t++) {
+        if (temperatureCounts[t] == 0) allTemperatures = 0;
+    }
+    check(allTemperatures, "All temperature counts 1..8 present");
+    check(blockCounts[1] && blockCounts[2] && blockCounts[3] && blockCounts[4],
+          "All dataBlocks counts 1..4 present");
+    Corpus_Close(&corpus);
+
+    // A truncated file must not be trusted
+    if (truncate(pathA, 100) == 0) {
+        check(!Corpus_Open(&corpus, pathA, &errCode) && errCode == ERR_CORPUS_FORMAT,
+              "Truncated corpus rejected");
+    }
+
+    // An index offset near 2^64 that wraps the size check back onto the file
+    byte crafted[48] = {0};
+    unsigned long long wrapOffset = ~0ULL - 7;
+    memcpy(crafted, CORPUS_MAGIC, 8);
+    crafted[8] = CORPUS_VERSION;
+    crafted[12] = 7;  // 7 entries: wrapOffset + 56 == 48 mod 2^64
+    for (int i = 0; i < 8; i++) crafted[24 + i] = (byte)(wrapOffset >> (8 * i));
+    FILE* out = fopen(pathA, "wb");
+    if (out != NULL) {
+        fwrite(crafted, 1, sizeof(crafted), out);
+        fclose(out);
+        check(!Corpus_Open(&corpus, pathA, &errCode) && errCode == ERR_CORPUS_FORMAT,
+              "Wrapping index offset rejected");
+    }
+
+    unlink(pathA);
+    unlink(pathB);
+    unlink(pathC);
+
+    return test_report("Frame corpus");
+}
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_dedup.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define FRAMES      20000
+#define CAPACITY    65536
+#define HISTORY     16
+#define HASH_ROUNDS 200000
+
+static int encode(const T_TelemetryFrame* frame, byte* buf) {
+    BitStream bs;
+    int errCode;
+
+    BitStream_Init(&bs, buf, T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING);
+    T_TelemetryFrame_Encode(frame, &bs, &errCode, TRUE);
+    return BitStream_GetLength(&bs);
+}
+
+static int same_frame(const T_TelemetryFrame* a, const T_TelemetryFrame* b) {
+    static byte ea[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING], eb[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    int length = encode(a, ea);
+    return length == encode(b, eb) && memcmp(ea, eb, (size_t)length) == 0;
+}
+
+static int compare_hash(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return x < y ? -1 : x > y;
+}
+
+/* Science traffic the way instruments send it: fill patterns, a repeated
+ * calibration block, and whole frames retransmitted after a NAK */
+static void add_repeats(T_TelemetryFrame* frame, T_ScienceData_dataBlocks* history, int* seen) {
+    T_ScienceData_dataBlocks* blocks = &frame->payload.u.science.dataBlocks;
+    int roll = rand() % 8;
+
+    if (roll == 0 && *seen > 0) {
+        *blocks = history[rand() % (*seen < HISTORY ? *seen : HISTORY)];
+    } else if (roll <= 2) {
+        T_ScienceData_dataBlocks_elem* b = &blocks->arr[rand() % blocks->nCount];
+        static const byte fills[] = { 0x00, 0xFF, 0x55, 0xAA };
+        b->nCount = LAYOUT_BLOCK_LENGTH_MAX;
+        memset(b->arr, fills[rand() % 4], LAYOUT_BLOCK_LENGTH_MAX);
+        if (roll == 2) {
+            for (int i = 0; i < LAYOUT_BLOCK_LENGTH_MAX; i++) b->arr[i] = (byte)i;  // Calibration ramp
+        }
+    }
+    history[*seen % HISTORY] = *blocks;
+    (*seen)++;
+}
+
+int main() {
+    MemPool pool;
+    BlockStore store;
+    int errCode = 0;
+    byte data[DEDUP_BLOCK_BYTES];
+
+    printf("===== Block Deduplication Test =====\n");
+    printf("Hash kernel: %s\n", Dedup_HashKernel());
+
+    printf("\nHash:\n");
+    srand(45);
+    for (int i = 0; i < DEDUP_BLOCK_BYTES; i++) data[i] = (byte)rand();
+    int same = 1;
+    for (size_t n = 0; n <= DEDUP_BLOCK_BYTES; n++) {
+        same = same && Dedup_Hash64(data, n) == Dedup_Hash64Generic(data, n);
+    }
+    check(same, "Dispatched kernel matches the generic one");
+    static unsigned long long hashes[DEDUP_BLOCK_BYTES * 8 + DEDUP_BLOCK_BYTES + 2];
+    int count = 0;
+    for (size_t n = 0; n <= DEDUP_BLOCK_BYTES; n++) hashes[count++] = Dedup_Hash64(data, n);
+    for (int bit = 0; bit < DEDUP_BLOCK_BYTES * 8; bit++) {
+        data[bit / 8] ^= (byte)(1 << (bit % 8));
+        hashes[count++] = Dedup_Hash64(data, DEDUP_BLOCK_BYTES);
+        data[bit / 8] ^= (byte)(1 << (bit % 8));
+    }
+    qsort(hashes, (size_t)count, sizeof(hashes[0]), compare_hash);
+    int distinct = 1;
+    for (int i = 1; i < count; i++) distinct = distinct && hashes[i] != hashes[i - 1];
+    check(distinct, "Every length and single-bit flip hashes apart");
+
+    unsigned long long sink = 0;
+    unsigned long long start = now_ns();
+    for (int i = 0; i < HASH_ROUNDS; i++) sink += Dedup_Hash64(data, DEDUP_BLOCK_BYTES - (size_t)(i & 1));
+    double fastNs = (double)(now_ns() - start) / HASH_ROUNDS;
+    start = now_ns();
+    for (int i = 0; i < HASH_ROUNDS; i++) sink += Dedup_Hash64Generic(data, DEDUP_BLOCK_BYTES - (size_t)(i & 1));
+    double genericNs = (double)(now_ns() - start) / HASH_ROUNDS;
+    printf("  256-byte block: %.1f ns %s, %.1f ns generic (%.2f GB/s) (%llu)\n", fastNs, Dedup_HashKernel(),
+           genericNs, DEDUP_BLOCK_BYTES / fastNs, sink % 10);
+
+    printf("\nBlock store:\n");
+    size_t poolSize = DedupWriter_PoolBytes(CAPACITY);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    check(BlockStore_Init(&store, &pool, 4, &errCode), "Store fits in BlockStore_PoolBytes");
+    unsigned int a, a2, b, c;
+    flag added, added2;
+    BlockStore_Put(&store, data, 100, &a, &added, &errCode);
+    BlockStore_Put(&store, data, 100, &a2, &added2, &errCode);
+    check(added && !added2 && a == a2 && BlockStore_Refs(&store, a) == 2, "Repeated block shares one cell");
+    BlockStore_Put(&store, data, 99, &b, &added, &errCode);
+    int length;
+    const byte* stored = BlockStore_Get(&store, b, &length);
+    check(added && b != a && length == 99 && memcmp(stored, data, 99) == 0, "Prefix of a block is a new block");
+    BlockStore_Release(&store, a);
+    check(BlockStore_Refs(&store, a) == 1 && store.stats.live == 2, "Release keeps a block still referenced");
+    BlockStore_Release(&store, a);
+    BlockStore_Put(&store, data, 99, &c, &added, &errCode);
+    check(store.stats.live == 1 && store.stats.released == 1 && !added && c == b,
+          "Last release frees the cell, index stays intact");
+    for (int i = 1; i <= 3; i++) BlockStore_Put(&store, data + i, 10, &c, &added, &errCode);
+    check(!BlockStore_Put(&store, data + 4, 10, &c, &added, &errCode) && errCode == ERR_DEDUP_FULL,
+          "Full store reports ERR_DEDUP_FULL");
+    check(!BlockStore_Put(&store, data, DEDUP_BLOCK_BYTES + 1, &c, &added, &errCode) &&
+          errCode == ERR_DEDUP_LENGTH, "Oversized block rejected");
+
+    printf("\nArchive:\n");
+    char path[] = "/tmp/test_dedup_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+    static T_TelemetryFrame frames[FRAMES];
+    static T_ScienceData_dataBlocks history[HISTORY];
+    CorpusMix mix;
+    CorpusGenerator gen;
+    static unsigned int frameCounts[256];
+    unsigned long long plainBytes = 0;
+    byte buf[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    int seen = 0;
+    CorpusMix_Default(&mix);
+    mix.seed = 45;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    for (int i = 0; i < FRAMES; i++) {
+        CorpusGenerator_Next(&gen, &mix, &frames[i]);
+        if (frames[i].payload.kind == science_PRESENT) add_repeats(&frames[i], history, &seen);
+        plainBytes += (unsigned long long)encode(&frames[i], buf);
+    }
+
+    DedupWriter w;
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    check(DedupWriter_Open(&w, path, &pool, CAPACITY, &errCode), "Writer fits in DedupWriter_PoolBytes");
+    start = now_ns();
+    int written = 1;
+    for (int i = 0; i < FRAMES; i++) written = written && DedupWriter_Write(&w, &frames[i], &errCode);
+    check(written && DedupWriter_Close(&w, &errCode), "Every frame archived");
+    double writeNs = (double)(now_ns() - start) / FRAMES;
+    printf("  %llu bytes as uPER, %llu deduplicated (%.1f%%); %llu of %llu blocks referenced\n", plainBytes,
+           w.stats.bytes, 100.0 * (double)w.stats.bytes / (double)plainBytes, w.stats.references,
+           w.stats.references + w.stats.literals);
+    printf("  write %.0f ns/frame\n", writeNs);
+    check(w.stats.references > 0 && w.stats.bytes < plainBytes, "Duplicate blocks written as references");
+
+    DedupArchive archive;
+    T_TelemetryFrame frame;
+    check(DedupArchive_Open(&archive, path, &errCode) && archive.frames == FRAMES, "Archive opens with its count");
+    int match = 1;
+    for (int i = 0; i < FRAMES; i++) {
+        match = match && DedupArchive_Next(&archive, &frame, &errCode) && same_frame(&frame, &frames[i]);
+    }
+    check(match, "Frames read back equal the originals");
+    check(!DedupArchive_Next(&archive, &frame, &errCode) && errCode == ERR_DEDUP_FORMAT, "Nothing past the count");
+    DedupArchive_Close(&archive);
+
+    // Two frames sharing their only block: the second ends in a reference
+    T_TelemetryFrame sci = frames[0];
+    while (sci.payload.kind != science_PRESENT) sci = frames[rand() % FRAMES];
+    sci.payload.u.science.dataBlocks.nCount = 1;
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    DedupWriter_Open(&w, path, &pool, 16, &errCode);
+    DedupWriter_Write(&w, &sci, &errCode);
+    DedupWriter_Write(&w, &sci, &errCode);
+    DedupWriter_Close(&w, &errCode);
+    FILE* f = fopen(path, "r+b");
+    byte forward[4] = { (byte)(w.stats.bytes - 1), (byte)((w.stats.bytes - 1) >> 8), 0, 0 };
+    fseek(f, (long)w.stats.bytes - 4, SEEK_SET);
+    fwrite(forward, 1, sizeof(forward), f);
+    fclose(f);
+    DedupArchive_Open(&archive, path, &errCode);
+    check(DedupArchive_Next(&archive, &frame, &errCode) && !DedupArchive_Next(&archive, &frame, &errCode) &&
+          errCode == ERR_DEDUP_FORMAT, "Reference to a later offset rejected");
+    DedupArchive_Close(&archive);
+
+    // A fill pattern repeated within one frame: the second block refers
+    // back into the record being written and must still read back
+    T_TelemetryFrame fill = sci;
+    T_ScienceData_dataBlocks* fillBlocks = &fill.payload.u.science.dataBlocks;
+    fillBlocks->nCount = 2;
+    for (int i = 0; i < 2; i++) {
+        fillBlocks->arr[i].nCount = LAYOUT_BLOCK_LENGTH_MAX;
+        memset(fillBlocks->arr[i].arr, 0xAA, LAYOUT_BLOCK_LENGTH_MAX);
+    }
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    DedupWriter_Open(&w, path, &pool, 16, &errCode);
+    written = DedupWriter_Write(&w, &fill, &errCode) && DedupWriter_Close(&w, &errCode);
+    DedupArchive_Open(&archive, path, &errCode);
+    check(written && w.stats.literals == 1 && w.stats.references == 1 &&
+          DedupArchive_Next(&archive, &frame, &errCode) && same_frame(&frame, &fill),
+          "Block repeated within one frame reads back");
+    DedupArchive_Close(&archive);
+
+    // Out of the schema's range: not archived as a record no decoder accepts
+    T_TelemetryFrame bad = sci;
+    bad.header.timestamp.subseconds = LAYOUT_SUBSECONDS_MAX + 1;
+    T_TelemetryFrame empty = sci;
+    empty.payload.u.science.dataBlocks.arr[0].nCount = 0;
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    DedupWriter_Open(&w, path, &pool, 16, &errCode);
+    check(!DedupWriter_Write(&w, &bad, &errCode) && !DedupWriter_Write(&w, &empty, &errCode) &&
+          w.stats.literals == 0, "Frames outside the schema constraints rejected");
+    DedupWriter_Close(&w, &errCode);
+    unlink(path);
+    free(poolBuffer);
+
+    return test_report("Block deduplication");
+}
@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_export.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define GENERATED_FRAMES 5000
+#define RANDOM_VALUES    200000
+
+static unsigned long long rng = 0x9E3779B97F4A7C15ULL;
+
+static unsigned long long next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+static int uint_matches(unsigned long long v) {
+    char mine[32], ref[32];
+    int n = Export_Uint(mine, v);
+    int m = snprintf(ref, sizeof(ref), "%llu", v);
+    return n == m && memcmp(mine, ref, (size_t)n) == 0;
+}
+
+static int sint_matches(long long v) {
+    char mine[32], ref[32];
+    int n = Export_Sint(mine, v);
+    int m = snprintf(ref, sizeof(ref), "%lld", v);
+    return n == m && memcmp(mine, ref, (size_t)n) == 0;
+}
+
+// Export into a temporary file and read it back whole
+static char* export_frames(const T_TelemetryFrame* frames, int count, ExportFormat format,
+                           ExportBlocks blocks, size_t* size) {
+    FILE* tmp = tmpfile();
+    size_t poolSize = Exporter_PoolBytes();
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    Exporter ex;
+    int errCode;
+    char* text = NULL;
+
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    if (tmp != NULL && Exporter_Open(&ex, fileno(tmp), format, blocks, &pool, &errCode) &&
+        Exporter_WriteBatch(&ex, frames, count, &errCode) == count && Exporter_Close(&ex, &errCode)) {
+        *size = (size_t)ex.bytes;
+        text = (char*)malloc(*size + 1);
+        rewind(tmp);
+        if (fread(text, 1, *size, tmp) != *size) {
+            free(text);
+            text = NULL;
+        } else {
+            text[*size] = '\0';
+        }
+    }
+    if (tmp != NULL) fclose(tmp);
+    free(poolBuffer);
+    return text;
+}
+
+static int hex_value(char c) {
+    return c <= '9' ? c - '0' : c - 'a' + 10;
+}
+
+// Parse one CSV row back into a frame; returns the start of the next row
+static char* parse_csv_row(char* row, T_TelemetryFrame* f) {
+    char* end = strchr(row, '\n');
+    char* fields[14];
+    int n = 0;
+
+    *end = '\0';
+    fields[n++] = row;
+    for (char* p = row; *p != '\0' && n < 14; p++) {
+        if (*p == ',') {
+            *p = '\0';
+            fields[n++] = p + 1;
+        }
+    }
+    if (n != 14) return NULL;
+
+    memset(f, 0, sizeof(T_TelemetryFrame));
+    f->header.timestamp.seconds = strtoull(fields[0], NULL, 10);
+    f->header.timestamp.subseconds = strtoull(fields[1], NULL, 10);
+    f->header.frameType = strtoull(fields[2], NULL, 10);
+    f->header.frameCount = strtoull(fields[3], NULL, 10);
+    if (strcmp(fields[4], "housekeeping") == 0) {
+        T_HousekeepingData* hk = &f->payload.u.housekeeping;
+        char* p = fields[8];
+        f->payload.kind = housekeeping_PRESENT;
+        hk->voltages.mainBus = strtoull(fields[5], NULL, 10);
+        hk->voltages.payload = strtoull(fields[6], NULL, 10);
+        hk->voltages.comms = strtoull(fields[7], NULL, 10);
+        while (*p != '\0') {
+            hk->temperature.arr[hk->temperature.nCount++] = strtoll(p, &p, 10);
+            if (*p == ';') p++;
+        }
+        hk->status = strtoull(fields[9], NULL, 10);
+    } else if (strcmp(fields[4], "science") == 0) {
+        T_ScienceData* sci = &f->payload.u.science;
+        char* p = fields[11];
+        f->payload.kind = science_PRESENT;
+        sci->instrumentId = strtoull(fields[10], NULL, 10);
+        while (*p != '\0') {
+            int b = sci->dataBlocks.nCount++;
+            while (*p != '\0' && *p != ';') {
+                sci->dataBlocks.arr[b].arr[sci->dataBlocks.arr[b].nCount++] =
+                    (byte)(hex_value(p[0]) << 4 | hex_value(p[1]));
+                p += 2;
+            }
+            if (*p == ';') p++;
+        }
+    } else {
+        static const char* const names[4] = { "success", "invalidCommand", "executionFailed", "insufficientPrivileges" };
+        f->payload.kind = commandAck_PRESENT;
+        f->payload.u.commandAck.commandId = strtoull(fields[12], NULL, 10);
+        for (int s = 0; s < 4; s++) {
+            if (strcmp(fields[13], names[s]) == 0) f->payload.u.commandAck.status = (T_CommandAck_status)s;
+        }
+    }
+    return end + 1;
+}
+
+static int same_frame(const T_TelemetryFrame* a, const T_TelemetryFrame* b) {
+    byte ea[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING], eb[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    BitStream bsa, bsb;
+    int errCode;
+
+    BitStream_Init(&bsa, ea, sizeof(ea));
+    BitStream_Init(&bsb, eb, sizeof(eb));
+    if (!T_TelemetryFrame_Encode(a, &bsa, &errCode, TRUE) || !T_TelemetryFrame_Encode(b, &bsb, &errCode, TRUE)) {
+        return 0;
+    }
+    return BitStream_GetLength(&bsa) == BitStream_GetLength(&bsb) &&
+           memcmp(ea, eb, (size_t)BitStream_GetLength(&bsa)) == 0;
+}
+
+int main() {
+    static T_TelemetryFrame frames[GENERATED_FRAMES];
+    static byte data[1024];
+    static char simd[4 * 1024], scalar[4 * 1024];
+
+    printf("===== Export Test =====\n");
+    printf("SIMD encoders: %s\n", Export_SimdAvailable() ? "SSSE3" : "unavailable (scalar only)");
+
+    printf("\nInteger formatting against snprintf:\n");
+    int edges = 1;
+    for (int d = 0; d < 20; d++) {
+        unsigned long long p = 1;
+        for (int i = 0; i < d; i++) p *= 10;
+        edges = edges && uint_matches(p) && uint_matches(p - 1) && uint_matches(p + 1);
+    }
+    edges = edges && uint_matches(0) && uint_matches(~0ULL) && uint_matches(1ULL << 63);
+    edges = edges && sint_matches(0) && sint_matches(-1) && sint_matches(-128) &&
+            sint_matches((long long)(~0ULL >> 1)) && sint_matches(-(long long)(~0ULL >> 1) - 1);
+    check(edges, "Powers of ten, their neighbours and the extremes");
+    int randoms = 1;
+    for (int i = 0; i < RANDOM_VALUES && randoms; i++) {
+        unsigned long long v = next_random() >> (next_random() & 63);
+        randoms = uint_matches(v) && sint_matches((long long)v) && sint_matches(-(long long)(v >> 1));
+    }
+    check(randoms, "Random widths");
+
+    printf("\nBlock encoders:\n");
+    size_t n = Export_Base64(simd, (const byte*)"foobar", 6);
+    check(n == 8 && memcmp(simd, "Zm9vYmFy", 8) == 0, "base64(\"foobar\") == \"Zm9vYmFy\"");
+    n = Export_Base64(simd, (const byte*)"fooba", 5);
+    check(n == 8 && memcmp(simd, "Zm9vYmE=", 8) == 0, "base64(\"fooba\") pads with '='");
+    n = Export_Hex(simd, (const byte*)"\x00\x9f\xff", 3);
+    check(n == 6 && memcmp(simd, "009fff", 6) == 0, "hex({00, 9f, ff}) == \"009fff\"");
+
+    int hexAgree = 1, base64Agree = 1;
+    for (int trial = 0; trial < 2000; trial++) {
+        size_t length = (size_t)(next_random() % sizeof(data));
+        for (size_t i = 0; i < length; i++) data[i] = (byte)next_random();
+        size_t a = Export_Hex(simd, data, length);
+        size_t b = Export_HexScalar(scalar, data, length);
+        hexAgree = hexAgree && a == b && a == 2 * length && memcmp(simd, scalar, a) == 0;
+        a = Export_Base64(simd, data, length);
+        b = Export_Base64Scalar(scalar, data, length);
+        base64Agree = base64Agree && a == b && a == 4 * ((length + 2) / 3) && memcmp(simd, scalar, a) == 0;
+    }
+    check(hexAgree, "Dispatched hex equals scalar at random lengths");
+    check(base64Agree, "Dispatched base64 equals scalar at random lengths");
+
+    printf("\nFrame export:\n");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    unsigned int frameCounts[256];
+    CorpusMix_Default(&mix);
+    mix.seed = 17;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    for (int i = 0; i < GENERATED_FRAMES; i++) CorpusGenerator_Next(&gen, &mix, &frames[i]);
+
+    size_t size = 0;
+    char* csv = export_frames(frames, GENERATED_FRAMES, EXPORT_CSV, EXPORT_BLOCKS_HEX, &size);
+    check(csv != NULL && size > Exporter_PoolBytes(),
+          "CSV export spans several writev flushes");
+    int roundTrip = csv != NULL && strncmp(csv, "seconds,subseconds,", 19) == 0;
+    char* row = roundTrip ? strchr(csv, '\n') + 1 : NULL;
+    for (int i = 0; roundTrip && i < GENERATED_FRAMES; i++) {
+        T_TelemetryFrame parsed;
+        row = parse_csv_row(row, &parsed);
+        roundTrip = row != NULL && same_frame(&parsed, &frames[i]);
+    }
+    check(roundTrip && row == csv + size, "CSV rows parse back to the source frames");
+    free(csv);
+
+    char* ndjson = export_frames(frames, GENERATED_FRAMES, EXPORT_NDJSON, EXPORT_BLOCKS_BASE64, &size);
+    int lines = 0, wellFormed = ndjson != NULL;
+    for (char* p = ndjson; wellFormed && p < ndjson + size; lines++) {
+        char* end = strchr(p, '\n');
+        wellFormed = end != NULL && p[0] == '{' && end[-1] == '}' && strncmp(p, "{\"seconds\":", 11) == 0;
+        p = end + 1;
+    }
+    check(wellFormed && lines == GENERATED_FRAMES, "NDJSON writes one object per line");
+    free(ndjson);
+
+    char* json = export_frames(frames, 2, EXPORT_JSON, EXPORT_BLOCKS_HEX, &size);
+    check(json != NULL && json[0] == '[' && strstr(json, "},\n{") != NULL && strcmp(json + size - 3, "\n]\n") == 0,
+          "JSON wraps objects in one array");
+    free(json);
+    json = export_frames(frames, 0, EXPORT_JSON, EXPORT_BLOCKS_HEX, &size);
+    check(json != NULL && strcmp(json, "[\n]\n") == 0, "Empty JSON export is an empty array");
+    free(json);
+
+    printf("\nErrors:\n");
+    byte small[1024];
+    MemPool pool;
+    Exporter ex;
+    int errCode = 0;
+    MemPool_Init(&pool, small, sizeof(small));
+    check(!Exporter_Open(&ex, 1, EXPORT_CSV, EXPORT_BLOCKS_HEX, &pool, &errCode) && errCode == ERR_EXPORT_POOL,
+          "Pool smaller than Exporter_PoolBytes rejected");
+    int pipefd[2];
+    size_t poolSize = Exporter_PoolBytes();
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    errCode = 0;
+    if (pipe(pipefd) == 0) {
+        close(pipefd[0]);
+        close(pipefd[1]);
+    }
+    check(Exporter_Open(&ex, pipefd[1], EXPORT_CSV, EXPORT_BLOCKS_HEX, &pool, &errCode) &&
+          !Exporter_Close(&ex, &errCode) && errCode == ERR_EXPORT_IO, "Write to a closed descriptor reported");
+    free(poolBuffer);
+
+    return test_report("Export");
+}
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_fieldprof.h"
+#include "asn1crt_layout.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define GENERATED_FRAMES 2000
+
+// Same bytes out of the generated encoder for both decodes means same values
+static int same_frame(const T_TelemetryFrame* a, const T_TelemetryFrame* b) {
+    byte ea[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    byte eb[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    BitStream sa, sb;
+    int errCode;
+
+    BitStream_Init(&sa, ea, sizeof(ea));
+    BitStream_Init(&sb, eb, sizeof(eb));
+    if (!T_TelemetryFrame_Encode(a, &sa, &errCode, TRUE) || !T_TelemetryFrame_Encode(b, &sb, &errCode, TRUE)) {
+        return 0;
+    }
+    return BitStream_GetLength(&sa) == BitStream_GetLength(&sb) &&
+           memcmp(ea, eb, (size_t)BitStream_GetLength(&sa)) == 0;
+}
+
+static int declared_widths_hold(const FieldProfile* prof) {
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        const FieldStats* s = &prof->fields[f];
+        int declared = FieldProfile_DeclaredBits((FieldId)f);
+        if (declared > 0 && s->bits != s->count * (unsigned long long)declared) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    static FieldProfile prof;
+    T_TelemetryFrame profiled, reference;
+    byte buffer[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    BitStream bs;
+    int errCode = 0;
+
+    printf("===== Field Profiler Test =====\n");
+
+    printf("\nMixed frames:\n");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    unsigned int frameCounts[256];
+    T_TelemetryFrame source;
+    CorpusMix_Default(&mix);
+    mix.seed = 7;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    FieldProfile_Init(&prof);
+
+    int agree = 1;
+    int padded = 1;
+    for (int i = 0; i < GENERATED_FRAMES; i++) {
+        unsigned long long bitsBefore = 0, bitsAfter = 0;
+        for (int f = 0; f < FIELD_COUNT; f++) bitsBefore += prof.fields[f].bits;
+
+        CorpusGenerator_Next(&gen, &mix, &source);
+        BitStream_Init(&bs, buffer, sizeof(buffer));
+        T_TelemetryFrame_Encode(&source, &bs, &errCode, TRUE);
+        int length = (int)BitStream_GetLength(&bs);
+
+        BitStream_AttachBuffer(&bs, buffer, length);
+        if (!FieldProfile_Decode(&prof, &profiled, &bs, &errCode)) {
+            agree = 0;
+            continue;
+        }
+        for (int f = 0; f < FIELD_COUNT; f++) bitsAfter += prof.fields[f].bits;
+        // Summed field bits account for the frame up to the final byte's padding
+        if ((bitsAfter - bitsBefore + 7) / 8 != (unsigned long long)length) padded = 0;
+
+        BitStream_AttachBuffer(&bs, buffer, length);
+        if (!T_TelemetryFrame_Decode(&reference, &bs, &errCode) || !same_frame(&profiled, &reference) ||
+            !same_frame(&profiled, &source)) {
+            agree = 0;
+        }
+    }
+    check(agree && prof.frames == GENERATED_FRAMES, "Profiler decode equals generated decode");
+    check(padded, "Field bits sum to encoded length minus padding");
+    check(declared_widths_hold(&prof), "Every field consumed its declared width");
+    check(prof.fields[FIELD_SECONDS].count == GENERATED_FRAMES &&
+          prof.fields[FIELD_PAYLOAD_CHOICE].count == GENERATED_FRAMES, "Header fields seen once per frame");
+    check(prof.fields[FIELD_HK_TEMP].count > prof.fields[FIELD_HK_TEMP_COUNT].count,
+          "Array elements aggregated under [i]");
+    check(prof.fields[FIELD_HK_TEMP].minValue >= LAYOUT_TEMP_MIN &&
+          prof.fields[FIELD_HK_TEMP].maxValue <= LAYOUT_TEMP_MAX, "Observed range inside constraint");
+
+    printf("\nRejection:\n");
+    unsigned long long failedBefore = prof.failures;
+    BitStream_AttachBuffer(&bs, buffer, 5);
+    check(!FieldProfile_Decode(&prof, &profiled, &bs, &errCode) &&
+          errCode == ERR_FIELDPROF_INSUFFICIENT_DATA, "Truncated frame rejected");
+
+    // CHOICE index 3 does not exist in a three-alternative CHOICE
+    memset(buffer, 0, sizeof(buffer));
+    buffer[LAYOUT_CHOICE_OFFSET / 8] = 0x30;
+    BitStream_AttachBuffer(&bs, buffer, LAYOUT_MIN_FRAME_BYTES);
+    check(!FieldProfile_Decode(&prof, &profiled, &bs, &errCode) && errCode == ERR_FIELDPROF_RANGE,
+          "Unknown CHOICE index rejected");
+    check(prof.failures == failedBefore + 2, "Failures counted");
+
+    printf("\nReport:\n");
+    FILE* out = tmpfile();
+    char text[8192];
+    FieldProfile_Report(out, &prof, FIELD_SORT_BITS);
+    rewind(out);
+    size_t n = fread(text, 1, sizeof(text) - 1, out);
+    text[n] = '\0';
+    fclose(out);
+    check(strstr(text, "payload.science.dataBlocks[i] ") != NULL, "Block data listed by path");
+    check(strstr(text, "8/8") != NULL || strstr(text, "7/8") != NULL, "Needed versus declared bits shown");
+    // Mixed corpus is dominated by science payload bytes
+    char* first = strstr(text, "payload.");
+    char* header = strstr(text, "header.timestamp.seconds");
+    check(first != NULL && header != NULL && first < header && strncmp(first, "payload.science", 15) == 0,
+          "Ranked by bits");
+    printf("%s", text);
+
+    return test_report("Field profiler");
+}
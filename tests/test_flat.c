@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_flat.h"
+#include "asn1crt_layout.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define GENERATED_FRAMES 5000
+
+static int encode(const T_TelemetryFrame* frame, byte* buffer, int size) {
+    BitStream bs;
+    int errCode;
+
+    BitStream_Init(&bs, buffer, size);
+    if (!T_TelemetryFrame_Encode(frame, &bs, &errCode, TRUE)) return 0;
+    return (int)BitStream_GetLength(&bs);
+}
+
+// Every in-place accessor against the value the frame was built from
+static int accessors_match(const byte* f, const T_TelemetryFrame* v) {
+    if (Flat_Kind(f) != (int)v->payload.kind || Flat_Seconds(f) != v->header.timestamp.seconds ||
+        Flat_Subseconds(f) != v->header.timestamp.subseconds || Flat_FrameType(f) != v->header.frameType ||
+        Flat_FrameCount(f) != v->header.frameCount) {
+        return 0;
+    }
+    if (v->payload.kind == housekeeping_PRESENT) {
+        const T_HousekeepingData* hk = &v->payload.u.housekeeping;
+        if (Flat_MainBus(f) != hk->voltages.mainBus || Flat_PayloadVoltage(f) != hk->voltages.payload ||
+            Flat_Comms(f) != hk->voltages.comms || Flat_Status(f) != hk->status ||
+            Flat_TemperatureCount(f) != hk->temperature.nCount) {
+            return 0;
+        }
+        for (int i = 0; i < hk->temperature.nCount; i++) {
+            if (Flat_Temperature(f, i) != hk->temperature.arr[i]) return 0;
+        }
+    } else if (v->payload.kind == science_PRESENT) {
+        const T_ScienceData* sci = &v->payload.u.science;
+        if (Flat_InstrumentId(f) != sci->instrumentId || Flat_BlockCount(f) != sci->dataBlocks.nCount) return 0;
+        for (int b = 0; b < sci->dataBlocks.nCount; b++) {
+            if (Flat_BlockLength(f, b) != sci->dataBlocks.arr[b].nCount ||
+                memcmp(Flat_Block(f, b), sci->dataBlocks.arr[b].arr, (size_t)sci->dataBlocks.arr[b].nCount) != 0) {
+                return 0;
+            }
+        }
+    } else if (Flat_CommandId(f) != v->payload.u.commandAck.commandId ||
+               Flat_AckStatus(f) != v->payload.u.commandAck.status) {
+        return 0;
+    }
+    return 1;
+}
+
+int main() {
+    static byte uper[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    static byte back[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    static byte flat[FLAT_MAX_FRAME_BYTES];
+    static byte transcoded[FLAT_MAX_FRAME_BYTES];
+    T_TelemetryFrame frame, restored;
+    int errCode = 0;
+
+    printf("===== Flat Encoding Test =====\n");
+
+    printf("\nAgainst the generated codec:\n");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    unsigned int frameCounts[256];
+    CorpusMix_Default(&mix);
+    mix.seed = 23;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+
+    int accessors = 1, values = 1, fromUper = 1, toUper = 1, aligned = 1;
+    int kinds[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < GENERATED_FRAMES; i++) {
+        int uperLength, flatLength, consumed, n;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        uperLength = encode(&frame, uper, sizeof(uper));
+        kinds[frame.payload.kind & 3]++;
+
+        if (!Flat_FromFrame(&frame, flat, sizeof(flat), &flatLength, &errCode)) {
+            values = 0;
+            continue;
+        }
+        aligned = aligned && flatLength % FLAT_ALIGN == 0 && flatLength == Flat_Size(flat) &&
+                  flatLength == Flat_SizeOf(&frame);
+        accessors = accessors && accessors_match(flat, &frame);
+        memset(&restored, 0, sizeof(restored));
+        values = values && Flat_ToFrame(flat, flatLength, &restored, &errCode) &&
+                 encode(&restored, back, sizeof(back)) == uperLength && memcmp(back, uper, (size_t)uperLength) == 0;
+
+        // Transcoders skip the T_TelemetryFrame and must land on the same bytes
+        fromUper = fromUper && Flat_FromUper(uper, uperLength, transcoded, sizeof(transcoded), &consumed, &n, &errCode) &&
+                   consumed == uperLength && n == flatLength && memcmp(transcoded, flat, (size_t)n) == 0;
+        memset(back, 0xA5, sizeof(back));
+        toUper = toUper && Flat_ToUper(flat, flatLength, back, sizeof(back), &n, &errCode) && n == uperLength &&
+                 memcmp(back, uper, (size_t)n) == 0;
+    }
+    check(kinds[housekeeping_PRESENT] > 0 && kinds[science_PRESENT] > 0 && kinds[commandAck_PRESENT] > 0,
+          "All payload alternatives covered");
+    check(aligned, "Sizes are FLAT_ALIGN multiples and self-describing");
+    check(accessors, "In-place accessors equal the source values");
+    check(values, "Flat_FromFrame / Flat_ToFrame round trip");
+    check(fromUper, "Flat_FromUper equals Flat_FromFrame byte for byte");
+    check(toUper, "Flat_ToUper equals T_TelemetryFrame_Encode");
+
+    printf("\nBack-to-back storage:\n");
+    static byte packed[64 * FLAT_MAX_FRAME_BYTES] __attribute__((aligned(8)));
+    int used = 0, stored = 0;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    for (int i = 0; i < 64; i++) {
+        int n;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        if (Flat_FromFrame(&frame, packed + used, (int)sizeof(packed) - used, &n, &errCode)) {
+            used += n;
+            stored++;
+        }
+    }
+    int walked = 0, allAligned = 1;
+    for (int offset = 0; offset < used; walked++) {
+        int n;
+        if (!Flat_Verify(packed + offset, used - offset, &n, &errCode)) break;
+        allAligned = allAligned && ((size_t)(packed + offset) & 7) == 0;
+        offset += n;
+    }
+    check(stored == 64 && walked == 64 && allAligned, "Frames walk by size and stay 8-byte aligned");
+
+    printf("\nMalformed flat frames:\n");
+    T_TelemetryFrame_Initialize(&frame);
+    frame.payload.kind = science_PRESENT;
+    frame.payload.u.science.dataBlocks.nCount = 2;
+    frame.payload.u.science.dataBlocks.arr[0].nCount = 10;
+    frame.payload.u.science.dataBlocks.arr[1].nCount = 20;
+    int flatLength, n;
+    Flat_FromFrame(&frame, flat, sizeof(flat), &flatLength, &errCode);
+    check(!Flat_Verify(flat, flatLength - 8, &n, &errCode) && errCode == ERR_FLAT_INSUFFICIENT_DATA,
+          "Truncated frame rejected");
+    memcpy(transcoded, flat, (size_t)flatLength);
+    transcoded[2] = FLAT_VERSION + 1;
+    check(!Flat_Verify(transcoded, flatLength, &n, &errCode) && errCode == ERR_FLAT_MALFORMED, "Unknown version rejected");
+    memcpy(transcoded, flat, (size_t)flatLength);
+    transcoded[FLAT_BLOCK_TABLE_OFFSET + 4] = (byte)(flatLength - 4);
+    check(!Flat_Verify(transcoded, flatLength, &n, &errCode) && errCode == ERR_FLAT_MALFORMED,
+          "Block running past the frame rejected");
+    memcpy(transcoded, flat, (size_t)flatLength);
+    transcoded[3] = 0;
+    check(!Flat_ToFrame(transcoded, flatLength, &restored, &errCode) && errCode == ERR_FLAT_MALFORMED,
+          "Unknown kind rejected");
+    check(!Flat_FromFrame(&frame, transcoded, FLAT_BLOCK_DATA_OFFSET, &n, &errCode) && errCode == ERR_FLAT_CAPACITY,
+          "Short output buffer rejected");
+    frame.payload.u.science.dataBlocks.nCount = 5;
+    check(!Flat_FromFrame(&frame, transcoded, sizeof(transcoded), &n, &errCode), "Constraint violation rejected");
+
+    printf("\nMalformed uPER:\n");
+    int consumed;
+    T_TelemetryFrame_Initialize(&frame);
+    frame.payload.kind = commandAck_PRESENT;
+    int uperLength = encode(&frame, uper, sizeof(uper));
+    check(!Flat_FromUper(uper, uperLength - 1, transcoded, sizeof(transcoded), &consumed, &n, &errCode) &&
+          errCode == ERR_FLAT_INSUFFICIENT_DATA, "Truncated frame rejected");
+    memcpy(back, uper, (size_t)uperLength);
+    back[LAYOUT_CHOICE_OFFSET / 8] |= 0x30;
+    check(!Flat_FromUper(back, uperLength, transcoded, sizeof(transcoded), &consumed, &n, &errCode) &&
+          errCode == ERR_FLAT_MALFORMED, "Unknown CHOICE index rejected");
+    memcpy(back, uper, (size_t)uperLength);
+    back[4] = 0xFF;
+    back[5] |= 0xC0;
+    check(!Flat_FromUper(back, uperLength, transcoded, sizeof(transcoded), &consumed, &n, &errCode) &&
+          errCode == ERR_FLAT_MALFORMED, "subseconds above 1000 rejected");
+
+    return test_report("Flat encoding");
+}
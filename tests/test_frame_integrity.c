@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_crc.h"
+#include "asn1crt_integrity.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define BATCH_FRAMES 100
+
+// Bit-at-a-time references the table-driven paths must agree with
+static unsigned int reference_crc32c(const byte* data, size_t length) {
+    unsigned int c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        c ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+        }
+    }
+    return ~c;
+}
+
+static unsigned short reference_crc16(const byte* data, size_t length) {
+    unsigned int c = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        c ^= (unsigned int)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            c = (c & 0x8000) ? ((c << 1) ^ 0x1021) & 0xFFFF : (c << 1) & 0xFFFF;
+        }
+    }
+    return (unsigned short)c;
+}
+
+static void build_frame(T_TelemetryFrame* frame, int i) {
+    T_TelemetryFrame_Initialize(frame);
+    frame->header.timestamp.seconds = 5000 + i;
+    frame->header.frameType = 2;
+    frame->header.frameCount = i;
+
+    if (i % 2 == 0) {
+        frame->payload.kind = science_PRESENT;
+        frame->payload.u.science.instrumentId = 3;
+        frame->payload.u.science.dataBlocks.nCount = 1;
+        frame->payload.u.science.dataBlocks.arr[0].nCount = 64 + i;
+        memset(frame->payload.u.science.dataBlocks.arr[0].arr, i & 0xFF, 64 + i);
+    } else {
+        frame->payload.kind = commandAck_PRESENT;
+        frame->payload.u.commandAck.commandId = i;
+    }
+}
+
+static void test_known_vectors(void) {
+    const byte* check9 = (const byte*)"123456789";
+
+    printf("\nKnown check values:\n");
+    check(Crc32c_Compute(check9, 9) == 0xE3069283u, "CRC-32C(\"123456789\") == 0xE3069283");
+    check(Crc32c_UpdateSoftware(0, check9, 9) == 0xE3069283u, "Software CRC-32C check value");
+    check(Crc16_Ccsds(check9, 9) == 0x29B1, "CRC-16 CCSDS(\"123456789\") == 0x29B1");
+    check(Crc32c_Update(Crc32c_Update(0, check9, 4), check9 + 4, 5) == 0xE3069283u,
+          "CRC-32C continued across chunks");
+    check(Crc16_CcsdsUpdate(Crc16_Ccsds(check9, 5), check9 + 5, 4) == 0x29B1,
+          "CRC-16 continued across chunks");
+}
+
+// Every length and start alignment, so the unaligned head and tail loops run
+static void test_dispatch_paths(void) {
+    static byte data[1100];
+    int crc32Ok = 1;
+    int crc16Ok = 1;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (byte)(i * 131 + 17);
+    }
+
+    printf("\nDispatch paths (SSE4.2 crc32 %s):\n",
+           Crc32c_HardwareAvailable() ? "available" : "not available");
+    for (int offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length + offset <= sizeof(data); length += (length < 64) ? 1 : 37) {
+            unsigned int expected = reference_crc32c(data + offset, length);
+            if (Crc32c_Compute(data + offset, length) != expected ||
+                Crc32c_UpdateSoftware(0, data + offset, length) != expected) {
+                crc32Ok = 0;
+            }
+            if (Crc16_Ccsds(data + offset, length) != reference_crc16(data + offset, length)) {
+                crc16Ok = 0;
+            }
+        }
+    }
+    check(crc32Ok, "CRC-32C dispatched == software == bitwise");
+    check(crc16Ok, "CRC-16 slicing-by-8 == bitwise");
+}
+
+static void test_frame_roundtrip(IntegrityKind kind, const char* name) {
+    byte buffer[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + INTEGRITY_MAX_TRAILER];
+    T_TelemetryFrame frame, decoded;
+    int length = 0;
+    int errCode = 0;
+    char label[64];
+
+    printf("\n%s trailer:\n", name);
+    build_frame(&frame, 10);
+    flag encoded = FrameIntegrity_EncodeFrame(&frame, kind, buffer, sizeof(buffer), &length, &errCode);
+    check(encoded, "Encode with trailer");
+
+    snprintf(label, sizeof(label), "Decode verifies (%d bytes)", length);
+    check(FrameIntegrity_DecodeFrame(&decoded, kind, buffer, length, &errCode) &&
+          decoded.header.frameCount == 10 &&
+          decoded.payload.u.science.dataBlocks.arr[0].nCount == 74, label);
+
+    buffer[length / 2] ^= 0x01;
+    errCode = 0;
+    check(!FrameIntegrity_DecodeFrame(&decoded, kind, buffer, length, &errCode) &&
+          errCode == ERR_FRAME_INTEGRITY_CHECKSUM, "Single bit flip rejected before decode");
+    buffer[length / 2] ^= 0x01;
+
+    check(!FrameIntegrity_DecodeFrame(&decoded, kind, buffer, FrameIntegrity_TrailerSize(kind), &errCode) &&
+          errCode == ERR_FRAME_INTEGRITY_LENGTH, "Trailer-only buffer rejected");
+    check(FrameIntegrity_Append(kind, buffer, 20, 21) == 0, "Append refuses short capacity");
+}
+
+static void test_batch(void) {
+    static byte storage[BATCH_FRAMES][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + INTEGRITY_MAX_TRAILER];
+    const byte* frames[BATCH_FRAMES];
+    int lengths[BATCH_FRAMES];
+    unsigned long long valid[(BATCH_FRAMES + 63) / 64];
+    T_TelemetryFrame frame;
+    int errCode;
+    int bitmapOk = 1;
+
+    printf("\nBatch verification:\n");
+    for (int i = 0; i < BATCH_FRAMES; i++) {
+        build_frame(&frame, i);
+        if (!FrameIntegrity_EncodeFrame(&frame, INTEGRITY_CRC32C, storage[i], sizeof(storage[i]),
+                                        &lengths[i], &errCode)) {
+            check(0, "Encode batch frame");
+            return;
+        }
+        frames[i] = storage[i];
+    }
+
+    // Corrupt every seventh frame, including some in the second bitmap word
+    for (int i = 0; i < BATCH_FRAMES; i += 7) {
+        storage[i][3] ^= 0x80;
+    }
+
+    int count = FrameIntegrity_VerifyBatch(INTEGRITY_CRC32C, frames, lengths, BATCH_FRAMES, valid);
+    for (int i = 0; i < BATCH_FRAMES; i++) {
+        int isValid = (valid[i >> 6] >> (i & 63)) & 1;
+        if (isValid != (i % 7 != 0)) bitmapOk = 0;
+    }
+    check(count == BATCH_FRAMES - (BATCH_FRAMES + 6) / 7, "Valid count excludes corrupted frames");
+    check(bitmapOk, "Bitmap marks exactly the corrupted frames");
+}
+
+int main() {
+    printf("===== Frame Integrity Test =====\n");
+
+    test_known_vectors();
+    test_dispatch_paths();
+    test_frame_roundtrip(INTEGRITY_CRC16_CCSDS, "CCSDS CRC-16");
+    test_frame_roundtrip(INTEGRITY_CRC32C, "CRC-32C");
+    test_batch();
+
+    return test_report("Frame integrity");
+}
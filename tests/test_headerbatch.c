@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_headerbatch.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define FRAMES 200000
+#define ROUNDS 5
+#define WINDOW 4096   /* Frames of an index page that stays in cache */
+#define WINDOW_ROUNDS 200
+
+typedef struct {
+    HeaderColumns cols;
+    unsigned long long* invalid;
+} Columns;
+
+static void columns_alloc(Columns* c, int count) {
+    c->cols.seconds = (unsigned int*)malloc((size_t)count * sizeof(unsigned int));
+    c->cols.subseconds = (unsigned short*)malloc((size_t)count * sizeof(unsigned short));
+    c->cols.frameType = (byte*)malloc((size_t)count);
+    c->cols.frameCount = (unsigned short*)malloc((size_t)count * sizeof(unsigned short));
+    c->invalid = (unsigned long long*)malloc((size_t)(count + 63) / 64 * sizeof(unsigned long long));
+}
+
+static void columns_free(Columns* c) {
+    free(c->cols.seconds);
+    free(c->cols.subseconds);
+    free(c->cols.frameType);
+    free(c->cols.frameCount);
+    free(c->invalid);
+}
+
+static int columns_equal(const Columns* a, const Columns* b, int count) {
+    return memcmp(a->cols.seconds, b->cols.seconds, (size_t)count * sizeof(unsigned int)) == 0 &&
+           memcmp(a->cols.subseconds, b->cols.subseconds, (size_t)count * sizeof(unsigned short)) == 0 &&
+           memcmp(a->cols.frameType, b->cols.frameType, (size_t)count) == 0 &&
+           memcmp(a->cols.frameCount, b->cols.frameCount, (size_t)count * sizeof(unsigned short)) == 0 &&
+           memcmp(a->invalid, b->invalid, (size_t)(count + 63) / 64 * sizeof(unsigned long long)) == 0;
+}
+
+static int row_is(const Columns* c, int i, const T_FrameHeader* h) {
+    return c->cols.seconds[i] == h->timestamp.seconds && c->cols.subseconds[i] == h->timestamp.subseconds &&
+           c->cols.frameType[i] == h->frameType && c->cols.frameCount[i] == h->frameCount &&
+           (c->invalid[i / 64] >> (i % 64) & 1) == 0;
+}
+
+int main() {
+    Corpus corpus;
+    CorpusMix mix;
+    Columns fast, generic;
+    int errCode = 0;
+    char path[] = "/tmp/test_headerbatch_XXXXXX";
+
+    printf("===== Batch FrameHeader Unpack Test =====\n");
+    printf("Unpack kernel: %s\n", HeaderBatch_Kernel());
+
+    close(mkstemp(path));
+    CorpusMix_Default(&mix);
+    mix.seed = 46;
+    if (!Corpus_Write(path, &mix, FRAMES, &errCode) || !Corpus_Open(&corpus, path, &errCode)) {
+        printf("Cannot build corpus (error %d)\n", errCode);
+        return 1;
+    }
+    unsigned long long* offsets = (unsigned long long*)malloc(FRAMES * sizeof(unsigned long long));
+    for (int i = 0; i < FRAMES; i++) offsets[i] = corpus.index[i].offset;
+    columns_alloc(&fast, FRAMES);
+    columns_alloc(&generic, FRAMES);
+
+    printf("\nAgainst T_FrameHeader_Decode:\n");
+    int bad = HeaderBatch_Unpack(corpus.base, corpus.size, offsets, FRAMES, &fast.cols, fast.invalid);
+    int match = bad == 0;
+    for (int i = 0; i < FRAMES && match; i++) {
+        BitStream bs;
+        T_FrameHeader header;
+        BitStream_AttachBuffer(&bs, (byte*)corpus.base + offsets[i], corpus.index[i].length);
+        match = T_FrameHeader_Decode(&header, &bs, &errCode) && row_is(&fast, i, &header);
+    }
+    check(match, "Every corpus header matches the generated decode");
+    HeaderBatch_UnpackGeneric(corpus.base, corpus.size, offsets, FRAMES, &generic.cols, generic.invalid);
+    check(columns_equal(&fast, &generic, FRAMES), "Dispatched kernel matches the generic one");
+
+    printf("\nInvalid rows:\n");
+    // Frames that decode, then ones T_FrameHeader_Decode rejects, in every lane position
+    static byte crafted[64];
+    unsigned long long edge[13];
+    memcpy(crafted, corpus.base + offsets[0], HEADERBATCH_FRAME_BYTES);
+    memcpy(crafted + 16, crafted, HEADERBATCH_FRAME_BYTES);
+    crafted[20] |= 0xFF;  // subseconds 1023
+    crafted[21] |= 0xC0;
+    for (int i = 0; i < 13; i++) edge[i] = 0;
+    edge[1] = 16;
+    edge[4] = sizeof(crafted) - HEADERBATCH_FRAME_BYTES + 1;  // One byte short
+    edge[6] = ~0ULL;
+    edge[11] = 16;
+    edge[12] = sizeof(crafted) - HEADERBATCH_FRAME_BYTES;     // Just fits
+    int fastBad = HeaderBatch_Unpack(crafted, sizeof(crafted), edge, 13, &fast.cols, fast.invalid);
+    int genericBad = HeaderBatch_UnpackGeneric(crafted, sizeof(crafted), edge, 13, &generic.cols, generic.invalid);
+    check(fastBad == 4 && genericBad == 4 && fast.invalid[0] == ((1 << 1) | (1 << 4) | (1 << 6) | (1 << 11)),
+          "Out-of-range subseconds and short frames flagged");
+    check(columns_equal(&fast, &generic, 13) && fast.cols.seconds[1] == 0 && fast.cols.frameCount[4] == 0 &&
+          fast.cols.seconds[0] == fast.cols.seconds[2], "Flagged rows read 0, the others unpack");
+
+    printf("\nThroughput (%d scattered frames):\n", FRAMES);
+    double best[3] = { 1e30, 1e30, 1e30 };
+    unsigned long long sink = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        unsigned long long start = now_ns();
+        for (int i = 0; i < FRAMES; i++) {
+            BitStream bs;
+            T_FrameHeader header;
+            BitStream_AttachBuffer(&bs, (byte*)corpus.base + offsets[i], corpus.index[i].length);
+            T_FrameHeader_Decode(&header, &bs, &errCode);
+            sink += header.frameCount;
+        }
+        double t = (double)(now_ns() - start) / FRAMES;
+        if (t < best[0]) best[0] = t;
+
+        start = now_ns();
+        HeaderBatch_UnpackGeneric(corpus.base, corpus.size, offsets, FRAMES, &generic.cols, generic.invalid);
+        t = (double)(now_ns() - start) / FRAMES;
+        if (t < best[1]) best[1] = t;
+
+        start = now_ns();
+        HeaderBatch_Unpack(corpus.base, corpus.size, offsets, FRAMES, &fast.cols, fast.invalid);
+        t = (double)(now_ns() - start) / FRAMES;
+        if (t < best[2]) best[2] = t;
+        sink += fast.cols.frameCount[round] + generic.cols.frameCount[round];
+    }
+    printf("  T_FrameHeader_Decode  %6.2f ns/frame\n", best[0]);
+    printf("  generic               %6.2f ns/frame\n", best[1]);
+    printf("  %-21s %6.2f ns/frame (%.1fx decode) (%llu)\n", HeaderBatch_Kernel(), best[2], best[0] / best[2],
+           sink % 10);
+
+    double hot[2] = { 1e30, 1e30 };
+    for (int round = 0; round < ROUNDS; round++) {
+        unsigned long long start = now_ns();
+        for (int k = 0; k < WINDOW_ROUNDS; k++) {
+            HeaderBatch_UnpackGeneric(corpus.base, corpus.size, offsets, WINDOW, &generic.cols, generic.invalid);
+        }
+        double t = (double)(now_ns() - start) / WINDOW / WINDOW_ROUNDS;
+        if (t < hot[0]) hot[0] = t;
+        start = now_ns();
+        for (int k = 0; k < WINDOW_ROUNDS; k++) {
+            HeaderBatch_Unpack(corpus.base, corpus.size, offsets, WINDOW, &fast.cols, fast.invalid);
+        }
+        t = (double)(now_ns() - start) / WINDOW / WINDOW_ROUNDS;
+        if (t < hot[1]) hot[1] = t;
+    }
+    printf("  in cache (%d frames): generic %.2f ns, %s %.2f ns/frame\n", WINDOW, hot[0], HeaderBatch_Kernel(),
+           hot[1]);
+
+    columns_free(&fast);
+    columns_free(&generic);
+    free(offsets);
+    Corpus_Close(&corpus);
+    unlink(path);
+
+    return test_report("Batch header unpack");
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_ingest.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define TEST_FRAMES 500
+#define TEST_BURST  50   /* Sent before each drain: well inside any default SO_RCVBUF */
+
+typedef struct {
+    int received;
+    unsigned long frameCountSum;
+    int kinds[4];
+} IngestTally;
+
+static void tally_batch(const T_TelemetryFrame* frames, int count, void* userData) {
+    IngestTally* tally = (IngestTally*)userData;
+    for (int i = 0; i < count; i++) {
+        tally->received++;
+        tally->frameCountSum += frames[i].header.frameCount;
+        tally->kinds[frames[i].payload.kind & 3]++;
+    }
+}
+
+// Receive until the server has seen target datagrams or stays idle for a second
+static int drain(IngestServer* server, unsigned long target, IngestTally* tally) {
+    int idle = 0;
+    while (server->stats.datagrams < target && idle < 10) {
+        int n = IngestServer_Poll(server, 100, tally_batch, tally);
+        if (n < 0) {
+            perror("IngestServer_Poll");
+            return 0;
+        }
+        idle = (n == 0) ? idle + 1 : 0;
+    }
+    return 1;
+}
+
+static int send_datagram(int fd, const unsigned char* buffer, int length, const struct sockaddr_in* dest) {
+    if (sendto(fd, buffer, length, 0, (const struct sockaddr*)dest, sizeof(*dest)) != length) {
+        perror("sendto");
+        return 0;
+    }
+    return 1;
+}
+
+// Encode frame i as one of the three payload kinds
+static int encode_frame(int i, unsigned char* buffer, size_t size) {
+    T_TelemetryFrame frame;
+    T_TelemetryFrame_Initialize(&frame);
+
+    frame.header.timestamp.seconds = 1000 + i;
+    frame.header.timestamp.subseconds = i % 1000;
+    frame.header.frameType = 1;
+    frame.header.frameCount = i;
+
+    if (i % 3 == 0) {
+        frame.payload.kind = housekeeping_PRESENT;
+        frame.payload.u.housekeeping.voltages.mainBus = 3300;
+        frame.payload.u.housekeeping.temperature.nCount = 2;
+        frame.payload.u.housekeeping.temperature.arr[0] = 25;
+        frame.payload.u.housekeeping.temperature.arr[1] = -30;
+    } else if (i % 3 == 1) {
+        frame.payload.kind = science_PRESENT;
+        frame.payload.u.science.instrumentId = 7;
+        frame.payload.u.science.dataBlocks.nCount = 2;
+        frame.payload.u.science.dataBlocks.arr[0].nCount = 200;
+        frame.payload.u.science.dataBlocks.arr[1].nCount = 17;
+        memset(frame.payload.u.science.dataBlocks.arr[0].arr, 0xA5, 200);
+        memset(frame.payload.u.science.dataBlocks.arr[1].arr, 0x5A, 17);
+    } else {
+        frame.payload.kind = commandAck_PRESENT;
+        frame.payload.u.commandAck.commandId = i;
+    }
+
+    BitStream bs;
+    int errCode;
+    BitStream_Init(&bs, buffer, (long)size);
+    if (!T_TelemetryFrame_Encode(&frame, &bs, &errCode, TRUE)) {
+        printf("ERROR: Encoding frame %d failed with error %d\n", i, errCode);
+        return 0;
+    }
+    return (int)BitStream_GetLength(&bs);
+}
+
+int main() {
+    printf("===== UDP Ingest Loopback Test =====\n");
+
+    IngestConfig config;
+    IngestConfig_Default(&config);
+    config.bindAddress = "127.0.0.1";
+    config.recvBufferBytes = 4 * 1024 * 1024;
+
+    size_t poolSize = IngestServer_PoolBytes(&config);
+    unsigned char* poolBuffer = (unsigned char*)malloc(poolSize);
+    check(poolBuffer != NULL, "Server pool allocated");
+    if (poolBuffer == NULL) return test_report("Loopback ingest");
+    MemPool pool;
+    MemPool_Init(&pool, poolBuffer, poolSize);
+
+    IngestServer server;
+    if (!IngestServer_Open(&server, &config, &pool)) {
+        perror("IngestServer_Open");
+        free(poolBuffer);
+        return 1;
+    }
+    printf("Listening on 127.0.0.1:%u (GRO %s), pool used %zu/%zu bytes\n",
+           server.port, server.groActive ? "on" : "off", pool.used, pool.size);
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    check(fd >= 0, "Sender socket opened");
+    if (fd < 0) {
+        IngestServer_Close(&server);
+        free(poolBuffer);
+        return test_report("Loopback ingest");
+    }
+    struct sockaddr_in dest;
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(server.port);
+    inet_pton(AF_INET, "127.0.0.1", &dest.sin_addr);
+
+    // Valid frames in bursts, each drained before the next so loopback
+    // never drops for lack of receive buffer, plus one datagram of garbage
+    // the decoder must reject
+    IngestTally tally;
+    memset(&tally, 0, sizeof(tally));
+    unsigned long expectedSum = 0;
+    unsigned char buffer[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    int delivered = 1;
+    for (int i = 0; delivered && i < TEST_FRAMES; i++) {
+        int length = encode_frame(i, buffer, sizeof(buffer));
+        delivered = length > 0 && send_datagram(fd, buffer, length, &dest);
+        expectedSum += i;
+        if (delivered && (i + 1) % TEST_BURST == 0) delivered = drain(&server, (unsigned long)i + 1, &tally);
+    }
+    memset(buffer, 0xFF, 4);
+    delivered = delivered && send_datagram(fd, buffer, 4, &dest) && drain(&server, TEST_FRAMES + 1, &tally);
+    check(delivered, "Every datagram sent and polled");
+
+    printf("Wakeups: %lu, datagrams: %lu, decoded: %lu, errors: %lu\n",
+           server.stats.wakeups, server.stats.datagrams,
+           server.stats.framesDecoded, server.stats.decodeErrors);
+    printf("Kinds: housekeeping %d, science %d, commandAck %d\n",
+           tally.kinds[housekeeping_PRESENT], tally.kinds[science_PRESENT],
+           tally.kinds[commandAck_PRESENT]);
+
+    check(tally.received == TEST_FRAMES && tally.frameCountSum == expectedSum, "Every frame received once");
+    check(server.stats.decodeErrors == 1, "Garbage datagram rejected");
+    check(server.stats.wakeups < TEST_FRAMES, "Datagrams batched per wakeup");
+
+    close(fd);
+    IngestServer_Close(&server);
+    free(poolBuffer);
+    return test_report("Loopback ingest");
+}
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "asn1crt.h"
+#include "asn1crt_latency.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define THREADS 4
+#define SAMPLES_PER_THREAD 50000
+#define OVERHEAD_ITERATIONS 50000
+
+static LatencySnapshot snap;
+
+static int within(unsigned long long value, unsigned long long expected) {
+    unsigned long long slack = expected / 16 + 1;
+    return value + slack >= expected && value <= expected + slack;
+}
+
+static int encode_frame(int kind, byte* buffer, int size) {
+    T_TelemetryFrame frame;
+    BitStream bs;
+    int errCode;
+
+    T_TelemetryFrame_Initialize(&frame);
+    frame.header.timestamp.seconds = 77;
+    frame.header.frameCount = 9;
+    if (kind == science_PRESENT) {
+        frame.payload.kind = science_PRESENT;
+        frame.payload.u.science.dataBlocks.nCount = 2;
+        frame.payload.u.science.dataBlocks.arr[0].nCount = 200;
+        frame.payload.u.science.dataBlocks.arr[1].nCount = 100;
+    } else {
+        frame.payload.kind = commandAck_PRESENT;
+        frame.payload.u.commandAck.commandId = 5;
+    }
+    BitStream_Init(&bs, buffer, size);
+    if (!T_TelemetryFrame_EncodeTimed(&frame, &bs, &errCode, TRUE)) {
+        return 0;
+    }
+    return (int)BitStream_GetLength(&bs);
+}
+
+static void* record_thread(void* arg) {
+    (void)arg;
+    for (int i = 0; i < SAMPLES_PER_THREAD; i++) {
+        Latency_Record(LATENCY_OP_PARTIAL, housekeeping_PRESENT, 0, 100 + (unsigned long long)(i % 100));
+    }
+    return NULL;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    byte science[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    byte ack[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    T_TelemetryFrame frame;
+    BitStream bs;
+    int errCode;
+
+    printf("===== Latency Histogram Test =====\n");
+
+    printf("\nRuntime switch:\n");
+    int scienceLength = encode_frame(science_PRESENT, science, sizeof(science));
+    BitStream_AttachBuffer(&bs, science, scienceLength);
+    check(T_TelemetryFrame_DecodeTimed(&frame, &bs, &errCode), "Timed decode works while disabled");
+    check(!Latency_Snapshot(&snap), "Nothing recorded while disabled");
+
+    Latency_SetEnabled(TRUE);
+    check(Latency_Enabled(), "Recording enabled");
+
+    printf("\nPercentiles:\n");
+    // 1000..1999 ticks, ten times each: p50 ~1500, p99 ~1990
+    for (int r = 0; r < 10; r++) {
+        for (int v = 1000; v < 2000; v++) {
+            Latency_Record(LATENCY_OP_DECODE, science_PRESENT, 0, (unsigned long long)v);
+        }
+    }
+    Latency_Snapshot(&snap);
+    const LatencyHistogram* h = &snap.ok[LATENCY_OP_DECODE][science_PRESENT];
+    check(h->total == 10000 && h->maxTicks == 1999, "Count and max exact");
+    check(within(LatencyHistogram_ValueAt(h, 50.0), 1500), "p50 within 1/16 of 1500");
+    check(within(LatencyHistogram_ValueAt(h, 99.0), 1990), "p99 within 1/16 of 1990");
+    check(LatencyHistogram_ValueAt(h, 100.0) <= 1999, "p100 capped at max");
+    check(h->sumTicks == 14995000ULL, "Sum exact");
+
+    printf("\nTimed wrappers:\n");
+    int ackLength = encode_frame(commandAck_PRESENT, ack, sizeof(ack));
+    for (int i = 0; i < 100; i++) {
+        BitStream_AttachBuffer(&bs, ack, ackLength);
+        T_TelemetryFrame_DecodeTimed(&frame, &bs, &errCode);
+    }
+    // A science frame cut short fails inside the decoder with its own error code
+    BitStream_AttachBuffer(&bs, science, 20);
+    flag truncatedOk = T_TelemetryFrame_DecodeTimed(&frame, &bs, &errCode);
+    int truncatedCode = errCode;
+
+    Latency_Snapshot(&snap);
+    check(snap.ok[LATENCY_OP_ENCODE][commandAck_PRESENT].total == 1, "Encode filed under commandAck");
+    check(snap.ok[LATENCY_OP_DECODE][commandAck_PRESENT].total == 100, "100 decodes filed under commandAck");
+    check(!truncatedOk && snap.errors[LATENCY_OP_DECODE][0].code == truncatedCode &&
+          snap.errors[LATENCY_OP_DECODE][0].hist.total == 1, "Failed decode filed under its error code");
+
+    printf("\nThreads:\n");
+    pthread_t threads[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+        pthread_create(&threads[t], NULL, record_thread, NULL);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    Latency_Snapshot(&snap);
+    check(snap.threads == THREADS + 1, "One recorder per thread");
+    check(snap.ok[LATENCY_OP_PARTIAL][housekeeping_PRESENT].total == THREADS * SAMPLES_PER_THREAD,
+          "All thread samples merged");
+
+    printf("\nExport:\n");
+    FILE* out = tmpfile();
+    char text[16384];
+    Latency_WritePrometheus(out, &snap);
+    rewind(out);
+    size_t n = fread(text, 1, sizeof(text) - 1, out);
+    text[n] = '\0';
+    fclose(out);
+    check(strstr(text, "# TYPE asn1_frame_latency_seconds summary") != NULL, "Prometheus TYPE line");
+    check(strstr(text, "asn1_frame_latency_seconds_count{op=\"decode\",kind=\"science\",error=\"0\"} 10000") != NULL,
+          "Prometheus count per kind");
+    check(strstr(text, "asn1_frame_latency_seconds{op=\"decode\",kind=\"commandAck\",error=\"0\",quantile=\"0.99\"}") != NULL,
+          "Prometheus quantile series");
+
+    out = tmpfile();
+    Latency_WriteJson(out, &snap);
+    rewind(out);
+    n = fread(text, 1, sizeof(text) - 1, out);
+    text[n] = '\0';
+    fclose(out);
+    check(strstr(text, "\"op\":\"partial\",\"kind\":\"housekeeping\",\"error\":0,\"count\":200000") != NULL,
+          "JSON series");
+
+    // Informational: wrapper cost against the plain call on the same frame
+    printf("\nOverhead:\n");
+    double plain = 0, timed = 0;
+    for (int round = 0; round < 2; round++) {
+        double start = now_seconds();
+        for (int i = 0; i < OVERHEAD_ITERATIONS; i++) {
+            BitStream_AttachBuffer(&bs, science, scienceLength);
+            T_TelemetryFrame_Decode(&frame, &bs, &errCode);
+        }
+        plain = now_seconds() - start;
+        start = now_seconds();
+        for (int i = 0; i < OVERHEAD_ITERATIONS; i++) {
+            BitStream_AttachBuffer(&bs, science, scienceLength);
+            T_TelemetryFrame_DecodeTimed(&frame, &bs, &errCode);
+        }
+        timed = now_seconds() - start;
+    }
+    printf("  Decode %.1f ns plain, %.1f ns timed (%+.2f%%)\n", plain / OVERHEAD_ITERATIONS * 1e9,
+           timed / OVERHEAD_ITERATIONS * 1e9, (timed - plain) / plain * 100.0);
+
+    return test_report("Latency histograms");
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_lazy.h"
+#include "asn1crt_layout.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define GENERATED_FRAMES 3000
+
+static int encode(const T_TelemetryFrame* frame, byte* buffer, int size) {
+    BitStream bs;
+    int errCode;
+
+    BitStream_Init(&bs, buffer, size);
+    if (!T_TelemetryFrame_Encode(frame, &bs, &errCode, TRUE)) return 0;
+    return (int)BitStream_GetLength(&bs);
+}
+
+// Every accessor of the frame's alternative against the full decode
+static int lazy_matches(const byte* buffer, int length, const T_TelemetryFrame* full) {
+    LazyFrame lf;
+    T_FrameHeader header;
+    int kind, errCode;
+    asn1SccUint v;
+
+    LazyFrame_Init(&lf, buffer, length);
+    if (!LazyFrame_Kind(&lf, &kind, &errCode) || kind != (int)full->payload.kind) return 0;
+    if (!LazyFrame_FrameCount(&lf, &v, &errCode) || v != full->header.frameCount) return 0;
+    if (!LazyFrame_Header(&lf, &header, &errCode) ||
+        header.timestamp.seconds != full->header.timestamp.seconds ||
+        header.timestamp.subseconds != full->header.timestamp.subseconds ||
+        header.frameType != full->header.frameType) {
+        return 0;
+    }
+
+    if (kind == housekeeping_PRESENT) {
+        const T_HousekeepingData* hk = &full->payload.u.housekeeping;
+        const T_HousekeepingData_temperature* temps;
+        T_VoltageReadings volts;
+        // Status first: located by skipping the temperatures without decoding them
+        if (!LazyFrame_Status(&lf, &v, &errCode) || v != hk->status) return 0;
+        if (!LazyFrame_Voltages(&lf, &volts, &errCode) || volts.mainBus != hk->voltages.mainBus ||
+            volts.payload != hk->voltages.payload || volts.comms != hk->voltages.comms) {
+            return 0;
+        }
+        if (!LazyFrame_Temperatures(&lf, &temps, &errCode) || temps->nCount != hk->temperature.nCount) return 0;
+        for (int i = 0; i < temps->nCount; i++) {
+            if (temps->arr[i] != hk->temperature.arr[i]) return 0;
+        }
+    } else if (kind == science_PRESENT) {
+        const T_ScienceData* sci = &full->payload.u.science;
+        byte block[256];
+        int count, n;
+        if (!LazyFrame_InstrumentId(&lf, &v, &errCode) || v != sci->instrumentId) return 0;
+        if (!LazyFrame_BlockCount(&lf, &count, &errCode) || count != sci->dataBlocks.nCount) return 0;
+        // Last block first, then the rest from the offset map
+        for (int step = 0; step < count; step++) {
+            int j = step == 0 ? count - 1 : step - 1;
+            if (!LazyFrame_ReadBlock(&lf, j, block, sizeof(block), &n, &errCode) ||
+                n != sci->dataBlocks.arr[j].nCount || memcmp(block, sci->dataBlocks.arr[j].arr, (size_t)n) != 0) {
+                return 0;
+            }
+        }
+    } else {
+        T_CommandAck_status status;
+        if (!LazyFrame_CommandId(&lf, &v, &errCode) || v != full->payload.u.commandAck.commandId) return 0;
+        if (!LazyFrame_AckStatus(&lf, &status, &errCode) || status != full->payload.u.commandAck.status) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    byte buffer[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    T_TelemetryFrame frame, full;
+    LazyFrame lf;
+    BitStream bs;
+    int errCode = 0;
+
+    printf("===== Lazy Frame Test =====\n");
+
+    printf("\nAccessors against full decode:\n");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    unsigned int frameCounts[256];
+    CorpusMix_Default(&mix);
+    mix.seed = 11;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+
+    int agree = 1;
+    int kinds[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < GENERATED_FRAMES; i++) {
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        int length = encode(&frame, buffer, sizeof(buffer));
+        BitStream_AttachBuffer(&bs, buffer, length);
+        if (!T_TelemetryFrame_Decode(&full, &bs, &errCode) || !lazy_matches(buffer, length, &full)) {
+            agree = 0;
+        }
+        kinds[full.payload.kind & 3]++;
+    }
+    check(agree, "Every accessor equals T_TelemetryFrame_Decode");
+    check(kinds[housekeeping_PRESENT] > 0 && kinds[science_PRESENT] > 0 && kinds[commandAck_PRESENT] > 0,
+          "All payload alternatives covered");
+
+    printf("\nScience frame:\n");
+    T_TelemetryFrame_Initialize(&frame);
+    frame.header.frameCount = 321;
+    frame.payload.kind = science_PRESENT;
+    frame.payload.u.science.instrumentId = 4;
+    frame.payload.u.science.dataBlocks.nCount = 4;
+    for (int b = 0; b < 4; b++) {
+        frame.payload.u.science.dataBlocks.arr[b].nCount = 200 + b;
+        memset(frame.payload.u.science.dataBlocks.arr[b].arr, 0x10 + b, 200 + b);
+    }
+    int length = encode(&frame, buffer, sizeof(buffer));
+    LazyFrame_Init(&lf, buffer, length);
+
+    asn1SccUint v = 0;
+    int n = 0;
+    check(lf.cached == 0 && lf.blocksLocated == 0, "Init decodes nothing");
+    check(LazyFrame_InstrumentId(&lf, &v, &errCode) && v == 4, "instrumentId");
+    check(lf.blocksLocated == 0, "Blocks untouched by header access");
+    check(LazyFrame_BlockLength(&lf, 1, &n, &errCode) && n == 201 && lf.blocksLocated == 2,
+          "Offset map grows only to the requested block");
+    check(LazyFrame_BlockLength(&lf, 3, &n, &errCode) && n == 203 && lf.blocksLocated == 4,
+          "Resumes from the furthest located block");
+    check(!LazyFrame_BlockLength(&lf, 4, &n, &errCode) && errCode == ERR_LAZY_INDEX, "Index past count rejected");
+    byte small[64];
+    check(!LazyFrame_ReadBlock(&lf, 0, small, sizeof(small), &n, &errCode) && errCode == ERR_LAZY_CAPACITY,
+          "Short output buffer rejected");
+    check(!LazyFrame_Status(&lf, &v, &errCode) && errCode == ERR_LAZY_WRONG_KIND, "Housekeeping field on science frame");
+
+    // Cached values are served without touching the buffer again
+    check(LazyFrame_FrameCount(&lf, &v, &errCode) && v == 321, "frameCount");
+    byte saved = buffer[6];
+    buffer[6] ^= 0xFF;
+    check(LazyFrame_FrameCount(&lf, &v, &errCode) && v == 321, "Second access served from cache");
+    buffer[6] = saved;
+
+    printf("\nMalformed input:\n");
+    LazyFrame_Init(&lf, buffer, 40);
+    check(LazyFrame_InstrumentId(&lf, &v, &errCode), "Fields inside a truncated buffer still readable");
+    check(!LazyFrame_BlockLength(&lf, 0, &n, &errCode) && errCode == ERR_LAZY_INSUFFICIENT_DATA,
+          "Block running past the buffer rejected");
+    memset(buffer, 0, sizeof(buffer));
+    buffer[LAYOUT_CHOICE_OFFSET / 8] = 0x30;
+    LazyFrame_Init(&lf, buffer, 11);
+    int kind;
+    check(!LazyFrame_Kind(&lf, &kind, &errCode) && errCode == ERR_LAZY_RANGE, "Unknown CHOICE index rejected");
+
+    return test_report("Lazy frame");
+}
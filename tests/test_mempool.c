@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define ARENA_BYTES   ((size_t)64 << 20)
+#define CORPUS_FRAMES 4096
+#define RANDOM_READS  2000000
+
+static volatile unsigned long long sink;  /* Keeps the random reads */
+
+static long minor_faults(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+/* THP actually backing the process, from the kernel's point of view */
+static long anon_huge_kb(void) {
+    char line[256];
+    long kb = -1;
+    FILE* f = fopen("/proc/self/smaps_rollup", "r");
+
+    if (f == NULL) return -1;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) break;
+    }
+    fclose(f);
+    return kb;
+}
+
+static void flag_names(int flags, char* out, size_t size) {
+    snprintf(out, size, "%s%s%s%s", (flags & MEMPOOL_MAP_HUGETLB) ? "hugetlb " : "",
+             (flags & MEMPOOL_MAP_THP) ? "thp " : "", (flags & MEMPOOL_MAP_PREFAULT) ? "prefault " : "",
+             (flags & MEMPOOL_MAP_NUMA) ? "numa" : "");
+    if (out[0] == '\0') snprintf(out, size, "-");
+}
+
+typedef struct {
+    const char* name;
+    int flags;           /* -1: malloc'd buffer through MemPool_Init */
+} Backing;
+
+typedef struct {
+    double setupUs;
+    double firstFrameUs;
+    double coldNs;       /* First decode into each slot */
+    double warmNs;       /* Same slots again */
+    double copyNs;       /* First write of each slot without the decoder */
+    double randomNs;
+    long coldFaults;
+    long copyFaults;
+    long hugeKb;
+    int took;
+} BackingResult;
+
+static flag make_pool(const Backing* b, MemPool* pool, byte** owned, int* errCode) {
+    *owned = NULL;
+    if (b->flags < 0) {
+        *owned = (byte*)malloc(ARENA_BYTES);
+        if (*owned == NULL) return FALSE;
+        MemPool_Init(pool, *owned, ARENA_BYTES);
+        return TRUE;
+    }
+    return MemPool_InitMapped(pool, ARENA_BYTES, b->flags, errCode);
+}
+
+static flag decode_into(const Corpus* corpus, unsigned int i, T_TelemetryFrame* frame) {
+    BitStream bs;
+    int length;
+    int errCode;
+    const byte* data = Corpus_Frame(corpus, i % corpus->count, &length);
+
+    BitStream_AttachBuffer(&bs, (byte*)data, length);
+    return T_TelemetryFrame_Decode(frame, &bs, &errCode);
+}
+
+static void drop_pool(MemPool* pool, byte* owned) {
+    MemPool_Destroy(pool);
+    free(owned);
+}
+
+static flag run_backing(const Backing* b, const Corpus* corpus, const T_TelemetryFrame* sample, BackingResult* r) {
+    MemPool pool;
+    byte* owned;
+    int errCode = 0;
+    size_t slot = (sizeof(T_TelemetryFrame) + 7) & ~(size_t)7;
+    unsigned int slots = (unsigned int)(ARENA_BYTES / slot);
+    T_TelemetryFrame* frames;
+    unsigned long long sum = 0;
+    unsigned long long state = 47;
+    unsigned long long start;
+    long faults;
+
+    // Startup: the arena appears, then the first frame arrives
+    start = now_ns();
+    if (!make_pool(b, &pool, &owned, &errCode)) return FALSE;
+    r->setupUs = (double)(now_ns() - start) / 1000.0;
+    r->took = pool.mapFlags;
+    start = now_ns();
+    frames = (T_TelemetryFrame*)MemPool_Alloc(&pool, (size_t)slots * slot);
+    if (frames == NULL || !decode_into(corpus, 0, &frames[0])) {
+        drop_pool(&pool, owned);
+        return FALSE;
+    }
+    r->firstFrameUs = (double)(now_ns() - start) / 1000.0;
+
+    faults = minor_faults();
+    start = now_ns();
+    for (unsigned int i = 1; i < slots; i++) decode_into(corpus, i, &frames[i]);
+    r->coldNs = (double)(now_ns() - start) / (slots - 1);
+    r->coldFaults = minor_faults() - faults;
+    r->hugeKb = anon_huge_kb();
+
+    start = now_ns();
+    for (unsigned int i = 0; i < slots; i++) decode_into(corpus, i + 1, &frames[i]);
+    r->warmNs = (double)(now_ns() - start) / slots;
+
+    start = now_ns();
+    for (unsigned int i = 0; i < RANDOM_READS; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        sum += frames[(state >> 33) % slots].header.frameCount;
+    }
+    r->randomNs = (double)(now_ns() - start) / RANDOM_READS;
+    sink = sum;
+    drop_pool(&pool, owned);
+
+    // Fresh arena of the same kind, written without the decoder in the way
+    if (!make_pool(b, &pool, &owned, &errCode)) return FALSE;
+    frames = (T_TelemetryFrame*)MemPool_Alloc(&pool, (size_t)slots * slot);
+    if (frames == NULL) {
+        drop_pool(&pool, owned);
+        return FALSE;
+    }
+    faults = minor_faults();
+    start = now_ns();
+    for (unsigned int i = 0; i < slots; i++) frames[i] = *sample;
+    r->copyNs = (double)(now_ns() - start) / slots;
+    r->copyFaults = minor_faults() - faults;
+    drop_pool(&pool, owned);
+    return TRUE;
+}
+
+int main() {
+    MemPool pool;
+    int errCode = 0;
+    char names[64];
+
+    printf("===== Mapped MemPool Test =====\n");
+
+    printf("\nMapping:\n");
+    check(MemPool_InitMapped(&pool, 1000, 0, &errCode) && pool.size >= 1000 &&
+          pool.size % (size_t)sysconf(_SC_PAGESIZE) == 0 && pool.mapFlags == 0, "Plain mapping rounded to pages");
+    memset(pool.buffer, 0xA5, pool.size);
+    check(MemPool_Alloc(&pool, pool.size) == pool.buffer && MemPool_Alloc(&pool, 1) == NULL,
+          "Whole mapping allocatable and writable");
+    MemPool_Destroy(&pool);
+    check(pool.buffer == NULL && pool.size == 0 && pool.mapped == 0 && MemPool_Alloc(&pool, 1) == NULL,
+          "Destroy unmaps and empties the pool");
+
+    int all = MEMPOOL_MAP_HUGETLB | MEMPOOL_MAP_THP | MEMPOOL_MAP_PREFAULT | MEMPOOL_MAP_NUMA;
+    check(MemPool_InitMapped(&pool, 3 << 20, all, &errCode) && (pool.mapFlags & ~all) == 0 &&
+          (pool.mapFlags & MEMPOOL_MAP_PREFAULT) != 0, "Every option requested: maps with what is available");
+    flag_names(pool.mapFlags, names, sizeof(names));
+    printf("    took: %s\n", names);
+    printf("    page: %zu kB\n", pool.pageSize >> 10);
+    check((pool.mapFlags & (MEMPOOL_MAP_HUGETLB | MEMPOOL_MAP_THP)) == 0 ||
+          ((size_t)pool.buffer % pool.pageSize == 0 && pool.size % pool.pageSize == 0 &&
+           pool.size >= (size_t)3 << 20 && pool.size - pool.pageSize < (size_t)3 << 20),
+          "Huge page backing aligned and sized to its page");
+    check(pool.buffer[0] == 0 && pool.buffer[pool.size - 1] == 0, "Mapped memory starts zeroed");
+    MemPool_Destroy(&pool);
+    check(!MemPool_InitMapped(&pool, 0, 0, &errCode) && errCode == ERR_MEMPOOL_MAP, "Empty mapping rejected");
+
+    byte own[64];
+    MemPool_Init(&pool, own, sizeof(own));
+    own[0] = 0x5A;
+    MemPool_Destroy(&pool);
+    check(own[0] == 0x5A && pool.buffer == NULL, "Destroy leaves a caller's buffer alone");
+
+    printf("\nStartup and decode into a %zu MB arena:\n", ARENA_BYTES >> 20);
+    char path[] = "/tmp/test_mempool_XXXXXX";
+    Corpus corpus;
+    CorpusMix mix;
+    T_TelemetryFrame sample;
+    close(mkstemp(path));
+    CorpusMix_Default(&mix);
+    mix.seed = 47;
+    if (!Corpus_Write(path, &mix, CORPUS_FRAMES, &errCode) || !Corpus_Open(&corpus, path, &errCode) ||
+        !decode_into(&corpus, 0, &sample)) {
+        printf("Cannot build corpus (error %d)\n", errCode);
+        return 1;
+    }
+
+    static const Backing backings[] = {
+        { "malloc", -1 },
+        { "mmap", 0 },
+        { "mmap+prefault", MEMPOOL_MAP_PREFAULT | MEMPOOL_MAP_NUMA },
+        { "thp", MEMPOOL_MAP_THP | MEMPOOL_MAP_NUMA },
+        { "thp+prefault", MEMPOOL_MAP_THP | MEMPOOL_MAP_PREFAULT | MEMPOOL_MAP_NUMA },
+        { "hugetlb+prefault", MEMPOOL_MAP_HUGETLB | MEMPOOL_MAP_PREFAULT | MEMPOOL_MAP_NUMA },
+    };
+    BackingResult results[sizeof(backings) / sizeof(backings[0])];
+    memset(results, 0, sizeof(results));
+    int count = (int)(sizeof(backings) / sizeof(backings[0]));
+    printf("  %-17s %9s %8s %9s %7s %8s %8s %7s %7s %8s  %s\n", "backing", "setup us", "first us", "cold ns",
+           "faults", "warm ns", "copy ns", "faults", "rand ns", "thp MB", "took");
+    int ran = 1;
+    for (int i = 0; i < count; i++) {
+        BackingResult* r = &results[i];
+        if (!run_backing(&backings[i], &corpus, &sample, r)) {
+            ran = 0;
+            continue;
+        }
+        flag_names(r->took, names, sizeof(names));
+        printf("  %-17s %9.0f %8.1f %9.0f %7ld %8.0f %8.1f %7ld %7.1f %8ld  %s\n", backings[i].name, r->setupUs,
+               r->firstFrameUs, r->coldNs, r->coldFaults, r->warmNs, r->copyNs, r->copyFaults, r->randomNs,
+               r->hugeKb / 1024, names);
+    }
+    check(ran, "Every backing ran");
+    check(results[2].copyFaults * 10 <= results[1].copyFaults && results[4].copyFaults * 10 <= results[1].copyFaults,
+          "Prefaulted arenas take no faults on first write");
+
+    Corpus_Close(&corpus);
+    unlink(path);
+
+    return test_report("Mapped MemPool");
+}
@@ -0,0 +1,268 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_integrity.h"
+#include "asn1crt_lazy.h"
+#include "asn1crt_outring.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define FILE_FRAMES     2000
+#define DATAGRAM_FRAMES 300
+#define STREAM_BYTES    (8 * 1024 * 1024)
+
+static CorpusMix mix;
+static CorpusGenerator gen;
+static unsigned int frameCounts[256];
+
+static void restart_frames(void) {
+    CorpusMix_Default(&mix);
+    mix.seed = 29;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+}
+
+static int same_frame(const T_TelemetryFrame* a, const T_TelemetryFrame* b) {
+    static byte ea[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING], eb[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    BitStream bsa, bsb;
+    int errCode;
+
+    BitStream_Init(&bsa, ea, sizeof(ea));
+    BitStream_Init(&bsb, eb, sizeof(eb));
+    return T_TelemetryFrame_Encode(a, &bsa, &errCode, TRUE) && T_TelemetryFrame_Encode(b, &bsb, &errCode, TRUE) &&
+           BitStream_GetLength(&bsa) == BitStream_GetLength(&bsb) &&
+           memcmp(ea, eb, (size_t)BitStream_GetLength(&bsa)) == 0;
+}
+
+static byte* open_ring(OutRing* ring, int fd, const OutRingConfig* cfg, MemPool* pool) {
+    size_t poolSize = OutRing_PoolBytes(cfg);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    int errCode;
+
+    MemPool_Init(pool, poolBuffer, poolSize);
+    if (!OutRing_Open(ring, fd, cfg, pool, &errCode)) {
+        free(poolBuffer);
+        return NULL;
+    }
+    return poolBuffer;
+}
+
+static void test_file(void) {
+    OutRingConfig cfg;
+    OutRing ring;
+    MemPool pool;
+    T_TelemetryFrame frame, decoded;
+    int errCode = 0;
+    FILE* tmp = tmpfile();
+
+    printf("\nStream mode to a file:\n");
+    OutRingConfig_Default(&cfg);
+    cfg.slotCount = 16;
+    cfg.batchSize = 8;
+    byte* poolBuffer = open_ring(&ring, fileno(tmp), &cfg, &pool);
+    check(poolBuffer != NULL && ring.slotCount == 16, "Ring opens inside OutRing_PoolBytes");
+    if (poolBuffer == NULL) return;
+
+    restart_frames();
+    int encoded = 1;
+    for (int i = 0; i < FILE_FRAMES && encoded; i++) {
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        encoded = OutRing_Encode(&ring, &frame, &errCode);
+    }
+    encoded = encoded && OutRing_Flush(&ring, &errCode);
+    check(encoded && OutRing_Pending(&ring) == 0 && ring.stats.flushed == FILE_FRAMES, "Every frame flushed");
+    check(ring.stats.syscalls <= FILE_FRAMES / 8 + 1, "One writev per batch of slots");
+
+    // Read back and walk the concatenated frames
+    long size = ftell(tmp);
+    byte* data = (byte*)malloc((size_t)size);
+    rewind(tmp);
+    int readBack = fread(data, 1, (size_t)size, tmp) == (size_t)size && (unsigned long)size == ring.stats.bytes;
+    restart_frames();
+    int offset = 0, frames = 0;
+    while (readBack && offset < size) {
+        int length, kind;
+        BitStream bs;
+        if (!LazyFrame_Measure(data + offset, (int)size - offset, &length, &kind, &errCode)) break;
+        BitStream_AttachBuffer(&bs, data + offset, length);
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        if (!T_TelemetryFrame_Decode(&decoded, &bs, &errCode) || !same_frame(&decoded, &frame)) break;
+        offset += length;
+        frames++;
+    }
+    check(readBack && frames == FILE_FRAMES && offset == size, "File holds the frames in order, nothing else");
+
+    free(data);
+    free(poolBuffer);
+    fclose(tmp);
+}
+
+static void test_datagrams(void) {
+    OutRingConfig cfg;
+    OutRing ring;
+    MemPool pool;
+    T_TelemetryFrame frame, decoded;
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof(addr);
+    int rcvbuf = 8 * 1024 * 1024;
+    int errCode = 0;
+
+    printf("\nDatagram mode over loopback UDP:\n");
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    setsockopt(rx, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    if (rx < 0 || tx < 0 || bind(rx, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(rx, (struct sockaddr*)&addr, &addrLen) != 0 ||
+        connect(tx, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        check(0, "Loopback sockets");
+        return;
+    }
+
+    OutRingConfig_Default(&cfg);
+    cfg.mode = OUTRING_DATAGRAM;
+    cfg.slotCount = 64;
+    cfg.batchSize = 32;
+    cfg.integrity = INTEGRITY_CRC32C;
+    byte* poolBuffer = open_ring(&ring, tx, &cfg, &pool);
+
+    restart_frames();
+    int sent = poolBuffer != NULL;
+    for (int i = 0; i < DATAGRAM_FRAMES && sent; i++) {
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        sent = OutRing_Encode(&ring, &frame, &errCode);
+    }
+    sent = sent && OutRing_Flush(&ring, &errCode);
+    check(sent && ring.stats.flushed == DATAGRAM_FRAMES && ring.stats.syscalls < DATAGRAM_FRAMES / 16,
+          "sendmmsg batches slots into few syscalls");
+
+    static byte datagram[OUTRING_SLOT_SIZE];
+    restart_frames();
+    int received = 0, intact = 1;
+    for (;;) {
+        ssize_t n = recv(rx, datagram, sizeof(datagram), MSG_DONTWAIT);
+        if (n <= 0) break;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        intact = intact && FrameIntegrity_DecodeFrame(&decoded, INTEGRITY_CRC32C, datagram, (int)n, &errCode) &&
+                 same_frame(&decoded, &frame);
+        received++;
+    }
+    check(received == DATAGRAM_FRAMES && intact, "One CRC-checked frame per datagram, in order");
+
+    free(poolBuffer);
+    close(rx);
+    close(tx);
+}
+
+static void test_backpressure(void) {
+    OutRingConfig cfg;
+    OutRing ring;
+    MemPool pool;
+    T_TelemetryFrame frame;
+    int pair[2];
+    int sndbuf = 4096;
+    int errCode = 0;
+
+    printf("\nBackpressure on a non-blocking stream:\n");
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+        check(0, "socketpair");
+        return;
+    }
+    setsockopt(pair[0], SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+    fcntl(pair[0], F_SETFL, fcntl(pair[0], F_GETFL) | O_NONBLOCK);
+    fcntl(pair[1], F_SETFL, fcntl(pair[1], F_GETFL) | O_NONBLOCK);
+
+    OutRingConfig_Default(&cfg);
+    cfg.slotCount = 8;
+    cfg.batchSize = 4;
+    byte* poolBuffer = open_ring(&ring, pair[0], &cfg, &pool);
+
+    // Produce until the ring refuses: the reader is not draining yet
+    restart_frames();
+    int refused = 0;
+    for (int i = 0; i < 100000 && poolBuffer != NULL; i++) {
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        if (!OutRing_Encode(&ring, &frame, &errCode)) {
+            refused = errCode == ERR_OUTRING_FULL;
+            break;
+        }
+    }
+    unsigned long produced = ring.stats.frames;
+    check(refused && OutRing_Pending(&ring) == 8 && ring.stats.fullEvents == 1, "Full ring reports ERR_OUTRING_FULL");
+
+    // Drain the reader while flushing; the stream must be exactly the produced frames
+    byte* got = (byte*)malloc(STREAM_BYTES);
+    size_t total = 0;
+    int idle = 0;
+    while (idle < 20 && total < STREAM_BYTES) {
+        ssize_t n = read(pair[1], got + total, STREAM_BYTES - total);
+        if (n > 0) {
+            total += (size_t)n;
+            idle = 0;
+        } else if (OutRing_Pending(&ring) == 0) {
+            idle++;
+        }
+        if (!OutRing_Wait(&ring, 1, &errCode)) break;
+    }
+    check(OutRing_Pending(&ring) == 0 && ring.stats.flushed == produced, "Ring drains once the reader catches up");
+
+    restart_frames();
+    int intact = 1;
+    size_t offset = 0;
+    for (unsigned long i = 0; i < produced && intact; i++) {
+        byte expected[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+        BitStream bs;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        BitStream_Init(&bs, expected, sizeof(expected));
+        T_TelemetryFrame_Encode(&frame, &bs, &errCode, TRUE);
+        size_t length = (size_t)BitStream_GetLength(&bs);
+        intact = offset + length <= total && memcmp(got + offset, expected, length) == 0;
+        offset += length;
+    }
+    check(intact && offset == total, "Short writes resume mid-slot without loss");
+
+    free(got);
+    free(poolBuffer);
+    close(pair[0]);
+    close(pair[1]);
+}
+
+int main() {
+    printf("===== Output Ring Test =====\n");
+
+    test_file();
+    test_datagrams();
+    test_backpressure();
+
+    printf("\nErrors:\n");
+    OutRingConfig cfg;
+    OutRing ring;
+    MemPool pool;
+    byte small[256];
+    int errCode = 0;
+    OutRingConfig_Default(&cfg);
+    MemPool_Init(&pool, small, sizeof(small));
+    check(!OutRing_Open(&ring, 1, &cfg, &pool, &errCode) && errCode == ERR_OUTRING_POOL,
+          "Pool smaller than OutRing_PoolBytes rejected");
+    byte* poolBuffer = open_ring(&ring, 1, &cfg, &pool);
+    byte* slot = poolBuffer != NULL ? OutRing_Reserve(&ring, &errCode) : NULL;
+    check(slot != NULL && !OutRing_Commit(&ring, OUTRING_SLOT_SIZE + 1, &errCode) && errCode == ERR_OUTRING_LENGTH,
+          "Commit larger than a slot rejected");
+    int devnull = open("/dev/null", O_RDONLY);
+    ring.fd = devnull;
+    check(slot != NULL && OutRing_Commit(&ring, 16, &errCode) && !OutRing_Flush(&ring, &errCode) &&
+          errCode == ERR_OUTRING_IO, "Write error reported");
+    close(devnull);
+    free(poolBuffer);
+
+    return test_report("Output ring");
+}
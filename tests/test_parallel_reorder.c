@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_reorder.h"
+#include "asn1crt_parallel.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define TEST_SOURCES 8
+#define FRAMES_PER_SOURCE 5000
+#define FIRST_FRAME_COUNT 63000
+
+/* ---- ReorderBuffer in isolation ---- */
+
+typedef struct {
+    unsigned int seqs[64];
+    int count;
+} EmitLog;
+
+static void log_frame(const T_TelemetryFrame* frame, void* userData) {
+    EmitLog* log = (EmitLog*)userData;
+    if (log->count < 64) log->seqs[log->count] = (unsigned int)frame->header.frameCount;
+    log->count++;
+}
+
+static void push_seq(ReorderBuffer* rb, unsigned int seq, unsigned long long nowNs, EmitLog* log) {
+    T_TelemetryFrame frame;
+    T_TelemetryFrame_Initialize(&frame);
+    frame.header.frameCount = seq;
+    ReorderBuffer_Push(rb, &frame, nowNs, log_frame, log);
+}
+
+static void test_reorder_buffer(void) {
+    static unsigned char poolBuffer[256 * 1024];
+    MemPool pool;
+    ReorderBuffer rb;
+    EmitLog log;
+
+    printf("===== Reorder Buffer =====\n");
+    MemPool_Init(&pool, poolBuffer, sizeof(poolBuffer));
+
+    // Wraparound at 65535 with one duplicate
+    ReorderBuffer_Init(&rb, &pool, 16);
+    memset(&log, 0, sizeof(log));
+    unsigned int input[] = {65534, 0, 65535, 1, 3, 2, 2, 4};
+    for (int i = 0; i < 8; i++) push_seq(&rb, input[i], 0, &log);
+    ReorderBuffer_Flush(&rb, log_frame, &log);
+    unsigned int expected[] = {65534, 65535, 0, 1, 2, 3, 4};
+    check(log.count == 7 && memcmp(log.seqs, expected, sizeof(expected)) == 0,
+          "Wraparound delivered in frameCount order");
+    check(rb.stats.duplicates == 1 && rb.stats.gaps == 0, "Duplicate counted, no gaps");
+
+    // The stream start and a gap are held until the latency limit, then skipped; the late frame is dropped
+    ReorderBuffer_Init(&rb, &pool, 16);
+    memset(&log, 0, sizeof(log));
+    push_seq(&rb, 10, 0, &log);
+    push_seq(&rb, 12, 0, &log);
+    ReorderBuffer_Expire(&rb, 1000000ULL, 5000000ULL, log_frame, &log);
+    check(log.count == 0 && rb.held == 2, "Start and gap held within latency limit");
+    ReorderBuffer_Expire(&rb, 10000000ULL, 5000000ULL, log_frame, &log);
+    check(log.count == 2 && log.seqs[1] == 12 && rb.stats.gaps == 1, "Gap skipped after latency limit");
+    push_seq(&rb, 11, 0, &log);
+    check(rb.stats.late == 1 && log.count == 2, "Late frame counted and dropped");
+
+    // Window overflow forces delivery (memory limit)
+    ReorderBuffer_Init(&rb, &pool, 4);
+    memset(&log, 0, sizeof(log));
+    push_seq(&rb, 20, 0, &log);
+    push_seq(&rb, 22, 0, &log);
+    push_seq(&rb, 24, 0, &log);
+    push_seq(&rb, 26, 0, &log);
+    check(log.count == 2 && log.seqs[1] == 22 && rb.held == 2 && rb.stats.gaps == 1,
+          "Full window releases oldest frames");
+
+    // Counter restart far behind the window resynchronises
+    ReorderBuffer_Init(&rb, &pool, 4);
+    memset(&log, 0, sizeof(log));
+    push_seq(&rb, 30000, 0, &log);
+    push_seq(&rb, 5, 0, &log);
+    push_seq(&rb, 6, 0, &log);
+    check(log.count == 3 && rb.stats.resyncs == 1, "Counter restart resynchronises");
+}
+
+/* ---- ParallelDecoder end to end ---- */
+
+typedef struct {
+    int delivered[TEST_SOURCES];
+    unsigned int lastSeq[TEST_SOURCES];
+    int outOfOrder[TEST_SOURCES];
+} OrderCheck;
+
+// Each source is always emitted by the same worker, so per-source fields need no lock
+static void check_order(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData) {
+    OrderCheck* oc = (OrderCheck*)userData;
+    unsigned int seq = (unsigned int)frame->header.frameCount;
+
+    if (oc->delivered[sourceId] > 0 && seq != ((oc->lastSeq[sourceId] + 1) & 0xFFFF)) {
+        oc->outOfOrder[sourceId]++;
+    }
+    if (frame->payload.u.commandAck.commandId != sourceId) {
+        oc->outOfOrder[sourceId]++;
+    }
+    oc->lastSeq[sourceId] = seq;
+    oc->delivered[sourceId]++;
+}
+
+static int encode_ack(unsigned int sourceId, unsigned int seq, unsigned char* buffer) {
+    T_TelemetryFrame frame;
+    T_TelemetryFrame_Initialize(&frame);
+    frame.header.timestamp.seconds = 5000 + seq;
+    frame.header.frameType = 3;
+    frame.header.frameCount = seq & 0xFFFF;
+    frame.payload.kind = commandAck_PRESENT;
+    frame.payload.u.commandAck.commandId = sourceId;
+
+    BitStream bs;
+    int errCode;
+    BitStream_Init(&bs, buffer, 64);
+    if (!T_TelemetryFrame_Encode(&frame, &bs, &errCode, TRUE)) return 0;
+    return (int)BitStream_GetLength(&bs);
+}
+
+static void test_parallel_decoder(void) {
+    ParallelConfig config;
+    ParallelDecoder decoder;
+    ParallelStats stats;
+    static OrderCheck oc;
+    MemPool pool;
+
+    printf("===== Parallel Decoder =====\n");
+    ParallelConfig_Default(&config);
+    config.workers = 4;
+    config.maxSources = 8;
+    // Every frame is submitted, so any gap would be a worker descheduled
+    // past maxHold; hold for 10 s so a loaded machine cannot fake one
+    config.maxHoldUs = 10000000;
+
+    size_t poolSize = ParallelDecoder_PoolBytes(&config);
+    unsigned char* poolBuffer = (unsigned char*)malloc(poolSize);
+    MemPool_Init(&pool, poolBuffer, poolSize);
+
+    if (!ParallelDecoder_Start(&decoder, &config, &pool, check_order, &oc)) {
+        check(0, "ParallelDecoder_Start");
+        free(poolBuffer);
+        return;
+    }
+
+    // Interleave sources and swap neighbours so every source arrives out of order
+    srand(1234);
+    unsigned char buffer[64];
+    int duplicates = 0;
+    for (int block = 0; block < FRAMES_PER_SOURCE; block += 8) {
+        for (unsigned int src = 0; src < TEST_SOURCES; src++) {
+            int order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+            for (int i = 7; i > 0; i--) {
+                int j = rand() % (i + 1);
+                int t = order[i]; order[i] = order[j]; order[j] = t;
+            }
+            for (int i = 0; i < 8; i++) {
+                unsigned int seq = FIRST_FRAME_COUNT + block + order[i];
+                int length = encode_ack(src, seq, buffer);
+                ParallelDecoder_Submit(&decoder, src, buffer, length);
+                if (rand() % 100 == 0) {
+                    ParallelDecoder_Submit(&decoder, src, buffer, length);
+                    duplicates++;
+                }
+            }
+        }
+    }
+
+    ParallelDecoder_Stop(&decoder, &stats);
+
+    int allDelivered = 1, inOrder = 1;
+    for (int src = 0; src < TEST_SOURCES; src++) {
+        if (oc.delivered[src] != FRAMES_PER_SOURCE) allDelivered = 0;
+        if (oc.outOfOrder[src] != 0) inOrder = 0;
+    }
+    printf("  Submitted %lu, decoded %lu, emitted %lu, gaps %lu, duplicates %lu (injected %d)\n",
+           stats.submitted, stats.decoded, stats.reorder.emitted, stats.reorder.gaps,
+           stats.reorder.duplicates, duplicates);
+    check(allDelivered, "Every source delivered all frames");
+    check(inOrder, "Per-source order preserved across 65535 wrap");
+    check(stats.reorder.duplicates == (unsigned long)duplicates, "Injected duplicates counted");
+    check(stats.reorder.gaps == 0 && stats.decodeErrors == 0, "No gaps or decode errors");
+
+    free(poolBuffer);
+}
+
+int main() {
+    test_reorder_buffer();
+    test_parallel_decoder();
+    return test_report("Parallel reorder tests");
+}
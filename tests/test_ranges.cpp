@@ -0,0 +1,152 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "asn1crt_ranges.hpp"
+
+extern "C" {
+#include "asn1crt_corpus.h"
+#include "test_util.h"
+}
+
+#define GENERATED_FRAMES 2000
+
+struct Packed {
+    std::vector<byte> bytes;
+    std::vector<int> offsets;
+    std::vector<T_TelemetryFrame> values;
+};
+
+// Back-to-back frames from the corpus generator, with their offsets and values
+static void pack(Packed& p, int count) {
+    CorpusMix mix;
+    CorpusGenerator gen;
+    unsigned int frameCounts[256];
+    byte buffer[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+
+    CorpusMix_Default(&mix);
+    mix.seed = 5;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    p.values.resize(count);
+    for (int i = 0; i < count; i++) {
+        BitStream bs;
+        int errCode;
+        CorpusGenerator_Next(&gen, &mix, &p.values[i]);
+        BitStream_Init(&bs, buffer, sizeof(buffer));
+        T_TelemetryFrame_Encode(&p.values[i], &bs, &errCode, TRUE);
+        p.offsets.push_back((int)p.bytes.size());
+        p.bytes.insert(p.bytes.end(), buffer, buffer + BitStream_GetLength(&bs));
+    }
+}
+
+static bool same_header(const T_FrameHeader& a, const T_FrameHeader& b) {
+    return a.timestamp.seconds == b.timestamp.seconds && a.timestamp.subseconds == b.timestamp.subseconds &&
+           a.frameType == b.frameType && a.frameCount == b.frameCount;
+}
+
+int main() {
+    Packed p;
+    int errCode = 0;
+
+    printf("===== Frame Range Pipeline Test =====\n");
+    pack(p, GENERATED_FRAMES);
+    const byte* base = p.bytes.data();
+
+    printf("\nframes():\n");
+    int n = 0;
+    bool zeroCopy = true, kinds = true;
+    for (const asn1crt::FrameView& f : asn1crt::frames(base, p.bytes.size(), &errCode)) {
+        if (n >= GENERATED_FRAMES || f.data() != base + p.offsets[n]) zeroCopy = false;
+        if (n < GENERATED_FRAMES && f.kind() != (int)p.values[n].payload.kind) kinds = false;
+        n++;
+    }
+    check(n == GENERATED_FRAMES && errCode == 0, "Every packed frame yielded");
+    check(zeroCopy, "Views point into the caller's buffer");
+    check(kinds, "payload.kind known without decoding");
+
+    printf("\nfilter_type | decode_header | take_while:\n");
+    // Reference: the ad-hoc loop consumers write today
+    std::vector<int> expected;
+    asn1SccUint t1 = p.values[GENERATED_FRAMES * 3 / 4].header.timestamp.seconds;
+    for (int i = 0; i < GENERATED_FRAMES; i++) {
+        if (p.values[i].payload.kind != commandAck_PRESENT) continue;
+        if (p.values[i].header.timestamp.seconds >= t1) break;
+        expected.push_back(i);
+    }
+
+    std::vector<const byte*> got;
+    bool headersMatch = true;
+    for (const auto& h : asn1crt::frames(base, p.bytes.size())
+                         | asn1crt::filter_type(commandAck_PRESENT)
+                         | asn1crt::decode_header()
+                         | std::views::take_while([&](const asn1crt::HeaderFrame& h) {
+                               return h.ok && h.header.timestamp.seconds < t1;
+                           })) {
+        size_t i = got.size();
+        if (i >= expected.size() || !same_header(h.header, p.values[expected[i]].header)) headersMatch = false;
+        got.push_back(h.frame.data());
+    }
+    bool sameFrames = got.size() == expected.size();
+    for (size_t i = 0; sameFrames && i < got.size(); i++) {
+        sameFrames = got[i] == base + p.offsets[expected[i]];
+    }
+    check(!expected.empty() && sameFrames, "Same frames as the hand-written loop");
+    check(headersMatch, "Headers equal the encoded values");
+
+    // A stage's function runs once per element even though take_while and the loop both read it
+    int calls = 0;
+    auto counted = [&calls](const asn1crt::FrameView& f) {
+        calls++;
+        return f.size();
+    };
+    int seen = 0;
+    for (int size : asn1crt::frames(base, p.bytes.size())
+                    | asn1crt::decode_closure<decltype(counted)>{ counted }
+                    | std::views::take_while([](int size) { return size > 0; })) {
+        seen += size > 0;
+    }
+    check(seen == GENERATED_FRAMES && calls == GENERATED_FRAMES, "Stage output cached per element");
+
+    printf("\ndecode():\n");
+    bool decoded = true;
+    n = 0;
+    for (const auto& d : asn1crt::frames(base, p.bytes.size())
+                         | asn1crt::filter_type(science_PRESENT)
+                         | asn1crt::decode()) {
+        while (n < GENERATED_FRAMES && p.values[n].payload.kind != science_PRESENT) n++;
+        const T_ScienceData& want = p.values[n].payload.u.science;
+        const T_ScienceData& have = d.value.payload.u.science;
+        if (!d.ok || have.dataBlocks.nCount != want.dataBlocks.nCount ||
+            have.dataBlocks.arr[0].nCount != want.dataBlocks.arr[0].nCount ||
+            memcmp(have.dataBlocks.arr[0].arr, want.dataBlocks.arr[0].arr, want.dataBlocks.arr[0].nCount) != 0) {
+            decoded = false;
+        }
+        n++;
+    }
+    check(decoded, "Science frames decode like T_TelemetryFrame_Decode");
+
+    printf("\nStreamContext:\n");
+    StreamContext ctx;
+    StreamContext_Init(&ctx);
+    int cut1 = p.offsets[500], cut2 = p.offsets[1200];
+    StreamContext_AddFragment(&ctx, p.bytes.data(), cut1);
+    StreamContext_AddFragment(&ctx, p.bytes.data() + cut1, cut2 - cut1);
+    StreamContext_AddFragment(&ctx, p.bytes.data() + cut2, p.bytes.size() - cut2);
+    n = 0;
+    bool ordered = true;
+    for (const auto& f : asn1crt::frames(ctx, &errCode)) {
+        if (f.data() != base + p.offsets[n]) ordered = false;
+        n++;
+    }
+    check(n == GENERATED_FRAMES && ordered && errCode == 0, "Fragments walked in order");
+
+    printf("\nMalformed data:\n");
+    size_t truncated = p.bytes.size() - 3;
+    n = 0;
+    for (const auto& f : asn1crt::frames(base, truncated, &errCode)) {
+        (void)f;
+        n++;
+    }
+    check(n == GENERATED_FRAMES - 1 && errCode != 0, "Truncated last frame ends the range with an error");
+
+    return test_report("Frame ranges");
+}
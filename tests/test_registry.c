@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_registry.h"
+#include "satellite.h"
+#include "beacon.h"
+#include "test_util.h"
+
+#define FRAMES 3000
+
+/* Two schemas from the satellite module: full frames, and header-only for
+ * sources whose payloads this process ignores; a third from the beacon
+ * module */
+SCHEMA_DECODER(T_TelemetryFrame)
+SCHEMA_DECODER(T_FrameHeader)
+SCHEMA_DECODER(T_BeaconFrame)
+
+typedef struct {
+    unsigned long seen;
+    unsigned long kinds[4];
+    unsigned int lastSource;
+} Tally;
+
+static void count_frame(int schemaId, unsigned int sourceId, const void* value, void* userData) {
+    const T_TelemetryFrame* frame = (const T_TelemetryFrame*)value;
+    Tally* tally = (Tally*)userData;
+
+    tally->seen++;
+    tally->kinds[frame->payload.kind & 3]++;
+    tally->lastSource = sourceId;
+}
+
+static void count_beacon(int schemaId, unsigned int sourceId, const void* value, void* userData) {
+    const T_BeaconFrame* beacon = (const T_BeaconFrame*)value;
+    Tally* tally = (Tally*)userData;
+
+    tally->seen++;
+    tally->kinds[beacon->stationId & 3]++;
+    tally->lastSource = sourceId;
+}
+
+static void count_header(int schemaId, unsigned int sourceId, const void* value, void* userData) {
+    Tally* tally = (Tally*)userData;
+
+    tally->seen++;
+    tally->lastSource = sourceId;
+}
+
+int main() {
+    SchemaRegistry* reg = (SchemaRegistry*)malloc(sizeof(SchemaRegistry));
+    Tally frames = {0}, headers = {0}, beacons = {0};
+    SchemaDesc frameDesc = SCHEMA_DESC(T_TelemetryFrame, "satellite", count_frame, &frames);
+    SchemaDesc headerDesc = SCHEMA_DESC(T_FrameHeader, "header-only", count_header, &headers);
+    SchemaDesc beaconDesc = SCHEMA_DESC(T_BeaconFrame, "beacon", count_beacon, &beacons);
+    int frameId, headerId, beaconId;
+    int errCode = 0;
+
+    printf("===== Schema Registry Test =====\n");
+    SchemaRegistry_Init(reg);
+
+    printf("\nRegistration:\n");
+    size_t poolSize = SchemaRegistry_PoolBytes(&frameDesc, 4096) + SchemaRegistry_PoolBytes(&headerDesc, 0) +
+                      SchemaRegistry_PoolBytes(&beaconDesc, 0);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    check(SchemaRegistry_Add(reg, &frameDesc, &pool, 4096, &frameId, &errCode) &&
+          SchemaRegistry_Add(reg, &headerDesc, &pool, 0, &headerId, &errCode) &&
+          SchemaRegistry_Add(reg, &beaconDesc, &pool, 0, &beaconId, &errCode) && frameId == 0 && headerId == 1 &&
+          beaconId == 2, "Three schemas fit in SchemaRegistry_PoolBytes");
+    MemPool* own = SchemaRegistry_Pool(reg, frameId);
+    check(own != NULL && own->size == 4096 && MemPool_Alloc(own, 4096) != NULL && MemPool_Alloc(own, 4) == NULL,
+          "Each schema gets its own pool");
+
+    // Source 1 is fully decoded, source 2 only in headers, source 3 only for frameType 0,
+    // source 5 is a ground station sending beacons
+    check(SchemaRegistry_RouteSource(reg, frameId, 1, &errCode) &&
+          SchemaRegistry_RouteSource(reg, headerId, 2, &errCode) &&
+          SchemaRegistry_Route(reg, frameId, 3, 0, &errCode) &&
+          SchemaRegistry_RouteSource(reg, beaconId, 5, &errCode), "Routes installed");
+    check(SchemaRegistry_Lookup(reg, 1, 200) == frameId && SchemaRegistry_Lookup(reg, 2, 0) == headerId &&
+          SchemaRegistry_Lookup(reg, 3, 1) == -1 && SchemaRegistry_Lookup(reg, 4, 0) == -1,
+          "Lookup is one table read per key");
+
+    printf("\nDispatch:\n");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    static unsigned int frameCounts[256];
+    static byte encoded[FRAMES][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    static const byte* bufs[FRAMES];
+    static int lengths[FRAMES];
+    unsigned long kinds[4] = {0}, type0 = 0, bytes = 0;
+    T_TelemetryFrame frame;
+
+    CorpusMix_Default(&mix);
+    mix.seed = 39;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    for (int i = 0; i < FRAMES; i++) {
+        BitStream bs;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        BitStream_Init(&bs, encoded[i], sizeof(encoded[i]));
+        T_TelemetryFrame_Encode(&frame, &bs, &errCode, TRUE);
+        bufs[i] = encoded[i];
+        lengths[i] = BitStream_GetLength(&bs);
+        kinds[frame.payload.kind & 3]++;
+        type0 += frame.header.frameType == 0;
+        bytes += (unsigned long)lengths[i];
+    }
+
+    int decoded = SchemaRegistry_DispatchBatch(reg, 1, bufs, lengths, FRAMES);
+    const SchemaStats* stats = SchemaRegistry_Stats(reg, frameId);
+    check(decoded == FRAMES && frames.seen == FRAMES && frames.lastSource == 1, "Source 1 reaches the frame handler");
+    check(memcmp(frames.kinds, kinds, sizeof(kinds)) == 0, "Handler sees the decoded payloads");
+    check(stats->frames == FRAMES && stats->bytes == bytes && stats->errors == 0, "Per-schema frame and byte counts");
+
+    decoded = SchemaRegistry_DispatchBatch(reg, 2, bufs, lengths, FRAMES);
+    check(decoded == FRAMES && headers.seen == FRAMES && headers.lastSource == 2 &&
+          SchemaRegistry_Stats(reg, headerId)->frames == FRAMES && stats->frames == FRAMES,
+          "Source 2 reaches the header schema only");
+
+    decoded = SchemaRegistry_DispatchBatch(reg, 3, bufs, lengths, FRAMES);
+    check((unsigned long)decoded == type0 && reg->unrouted == FRAMES - type0, "Source 3 routed by frameType");
+
+    // Beacons share the header prefix, so frameType is read at the same bit offset
+    static byte beaconBufs[FRAMES][T_BeaconFrame_REQUIRED_BYTES_FOR_ENCODING];
+    static const byte* beaconPtrs[FRAMES];
+    static int beaconLengths[FRAMES];
+    unsigned long stations[4] = {0};
+    for (int i = 0; i < FRAMES; i++) {
+        BitStream bs;
+        T_BeaconFrame beacon;
+        T_BeaconFrame_Initialize(&beacon);
+        beacon.seconds = 1000000u + (unsigned int)i;
+        beacon.subseconds = (unsigned int)(i % 1001);
+        beacon.frameType = (unsigned int)(i % 256);
+        beacon.stationId = (unsigned int)(i * 7 % 65536);
+        beacon.rssi = -(i % 151);
+        BitStream_Init(&bs, beaconBufs[i], sizeof(beaconBufs[i]));
+        T_BeaconFrame_Encode(&beacon, &bs, &errCode, TRUE);
+        beaconPtrs[i] = beaconBufs[i];
+        beaconLengths[i] = BitStream_GetLength(&bs);
+        stations[beacon.stationId & 3]++;
+    }
+    unsigned long satellite = frames.seen + headers.seen;
+    decoded = SchemaRegistry_DispatchBatch(reg, 5, beaconPtrs, beaconLengths, FRAMES);
+    check(decoded == FRAMES && beacons.seen == FRAMES && beacons.lastSource == 5 &&
+          memcmp(beacons.kinds, stations, sizeof(stations)) == 0 && frames.seen + headers.seen == satellite,
+          "Source 5 reaches the beacon module's schema");
+
+    printf("\nErrors:\n");
+    check(!SchemaRegistry_Dispatch(reg, 9, bufs[0], lengths[0], &errCode) && errCode == ERR_REGISTRY_UNROUTED,
+          "Unknown source reports ERR_REGISTRY_UNROUTED");
+    check(!SchemaRegistry_Dispatch(reg, 1, bufs[0], 5, &errCode) && errCode == ERR_REGISTRY_SHORT &&
+          reg->shortFrames == 1, "Truncated frame reports ERR_REGISTRY_SHORT");
+    unsigned long before = stats->frames;
+    check(!SchemaRegistry_Dispatch(reg, 1, bufs[0], 9, &errCode) && stats->errors == 1 &&
+          stats->lastErrCode == errCode && stats->frames == before, "Decoder failure counted against its schema");
+    check(!SchemaRegistry_Route(reg, 7, 1, 0, &errCode) && errCode == ERR_REGISTRY_SCHEMA,
+          "Route to unknown schema rejected");
+    // 257 would alias source 1 in the 16-bit key
+    check(!SchemaRegistry_Route(reg, headerId, 257, 0, &errCode) && errCode == ERR_REGISTRY_SOURCE &&
+          !SchemaRegistry_RouteSource(reg, headerId, 257, &errCode) && errCode == ERR_REGISTRY_SOURCE &&
+          SchemaRegistry_Lookup(reg, 1, 0) == frameId && SchemaRegistry_Lookup(reg, 257, 0) == -1,
+          "Source above 255 rejected, source 1 untouched");
+    before = frames.seen;
+    check(!SchemaRegistry_Dispatch(reg, 257, bufs[0], lengths[0], &errCode) && errCode == ERR_REGISTRY_SOURCE &&
+          frames.seen == before, "Dispatch from source above 255 rejected");
+    check(!SchemaRegistry_Add(reg, &frameDesc, &pool, 0, &frameId, &errCode) && errCode == ERR_REGISTRY_POOL,
+          "Exhausted parent pool reported");
+
+    free(poolBuffer);
+    free(reg);
+
+    return test_report("Schema registry");
+}
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_sched.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define SCIENCE_FRAMES 4000
+#define ACK_EVERY      16
+#define SCIENCE_WORK_NS 100000ULL
+
+/* Science frames stand in for an expensive downstream step */
+static void handle_frame(unsigned int sourceId, const T_TelemetryFrame* frame, void* userData) {
+    unsigned long* emitted = (unsigned long*)userData;
+
+    if (frame->payload.kind == science_PRESENT) {
+        unsigned long long until = now_ns() + SCIENCE_WORK_NS;
+        while (now_ns() < until) {
+        }
+    }
+    __atomic_add_fetch(&emitted[frame->payload.kind & 3], 1, __ATOMIC_RELAXED);
+}
+
+static byte science[64][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+static int scienceLength[64];
+static byte ack[64][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+static int ackLength[64];
+
+/* Encode 64 frames of one kind into bufs */
+static void make_frames(int hk, int sci, int acks, byte bufs[][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING],
+                        int* lengths) {
+    CorpusMix mix;
+    CorpusGenerator gen;
+    static unsigned int frameCounts[256];
+    T_TelemetryFrame frame;
+    int errCode;
+
+    CorpusMix_Default(&mix);
+    mix.seed = 40;
+    mix.housekeepingWeight = hk;
+    mix.scienceWeight = sci;
+    mix.commandAckWeight = acks;
+    mix.minBlocks = 4;
+    mix.minBlockBytes = 200;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    for (int i = 0; i < 64; i++) {
+        BitStream bs;
+        CorpusGenerator_Next(&gen, &mix, &frame);
+        BitStream_Init(&bs, bufs[i], T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING);
+        T_TelemetryFrame_Encode(&frame, &bs, &errCode, TRUE);
+        lengths[i] = BitStream_GetLength(&bs);
+    }
+}
+
+/* Science dump with acks sprinkled in; returns the final stats */
+static void run_dump(const SchedConfig* cfg, SchedStats* stats, unsigned long* emitted) {
+    Scheduler* sched = (Scheduler*)malloc(sizeof(Scheduler));
+    size_t poolSize = Scheduler_PoolBytes(cfg);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    int submitted = 1;
+
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    memset(emitted, 0, sizeof(unsigned long) * 4);
+    if (!Scheduler_Start(sched, cfg, &pool, handle_frame, emitted)) {
+        memset(stats, 0, sizeof(SchedStats));
+        free(poolBuffer);
+        free(sched);
+        return;
+    }
+    for (int i = 0; i < SCIENCE_FRAMES && submitted; i++) {
+        submitted = Scheduler_Submit(sched, 1, science[i % 64], scienceLength[i % 64]);
+        if (i % ACK_EVERY == 0) {
+            submitted = submitted && Scheduler_Submit(sched, 2, ack[i % 64], ackLength[i % 64]);
+        }
+    }
+    Scheduler_Stop(sched, stats);
+    free(poolBuffer);
+    free(sched);
+}
+
+static void report(const char* label, const SchedStats* stats) {
+    printf("  %s: ack p50 %llu us p99 %llu us, science p50 %llu us p99 %llu us\n", label,
+           LatencyHistogram_ValueAt(&stats->delayNs[commandAck_PRESENT], 50) / 1000,
+           LatencyHistogram_ValueAt(&stats->delayNs[commandAck_PRESENT], 99) / 1000,
+           LatencyHistogram_ValueAt(&stats->delayNs[science_PRESENT], 50) / 1000,
+           LatencyHistogram_ValueAt(&stats->delayNs[science_PRESENT], 99) / 1000);
+}
+
+int main() {
+    SchedConfig cfg;
+    SchedStats stats;
+    unsigned long emitted[4];
+    const unsigned long acks = (SCIENCE_FRAMES + ACK_EVERY - 1) / ACK_EVERY;
+
+    printf("===== Priority Scheduler Test =====\n");
+    make_frames(0, 1, 0, science, scienceLength);
+    make_frames(0, 0, 1, ack, ackLength);
+
+    printf("\nClassification:\n");
+    static byte hk[64][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    static int hkLength[64];
+    make_frames(1, 0, 0, hk, hkLength);
+    int classified = 1;
+    for (int i = 0; i < 64; i++) {
+        classified = classified && Scheduler_Classify(hk[i], hkLength[i]) == housekeeping_PRESENT &&
+                     Scheduler_Classify(science[i], scienceLength[i]) == science_PRESENT &&
+                     Scheduler_Classify(ack[i], ackLength[i]) == commandAck_PRESENT;
+    }
+    check(classified, "CHOICE index peeked without decoding");
+    check(Scheduler_Classify(ack[0], 8) == 0, "Frame shorter than the index is unclassified");
+    check(ackLength[0] <= SCHED_ACK_SLOT_BYTES, "Every CommandAck fits an ack slot");
+
+    printf("\nScience dump, one dedicated ack worker:\n");
+    SchedConfig_Default(&cfg);
+    cfg.workers = 2;
+    cfg.ackWorkers = 1;
+    cfg.bulkDepth = 256;
+    run_dump(&cfg, &stats, emitted);
+    report("dedicated", &stats);
+    check(stats.decoded == SCIENCE_FRAMES + acks && stats.decodeErrors == 0 &&
+          emitted[science_PRESENT] == SCIENCE_FRAMES && emitted[commandAck_PRESENT] == acks,
+          "Every frame decoded and emitted");
+    check(stats.submitted[commandAck_PRESENT] == acks && stats.delayNs[commandAck_PRESENT].total == acks,
+          "Ack delay recorded per frame");
+    check(LatencyHistogram_ValueAt(&stats.delayNs[commandAck_PRESENT], 99) * 20 <
+          LatencyHistogram_ValueAt(&stats.delayNs[science_PRESENT], 99), "Ack p99 delay far below science p99");
+
+    printf("\nScience dump, shared workers only:\n");
+    cfg.ackWorkers = 0;
+    run_dump(&cfg, &stats, emitted);
+    report("preemptive", &stats);
+    check(stats.decoded == SCIENCE_FRAMES + acks && emitted[commandAck_PRESENT] == acks,
+          "Every frame decoded and emitted");
+    check(stats.preemptions > 0, "Acks overtake queued science frames");
+    check(LatencyHistogram_ValueAt(&stats.delayNs[commandAck_PRESENT], 99) * 5 <
+          LatencyHistogram_ValueAt(&stats.delayNs[science_PRESENT], 99), "Ack p99 delay below science p99");
+
+    printf("\nErrors:\n");
+    Scheduler* sched = (Scheduler*)malloc(sizeof(Scheduler));
+    MemPool pool;
+    byte small[256];
+    MemPool_Init(&pool, small, sizeof(small));
+    check(!Scheduler_Start(sched, &cfg, &pool, handle_frame, emitted), "Pool smaller than Scheduler_PoolBytes rejected");
+    cfg.workers = 0;
+    check(!Scheduler_Start(sched, &cfg, &pool, handle_frame, emitted), "Zero shared workers rejected");
+    free(sched);
+
+    return test_report("Priority scheduler");
+}
@@ -0,0 +1,335 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_shmring.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define SLOTS        256
+#define PRODUCERS    2
+#define CONSUMERS    3
+#define FRAMES       20000  /* Per producer */
+#define BENCH_FRAMES 200000
+#define BENCH_DISTINCT 2000
+
+/* Producer p's stream: corpus frames stamped with p and their index, so a
+ * consumer can regenerate each one and check order per producer */
+typedef struct {
+    CorpusMix mix;
+    CorpusGenerator gen;
+    unsigned int frameCounts[256];
+    int producer;
+    int next;
+} Stream;
+
+static void stream_init(Stream* s, int producer) {
+    memset(s, 0, sizeof(Stream));
+    CorpusMix_Default(&s->mix);
+    s->mix.seed = 43 + (unsigned int)producer;
+    CorpusGenerator_Init(&s->gen, &s->mix, s->frameCounts);
+    s->producer = producer;
+}
+
+static void stream_next(Stream* s, T_TelemetryFrame* frame) {
+    CorpusGenerator_Next(&s->gen, &s->mix, frame);
+    frame->header.timestamp.seconds = (asn1SccUint)s->producer;
+    frame->header.frameCount = (asn1SccUint)(s->next++ & 0xFFFF);
+}
+
+static int encode(const T_TelemetryFrame* frame, byte* buf) {
+    BitStream bs;
+    int errCode;
+
+    BitStream_Init(&bs, buf, T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING);
+    T_TelemetryFrame_Encode(frame, &bs, &errCode, TRUE);
+    return BitStream_GetLength(&bs);
+}
+
+static int same_frame(const T_TelemetryFrame* a, const T_TelemetryFrame* b) {
+    static byte ea[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING], eb[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    int length = encode(a, ea);
+    return length == encode(b, eb) && memcmp(ea, eb, (size_t)length) == 0;
+}
+
+/* Publish frames [from, to) of producer's stream */
+static void produce(ShmRing* ring, int producer, int from, int to) {
+    Stream s;
+    T_TelemetryFrame frame;
+    byte buf[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    int errCode;
+
+    stream_init(&s, producer);
+    for (int i = 0; i < to; i++) {
+        BitStream bs;
+        stream_next(&s, &frame);
+        if (i < from) continue;
+        BitStream_AttachBuffer(&bs, buf, encode(&frame, buf));
+        ShmRing_Decode(ring, &bs, SHMRING_WAIT_FOREVER, &errCode);
+    }
+}
+
+/* Child consumer: read every frame in place and regenerate it from its
+ * producer's stream. Exit status 0 when all PRODUCERS * FRAMES matched. */
+static int consume(ShmRing* ring, int consumerId, int slow) {
+    static Stream streams[PRODUCERS];
+    T_TelemetryFrame expected;
+    int seen = 0, empty = 0, idle = 0;
+
+    for (int p = 0; p < PRODUCERS; p++) stream_init(&streams[p], p);
+    while (seen < PRODUCERS * FRAMES && idle < 10) {
+        int ready = ShmRing_Poll(ring, consumerId, 1000);
+        idle = ready == 0 ? idle + 1 : 0;
+        for (int i = 0; i < ready; i++) {
+            int length;
+            const T_TelemetryFrame* f = (const T_TelemetryFrame*)ShmRing_Peek(ring, consumerId, i, &length);
+            if (length == 0) {
+                empty++;
+                continue;
+            }
+            int p = (int)f->header.timestamp.seconds;
+            if (length != (int)sizeof(T_TelemetryFrame) || p < 0 || p >= PRODUCERS) return 2;
+            stream_next(&streams[p], &expected);
+            if (!same_frame(f, &expected)) return 3;
+            seen++;
+        }
+        ShmRing_Release(ring, consumerId, ready);
+        if (slow && seen % 1000 < ready) usleep(2000);
+    }
+    return seen == PRODUCERS * FRAMES && empty == 1 ? 0 : 4;
+}
+
+static int read_full(int fd, byte* buf, int length) {
+    int got = 0;
+    while (got < length) {
+        ssize_t n = read(fd, buf + got, (size_t)(length - got));
+        if (n <= 0) return 0;
+        got += (int)n;
+    }
+    return 1;
+}
+
+/* ns per frame through a ring to a reader process, either decoding each
+ * frame into its slot or copying one already decoded; -1 if frames went missing */
+static double ring_bench(const ShmRingConfig* cfg, byte (*encoded)[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING],
+                         const int* lengths, int decode) {
+    static T_TelemetryFrame decoded[BENCH_DISTINCT];
+    ShmRing ring;
+    int consumerId, errCode, status, length;
+
+    for (int i = 0; i < BENCH_DISTINCT; i++) {
+        BitStream bs;
+        BitStream_AttachBuffer(&bs, encoded[i], lengths[i]);
+        T_TelemetryFrame_Decode(&decoded[i], &bs, &errCode);
+    }
+    ShmRing_Create(&ring, "asn1crt-bench", cfg, &errCode);
+    ShmRing_Join(&ring, &consumerId, &errCode);
+    unsigned long long start = now_ns();
+    pid_t reader = fork();
+    if (reader == 0) {
+        unsigned long sum = 0;
+        int seen = 0;
+        while (seen < BENCH_FRAMES) {
+            int ready = ShmRing_Poll(&ring, consumerId, SHMRING_WAIT_FOREVER);
+            for (int i = 0; i < ready; i++) {
+                sum += ((const T_TelemetryFrame*)ShmRing_Peek(&ring, consumerId, i, &length))->header.frameCount;
+            }
+            ShmRing_Release(&ring, consumerId, ready);
+            seen += ready;
+        }
+        _exit(sum > 0 ? 0 : 1);
+    }
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        if (decode) {
+            BitStream bs;
+            BitStream_AttachBuffer(&bs, encoded[i % BENCH_DISTINCT], lengths[i % BENCH_DISTINCT]);
+            ShmRing_Decode(&ring, &bs, SHMRING_WAIT_FOREVER, &errCode);
+        } else {
+            unsigned long long seq;
+            byte* slot = ShmRing_Claim(&ring, SHMRING_WAIT_FOREVER, &seq, &errCode);
+            memcpy(slot, &decoded[i % BENCH_DISTINCT], sizeof(T_TelemetryFrame));
+            ShmRing_Publish(&ring, seq, (int)sizeof(T_TelemetryFrame), &errCode);
+        }
+    }
+    waitpid(reader, &status, 0);
+    double ns = (double)(now_ns() - start) / BENCH_FRAMES;
+    ShmRing_Close(&ring);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? ns : -1;
+}
+
+int main() {
+    ShmRing ring, attached;
+    ShmRingConfig cfg;
+    ShmRingStats stats;
+    pid_t children[CONSUMERS + PRODUCERS];
+    int ids[SHMRING_MAX_CONSUMERS];
+    int errCode = 0, status;
+
+    printf("===== Shared-Memory Ring Test =====\n");
+    ShmRingConfig_Default(&cfg);
+    cfg.slotCount = SLOTS;
+
+    printf("\nSingle process:\n");
+    check(ShmRing_Create(&ring, "asn1crt-test", &cfg, &errCode), "Ring created in a memfd");
+    check(ShmRing_Attach(&attached, ring.fd, &errCode), "Second mapping attaches through the fd");
+    int devNull = open("/dev/null", O_RDWR);
+    ShmRing bogus;
+    check(!ShmRing_Attach(&bogus, devNull, &errCode) && errCode == ERR_SHMRING_LAYOUT,
+          "Non-ring fd rejected with ERR_SHMRING_LAYOUT");
+    close(devNull);
+    ring.header->slotStride += 64;
+    check(!ShmRing_Attach(&bogus, ring.fd, &errCode) && errCode == ERR_SHMRING_LAYOUT,
+          "Header with a forged stride rejected");
+    ring.header->slotStride -= 64;
+
+    unsigned long long seq;
+    byte* slot = ShmRing_Claim(&ring, 0, &seq, &errCode);
+    memcpy(slot, "hello", 5);
+    ShmRing_Publish(&ring, seq, 5, &errCode);
+    ShmRing_Snapshot(&ring, &stats);
+    check(stats.claimed == 1 && stats.consumers == 0, "Without consumers slots are overwritten freely");
+
+    // One producer stalls mid-fill; the others must not lap its slot
+    unsigned long long held;
+    ShmRing_Claim(&ring, 0, &held, &errCode);
+    for (int i = 1; i < SLOTS; i++) {
+        ShmRing_Claim(&ring, 0, &seq, &errCode);
+        ShmRing_Publish(&ring, seq, 1, &errCode);
+    }
+    check(ShmRing_Claim(&ring, 0, &seq, &errCode) == NULL && errCode == ERR_SHMRING_FULL,
+          "Unpublished slot stops producers lapping it");
+    ShmRing_Publish(&ring, held, 1, &errCode);
+    check(ShmRing_Claim(&ring, 0, &seq, &errCode) != NULL && seq == held + SLOTS,
+          "Publishing it lets the next lap through");
+    ShmRing_Publish(&ring, seq, 1, &errCode);
+
+    check(ShmRing_Join(&attached, &ids[0], &errCode) && ShmRing_Poll(&attached, ids[0], 10) == 0,
+          "New consumer starts at the next claim");
+    for (int i = 0; i < SLOTS; i++) {
+        slot = ShmRing_Claim(&ring, 0, &seq, &errCode);
+        slot[0] = (byte)i;
+        ShmRing_Publish(&ring, seq, 1, &errCode);
+    }
+    check(ShmRing_Claim(&ring, 0, &seq, &errCode) == NULL && errCode == ERR_SHMRING_FULL,
+          "Lagging consumer fills the ring: ERR_SHMRING_FULL");
+    int length;
+    const byte* in = ShmRing_Peek(&attached, ids[0], 7, &length);
+    check(ShmRing_Poll(&attached, ids[0], 0) == SHMRING_POLL_MAX && length == 1 && in[0] == 7,
+          "Other mapping reads the slots in place");
+    ShmRing_Release(&attached, ids[0], SHMRING_POLL_MAX);
+    check(ShmRing_Claim(&ring, 0, &seq, &errCode) != NULL, "Release frees slots for producers");
+    check(!ShmRing_Publish(&ring, seq, SLOTS * (int)sizeof(T_TelemetryFrame), &errCode) &&
+          errCode == ERR_SHMRING_LENGTH, "Oversized publish rejected");
+
+    int joined = 1;
+    while (ShmRing_Join(&ring, &ids[joined], &errCode)) joined++;
+    check(joined == SHMRING_MAX_CONSUMERS && errCode == ERR_SHMRING_CONSUMERS,
+          "Ninth consumer gets ERR_SHMRING_CONSUMERS");
+    for (int i = 0; i < joined; i++) ShmRing_Leave(&ring, ids[i]);
+    ShmRing_Close(&attached);
+    ShmRing_Close(&ring);
+
+    printf("\nProcesses (%d producers, %d consumers):\n", PRODUCERS, CONSUMERS);
+    ShmRing_Create(&ring, "asn1crt-test", &cfg, &errCode);
+    for (int c = 0; c < CONSUMERS; c++) {
+        // Joined before any producer starts, so no consumer misses a frame
+        ShmRing_Join(&ring, &ids[c], &errCode);
+    }
+    for (int c = 0; c < CONSUMERS; c++) {
+        children[c] = fork();
+        if (children[c] == 0) {
+            // Consumer 0 uses the inherited mapping, the others map the fd again
+            if (c > 0 && !ShmRing_Attach(&attached, ring.fd, &errCode)) _exit(1);
+            _exit(consume(c > 0 ? &attached : &ring, ids[c], c == CONSUMERS - 1));
+        }
+    }
+    for (int p = 1; p < PRODUCERS; p++) {
+        children[CONSUMERS + p - 1] = fork();
+        if (children[CONSUMERS + p - 1] == 0) {
+            produce(&ring, p, 0, FRAMES);
+            _exit(0);
+        }
+    }
+    produce(&ring, 0, 0, FRAMES / 2);
+    // A frame that does not decode is published empty; consumers skip it
+    byte junk[2] = { 0xFF, 0xFF };
+    BitStream bs;
+    BitStream_AttachBuffer(&bs, junk, sizeof(junk));
+    check(!ShmRing_Decode(&ring, &bs, SHMRING_WAIT_FOREVER, &errCode), "Undecodable frame reported");
+    produce(&ring, 0, FRAMES / 2, FRAMES);
+
+    int consumersOk = 1, producersOk = 1;
+    for (int c = 0; c < CONSUMERS; c++) {
+        consumersOk = consumersOk && waitpid(children[c], &status, 0) == children[c] && WIFEXITED(status) &&
+                      WEXITSTATUS(status) == 0;
+    }
+    for (int p = 1; p < PRODUCERS; p++) {
+        producersOk = producersOk && waitpid(children[CONSUMERS + p - 1], &status, 0) > 0 &&
+                      WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    ShmRing_Snapshot(&ring, &stats);
+    check(producersOk && stats.claimed == PRODUCERS * FRAMES + 1, "Every producer claim accounted for");
+    check(consumersOk, "Each consumer saw every frame, in producer order");
+    check(stats.maxLag == 0, "All cursors caught up");
+    printf("  Producer waits %llu, consumer waits %llu\n", stats.producerWaits, stats.consumerWaits);
+    ShmRing_Close(&ring);
+
+    printf("\nThroughput (decode, hand over, read one field):\n");
+    static byte encoded[BENCH_DISTINCT][T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+    static int lengths[BENCH_DISTINCT];
+    Stream bench;
+    stream_init(&bench, 0);
+    for (int i = 0; i < BENCH_DISTINCT; i++) {
+        T_TelemetryFrame frame;
+        stream_next(&bench, &frame);
+        lengths[i] = encode(&frame, encoded[i]);
+    }
+
+    double ringNs = ring_bench(&cfg, encoded, lengths, TRUE);
+    double handoverNs = ring_bench(&cfg, encoded, lengths, FALSE);
+    check(ringNs > 0 && handoverNs > 0, "Ring reader received every frame");
+
+    // Baseline: the producer re-serializes and every frame crosses a pipe
+    int pipefd[2];
+    if (pipe(pipefd) != 0) return 1;
+    unsigned long long start = now_ns();
+    pid_t reader = fork();
+    if (reader == 0) {
+        byte buf[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+        T_TelemetryFrame frame;
+        unsigned long sum = 0;
+        close(pipefd[1]);
+        for (int i = 0; i < BENCH_FRAMES; i++) {
+            byte prefix[2];
+            if (!read_full(pipefd[0], prefix, 2) || !read_full(pipefd[0], buf, prefix[0] | prefix[1] << 8)) _exit(1);
+            BitStream_AttachBuffer(&bs, buf, prefix[0] | prefix[1] << 8);
+            T_TelemetryFrame_Decode(&frame, &bs, &errCode);
+            sum += frame.header.frameCount;
+        }
+        _exit(sum > 0 ? 0 : 1);
+    }
+    close(pipefd[0]);
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        T_TelemetryFrame frame;
+        byte out[T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING + 2];
+        BitStream_AttachBuffer(&bs, encoded[i % (BENCH_DISTINCT)], lengths[i % (BENCH_DISTINCT)]);
+        T_TelemetryFrame_Decode(&frame, &bs, &errCode);
+        int n = encode(&frame, out + 2);
+        out[0] = (byte)n;
+        out[1] = (byte)(n >> 8);
+        if (write(pipefd[1], out, (size_t)n + 2) != n + 2) break;
+    }
+    close(pipefd[1]);
+    waitpid(reader, &status, 0);
+    double pipeNs = (double)(now_ns() - start) / BENCH_FRAMES;
+    printf("  shared ring %.0f ns/frame (%.0f ns copying instead of decoding), re-encode + pipe %.0f ns/frame\n",
+           ringNs, handoverNs, pipeNs);
+    check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "Pipe baseline delivered every frame");
+
+    return test_report("Shared-memory ring");
+}
@@ -0,0 +1,165 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_statetable.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define SOURCES        4
+#define WRITER_UPDATES 2000000
+#define READERS        2
+#define BENCH_OPS      2000000
+
+/* Housekeeping frame whose every value follows from k, so a reader can
+ * tell a consistent snapshot from one mixing two updates */
+static void make_frame(T_TelemetryFrame* f, unsigned long k) {
+    memset(f, 0, sizeof(T_TelemetryFrame));
+    f->header.timestamp.seconds = k;
+    f->header.frameCount = k & 0xFFFF;
+    f->payload.kind = housekeeping_PRESENT;
+    f->payload.u.housekeeping.voltages.mainBus = k % 5001;
+    f->payload.u.housekeeping.voltages.payload = (k * 7) % 5001;
+    f->payload.u.housekeeping.voltages.comms = (k * 13) % 5001;
+    f->payload.u.housekeeping.temperature.nCount = 1 + (int)(k % 8);
+    for (int i = 0; i < 8; i++) {
+        f->payload.u.housekeeping.temperature.arr[i] = (asn1SccSint)((k + (unsigned long)i) % 201) - 100;
+    }
+    f->payload.u.housekeeping.status = k & 0xFF;
+}
+
+static int consistent(const StateSnapshot* s) {
+    T_TelemetryFrame expected;
+    make_frame(&expected, (unsigned long)s->header.timestamp.seconds);
+    return memcmp(&s->header, &expected.header, sizeof(T_FrameHeader)) == 0 &&
+           memcmp(&s->housekeeping, &expected.payload.u.housekeeping, sizeof(T_HousekeepingData)) == 0;
+}
+
+typedef struct {
+    StateTable* table;
+    volatile int* stop;
+    unsigned long reads;
+    unsigned long torn;
+    unsigned long backwards;
+} Reader;
+
+static void* reader_main(void* arg) {
+    Reader* r = (Reader*)arg;
+    unsigned long long last[SOURCES] = { 0 };
+    StateSnapshot snap;
+
+    while (!*r->stop) {
+        for (unsigned int s = 0; s < SOURCES; s++) {
+            if (!StateTable_Read(r->table, s, &snap)) continue;
+            r->reads++;
+            r->torn += !consistent(&snap);
+            r->backwards += snap.header.timestamp.seconds < last[s];
+            last[s] = snap.header.timestamp.seconds;
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    StateTable table;
+    StateSnapshot snap;
+    MemPool pool;
+    T_TelemetryFrame frame;
+    size_t poolSize = StateTable_PoolBytes(SOURCES);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    int errCode = 0;
+
+    printf("===== State Table Test =====\n");
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    check(StateTable_Init(&table, &pool, SOURCES, &errCode), "Table fits in StateTable_PoolBytes");
+
+    printf("\nLatest values:\n");
+    check(!StateTable_Read(&table, 1, &snap), "No snapshot before the first housekeeping frame");
+    CorpusMix mix;
+    CorpusGenerator gen;
+    static unsigned int frameCounts[256];
+    CorpusMix_Default(&mix);
+    mix.seed = 44;
+    mix.housekeepingWeight = 0;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    CorpusGenerator_Next(&gen, &mix, &frame);
+    check(StateTable_Update(&table, 1, &frame, &errCode) && !StateTable_Read(&table, 1, &snap),
+          "Science and CommandAck frames ignored");
+
+    make_frame(&frame, 100);
+    StateTable_Emit(1, &frame, &table);
+    check(StateTable_Read(&table, 1, &snap) && consistent(&snap) && snap.updates == 1 && snap.updatedNs > 0,
+          "StateTable_Emit stores the housekeeping values");
+    make_frame(&frame, 99);
+    StateTable_Update(&table, 1, &frame, &errCode);
+    check(StateTable_Read(&table, 1, &snap) && snap.header.timestamp.seconds == 100 && snap.stale == 1,
+          "Older frame counted stale, newer values kept");
+    make_frame(&frame, 101);
+    StateTable_Update(&table, 1, &frame, &errCode);
+    check(StateTable_Read(&table, 1, &snap) && snap.header.timestamp.seconds == 101 && snap.updates == 2,
+          "Newer frame replaces the values");
+    check(!StateTable_Read(&table, 0, &snap), "Sources are independent");
+    check(!StateTable_Update(&table, SOURCES, &frame, &errCode) && errCode == ERR_STATETABLE_SOURCE,
+          "sourceId outside the table rejected");
+
+    printf("\nConcurrent readers:\n");
+    volatile int stop = 0;
+    pthread_t threads[READERS];
+    Reader readers[READERS];
+    for (int i = 0; i < READERS; i++) {
+        memset(&readers[i], 0, sizeof(Reader));
+        readers[i].table = &table;
+        readers[i].stop = &stop;
+        pthread_create(&threads[i], NULL, reader_main, &readers[i]);
+    }
+    for (unsigned long k = 0; k < WRITER_UPDATES; k++) {
+        make_frame(&frame, 1000 + k);
+        StateTable_Update(&table, (unsigned int)(k % SOURCES), &frame, &errCode);
+    }
+    stop = 1;
+    unsigned long reads = 0, torn = 0, backwards = 0;
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(threads[i], NULL);
+        reads += readers[i].reads;
+        torn += readers[i].torn;
+        backwards += readers[i].backwards;
+    }
+    printf("  %lu snapshots read during %d updates\n", reads, WRITER_UPDATES);
+    check(reads > 0 && torn == 0, "Every snapshot consistent");
+    check(backwards == 0, "Snapshots never go back in time");
+    int all = 1;
+    for (unsigned int s = 0; s < SOURCES; s++) {
+        all = all && StateTable_Read(&table, s, &snap) && consistent(&snap) &&
+              snap.header.timestamp.seconds == 1000 + WRITER_UPDATES - SOURCES + s;
+    }
+    check(all, "Final snapshot is the last update of each source");
+
+    printf("\nThroughput:\n");
+    make_frame(&frame, 10000000);
+    unsigned long long start = now_ns();
+    for (unsigned long k = 0; k < BENCH_OPS; k++) {
+        frame.header.timestamp.seconds++;
+        StateTable_Update(&table, (unsigned int)(k % SOURCES), &frame, &errCode);
+    }
+    double updateNs = (double)(now_ns() - start) / BENCH_OPS;
+    unsigned long sink = 0;
+    start = now_ns();
+    for (unsigned long k = 0; k < BENCH_OPS; k++) {
+        StateTable_Read(&table, (unsigned int)(k % SOURCES), &snap);
+        sink += snap.housekeeping.status;
+    }
+    double readNs = (double)(now_ns() - start) / BENCH_OPS;
+    printf("  update %.1f ns, read %.1f ns (%lu)\n", updateNs, readNs, sink % 10);
+
+    MemPool small;
+    byte tiny[64];
+    MemPool_Init(&small, tiny, sizeof(tiny));
+    check(!StateTable_Init(&table, &small, SOURCES, &errCode) && errCode == ERR_STATETABLE_POOL,
+          "Pool smaller than StateTable_PoolBytes rejected");
+    free(poolBuffer);
+
+    return test_report("State table");
+}
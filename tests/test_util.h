@@ -0,0 +1,28 @@
+/* test_util.h - Pass/fail bookkeeping and timing shared by the unit tests */
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+#include <time.h>
+
+static int failures = 0;
+
+/* One aligned result line per condition; any FAILED fails the program */
+static inline void check(int condition, const char* what) {
+    printf("  %-52s %s\n", what, condition ? "PASSED" : "FAILED");
+    if (!condition) failures++;
+}
+
+static inline unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/* Print the "<name>: PASSED|FAILED" summary and return main's exit code */
+static inline int test_report(const char* name) {
+    printf("\n%s: %s\n", name, failures == 0 ? "PASSED" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
+
+#endif /* TEST_UTIL_H */
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_validate.h"
+#include "satellite.h"
+#include "test_util.h"
+
+#define FRAMES      4099   /* Not a multiple of VALIDATE_BLOCK */
+#define BENCH_ROUNDS 200
+
+/* Break one constraint of f, picked by choice; returns the field broken
+ * or VALIDATE_OK when the choice does not apply to this payload */
+static ValidateField corrupt(T_TelemetryFrame* f, int choice) {
+    T_HousekeepingData* hk = &f->payload.u.housekeeping;
+    T_ScienceData* sci = &f->payload.u.science;
+    int isHk = f->payload.kind == housekeeping_PRESENT;
+    int isSci = f->payload.kind == science_PRESENT;
+    int isAck = f->payload.kind == commandAck_PRESENT;
+
+    switch (choice) {
+    case 0: f->header.timestamp.seconds = 0x100000000ULL; return VALIDATE_SECONDS;
+    case 1: f->header.timestamp.subseconds = 1001; return VALIDATE_SUBSECONDS;
+    case 2: f->header.frameType = 256; return VALIDATE_FRAME_TYPE;
+    case 3: f->header.frameCount = 70000; return VALIDATE_FRAME_COUNT;
+    case 4: f->payload.kind = TelemetryPayload_NONE; return VALIDATE_KIND;
+    case 5: if (!isHk) break; hk->voltages.mainBus = 5001; return VALIDATE_MAIN_BUS;
+    case 6: if (!isHk) break; hk->voltages.comms = 0xFFFFFFFFFFULL; return VALIDATE_COMMS_BUS;
+    case 7: if (!isHk) break; hk->temperature.nCount = 9; return VALIDATE_TEMP_COUNT;
+    case 8: if (!isHk) break; hk->temperature.arr[hk->temperature.nCount - 1] = -101; return VALIDATE_TEMPERATURE;
+    case 9: if (!isHk) break; hk->status = 300; return VALIDATE_HK_STATUS;
+    case 10: if (!isSci) break; sci->instrumentId = 256; return VALIDATE_INSTRUMENT;
+    case 11: if (!isSci) break; sci->dataBlocks.nCount = 0; return VALIDATE_BLOCK_COUNT;
+    case 12: if (!isSci) break; sci->dataBlocks.arr[sci->dataBlocks.nCount - 1].nCount = 257; return VALIDATE_BLOCK_LENGTH;
+    case 13: if (!isAck) break; f->payload.u.commandAck.commandId = 65536; return VALIDATE_COMMAND_ID;
+    case 14: if (!isAck) break; f->payload.u.commandAck.status = (T_CommandAck_status)4; return VALIDATE_ACK_STATUS;
+    case 15: if (!isHk || hk->temperature.nCount == 8) break;
+        hk->temperature.arr[7] = 1000;  // Beyond nCount: not checked
+        return VALIDATE_OK;
+    }
+    return VALIDATE_OK;
+}
+
+int main() {
+    static T_TelemetryFrame frames[FRAMES];
+    static byte expected[FRAMES];
+    static byte first[FRAMES];
+    unsigned long long invalid[(FRAMES + 63) / 64];
+    CorpusMix mix;
+    CorpusGenerator gen;
+    static unsigned int frameCounts[256];
+    int errCode;
+
+    printf("===== Batch Validation Test =====\n");
+    printf("Kernel: %s\n", Validate_Kernel());
+
+    CorpusMix_Default(&mix);
+    mix.seed = 42;
+    CorpusGenerator_Init(&gen, &mix, frameCounts);
+    for (int i = 0; i < FRAMES; i++) {
+        CorpusGenerator_Next(&gen, &mix, &frames[i]);
+    }
+
+    printf("\nValid corpus:\n");
+    check(Validate_Frames(frames, FRAMES, invalid, first) == 0, "Generated frames all pass");
+    int clear = 1;
+    for (int i = 0; i < FRAMES; i++) clear = clear && first[i] == VALIDATE_OK;
+    check(clear, "firstField is VALIDATE_OK for every row");
+
+    printf("\nCorrupted rows:\n");
+    srand(42);
+    int expectInvalid = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        expected[i] = VALIDATE_OK;
+        if (rand() % 3 == 0) {
+            expected[i] = (byte)corrupt(&frames[i], rand() % 16);
+            // A second, later field must not hide the first
+            if (expected[i] != VALIDATE_OK && expected[i] < VALIDATE_KIND && rand() % 2 == 0) {
+                corrupt(&frames[i], 9 + rand() % 6);
+            }
+        }
+        expectInvalid += expected[i] != VALIDATE_OK;
+    }
+    int count = Validate_Frames(frames, FRAMES, invalid, first);
+    int agree = 1, fields = 1;
+    for (int i = 0; i < FRAMES; i++) {
+        int bit = (int)((invalid[i / 64] >> (i % 64)) & 1);
+        agree = agree && bit == !T_TelemetryFrame_IsConstraintValid(&frames[i], &errCode);
+        fields = fields && first[i] == expected[i];
+    }
+    check(count == expectInvalid && expectInvalid > FRAMES / 8, "Invalid count matches the corruption");
+    check(agree, "Bitmap agrees with T_TelemetryFrame_IsConstraintValid");
+    check(fields, "First failing field reported per row");
+    check(strcmp(Validate_FieldName(VALIDATE_TEMPERATURE), "housekeeping.temperature[i]") == 0,
+          "Field names follow the schema paths");
+
+    printf("\nThroughput:\n");
+    unsigned long long start = now_ns();
+    int sink = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < FRAMES; i++) {
+            sink += T_TelemetryFrame_IsConstraintValid(&frames[i], &errCode) ? 0 : 1;
+        }
+    }
+    double scalarNs = (double)(now_ns() - start) / ((double)BENCH_ROUNDS * FRAMES);
+    start = now_ns();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        sink += Validate_Frames(frames, FRAMES, invalid, NULL);
+    }
+    double batchNs = (double)(now_ns() - start) / ((double)BENCH_ROUNDS * FRAMES);
+    printf("  IsConstraintValid %.1f ns/frame, Validate_Frames %.1f ns/frame (%d)\n", scalarNs, batchNs,
+           sink / BENCH_ROUNDS);
+    check(sink == 2 * BENCH_ROUNDS * expectInvalid, "Both paths reject the same frames every round");
+
+    return test_report("Batch validation");
+}
@@ -0,0 +1,111 @@
+/* corpus_gen.c - Writes a seeded mixed-workload TelemetryFrame corpus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "satellite.h"
+
+// Parse "lo-hi" (or a single value) into an inclusive range
+static int parse_range(const char* text, int* lo, int* hi) {
+    if (sscanf(text, "%d-%d", lo, hi) == 2) return 1;
+    if (sscanf(text, "%d", lo) == 1) {
+        *hi = *lo;
+        return 1;
+    }
+    return 0;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s <output> [frames] [seed] [hk:sci:ack] [options]\n", prog);
+    printf("  --temperatures LO-HI   housekeeping temperature count (1-8)\n");
+    printf("  --blocks LO-HI         science dataBlocks count (1-4)\n");
+    printf("  --block-bytes LO-HI    bytes per data block (1-256)\n");
+    printf("  --sources N            distinct frameType streams (1-256)\n");
+}
+
+int main(int argc, char** argv) {
+    CorpusMix mix;
+    unsigned long frames = 100000;
+    int positional = 0;
+    const char* path = NULL;
+
+    CorpusMix_Default(&mix);
+    for (int i = 1; i < argc; i++) {
+        int ok = 1;
+        if (strcmp(argv[i], "--temperatures") == 0 && i + 1 < argc) {
+            ok = parse_range(argv[++i], &mix.minTemperatures, &mix.maxTemperatures);
+        } else if (strcmp(argv[i], "--blocks") == 0 && i + 1 < argc) {
+            ok = parse_range(argv[++i], &mix.minBlocks, &mix.maxBlocks);
+        } else if (strcmp(argv[i], "--block-bytes") == 0 && i + 1 < argc) {
+            ok = parse_range(argv[++i], &mix.minBlockBytes, &mix.maxBlockBytes);
+        } else if (strcmp(argv[i], "--sources") == 0 && i + 1 < argc) {
+            mix.sources = atoi(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            ok = 0;
+        } else if (positional == 0) {
+            path = argv[i];
+            positional++;
+        } else if (positional == 1) {
+            frames = strtoul(argv[i], NULL, 10);
+            positional++;
+        } else if (positional == 2) {
+            mix.seed = strtoull(argv[i], NULL, 10);
+            positional++;
+        } else if (positional == 3) {
+            ok = CorpusMix_ParseWeights(&mix, argv[i]);
+            positional++;
+        } else {
+            ok = 0;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (path == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("===== Telemetry Corpus Generator =====\n");
+    printf("Frames: %lu, seed: %llu, mix hk:sci:ack = %d:%d:%d, sources: %d\n", frames, mix.seed,
+           mix.housekeepingWeight, mix.scienceWeight, mix.commandAckWeight, mix.sources);
+    printf("Temperatures %d-%d, blocks %d-%d, block bytes %d-%d\n",
+           mix.minTemperatures, mix.maxTemperatures, mix.minBlocks, mix.maxBlocks,
+           mix.minBlockBytes, mix.maxBlockBytes);
+
+    int errCode = 0;
+    if (!Corpus_Write(path, &mix, (unsigned int)frames, &errCode)) {
+        printf("ERROR: Failed to write corpus %s: error %d\n", path, errCode);
+        return 1;
+    }
+
+    // Read it back so the summary reflects what is actually on disk
+    Corpus corpus;
+    if (!Corpus_Open(&corpus, path, &errCode)) {
+        printf("ERROR: Written corpus does not validate: error %d\n", errCode);
+        return 1;
+    }
+
+    unsigned long kinds[4] = { 0, 0, 0, 0 };
+    unsigned long long bytes = 0;
+    int minLength = 0, maxLength = 0;
+    for (unsigned int i = 0; i < corpus.count; i++) {
+        int length = corpus.index[i].length;
+        kinds[corpus.index[i].kind & 3]++;
+        bytes += (unsigned long long)length;
+        if (i == 0 || length < minLength) minLength = length;
+        if (length > maxLength) maxLength = length;
+    }
+
+    printf("\nWrote %s: %u frames, %zu bytes\n", path, corpus.count, corpus.size);
+    printf("  Housekeeping: %lu, science: %lu, commandAck: %lu\n",
+           kinds[housekeeping_PRESENT], kinds[science_PRESENT], kinds[commandAck_PRESENT]);
+    printf("  Encoded length: min %d, max %d, mean %.1f bytes\n", minLength, maxLength,
+           corpus.count > 0 ? (double)bytes / corpus.count : 0);
+    printf("\nReplay with: ./telemetry_benchmark --corpus %s\n", path);
+
+    Corpus_Close(&corpus);
+    return 0;
+}
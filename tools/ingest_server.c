@@ -0,0 +1,147 @@
+/* ingest_server.c - Multi-shard UDP telemetry ingest using SO_REUSEPORT */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "asn1crt.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_ingest.h"
+#include "asn1crt_latency.h"
+#include "satellite.h"
+
+#define MAX_SHARDS 64
+
+typedef struct {
+    int id;
+    IngestConfig config;
+    IngestServer server;
+    unsigned char* poolBuffer;
+    MemPool pool;
+    time_t endTime;
+    unsigned long kindCounts[4];
+    flag ok;
+} Shard;
+
+// Consume a decoded batch: just count payload kinds
+static void count_batch(const T_TelemetryFrame* frames, int count, void* userData) {
+    Shard* shard = (Shard*)userData;
+    for (int i = 0; i < count; i++) {
+        int kind = (int)frames[i].payload.kind;
+        shard->kindCounts[(kind >= 0 && kind < 4) ? kind : 0]++;
+    }
+}
+
+static void* shard_main(void* arg) {
+    Shard* shard = (Shard*)arg;
+
+    while (time(NULL) < shard->endTime) {
+        if (IngestServer_Poll(&shard->server, 100, count_batch, shard) < 0) {
+            perror("recvmmsg");
+            shard->ok = FALSE;
+            break;
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    int port = 9000;
+    int shards = 1;
+    int duration = 10;
+    IntegrityKind integrity = INTEGRITY_NONE;
+
+    if (argc > 1) port = atoi(argv[1]);
+    if (argc > 2) shards = atoi(argv[2]);
+    if (argc > 3) duration = atoi(argv[3]);
+    if (argc > 4) {
+        if (strcmp(argv[4], "crc16") == 0) integrity = INTEGRITY_CRC16_CCSDS;
+        else if (strcmp(argv[4], "crc32c") == 0) integrity = INTEGRITY_CRC32C;
+    }
+    if (shards <= 0 || shards > MAX_SHARDS) {
+        printf("Invalid shard count. Using 1\n");
+        shards = 1;
+    }
+
+    // ASN1CRT_LATENCY=1 records decode latency and prints it in Prometheus format at exit
+    Latency_InitFromEnv();
+
+    printf("===== UDP Telemetry Ingest Server =====\n");
+    printf("Port: %d, shards: %d, duration: %d seconds\n", port, shards, duration);
+
+    static Shard shardState[MAX_SHARDS];
+    pthread_t threads[MAX_SHARDS];
+    time_t endTime = time(NULL) + duration;
+
+    // Every shard binds its own socket to the same port; the kernel hashes flows across them
+    for (int s = 0; s < shards; s++) {
+        Shard* shard = &shardState[s];
+        shard->id = s;
+        shard->endTime = endTime;
+        shard->ok = TRUE;
+
+        IngestConfig_Default(&shard->config);
+        shard->config.port = (unsigned short)port;
+        shard->config.reusePort = TRUE;
+        shard->config.recvBufferBytes = 8 * 1024 * 1024;
+        shard->config.integrity = integrity;
+
+        size_t poolSize = IngestServer_PoolBytes(&shard->config);
+        shard->poolBuffer = (unsigned char*)malloc(poolSize);
+        if (!shard->poolBuffer) {
+            printf("ERROR: Failed to allocate pool for shard %d\n", s);
+            return 1;
+        }
+        MemPool_Init(&shard->pool, shard->poolBuffer, poolSize);
+
+        if (!IngestServer_Open(&shard->server, &shard->config, &shard->pool)) {
+            perror("IngestServer_Open");
+            return 1;
+        }
+        printf("Shard %d listening on port %u (GRO %s)\n", s, shard->server.port,
+               shard->server.groActive ? "on" : "off");
+    }
+
+    for (int s = 0; s < shards; s++) {
+        pthread_create(&threads[s], NULL, shard_main, &shardState[s]);
+    }
+
+    unsigned long totalFrames = 0;
+    unsigned long totalErrors = 0;
+    int status = 0;
+
+    for (int s = 0; s < shards; s++) {
+        Shard* shard = &shardState[s];
+        IngestStats* st = &shard->server.stats;
+
+        pthread_join(threads[s], NULL);
+        printf("\nShard %d:\n", s);
+        printf("  Wakeups: %lu\n", st->wakeups);
+        printf("  Datagrams: %lu (%.1f per wakeup)\n", st->datagrams,
+               st->wakeups > 0 ? (double)st->datagrams / st->wakeups : 0);
+        printf("  Frames decoded: %lu (housekeeping %lu, science %lu, commandAck %lu)\n",
+               st->framesDecoded, shard->kindCounts[housekeeping_PRESENT],
+               shard->kindCounts[science_PRESENT], shard->kindCounts[commandAck_PRESENT]);
+        printf("  Checksum errors: %lu\n", st->checksumErrors);
+        printf("  Decode errors: %lu (last error %d)\n", st->decodeErrors, st->lastErrCode);
+        printf("  Truncated: %lu\n", st->truncated);
+
+        totalFrames += st->framesDecoded;
+        totalErrors += st->decodeErrors;
+        if (!shard->ok) status = 1;
+
+        IngestServer_Close(&shard->server);
+        free(shard->poolBuffer);
+    }
+
+    printf("\nTotal frames decoded: %lu\n", totalFrames);
+    printf("Total decode errors: %lu\n", totalErrors);
+    printf("Average rate: %.0f frames/sec\n", duration > 0 ? (double)totalFrames / duration : 0);
+
+    static LatencySnapshot latency;
+    if (Latency_Enabled() && Latency_Snapshot(&latency)) {
+        printf("\n");
+        Latency_WritePrometheus(stdout, &latency);
+    }
+    return status;
+}
@@ -0,0 +1,259 @@
+/* telemetry_export.c - Transcodes a frame corpus to CSV, JSON or NDJSON */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "asn1crt.h"
+#include "asn1crt_corpus.h"
+#include "asn1crt_export.h"
+#include "asn1crt_mempool.h"
+#include "satellite.h"
+
+#define DEFAULT_BATCH 256
+#define MAX_BATCH     4096
+
+static const char* const ackStatusNames[4] = { "success", "invalidCommand", "executionFailed", "insufficientPrivileges" };
+
+static void usage(const char* prog) {
+    printf("Usage: %s <corpus> <output|-> [csv|json|ndjson] [hex|base64] [--batch N] [--printf]\n", prog);
+    printf("  --batch N   Frames decoded per batch before serializing (default %d, max %d)\n", DEFAULT_BATCH, MAX_BATCH);
+    printf("  --printf    Serialize with stdio field by field instead (baseline)\n");
+    printf("  Build a corpus first with ./corpus_gen\n");
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void printf_blocks(FILE* out, const T_ScienceData* sci, ExportBlocks blocks, const char* sep, int quoted) {
+    static char text[4 * T_TelemetryFrame_REQUIRED_BYTES_FOR_ENCODING];
+
+    for (int b = 0; b < sci->dataBlocks.nCount; b++) {
+        fprintf(out, "%s%s", b > 0 ? sep : "", quoted ? "\"" : "");
+        if (blocks == EXPORT_BLOCKS_HEX) {
+            for (int i = 0; i < sci->dataBlocks.arr[b].nCount; i++) fprintf(out, "%02x", sci->dataBlocks.arr[b].arr[i]);
+        } else {
+            size_t n = Export_Base64Scalar(text, sci->dataBlocks.arr[b].arr, (size_t)sci->dataBlocks.arr[b].nCount);
+            fprintf(out, "%.*s", (int)n, text);
+        }
+        if (quoted) fputc('"', out);
+    }
+}
+
+// The decode-then-printf path the exporter replaces, kept for comparison
+static void printf_frame(FILE* out, const T_TelemetryFrame* f, ExportFormat format, ExportBlocks blocks,
+                         unsigned long long index) {
+    static const char* const kinds[4] = { "none", "housekeeping", "science", "commandAck" };
+    const T_FrameHeader* h = &f->header;
+
+    if (format == EXPORT_CSV) {
+        fprintf(out, "%llu,%llu,%llu,%llu,%s,", (unsigned long long)h->timestamp.seconds,
+                (unsigned long long)h->timestamp.subseconds, (unsigned long long)h->frameType,
+                (unsigned long long)h->frameCount, kinds[f->payload.kind & 3]);
+        if (f->payload.kind == housekeeping_PRESENT) {
+            const T_HousekeepingData* hk = &f->payload.u.housekeeping;
+            fprintf(out, "%llu,%llu,%llu,", (unsigned long long)hk->voltages.mainBus,
+                    (unsigned long long)hk->voltages.payload, (unsigned long long)hk->voltages.comms);
+            for (int i = 0; i < hk->temperature.nCount; i++) {
+                fprintf(out, "%s%lld", i > 0 ? ";" : "", (long long)hk->temperature.arr[i]);
+            }
+            fprintf(out, ",%llu,,,,\n", (unsigned long long)hk->status);
+        } else if (f->payload.kind == science_PRESENT) {
+            fprintf(out, ",,,,,%llu,", (unsigned long long)f->payload.u.science.instrumentId);
+            printf_blocks(out, &f->payload.u.science, blocks, ";", 0);
+            fprintf(out, ",,\n");
+        } else {
+            fprintf(out, ",,,,,,,%llu,%s\n", (unsigned long long)f->payload.u.commandAck.commandId,
+                    ackStatusNames[f->payload.u.commandAck.status & 3]);
+        }
+        return;
+    }
+
+    if (format == EXPORT_JSON) fprintf(out, "%s\n", index > 0 ? "," : "");
+    fprintf(out, "{\"seconds\":%llu,\"subseconds\":%llu,\"frameType\":%llu,\"frameCount\":%llu,\"kind\":\"%s\"",
+            (unsigned long long)h->timestamp.seconds, (unsigned long long)h->timestamp.subseconds,
+            (unsigned long long)h->frameType, (unsigned long long)h->frameCount, kinds[f->payload.kind & 3]);
+    if (f->payload.kind == housekeeping_PRESENT) {
+        const T_HousekeepingData* hk = &f->payload.u.housekeeping;
+        fprintf(out, ",\"voltages\":{\"mainBus\":%llu,\"payload\":%llu,\"comms\":%llu},\"temperature\":[",
+                (unsigned long long)hk->voltages.mainBus, (unsigned long long)hk->voltages.payload,
+                (unsigned long long)hk->voltages.comms);
+        for (int i = 0; i < hk->temperature.nCount; i++) {
+            fprintf(out, "%s%lld", i > 0 ? "," : "", (long long)hk->temperature.arr[i]);
+        }
+        fprintf(out, "],\"status\":%llu", (unsigned long long)hk->status);
+    } else if (f->payload.kind == science_PRESENT) {
+        fprintf(out, ",\"instrumentId\":%llu,\"dataBlocks\":[", (unsigned long long)f->payload.u.science.instrumentId);
+        printf_blocks(out, &f->payload.u.science, blocks, ",", 1);
+        fputc(']', out);
+    } else {
+        fprintf(out, ",\"commandId\":%llu,\"status\":\"%s\"", (unsigned long long)f->payload.u.commandAck.commandId,
+                ackStatusNames[f->payload.u.commandAck.status & 3]);
+    }
+    fprintf(out, "}%s", format == EXPORT_NDJSON ? "\n" : "");
+}
+
+// Release whatever main has set up so far; out owns fd once fdopen succeeds
+static void release(Corpus* corpus, int fd, int toStdout, FILE* out, byte* poolBuffer) {
+    if (out != NULL) {
+        fclose(out);
+    } else if (fd >= 0 && !toStdout) {
+        close(fd);
+    }
+    free(poolBuffer);
+    Corpus_Close(corpus);
+}
+
+int main(int argc, char** argv) {
+    ExportFormat format = EXPORT_CSV;
+    ExportBlocks blocks = EXPORT_BLOCKS_HEX;
+    int batch = DEFAULT_BATCH;
+    int usePrintf = 0;
+    const char* positional[4];
+    int npos = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch = atoi(argv[++i]);
+            if (batch < 1) batch = 1;
+            if (batch > MAX_BATCH) batch = MAX_BATCH;
+        } else if (strcmp(argv[i], "--printf") == 0) {
+            usePrintf = 1;
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else if (npos < 4) {
+            positional[npos++] = argv[i];
+        }
+    }
+    if (npos < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (npos > 2) {
+        if (strcmp(positional[2], "json") == 0) {
+            format = EXPORT_JSON;
+        } else if (strcmp(positional[2], "ndjson") == 0) {
+            format = EXPORT_NDJSON;
+        } else if (strcmp(positional[2], "csv") != 0) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (npos > 3) {
+        if (strcmp(positional[3], "base64") == 0) {
+            blocks = EXPORT_BLOCKS_BASE64;
+        } else if (strcmp(positional[3], "hex") != 0) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Corpus corpus;
+    int errCode = 0;
+    if (!Corpus_Open(&corpus, positional[0], &errCode)) {
+        fprintf(stderr, "ERROR: Cannot open corpus %s: error %d\n", positional[0], errCode);
+        return 1;
+    }
+
+    int toStdout = strcmp(positional[1], "-") == 0;
+    int fd = toStdout ? STDOUT_FILENO : open(positional[1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "ERROR: Cannot create %s\n", positional[1]);
+        Corpus_Close(&corpus);
+        return 1;
+    }
+    // Keep the report off the data when exporting to stdout
+    FILE* report = toStdout ? stderr : stdout;
+
+    static T_TelemetryFrame frames[MAX_BATCH];
+    size_t poolSize = Exporter_PoolBytes();
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    Exporter ex;
+    FILE* out = NULL;
+    unsigned long failed = 0;
+    unsigned long long exported = 0;
+    unsigned long long bytesIn = 0;
+    unsigned long long bytesOut = 0;
+    int ok = 1;
+
+    if (poolBuffer == NULL) {
+        fprintf(stderr, "ERROR: Out of memory\n");
+        release(&corpus, fd, toStdout, NULL, NULL);
+        return 1;
+    }
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    if (usePrintf) {
+        out = fdopen(fd, "w");
+        if (out == NULL) {
+            fprintf(stderr, "ERROR: Cannot open a stream on %s\n", positional[1]);
+            release(&corpus, fd, toStdout, NULL, poolBuffer);
+            return 1;
+        }
+        if (format == EXPORT_CSV) {
+            fprintf(out, "seconds,subseconds,frameType,frameCount,kind,mainBus,payload,comms,"
+                         "temperature,status,instrumentId,dataBlocks,commandId,ackStatus\n");
+        } else if (format == EXPORT_JSON) {
+            fputc('[', out);
+        }
+    } else if (!Exporter_Open(&ex, fd, format, blocks, &pool, &errCode)) {
+        fprintf(stderr, "ERROR: Exporter setup failed: error %d\n", errCode);
+        release(&corpus, fd, toStdout, NULL, poolBuffer);
+        return 1;
+    }
+
+    double start = now_seconds();
+    for (unsigned int base = 0; ok && base < corpus.count; base += (unsigned int)batch) {
+        int n = 0;
+        for (unsigned int i = base; i < corpus.count && i < base + (unsigned int)batch; i++) {
+            int length;
+            const byte* data = Corpus_Frame(&corpus, i, &length);
+            BitStream bs;
+            BitStream_AttachBuffer(&bs, (unsigned char*)data, length);
+            bytesIn += (unsigned long long)length;
+            if (T_TelemetryFrame_Decode(&frames[n], &bs, &errCode)) {
+                n++;
+            } else {
+                failed++;
+            }
+        }
+        if (usePrintf) {
+            for (int i = 0; i < n; i++) printf_frame(out, &frames[i], format, blocks, exported + (unsigned long long)i);
+        } else if (Exporter_WriteBatch(&ex, frames, n, &errCode) != n) {
+            ok = 0;
+        }
+        exported += (unsigned long long)n;
+    }
+    if (usePrintf) {
+        if (format == EXPORT_JSON) fprintf(out, "\n]\n");
+        fflush(out);
+        bytesOut = (unsigned long long)ftello(out);
+        if (toStdout) bytesOut = 0;
+    } else {
+        ok = ok && Exporter_Close(&ex, &errCode);
+        bytesOut = ex.bytes;
+    }
+    double elapsed = now_seconds() - start;
+
+    if (!ok) {
+        fprintf(stderr, "ERROR: Write to %s failed: error %d\n", positional[1], errCode);
+    }
+    fprintf(report, "===== Telemetry Export =====\n");
+    fprintf(report, "Corpus: %s, %u frames -> %s (%s, blocks as %s, %s)\n", positional[0], corpus.count,
+            positional[1], format == EXPORT_CSV ? "csv" : format == EXPORT_JSON ? "json" : "ndjson",
+            blocks == EXPORT_BLOCKS_HEX ? "hex" : "base64",
+            usePrintf ? "stdio printf" : Export_SimdAvailable() ? "exporter, SSSE3" : "exporter, scalar");
+    fprintf(report, "Exported %llu frames, %lu undecodable, %.3fs\n", exported, failed, elapsed);
+    if (elapsed > 0) {
+        fprintf(report, "Throughput: %.0f frames/s, %.1f MB/s input, %.1f MB/s output\n",
+                exported / elapsed, bytesIn / elapsed / 1e6, bytesOut / elapsed / 1e6);
+    }
+
+    release(&corpus, fd, toStdout, out, poolBuffer);
+    return ok && failed == 0 ? 0 : 1;
+}
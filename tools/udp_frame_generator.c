@@ -0,0 +1,178 @@
+/* udp_frame_generator.c - Sends uPER TelemetryFrames over UDP for ingest testing */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "asn1crt.h"
+#include "asn1crt_integrity.h"
+#include "asn1crt_mempool.h"
+#include "asn1crt_outring.h"
+#include "satellite.h"
+
+#define GENERATOR_BATCH 64
+#define GENERATOR_DRAIN_MS 1000  /* Longest wait for the socket to take the last frames */
+
+// Build frame number i, rotating through the three payload kinds
+static void build_frame(T_TelemetryFrame* frame, unsigned long i) {
+    T_TelemetryFrame_Initialize(frame);
+
+    frame->header.timestamp.seconds = 1000000 + i / 1000;
+    frame->header.timestamp.subseconds = i % 1000;
+    frame->header.frameType = (i % 3) + 1;
+    frame->header.frameCount = i % 65536;
+
+    switch (i % 3) {
+    case 0:
+        frame->payload.kind = housekeeping_PRESENT;
+        frame->payload.u.housekeeping.voltages.mainBus = 3300;
+        frame->payload.u.housekeeping.voltages.payload = 5000;
+        frame->payload.u.housekeeping.voltages.comms = 1800;
+        frame->payload.u.housekeeping.temperature.nCount = 1 + i % 8;
+        for (int t = 0; t < frame->payload.u.housekeeping.temperature.nCount; t++) {
+            frame->payload.u.housekeeping.temperature.arr[t] = (asn1SccSint)((i + t) % 201) - 100;
+        }
+        frame->payload.u.housekeeping.status = i % 256;
+        break;
+    case 1:
+        frame->payload.kind = science_PRESENT;
+        frame->payload.u.science.instrumentId = i % 256;
+        frame->payload.u.science.dataBlocks.nCount = 1 + i % 4;
+        for (int b = 0; b < frame->payload.u.science.dataBlocks.nCount; b++) {
+            int size = 1 + (int)((i * 37 + b * 101) % 256);
+            frame->payload.u.science.dataBlocks.arr[b].nCount = size;
+            for (int k = 0; k < size; k++) {
+                frame->payload.u.science.dataBlocks.arr[b].arr[k] = (byte)(i + k);
+            }
+        }
+        break;
+    default:
+        frame->payload.kind = commandAck_PRESENT;
+        frame->payload.u.commandAck.commandId = i % 65536;
+        frame->payload.u.commandAck.status = (T_CommandAck_status)(i % 4);
+        break;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* host = "127.0.0.1";
+    int port = 0;
+    unsigned long count = 10000;
+    long rate = 0; /* frames per second, 0 = as fast as possible */
+    IntegrityKind integrity = INTEGRITY_NONE;
+
+    if (argc < 3) {
+        printf("Usage: %s <host> <port> [frames] [frames_per_second] [none|crc16|crc32c]\n", argv[0]);
+        return 1;
+    }
+    host = argv[1];
+    port = atoi(argv[2]);
+    if (argc > 3) count = strtoul(argv[3], NULL, 10);
+    if (argc > 4) rate = atol(argv[4]);
+    if (argc > 5) {
+        if (strcmp(argv[5], "crc16") == 0) integrity = INTEGRITY_CRC16_CCSDS;
+        else if (strcmp(argv[5], "crc32c") == 0) integrity = INTEGRITY_CRC32C;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    struct sockaddr_in dest;
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons((unsigned short)port);
+    if (inet_pton(AF_INET, host, &dest.sin_addr) != 1) {
+        printf("ERROR: Invalid IPv4 address: %s\n", host);
+        return 1;
+    }
+    // Connected, so the output ring can sendmmsg without per-message addresses
+    if (connect(fd, (struct sockaddr*)&dest, sizeof(dest)) != 0) {
+        perror("connect");
+        return 1;
+    }
+
+    // Frames are encoded straight into the ring's slots and sent a batch per sendmmsg
+    OutRingConfig cfg;
+    OutRingConfig_Default(&cfg);
+    cfg.mode = OUTRING_DATAGRAM;
+    cfg.batchSize = GENERATOR_BATCH;
+    cfg.integrity = integrity;
+    size_t poolSize = OutRing_PoolBytes(&cfg);
+    byte* poolBuffer = (byte*)malloc(poolSize);
+    MemPool pool;
+    OutRing ring;
+    int errCode;
+    if (poolBuffer == NULL) {
+        printf("ERROR: Out of memory\n");
+        return 1;
+    }
+    MemPool_Init(&pool, poolBuffer, poolSize);
+    if (!OutRing_Open(&ring, fd, &cfg, &pool, &errCode)) {
+        printf("ERROR: Output ring setup failed: error %d\n", errCode);
+        return 1;
+    }
+
+    T_TelemetryFrame frame;
+    unsigned long sent = 0;
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while (sent < count) {
+        int batch = (count - sent < GENERATOR_BATCH) ? (int)(count - sent) : GENERATOR_BATCH;
+
+        for (int i = 0; i < batch; i++) {
+            build_frame(&frame, sent + i);
+            if (!OutRing_Encode(&ring, &frame, &errCode)) {
+                printf("ERROR: Failed to send frame %lu: error %d\n", sent + i, errCode);
+                return 1;
+            }
+        }
+        if (!OutRing_Flush(&ring, &errCode)) {
+            perror("sendmmsg");
+            return 1;
+        }
+        sent += batch;
+
+        // Pace to the requested rate by sleeping until this batch is due
+        if (rate > 0) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            double elapsed = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+            double due = (double)sent / rate;
+            if (due > elapsed) {
+                usleep((useconds_t)((due - elapsed) * 1e6));
+            }
+        }
+    }
+
+    // sendmmsg may take only part of a batch, and after the last one no
+    // further Encode flushes the rest: drain until nothing is pending or a
+    // wait moves nothing
+    while (OutRing_Pending(&ring) > 0) {
+        unsigned long flushed = ring.stats.flushed;
+        if (!OutRing_Wait(&ring, GENERATOR_DRAIN_MS, &errCode)) {
+            perror("sendmmsg");
+            return 1;
+        }
+        if (ring.stats.flushed == flushed) {
+            printf("ERROR: %d frames still queued after %d ms\n", OutRing_Pending(&ring), GENERATOR_DRAIN_MS);
+            return 1;
+        }
+    }
+    unsigned long bytes = ring.stats.bytes;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+    printf("Sent %lu frames (%lu bytes) to %s:%d in %.3f seconds\n", sent, bytes, host, port, elapsed);
+    printf("Send rate: %.0f frames/sec\n", elapsed > 0 ? sent / elapsed : 0);
+
+    close(fd);
+    free(poolBuffer);
+    return 0;
+}